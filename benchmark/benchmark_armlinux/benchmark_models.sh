@@ -74,8 +74,7 @@ function build_armlinux_bench() {
         -DTNN_UNIT_TEST_ENABLE=ON \
         -DTNN_COVERAGE=ON \
         -DCMAKE_SYSTEM_PROCESSOR=$TARGET_ARCH \
-        -DTNN_BUILD_SHARED:BOOL=$SHARED_LIB \
-        -DTNN_BENCHMARK_MODE=ON 
+        -DTNN_BUILD_SHARED:BOOL=$SHARED_LIB
 
     make -j4
 }
@@ -107,7 +106,7 @@ function bench_armlinux() {
 
         for benchmark_model in ${benchmark_model_list[*]}
         do
-            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
+            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest -bm -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
         done
     fi
 
@@ -121,7 +120,7 @@ function bench_armlinux() {
         echo "benchmark device: ${device} " >> $WORK_DIR/$OUTPUT_LOG_FILE
         for benchmark_model in ${benchmark_model_list[*]}
         do
-            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
+            cd ${WORK_DIR}; LD_LIBRARY_PATH=. ./build/test/TNNTest -bm -wc ${WARM_UP_COUNT} -ic ${LOOP_COUNT} -dt ${device} -mt ${MODEL_TYPE} -mp ${BENCHMARK_MODEL_DIR}/${benchmark_model}  >> $OUTPUT_LOG_FILE
         done
     fi
 
@@ -0,0 +1,200 @@
+# Tencent is pleased to support the open source community by making TNN available.
+#
+# Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+#
+# Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+# in compliance with the License. You may obtain a copy of the License at
+#
+# https://opensource.org/licenses/BSD-3-Clause
+#
+# Unless required by applicable law or agreed to in writing, software distributed
+# under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+# CONDITIONS OF ANY KIND, either express or implied. See the License for the
+# specific language governing permissions and limitations under the License.
+
+# Compare two sets of benchmark json results, written by TNNTest -bo and
+# layer_benchmark -op. Each case is compared by the ratio of the median time,
+# target / base, with a bootstrap confidence interval over the iteration times.
+# Repeated runs of a case, in several files, are resampled run by run first.
+#
+#   python3 compare_benchmark.py base_dir target_dir
+#   python3 compare_benchmark.py base.json target.json -t 0.05 -c 0.99
+
+import argparse
+import json
+import os
+import random
+import sys
+
+
+def load_results(paths):
+    """results of json files, directories are searched for *.json"""
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            for name in sorted(os.listdir(path)):
+                if name.endswith(".json"):
+                    files.append(os.path.join(path, name))
+        else:
+            files.append(path)
+
+    cases = {}
+    for file_name in files:
+        with open(file_name) as f:
+            try:
+                content = json.load(f)
+            except ValueError as e:
+                print("skip %s: %s" % (file_name, e), file=sys.stderr)
+                continue
+        for result in content.get("results", []):
+            key = case_key(result)
+            times = result.get("times_ms") or []
+            if not times and result.get("time_avg_ms") is not None:
+                # results without the time of each iteration
+                times = [result["time_avg_ms"]]
+            if not times:
+                continue
+            case = cases.setdefault(key, {"kind": "layer" if "params" in result else "model", "runs": []})
+            case["runs"].append([float(t) for t in times])
+    return cases
+
+
+def case_key(result):
+    params = result.get("params", {})
+    params_str = ",".join("%s=%s" % (k, params[k]) for k in params)
+    return (result.get("name", ""), result.get("device", ""), result.get("data_type", ""),
+            str(result.get("threads", "")), params_str, json.dumps(result.get("input_dims", [])))
+
+
+def case_title(key):
+    name, device, data_type, threads, params, _ = key
+    title = "%s %s %s th%s" % (name, device, data_type, threads)
+    return title + (" " + params if params else "")
+
+
+def median(values):
+    values = sorted(values)
+    n = len(values)
+    if n == 0:
+        return 0.0
+    if n % 2 == 1:
+        return values[n // 2]
+    return 0.5 * (values[n // 2 - 1] + values[n // 2])
+
+
+def resample(runs, rng):
+    """resample runs, then iterations of each chosen run"""
+    samples = []
+    for _ in range(len(runs)):
+        run = runs[rng.randrange(len(runs))]
+        samples.extend(run[rng.randrange(len(run))] for _ in range(len(run)))
+    return samples
+
+
+def percentile(sorted_values, percent):
+    index = int(round(percent / 100.0 * (len(sorted_values) - 1)))
+    return sorted_values[min(max(index, 0), len(sorted_values) - 1)]
+
+
+def compare_case(base_runs, target_runs, args, rng):
+    base_all = [t for run in base_runs for t in run]
+    target_all = [t for run in target_runs for t in run]
+    base_median = median(base_all)
+    target_median = median(target_all)
+    ratio = target_median / base_median if base_median > 0 else float("inf")
+
+    compare = {"base_ms": base_median, "target_ms": target_median, "ratio": ratio,
+               "ci_low": ratio, "ci_high": ratio, "p_slower": None}
+    # a single time on either side, such as results without times_ms, can not be tested
+    if len(base_all) < 2 or len(target_all) < 2 or base_median <= 0:
+        compare["verdict"] = "no samples"
+        return compare
+
+    ratios = []
+    for _ in range(args.bootstrap):
+        base = median(resample(base_runs, rng))
+        target = median(resample(target_runs, rng))
+        if base > 0:
+            ratios.append(target / base)
+    ratios.sort()
+    alpha = (1.0 - args.confidence) / 2.0 * 100.0
+    compare["ci_low"] = percentile(ratios, alpha)
+    compare["ci_high"] = percentile(ratios, 100.0 - alpha)
+    compare["p_slower"] = sum(1 for r in ratios if r > 1.0) / float(len(ratios))
+
+    # the whole interval has to be beyond the threshold, noise widens the interval
+    if compare["ci_low"] > 1.0 + args.threshold:
+        compare["verdict"] = "regression"
+    elif compare["ci_high"] < 1.0 - args.threshold:
+        compare["verdict"] = "improvement"
+    elif compare["ci_high"] - compare["ci_low"] > 4 * args.threshold:
+        compare["verdict"] = "noisy"
+    else:
+        compare["verdict"] = "unchanged"
+    return compare
+
+
+def print_report(rows, args):
+    for kind in ["model", "layer"]:
+        kind_rows = [row for row in rows if row["kind"] == kind]
+        if not kind_rows:
+            continue
+        print("%s results, ratio = target / base median time, %d%% confidence interval" %
+              (kind, int(args.confidence * 100)))
+        width = max(len(row["case"]) for row in kind_rows)
+        print("%-*s %10s %10s %8s %19s %9s  %s" %
+              (width, "case", "base(ms)", "target(ms)", "ratio", "interval", "p(slower)", "verdict"))
+        for row in sorted(kind_rows, key=lambda r: -r["ratio"]):
+            p_slower = "-" if row["p_slower"] is None else "%.3f" % row["p_slower"]
+            print("%-*s %10.3f %10.3f %8.3f   [%6.3f, %6.3f] %9s  %s" %
+                  (width, row["case"], row["base_ms"], row["target_ms"], row["ratio"], row["ci_low"],
+                   row["ci_high"], p_slower, row["verdict"]))
+        print("")
+
+    counts = {}
+    for row in rows:
+        counts[row["verdict"]] = counts.get(row["verdict"], 0) + 1
+    print("summary: " + ", ".join("%s %d" % (k, counts[k]) for k in sorted(counts)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare two sets of TNN benchmark json results")
+    parser.add_argument("base", help="base json file or directory, before the change")
+    parser.add_argument("target", help="target json file or directory, after the change")
+    parser.add_argument("-t", "--threshold", type=float, default=0.03,
+                        help="relative change below which cases are unchanged (default 0.03)")
+    parser.add_argument("-c", "--confidence", type=float, default=0.95,
+                        help="confidence level of the interval (default 0.95)")
+    parser.add_argument("-b", "--bootstrap", type=int, default=2000, help="bootstrap resamples (default 2000)")
+    parser.add_argument("-s", "--seed", type=int, default=2020, help="random seed of the resampling")
+    parser.add_argument("-o", "--output", default="", help="write the comparison as json")
+    parser.add_argument("--fail-on-regression", action="store_true", help="exit with 1 if any case regressed")
+    args = parser.parse_args()
+
+    base_cases = load_results([args.base])
+    target_cases = load_results([args.target])
+    rng = random.Random(args.seed)
+
+    rows = []
+    for key in sorted(set(base_cases) & set(target_cases)):
+        row = compare_case(base_cases[key]["runs"], target_cases[key]["runs"], args, rng)
+        row["case"] = case_title(key)
+        row["kind"] = base_cases[key]["kind"]
+        rows.append(row)
+
+    print_report(rows, args)
+    for key in sorted(set(base_cases) ^ set(target_cases)):
+        side = "base" if key in base_cases else "target"
+        print("only in %s: %s" % (side, case_title(key)))
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump({"threshold": args.threshold, "confidence": args.confidence, "cases": rows}, f, indent=2)
+
+    if args.fail_on_regression and any(row["verdict"] == "regression" for row in rows):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
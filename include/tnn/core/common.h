@@ -45,6 +45,9 @@ typedef enum {
     DATA_FORMAT_NC4HW4 = 3,
     DATA_FORMAT_NCDHW  = 4,
     DATA_FORMAT_NHC4W4 = 5,
+    // channels packed by 8 and 16, the vector widths of avx2 and avx512
+    DATA_FORMAT_NC8HW8   = 6,
+    DATA_FORMAT_NC16HW16 = 7,
 } DataFormat;
 
 typedef enum {
@@ -70,6 +73,15 @@ typedef enum {
     PRECISION_LOW = 2
 } Precision;
 
+typedef enum {
+    // threads are not bound to cpus
+    CPU_AFFINITY_NONE = 0,
+    // threads are bound to the little (efficient) cores
+    CPU_AFFINITY_LITTLE_CORES = 1,
+    // threads are bound to the big (performance) cores
+    CPU_AFFINITY_BIG_CORES = 2
+} CpuAffinityMode;
+
 typedef enum {
     NETWORK_TYPE_DEFAULT    = 0,
     NETWORK_TYPE_OPENVINO   = 0x1000,
@@ -116,6 +128,40 @@ typedef enum {
 
 using DimsVector = std::vector<int>;
 
+//@brief Config of the incremental forward for video streams of fixed cameras.
+// Forward compares the input with the previous one tile by tile, and only
+// the output regions depending on the changed tiles are computed again.
+// Supported with a single nchw input of batch 1 on host devices, for models
+// of convolutions, poolings and element wise layers, other models are
+// computed again only if the input changes.
+struct PUBLIC IncrementalConfig {
+    // enable the incremental forward
+    bool enable = false;
+
+    // tile size in pixels of the input change detection
+    int tile_size = 16;
+
+    // compute the whole network if the input region to compute again covers
+    // more than the ratio of the input
+    float max_recompute_ratio = 0.5f;
+
+    // a float input value is unchanged if its absolute difference with the
+    // previous one is not larger than the tolerance
+    float tolerance = 0.0f;
+};
+
+//@brief Forward counts of the incremental forward
+struct PUBLIC IncrementalStats {
+    // forwards computing the whole network
+    long long full_count = 0;
+    // forwards computing the regions of the changed tiles
+    long long partial_count = 0;
+    // forwards skipped as the input is unchanged
+    long long skip_count = 0;
+    // ratio of the input computed again by the last forward
+    float last_recompute_ratio = 0.0f;
+};
+
 //@brief Config used to create tnn instance, config
 // device type, network type and share memory mode.
 struct PUBLIC NetworkConfig {
@@ -142,6 +188,27 @@ struct PUBLIC NetworkConfig {
 
     // cache path to store possible cache models
     std::string cache_path = "";
+
+    // numa node the instance is placed on, -1 means no binding.
+    // cpu threads are bound to the cpus of the node and memory allocated
+    // during instance creation prefers the node.
+    int numa_node = -1;
+
+    // cpu ids the instance threads are bound to, empty means no binding.
+    // restricted to the cpus of numa_node if it is set.
+    std::vector<int> cpu_list = {};
+
+    // cpu cluster the instance threads are bound to if cpu_list is empty.
+    // all cpus are used on cpus without big and little cores.
+    CpuAffinityMode cpu_affinity_mode = CPU_AFFINITY_NONE;
+
+    // record forward and mat conversion latencies of the instance, read
+    // with Instance::GetServingMetrics
+    bool enable_metrics = false;
+
+    // compute only the regions changed since the previous forward, read the
+    // counts with Instance::GetIncrementalStats
+    IncrementalConfig incremental_config;
 };
 
 struct PUBLIC ModelConfig {
@@ -155,6 +222,10 @@ struct PUBLIC ModelConfig {
     // hiai model need two params: order is model name, model_file_path.
     // atlas model need one param: config string.
     std::vector<std::string> params = {};
+
+    // benchmark mode, tnn and ncnn model only. the model content can be empty,
+    // weights and int8 blob scales missing in it are generated randomly.
+    bool benchmark_mode = false;
 };
 
 }  // namespace TNN_NS
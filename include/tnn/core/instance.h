@@ -24,6 +24,8 @@
 #include "tnn/core/macro.h"
 #include "tnn/core/status.h"
 #include "tnn/utils/blob_converter.h"
+#include "tnn/utils/memory_report.h"
+#include "tnn/utils/serving_metrics.h"
 
 #pragma warning(push)
 #pragma warning(disable : 4251)
@@ -32,6 +34,8 @@ namespace TNN_NS {
 
 class AbstractNetwork;
 class AbstractModelInterpreter;
+class IncrementalForward;
+class ServingMetrics;
 
 struct LayerInfo;
 
@@ -51,6 +55,10 @@ public:
     // deinit, release network
     Status DeInit();
 
+    // create an instance with the same config and input shapes, sharing the converted
+    // layer weights of this instance. only blobs and forward memory are allocated.
+    std::shared_ptr<Instance> Clone(Status& status);
+
     //  return memory bytes required for forward
     Status GetForwardMemorySize(int& memory_size);
 
@@ -61,6 +69,18 @@ public:
     //  will result in undefined behavior.
     Status SetForwardMemory(void* memory);
 
+    // get memory allocated for the instance, by type and by layer, including
+    // the weights shared with other instances, converters and output mats.
+    Status GetMemoryReport(MemoryReport& report);
+
+    // get forward count, error count and latency histograms of the instance,
+    // only available if NetworkConfig::enable_metrics is set.
+    Status GetServingMetrics(ServingMetricsData& metrics);
+
+    // get forward counts of the incremental forward, only available if
+    // NetworkConfig::incremental_config is enabled.
+    Status GetIncrementalStats(IncrementalStats& stats);
+
     // reshape instance with new input shapes
     Status Reshape(const InputShapesMap& inputs);
 
@@ -87,6 +107,9 @@ public:
 
     // set threads run on cpu
     virtual Status SetCpuNumThreads(int num_threads);
+
+    // bind threads run on cpu to cpu ids, empty list means no binding
+    virtual Status SetCpuAffinity(const std::vector<int>& cpu_list);
 #if TNN_PROFILE
 public:
     /**start to profile each layer, dont call this func if you only want to profile the whole mode*/
@@ -100,6 +123,10 @@ private:
     std::shared_ptr<AbstractNetwork> network_;
     NetworkConfig net_config_;
     ModelConfig model_config_;
+    // null if metrics are not enabled
+    std::shared_ptr<ServingMetrics> metrics_;
+    // null if the incremental forward is not enabled
+    std::shared_ptr<IncrementalForward> incremental_;
     
     //Mat interface for simple use
 public:
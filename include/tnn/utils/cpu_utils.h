@@ -32,6 +32,33 @@ public:
     // @brief set cpu powersave
     // @param powersave 0:all cpus 1:little cluster 2:big cluster
     PUBLIC static Status SetCpuPowersave(int powersave);
+
+    // @brief get cpu ids of cluster, cpus are ranked by max frequency or
+    // by core type on hybrid x86 cpus, all cpus are returned on SMP cpus
+    // @param powersave 0:all cpus 1:little cluster 2:big cluster
+    // @param cpu_list vector of cpuids in the cluster
+    PUBLIC static Status GetCpuClusterList(int powersave, std::vector<int>& cpu_list);
+
+    // @brief get cpu affinity of the calling thread
+    // @param cpu_list vector of cpuids the thread may run on
+    PUBLIC static Status GetCpuAffinity(std::vector<int>& cpu_list);
+
+    // @brief set cpu affinity for the calling thread and its openmp threads
+    // @param cpu_list vector of cpuids("0,1,2,3")
+    // @param num_threads openmp threads to bind
+    PUBLIC static Status SetCpuAffinityForThreads(const std::vector<int>& cpu_list, int num_threads);
+
+    // @brief get numa node count, 1 if numa is not supported
+    PUBLIC static int GetNumaNodeCount();
+
+    // @brief get cpu list of numa node
+    // @param numa_node numa node id
+    // @param cpu_list vector of cpuids on the numa node
+    PUBLIC static Status GetNumaNodeCpuList(int numa_node, std::vector<int>& cpu_list);
+
+    // @brief prefer to allocate memory of the calling thread on numa node
+    // @param numa_node numa node id, -1 restores the default local policy
+    PUBLIC static Status SetNumaMemoryPolicy(int numa_node);
 };
 
 }  // namespace TNN_NS
@@ -0,0 +1,83 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_UTILS_MEMORY_REPORT_H_
+#define TNN_INCLUDE_TNN_UTILS_MEMORY_REPORT_H_
+
+#include <string>
+#include <vector>
+
+#include "tnn/core/macro.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+namespace TNN_NS {
+
+typedef enum {
+    // model weights of the net resource, shared by instances of the same TNN
+    MEMORY_TYPE_WEIGHTS = 0,
+    // buffers held by layer accs, such as converted and packed weights
+    MEMORY_TYPE_LAYER = 1,
+    // blob memory used by forward
+    MEMORY_TYPE_BLOB = 2,
+    // shared workspace of the device context
+    MEMORY_TYPE_WORKSPACE = 3,
+    // scratch of the blob converters of the instance
+    MEMORY_TYPE_CONVERTER = 4,
+    // mats allocated by the instance, such as output mats
+    MEMORY_TYPE_MAT = 5,
+    MEMORY_TYPE_COUNT = 6,
+} MemoryType;
+
+struct PUBLIC MemoryUsage {
+    // bytes allocated now
+    long long current = 0;
+    // most bytes allocated at the same time
+    long long peak = 0;
+};
+
+struct PUBLIC LayerMemoryReport {
+    std::string layer_name = "";
+    std::string layer_type = "";
+    // buffers allocated by the layer in init, reshape and forward
+    MemoryUsage usage;
+};
+
+// @brief MemoryReport lists memory allocated through RawBuffer and the cpu
+// devices (ARM, NAIVE) on behalf of an instance. Allocations made on the
+// OpenMP worker threads of a kernel and memory of other devices are not
+// included, except the forward memory of the blob manager.
+struct PUBLIC MemoryReport {
+    // usage of each MemoryType
+    MemoryUsage usage[MEMORY_TYPE_COUNT];
+    // all types, including the weights shared with other instances
+    MemoryUsage total;
+    // blob memory required by forward, as Instance::GetForwardMemorySize
+    long long forward_memory = 0;
+    // layers in network order
+    std::vector<LayerMemoryReport> layers;
+
+    // @brief readable report with the usage of each type and each layer
+    std::string ToString() const;
+};
+
+// @brief name of the memory type, such as weights
+PUBLIC const char* MemoryTypeToString(MemoryType type);
+
+}  // namespace TNN_NS
+
+#pragma warning(pop)
+
+#endif  // TNN_INCLUDE_TNN_UTILS_MEMORY_REPORT_H_
@@ -0,0 +1,71 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_UTILS_SERVING_METRICS_H_
+#define TNN_INCLUDE_TNN_UTILS_SERVING_METRICS_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tnn/core/macro.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+namespace TNN_NS {
+
+// @brief snapshot of a latency histogram, times in ms
+struct PUBLIC LatencyHistogramData {
+    long long count = 0;
+    double sum      = 0;
+    double min      = 0;
+    double max      = 0;
+    double p50      = 0;
+    double p90      = 0;
+    double p99      = 0;
+    double p999     = 0;
+    // upper bounds of the exported buckets in ms and the number of samples
+    // not greater than each bound
+    std::vector<double> bucket_bounds;
+    std::vector<long long> bucket_counts;
+};
+
+// @brief ServingMetricsData is a snapshot of the metrics of an instance
+// enabled by NetworkConfig::enable_metrics. Counters and histograms only grow.
+struct PUBLIC ServingMetricsData {
+    // Forward, ForwardAsync and ForwardWithCallback calls
+    long long forward_count = 0;
+    // failed forward calls and failed mat conversions of the instance
+    long long error_count = 0;
+    // Instance::SetInputMat
+    LatencyHistogramData convert_in;
+    // forward calls, the submission only for ForwardAsync
+    LatencyHistogramData forward;
+    // Instance::GetOutputMat with a conversion
+    LatencyHistogramData convert_out;
+    // from the end of a ForwardAsync submission until its first output mat is
+    // converted by GetOutputMat, covering the device queue and the collection
+    LatencyHistogramData queue;
+
+    // @brief metrics in the prometheus text exposition format, named tnn_*
+    // @param labels labels added to every sample, such as {"model", "mobilenet"}
+    std::string ToPrometheusText(const std::map<std::string, std::string>& labels = {}) const;
+};
+
+}  // namespace TNN_NS
+
+#pragma warning(pop)
+
+#endif  // TNN_INCLUDE_TNN_UTILS_SERVING_METRICS_H_
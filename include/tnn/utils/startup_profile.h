@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_UTILS_STARTUP_PROFILE_H_
+#define TNN_INCLUDE_TNN_UTILS_STARTUP_PROFILE_H_
+
+#include <string>
+#include <vector>
+
+#include "tnn/core/macro.h"
+
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
+namespace TNN_NS {
+
+struct PUBLIC StartupStageData {
+    // stage name, such as proto parse, net optimize, blob memory allocate
+    std::string name = "";
+    // time cost in ms, summed over all calls of the stage
+    double time = 0;
+    // minor page faults of the process during the stage, 0 if unknown
+    long page_faults = 0;
+};
+
+struct PUBLIC StartupLayerData {
+    std::string layer_name = "";
+    std::string layer_type = "";
+    // layer init and weights init time in ms
+    double time = 0;
+};
+
+// @brief StartupProfile records where the time of TNN::Init, CreateInst and
+// the first Forward goes, in the order stages are first seen. It is disabled by
+// default and records the whole process, enable it before TNN::Init.
+class StartupProfile {
+public:
+    // @brief enable or disable recording
+    PUBLIC static void SetEnabled(bool enabled);
+
+    PUBLIC static bool IsEnabled();
+
+    // @brief clear recorded data
+    PUBLIC static void Reset();
+
+    // @brief add a stage, the cost of stages with the same name is accumulated
+    PUBLIC static void AddStage(const std::string& name, double time, long page_faults);
+
+    // @brief add init time of a layer, accumulated by layer name
+    PUBLIC static void AddLayer(const std::string& layer_name, const std::string& layer_type, double time);
+
+    PUBLIC static std::vector<StartupStageData> GetStages();
+
+    // @brief layers sorted by time, the slowest first
+    PUBLIC static std::vector<StartupLayerData> GetLayers();
+
+    // @brief minor page faults of the process so far, 0 if unknown
+    PUBLIC static long GetPageFaults();
+};
+
+}  // namespace TNN_NS
+
+#pragma warning(pop)
+
+#endif  // TNN_INCLUDE_TNN_UTILS_STARTUP_PROFILE_H_
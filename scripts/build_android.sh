@@ -12,7 +12,6 @@ OPENCL="ON"
 if [ -z "$HUAWEI_NPU" ]; then
     HUAWEI_NPU="OFF"
 fi
-BENMARK_MODE="OFF"
 DEBUG="OFF"
 INCREMENTAL_COMPILE="OFF"
 SHARING_MEM_WITH_OPENGL=0
@@ -95,7 +94,6 @@ cmake ${TNN_ROOT_PATH} \
       -DTNN_ARM_ENABLE:BOOL=$ARM \
       -DTNN_HUAWEI_NPU_ENABLE:BOOL=$HUAWEI_NPU \
       -DTNN_OPENCL_ENABLE:BOOL=$OPENCL \
-      -DTNN_BENCHMARK_MODE:BOOL=$BENMARK_MODE \
       -DTNN_TEST_ENABLE:BOOL=ON \
       -DTNN_OPENMP_ENABLE:BOOL=$OPENMP \
       -DSHARING_MEM_WITH_OPENGL=${SHARING_MEM_WITH_OPENGL} \
@@ -129,7 +127,6 @@ cmake ${TNN_ROOT_PATH} \
       -DTNN_HUAWEI_NPU_ENABLE:BOOL=$HUAWEI_NPU \
       -DTNN_OPENCL_ENABLE:BOOL=$OPENCL \
       -DTNN_TEST_ENABLE:BOOL=ON \
-      -DTNN_BENCHMARK_MODE:BOOL=$BENMARK_MODE \
       -DTNN_OPENMP_ENABLE:BOOL=$OPENMP \
       -DSHARING_MEM_WITH_OPENGL=${SHARING_MEM_WITH_OPENGL} \
       -DTNN_BUILD_SHARED:BOOL=$SHARED_LIB
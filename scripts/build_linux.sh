@@ -28,7 +28,6 @@ cmake ${TNN_ROOT_PATH} \
     -DTNN_QUANTIZATION_ENABLE:BOOL=$QUANTIZATION \
     -DTNN_UNIT_TEST_ENABLE=ON \
     -DTNN_COVERAGE=ON \
-    -DTNN_BENCHMARK_MODE=ON \
     -DTNN_BUILD_SHARED:BOOL=$SHARED_LIB
 
 
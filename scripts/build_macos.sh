@@ -17,7 +17,6 @@ cmake ${TNN_ROOT_PATH} \
     -DTNN_METAL_ENABLE:BOOL=$METAL \
     -DTNN_UNIT_TEST_ENABLE=ON \
     -DTNN_COVERAGE=ON \
-    -DTNN_BENCHMARK_MODE=ON \
     -DTNN_BUILD_SHARED:BOOL=$SHARED_LIB
 
 make -j4
@@ -93,6 +93,15 @@ void AbstractLayerAcc::UpdateProfilingData(ProfilingData *pdata, LayerParam *par
         }
     }
 }
+#endif
+
+Status AbstractLayerAcc::InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status AbstractLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    return TNN_OK;
+}
 
 double AbstractLayerAcc::GetFlops() {
     return 0;
@@ -101,7 +110,6 @@ double AbstractLayerAcc::GetFlops() {
 double AbstractLayerAcc::GetBandwidth() {
     return 0;
 }
-#endif
 
 Status AbstractLayerAcc::ResolveBlobDataFormat(Blob *blob) {
     BlobDesc desc                        = blob->GetBlobDesc();
@@ -55,11 +55,27 @@ public:
     // @return execution result
     virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) = 0;
 
+    // @brief init work depending only on the layer itself, such as weight
+    // conversion and packing. called after Init, blob descs must not be changed
+    // here since the network runs it concurrently for different layers.
+    // @param inputs    input blobs
+    // @param outputs   output blobs
+    virtual Status InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // @brief share weights converted in Init with the same layer of another
+    // instance, must be called before Init
+    // @param acc    initialized layer acc with the same param and resource
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc);
+
+    // @brief estimated computation of the layer in MFLOPs, 0 if unknown
+    virtual double GetFlops();
+
+    // @brief estimated memory traffic of the layer in MB, 0 if unknown
+    virtual double GetBandwidth();
+
 #if TNN_PROFILE
     virtual void UpdateProfilingData(ProfilingData *pdata, LayerParam *param, DimsVector input_dim,
                                      DimsVector output_dim);
-    virtual double GetFlops();
-    virtual double GetBandwidth();
 #endif
 
 private:
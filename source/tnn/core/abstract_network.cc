@@ -28,6 +28,34 @@ Status AbstractNetwork::SetCpuNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+Status AbstractNetwork::SetCpuAffinity(const std::vector<int> &cpu_list) {
+    return TNN_OK;
+}
+
+Status AbstractNetwork::InitFromNetwork(AbstractNetwork *network, InputShapesMap inputs_shape) {
+    LOGE("network type does not support init from network\n");
+    return Status(TNNERR_UNSUPPORT_NET, "network type does not support init from network");
+}
+
+Status AbstractNetwork::GetMemoryReport(MemoryReport &report) {
+    report     = MemoryReport();
+    int size   = 0;
+    Status ret = GetForwardMemorySize(size);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    report.forward_memory = size;
+    return TNN_OK;
+}
+
+MemoryTracker *AbstractNetwork::GetMemoryTracker() {
+    return nullptr;
+}
+
+Blob *AbstractNetwork::GetBlob(const std::string &name) {
+    return nullptr;
+}
+
 #if TNN_PROFILE
 void AbstractNetwork::StartProfile() {
     LOGI("subclass should implement the func: StartProfile\n");
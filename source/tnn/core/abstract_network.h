@@ -26,9 +26,12 @@
 #include "tnn/core/profile.h"
 #include "tnn/core/status.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
+#include "tnn/utils/memory_report.h"
 
 namespace TNN_NS {
 
+class MemoryTracker;
+
 class AbstractNetwork {
 public:
     // @brief virtual default destructor
@@ -40,6 +43,12 @@ public:
     virtual Status Init(NetworkConfig &net_config, ModelConfig &model_config, AbstractModelInterpreter *interpreter,
                         InputShapesMap inputs_shape) = 0;
 
+    // @brief init network sharing layer weights of an initialized network,
+    // only blobs and forward memory are created
+    // @param network initialized network of the same model and config
+    // @param inputs_shape input shapes of the network
+    virtual Status InitFromNetwork(AbstractNetwork *network, InputShapesMap inputs_shape);
+
     // @brief deinit release init create resource
     virtual Status DeInit() = 0;
 
@@ -61,6 +70,14 @@ public:
     //
     virtual Status SetForwardMemory(void *memory) = 0;
 
+    //  @brief return memory allocated for the network by type and by layer,
+    //  the default one only reports the forward memory
+    virtual Status GetMemoryReport(MemoryReport &report);
+
+    //  @brief tracker counting the memory allocated for the network, null if
+    //  not tracked
+    virtual MemoryTracker *GetMemoryTracker();
+
     // @brief network infer
     virtual Status Reshape(const InputShapesMap &inputs) = 0;
 
@@ -87,9 +104,16 @@ public:
     // @param blobs output blobs name map
     virtual Status GetAllOutputBlobs(BlobMap &blobs) = 0;
 
+    // @brief get a blob of the network by name, including the intermediate
+    // blobs. null if the blob is not found or not exposed by the network
+    virtual Blob *GetBlob(const std::string &name);
+
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief bind threads run on device to cpu ids
+    virtual Status SetCpuAffinity(const std::vector<int> &cpu_list);
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
@@ -18,6 +18,8 @@
 #include <cstring>
 #include <set>
 
+#include "tnn/memory_manager/blob_memory_plan.h"
+#include "tnn/memory_manager/memory_arena_assign_strategy.h"
 #include "tnn/memory_manager/blob_memory_pool_factory.h"
 #include "tnn/memory_manager/blob_memory_size_info.h"
 #include "tnn/memory_manager/memory_mode_state_factory.h"
@@ -32,6 +34,7 @@ BlobManager::BlobManager(AbstractDevice *device) {
     blob_memory_pool_  = BlobMemoryPoolFactory::CreateBlobMemoryPool(device);
     net_structure_     = nullptr;
     memory_mode_state_ = nullptr;
+    forward_memory_    = nullptr;
 }
 
 BlobManager::~BlobManager() {
@@ -142,50 +145,66 @@ Status BlobManager::AllocateBlobMemory() {
     }
 
     /*
-     *  We reuse blob memory of the previos layers if it is not referenced.
-     *  So, a use_count is calculated here.
+     *  The memory plan packed with the model is used if the blob shapes are the
+     *  static shapes it is planned for.
      */
-    for (int layer_index = 0; layer_index < net_structure_->layers.size(); layer_index++) {
-        LayerInfo *layer_info = net_structure_->layers[layer_index].get();
-        // allocating blob memory for every out nodes of this layer
-        for (auto current_blob_name : layer_info->outputs) {
-            Blob *current_blob = blobs_[current_blob_name];
-            // ASSERT(current_blob->count() > 0);
-            if (DimsVectorUtils::Count(current_blob->GetBlobDesc().dims) <= 0) {
-                LOGE("Got empty blob, name:%s\n", current_blob_name.c_str());
-                return Status(TNNERR_LAYER_ERR, "blob dims is invaid");
-            }
+    bool use_memory_plan = CanUseMemoryPlan();
+    if (use_memory_plan) {
+        BorrowPlannedBlobMemory();
+    } else {
+        /*
+         *  We reuse blob memory of the previos layers if it is not referenced.
+         *  So, a use_count is calculated here.
+         */
+        for (int layer_index = 0; layer_index < net_structure_->layers.size(); layer_index++) {
+            LayerInfo *layer_info = net_structure_->layers[layer_index].get();
+            // allocating blob memory for every out nodes of this layer
+            for (auto current_blob_name : layer_info->outputs) {
+                Blob *current_blob = blobs_[current_blob_name];
+                // ASSERT(current_blob->count() > 0);
+                if (DimsVectorUtils::Count(current_blob->GetBlobDesc().dims) <= 0) {
+                    LOGE("Got empty blob, name:%s\n", current_blob_name.c_str());
+                    return Status(TNNERR_LAYER_ERR, "blob dims is invaid");
+                }
 
-            if (blob_memory_mapping_.find(current_blob) == blob_memory_mapping_.end()) {
-                // calculate the use count of this blob
-                int use_count = GetBlobUseCount(layer_index, current_blob_name);
+                if (blob_memory_mapping_.find(current_blob) == blob_memory_mapping_.end()) {
+                    // calculate the use count of this blob
+                    int use_count = GetBlobUseCount(layer_index, current_blob_name);
 
-                BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
-                // find an available BlobMemory
-                BlobMemory *blob_memory = blob_memory_pool_->BorrowBlobMemory(use_count, info, false);
-                blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
+                    BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
+                    // find an available BlobMemory
+                    BlobMemory *blob_memory = blob_memory_pool_->BorrowBlobMemory(use_count, info, false);
+                    blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
+                }
             }
-        }
 
-        // refund the input blob memory
-        for (auto current_blob_name : layer_info->inputs) {
-            Blob *current_blob = blobs_[current_blob_name];
-            if (input_shapes_map.count(current_blob_name) == 0) {
-                std::map<Blob *, BlobMemory *>::const_iterator blob_memory_iter =
-                    blob_memory_mapping_.find(current_blob);
-                ASSERT(blob_memory_iter->second->GetUseCount() > 0);
-                blob_memory_iter->second->DecrementUseCount();
-                if (blob_memory_iter->second->GetUseCount() == 0) {
-                    blob_memory_pool_->RefundBlobMemory(blob_memory_iter->second);
+            // refund the input blob memory
+            for (auto current_blob_name : layer_info->inputs) {
+                Blob *current_blob = blobs_[current_blob_name];
+                if (input_shapes_map.count(current_blob_name) == 0) {
+                    std::map<Blob *, BlobMemory *>::const_iterator blob_memory_iter =
+                        blob_memory_mapping_.find(current_blob);
+                    ASSERT(blob_memory_iter->second->GetUseCount() > 0);
+                    blob_memory_iter->second->DecrementUseCount();
+                    if (blob_memory_iter->second->GetUseCount() == 0) {
+                        blob_memory_pool_->RefundBlobMemory(blob_memory_iter->second);
+                    }
                 }
             }
         }
     }
-    
+
     Status status = TNN_OK;
     
     do {
-        if (config_.share_memory_mode == SHARE_MEMORY_MODE_DEFAULT) {
+        if (config_.share_memory_mode == SHARE_MEMORY_MODE_DEFAULT && use_memory_plan && IsHostDevice()) {
+            // The planned blob memory is allocated in one arena.
+            MemoryArenaAssignStrategy strategy(device_);
+            status          = blob_memory_pool_->AssignAllBlobMemory(strategy);
+            forward_memory_ = strategy.GetArena();
+            BREAK_IF(status != TNN_OK);
+            BindBlobMemory();
+        } else if (config_.share_memory_mode == SHARE_MEMORY_MODE_DEFAULT) {
             // The default strategy allocated the blob memory seperately.
             MemorySeperateAssignStrategy strategy;
             status = blob_memory_pool_->AssignAllBlobMemory(strategy);
@@ -208,6 +227,71 @@ Status BlobManager::AllocateBlobMemory() {
     return status;
 }
 
+/*
+ * The memory plan is valid for the blobs of the static shapes it is planned for.
+ * The layers or the shapes may differ, eg. the net is changed by the optimizer or
+ * the instance has other input shapes, then the memory is planned by the pool.
+ */
+bool BlobManager::CanUseMemoryPlan() {
+    const auto &blob_slots = net_structure_->blobs_memory_slot_map;
+    if (blob_slots.empty()) {
+        return false;
+    }
+
+    // blobs removed by the optimizer are left in the blob list, only the blobs of the layers are checked
+    std::set<std::string> blob_names;
+    for (auto &layer_info : net_structure_->layers) {
+        blob_names.insert(layer_info->inputs.begin(), layer_info->inputs.end());
+        blob_names.insert(layer_info->outputs.begin(), layer_info->outputs.end());
+    }
+    for (auto &name : blob_names) {
+        auto blob_iter  = blobs_.find(name);
+        auto shape_iter = net_structure_->blobs_shape_map.find(name);
+        if (blob_iter == blobs_.end() || shape_iter == net_structure_->blobs_shape_map.end() ||
+            !DimsVectorUtils::Equal(shape_iter->second, blob_iter->second->GetBlobDesc().dims)) {
+            return false;
+        }
+        // the slots of the 2d memory can not be placed in one arena
+        BlobMemorySizeInfo info = device_->Calculate(blob_iter->second->GetBlobDesc());
+        if (info.dims.size() != 1) {
+            return false;
+        }
+    }
+    return CheckBlobMemoryPlan(net_structure_, blob_slots);
+}
+
+// the blob memory of the cpu devices is host memory, it can be split into the blobs
+bool BlobManager::IsHostDevice() {
+    auto device_type = device_->GetDeviceType();
+    return device_type == DEVICE_NAIVE || device_type == DEVICE_ARM;
+}
+
+/*
+ * Blobs of the same slot share one BlobMemory of the largest size.
+ */
+void BlobManager::BorrowPlannedBlobMemory() {
+    const auto &blob_slots = net_structure_->blobs_memory_slot_map;
+    std::map<int, BlobMemory *> slot_memory;
+    for (auto &layer_info : net_structure_->layers) {
+        for (auto current_blob_name : layer_info->outputs) {
+            Blob *current_blob = blobs_[current_blob_name];
+            auto slot_iter     = blob_slots.find(current_blob_name);
+            if (slot_iter == blob_slots.end() || blob_memory_mapping_.find(current_blob) != blob_memory_mapping_.end()) {
+                continue;
+            }
+
+            BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
+            auto memory_iter        = slot_memory.find(slot_iter->second);
+            if (memory_iter == slot_memory.end()) {
+                slot_memory[slot_iter->second] = blob_memory_pool_->BorrowBlobMemory(1, info, true);
+            } else {
+                memory_iter->second->UpdateBlobMemorySizeInfo(info);
+            }
+            blob_memory_mapping_.insert(std::make_pair(current_blob, slot_memory[slot_iter->second]));
+        }
+    }
+}
+
 /*
  * This function calculate the use count of the given blob.
  * output layer is regarded as an additional reference.
@@ -240,6 +324,11 @@ Status BlobManager::DeInit() {
         delete blob.second;
     }
 
+    if (forward_memory_ != nullptr) {
+        device_->Free(forward_memory_);
+        forward_memory_ = nullptr;
+    }
+
     if (memory_mode_state_ != NULL) {
         delete memory_mode_state_;
         memory_mode_state_ = NULL;
@@ -82,6 +82,9 @@ public:
 private:
     void BindBlobMemory();
     int GetBlobUseCount(int layer_index, std::string current_blob_name);
+    bool CanUseMemoryPlan();
+    bool IsHostDevice();
+    void BorrowPlannedBlobMemory();
 
     NetworkConfig config_;
     NetStructure *net_structure_;
@@ -92,6 +95,8 @@ private:
     std::shared_ptr<MemoryAssignStrategy> strategy_;
     std::map<std::string, Blob *> blobs_;
     std::map<Blob *, BlobMemory *> blob_memory_mapping_;
+    // the arena of the planned blob memory
+    void *forward_memory_;
 
     std::thread::id init_thread_id_;
     MemoryModeState *memory_mode_state_;
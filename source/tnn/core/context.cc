@@ -14,13 +14,14 @@
 
 #include "tnn/core/context.h"
 #include "tnn/core/profile.h"
+#include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/string_format.h"
 
 namespace TNN_NS {
 
 // this function is called before forward by Network.
 Status Context::OnInstanceForwardBegin() {
-    return TNN_OK;
+    return BindCpuAffinity(GetNumThreads());
 }
 
 /*
@@ -31,6 +32,44 @@ Status Context::SetNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+int Context::GetNumThreads() {
+    return 1;
+}
+
+Status Context::SetCpuAffinity(const std::vector<int>& cpu_list) {
+    unbind_pending_    = unbind_pending_ || (cpu_list.empty() && !cpu_list_.empty());
+    cpu_list_          = cpu_list;
+    bound_num_threads_ = 0;
+    return TNN_OK;
+}
+
+Status Context::BindCpuAffinity(int num_threads) {
+    if (cpu_list_.empty()) {
+        if (!unbind_pending_) {
+            return TNN_OK;
+        }
+        // no binding, let the threads run on all cpus again
+        std::vector<int> all_cpus;
+        Status ret = CpuUtils::GetCpuClusterList(0, all_cpus);
+        if (ret == TNN_OK) {
+            ret = CpuUtils::SetCpuAffinityForThreads(all_cpus, num_threads);
+        }
+        unbind_pending_ = false;
+        return ret;
+    }
+    // openmp thread teams belong to the forward thread, rebind when it changes
+    if (bound_thread_id_ == std::this_thread::get_id() && bound_num_threads_ == num_threads) {
+        return TNN_OK;
+    }
+    Status ret = CpuUtils::SetCpuAffinityForThreads(cpu_list_, num_threads);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    bound_thread_id_   = std::this_thread::get_id();
+    bound_num_threads_ = num_threads;
+    return TNN_OK;
+}
+
 Status Context::SetPrecision(Precision precision) {
     precision_ = precision;
     return TNN_OK;
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "tnn/core/status.h"
@@ -49,6 +50,12 @@ public:
     // @brief set threads run on device
     virtual Status SetNumThreads(int num_threads);
 
+    // @brief get threads run on device
+    virtual int GetNumThreads();
+
+    // @brief bind threads run on device to cpus, empty list means no binding
+    virtual Status SetCpuAffinity(const std::vector<int>& cpu_list);
+
     // @brief set precision to run on device
     virtual Status SetPrecision(Precision precision);
 
@@ -68,7 +75,18 @@ protected:
 #endif
 
 protected:
+    // @brief bind the calling thread and its openmp threads to cpu_list_
+    Status BindCpuAffinity(int num_threads);
+
     Precision precision_ = PRECISION_AUTO;
+    std::vector<int> cpu_list_;
+
+private:
+    // threads are bound once per forward thread and thread count
+    std::thread::id bound_thread_id_;
+    int bound_num_threads_ = 0;
+    // the binding is reset to all cpus once after cpu_list_ is cleared
+    bool unbind_pending_ = false;
 };
 
 }  // namespace TNN_NS
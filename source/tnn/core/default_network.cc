@@ -16,6 +16,8 @@
 
 #include <string.h>
 
+#include <algorithm>
+
 #include "tnn/core/blob_int8.h"
 #include "tnn/core/profile.h"
 #include "tnn/interpreter/default_model_interpreter.h"
@@ -24,7 +26,11 @@
 #include "tnn/optimizer/net_optimizer_manager.h"
 #include "tnn/utils/blob_dump_utils.h"
 #include "tnn/utils/blob_transfer_utils.h"
+#include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/numa_utils.h"
+#include "tnn/utils/omp_utils.h"
+#include "tnn/utils/startup_profile_inner.h"
 
 namespace TNN_NS {
 
@@ -34,7 +40,11 @@ NetworkImplFactoryRegister<NetworkImplFactory<DefaultNetwork>> g_network_impl_de
 std::mutex DefaultNetwork::optimize_mtx_;
 
 DefaultNetwork::DefaultNetwork()
-    : device_(nullptr), context_(nullptr), blob_manager_(nullptr), net_structure_(nullptr) {}
+    : init_weights_threads_(OMP_CORES_),
+      device_(nullptr),
+      context_(nullptr),
+      blob_manager_(nullptr),
+      net_structure_(nullptr) {}
 
 DefaultNetwork::~DefaultNetwork() {
     DeInit();
@@ -47,13 +57,58 @@ Status DefaultNetwork::SetCpuNumThreads(int num_threads) {
         return Status(TNNERR_CONTEXT_ERR, "context is nil");
 }
 
+Status DefaultNetwork::SetCpuAffinity(const std::vector<int> &cpu_list) {
+    if (context_)
+        return context_->SetCpuAffinity(cpu_list);
+    else
+        return Status(TNNERR_CONTEXT_ERR, "context is nil");
+}
+
+/*
+ * The cpus instance threads are bound to, decided by cpu_list,
+ * cpu_affinity_mode and numa_node in network config.
+ */
+static Status GetCpuAffinityList(NetworkConfig &net_config, std::vector<int> &cpu_list) {
+    Status ret = TNN_OK;
+    cpu_list   = net_config.cpu_list;
+    if (cpu_list.empty() && net_config.cpu_affinity_mode != CPU_AFFINITY_NONE) {
+        ret = CpuUtils::GetCpuClusterList(net_config.cpu_affinity_mode, cpu_list);
+        if (ret != TNN_OK) {
+            return ret;
+        }
+    }
+
+    if (net_config.numa_node >= 0) {
+        std::vector<int> numa_cpu_list;
+        ret = CpuUtils::GetNumaNodeCpuList(net_config.numa_node, numa_cpu_list);
+        if (ret != TNN_OK) {
+            return ret;
+        }
+        if (cpu_list.empty()) {
+            cpu_list = numa_cpu_list;
+        } else {
+            std::vector<int> numa_cpus_in_list;
+            for (auto cpu : cpu_list) {
+                if (std::find(numa_cpu_list.begin(), numa_cpu_list.end(), cpu) != numa_cpu_list.end()) {
+                    numa_cpus_in_list.push_back(cpu);
+                }
+            }
+            if (numa_cpus_in_list.empty()) {
+                LOGE("cpu list has no cpu on numa node %d\n", net_config.numa_node);
+                return Status(TNNERR_SET_CPU_AFFINITY, "cpu list has no cpu on numa node");
+            }
+            cpu_list = numa_cpus_in_list;
+        }
+    }
+    return TNN_OK;
+}
+
 /*
  * The Network holds blob, blobmanager, layers etc.
  * Those object is initialized in this function.
  */
 Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config, AbstractModelInterpreter *interpreter,
                             InputShapesMap inputs_shape) {
-    config_                                      = net_config;
     Status ret                                   = TNN_OK;
     DefaultModelInterpreter *default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter);
     CHECK_PARAM_NULL(default_interpreter);
@@ -66,6 +121,59 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
         return Status(TNNERR_NULL_PARAM, "network_ is nil, network_type may not support");
     }
 
+    /*
+     * The NetOptimizeManager holds a list of network optimization processes.
+     * The optimization process may change the network structure accoundingly.
+     * eg. fuse conv+bn, conv+relu.
+     */
+    weights_memory_tracker_ = default_interpreter->GetMemoryTracker();
+    {
+        // use mutex to protect net_resource and net_structure in multi-thread
+        auto lck = LockOptimizeMutex();
+        StartupStageTimer optimize_timer("net optimize");
+        // resources fused by the optimizer belong to the net resource
+        MemoryTrackerScope memory_scope(weights_memory_tracker_.get(), MEMORY_TYPE_WEIGHTS);
+        ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, net_config.device_type);
+        if (ret != TNN_OK) {
+            return ret;
+        }
+    }
+
+    benchmark_mode_ = model_config.benchmark_mode;
+    return InitNetwork(net_config, net_structure, net_resource, inputs_shape, nullptr);
+}
+
+/*
+ * The net structure is already optimized by the shared network, layers reuse
+ * the weights converted by the layers of the shared network. Only context,
+ * blobs and blob memory are created for this network.
+ */
+Status DefaultNetwork::InitFromNetwork(AbstractNetwork *network, InputShapesMap inputs_shape) {
+    DefaultNetwork *shared_network = dynamic_cast<DefaultNetwork *>(network);
+    CHECK_PARAM_NULL(shared_network);
+
+    if (shared_network->net_structure_ == NULL || shared_network->net_resource_ == NULL) {
+        LOGE("ERROR: shared network is not initialized\n");
+        return Status(TNNERR_NET_ERR, "shared network is not initialized");
+    }
+
+    benchmark_mode_         = shared_network->benchmark_mode_;
+    weights_memory_tracker_ = shared_network->weights_memory_tracker_;
+    Status ret              = InitNetwork(shared_network->config_, shared_network->net_structure_,
+                                          shared_network->net_resource_, inputs_shape, shared_network);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    return context_->SetNumThreads(shared_network->context_->GetNumThreads());
+}
+
+Status DefaultNetwork::InitNetwork(NetworkConfig &net_config, NetStructure *net_structure, NetResource *net_resource,
+                                   InputShapesMap inputs_shape, DefaultNetwork *shared_network) {
+    config_         = net_config;
+    memory_tracker_ = std::make_shared<MemoryTracker>();
+    Status ret      = TNN_OK;
+
+    StartupStageTimer context_timer("context init");
     device_ = GetDevice(net_config.device_type);
     if (device_ == NULL) {
         return TNNERR_DEVICE_NOT_SUPPORT;
@@ -85,40 +193,60 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     if (ret != TNN_OK) {
         return ret;
     }
+    context_timer.Stop();
 
     /*
-     * The NetOptimizeManager holds a list of network optimization processes.
-     * The optimization process may change the network structure accoundingly.
-     * eg. fuse conv+bn, conv+relu.
+     * Bind the instance to a numa node. Weights converted in layer init and
+     * blob memory are allocated while the creating thread is on the node.
      */
-    {
-        // use mutex to protect net_resource and net_structure in multi-thread
-        std::unique_lock<std::mutex> lck(optimize_mtx_);
-        ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, net_config.device_type);
-        if (ret != TNN_OK) {
-            return ret;
-        }
+    NumaNodeGuard numa_guard(net_config.numa_node);
+    ret = numa_guard.GetStatus();
+    if (ret != TNN_OK) {
+        return ret;
     }
 
+    // forward threads are bound to the cpus
+    std::vector<int> cpu_list;
+    ret = GetCpuAffinityList(net_config, cpu_list);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    ret = context_->SetCpuAffinity(cpu_list);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    StartupStageTimer blob_manager_timer("blob manager init");
     blob_manager_ = new BlobManager(device_);
 
-    ret = blob_manager_->Init(net_config, net_structure, inputs_shape, GetNetResourceDataType(net_resource));
+    {
+        MemoryTrackerScope memory_scope(memory_tracker_.get(), MEMORY_TYPE_BLOB);
+        ret = blob_manager_->Init(net_config, net_structure, inputs_shape, GetNetResourceDataType(net_resource));
+    }
     if (ret != TNN_OK) {
         return ret;
     }
+    blob_manager_timer.Stop();
 
-    ret = InitLayers(net_structure, net_resource);
+    ret = InitLayers(net_structure, net_resource, shared_network);
     if (ret != TNN_OK) {
         return ret;
     }
 
-    ret = blob_manager_->AllocateBlobMemory();
+    StartupStageTimer allocate_timer("blob memory allocate");
+    {
+        MemoryTrackerScope memory_scope(memory_tracker_.get(), MEMORY_TYPE_BLOB);
+        ret = blob_manager_->AllocateBlobMemory();
+    }
     if (ret != TNN_OK) {
         return ret;
     }
+    allocate_timer.Stop();
 
     net_structure_ = net_structure;
+    net_resource_  = net_resource;
 
+    StartupStageTimer reshape_timer("reshape");
     InputShapesMap input_shape_map;
     return Reshape(input_shape_map);
 }
@@ -130,9 +258,12 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
  *  3. Infer the blob shapes.
  *  4. Check the weights required.
  */
-Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_resource) {
+Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_resource,
+                                  DefaultNetwork *shared_network) {
     Status ret = TNN_OK;
-    for (auto layer_info : net_structure->layers) {
+    StartupStageTimer layer_timer("layer init");
+    for (int index = 0; index < net_structure->layers.size(); index++) {
+        auto layer_info = net_structure->layers[index];
         LayerType type       = layer_info->type;
         BaseLayer *cur_layer = CreateLayer(type);
         if (cur_layer == NULL) {
@@ -153,16 +284,14 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
                 auto new_blob               = new BlobInt8(blob->GetBlobDesc(), blob->GetHandle());
                 auto dest                   = blob->GetBlobDesc();
                 std::string blob_scale_name = name + "_scale_data_";
-#ifdef BENCHMARK
-                if (net_resource->resource_map.count(blob_scale_name) == 0) {
-                    LayerResource *layer_res  = nullptr;
-                    std::vector<Blob *> blobs = {blob};
-                    GenerateRandomResource(LAYER_BLOB_SCALE, nullptr, &layer_res, blobs);
-                    net_resource->resource_map[blob_scale_name] = std::shared_ptr<LayerResource>(layer_res);
+                if (benchmark_mode_) {
+                    ret = GenerateResourceIfNeeded(LAYER_BLOB_SCALE, nullptr, blob_scale_name, {blob}, net_resource);
+                    if (ret != TNN_OK) {
+                        return ret;
+                    }
                 }
-#endif
                 new_blob->SetIntResource(
-                    reinterpret_cast<IntScaleResource *>(net_resource->resource_map[blob_scale_name].get()));
+                    reinterpret_cast<IntScaleResource *>(FindResource(blob_scale_name, net_resource)));
                 blob_manager_->ReplaceBlob(name, new_blob);
                 blob = new_blob;
             }
@@ -176,22 +305,21 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
         std::vector<Blob *> outputs;
         std::vector<std::string> &output_names = layer_info->outputs;
 
-#ifdef BENCHMARK
-        // generate resource if null
-        if (net_resource->resource_map.count(layer_name) == 0) {
-            LayerParam *layer_param  = layer_info->param.get();
-            LayerResource *layer_res = nullptr;
-            GenerateRandomResource(type, layer_param, &layer_res, inputs);
-            net_resource->resource_map[layer_name] = std::shared_ptr<LayerResource>(layer_res);
-        }
+        if (benchmark_mode_) {
+            // generate resource if null
+            ret = GenerateResourceIfNeeded(type, layer_info->param.get(), layer_name, inputs, net_resource);
+            if (ret != TNN_OK) {
+                return ret;
+            }
 
-        std::vector<Blob *> outputs_for_shape;
-        for (auto name : output_names) {
-            outputs_for_shape.push_back(blob_manager_->GetBlob(name));
+            // shapes of the following layers are required to generate their resources
+            std::vector<Blob *> outputs_for_shape;
+            for (auto name : output_names) {
+                outputs_for_shape.push_back(blob_manager_->GetBlob(name));
+            }
+            cur_layer->InferShapeAhead(inputs, outputs_for_shape, layer_info->param.get(),
+                                       FindResource(layer_name, net_resource));
         }
-        cur_layer->InferShapeAhead(inputs, outputs_for_shape, layer_info->param.get(),
-                                   net_resource->resource_map[layer_name].get());
-#endif
 
         for (auto name : output_names) {
             auto blob = blob_manager_->GetBlob(name);
@@ -204,16 +332,14 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
             if (is_int8_blob) {
                 auto new_blob               = new BlobInt8(blob->GetBlobDesc(), blob->GetHandle());
                 std::string blob_scale_name = name + "_scale_data_";
-#ifdef BENCHMARK
-                if (net_resource->resource_map.count(blob_scale_name) == 0) {
-                    LayerResource *layer_res  = nullptr;
-                    std::vector<Blob *> blobs = {blob};
-                    GenerateRandomResource(LAYER_BLOB_SCALE, nullptr, &layer_res, blobs);
-                    net_resource->resource_map[blob_scale_name] = std::shared_ptr<LayerResource>(layer_res);
+                if (benchmark_mode_) {
+                    ret = GenerateResourceIfNeeded(LAYER_BLOB_SCALE, nullptr, blob_scale_name, {blob}, net_resource);
+                    if (ret != TNN_OK) {
+                        return ret;
+                    }
                 }
-#endif
                 new_blob->SetIntResource(
-                    reinterpret_cast<IntScaleResource *>(net_resource->resource_map[blob_scale_name].get()));
+                    reinterpret_cast<IntScaleResource *>(FindResource(blob_scale_name, net_resource)));
                 blob_manager_->ReplaceBlob(name, new_blob);
                 blob = new_blob;
             }
@@ -224,20 +350,117 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
             outputs.push_back(blob);
         }
 
-        LayerResource *layer_resource = nullptr;
-        if (net_resource->resource_map.count(layer_name) != 0) {
-            layer_resource = net_resource->resource_map[layer_name].get();
+        LayerResource *layer_resource = FindResource(layer_name, net_resource);
+
+        // layers of the shared network are created from the same net structure
+        BaseLayer *shared_layer = nullptr;
+        if (shared_network != nullptr && index < shared_network->layers_.size()) {
+            shared_layer = shared_network->layers_[index];
         }
 
-        ret = cur_layer->Init(context_, layer_info->param.get(), layer_resource, inputs, outputs, device_);
+        auto memory_counter = memory_tracker_->CreateLayerCounter();
+        {
+            StartupLayerTimer layer_init_timer(layer_name, layer_info->type_str);
+            MemoryTrackerScope memory_scope(memory_tracker_.get(), memory_counter.get());
+            ret = cur_layer->InitLayer(context_, layer_info->param.get(), layer_resource, inputs, outputs, device_,
+                                       shared_layer);
+        }
         if (ret != TNN_OK) {
             LOGE("Error Init layer %s (err: %d or 0x%X)\n", cur_layer->GetLayerName().c_str(), (int)ret, (int)ret);
             return ret;
         }
 
         layers_.push_back(cur_layer);
+        layer_memory_counters_.push_back(memory_counter);
+        layer_types_.push_back(layer_info->type_str);
     }
-    return ret;
+
+    layer_timer.Stop();
+    return InitLayerWeights();
+}
+
+/*
+ * Generate random resource named name in benchmark mode if it is not in the
+ * model. The net resource may be shared by instances created concurrently.
+ */
+Status DefaultNetwork::GenerateResourceIfNeeded(LayerType type, LayerParam *param, const std::string &name,
+                                                std::vector<Blob *> inputs, NetResource *net_resource) {
+    auto lck = LockOptimizeMutex();
+    StartupStageTimer generate_timer("benchmark resource generate");
+    MemoryTrackerScope memory_scope(weights_memory_tracker_.get(), MEMORY_TYPE_WEIGHTS);
+    if (net_resource->resource_map.count(name) > 0) {
+        return TNN_OK;
+    }
+
+    LayerResource *layer_res = nullptr;
+    Status ret               = GenerateRandomResource(type, param, &layer_res, inputs);
+    if (ret != TNN_OK) {
+        LOGE("Error: generate resource of %s failed\n", name.c_str());
+        return ret;
+    }
+    net_resource->resource_map[name] = std::shared_ptr<LayerResource>(layer_res);
+    return TNN_OK;
+}
+
+/*
+ * Resources are looked up under the same lock, as instances sharing the net
+ * resource may be generating resources into it.
+ */
+LayerResource *DefaultNetwork::FindResource(const std::string &name, NetResource *net_resource) {
+    auto lck = LockOptimizeMutex();
+    auto iter = net_resource->resource_map.find(name);
+    return iter != net_resource->resource_map.end() ? iter->second.get() : nullptr;
+}
+
+/*
+ * optimize_mtx_ serializes the instances created concurrently. The time
+ * waiting for it is a startup stage, the time holding it is the net optimize
+ * and benchmark resource generate stages.
+ */
+std::unique_lock<std::mutex> DefaultNetwork::LockOptimizeMutex() {
+    StartupStageTimer wait_timer("optimize mutex wait");
+    return std::unique_lock<std::mutex>(optimize_mtx_);
+}
+
+/*
+ * Weight conversion and packing of a layer only depend on the layer itself,
+ * layers are handled concurrently. The error of the first failed layer in
+ * layer order is reported.
+ */
+Status DefaultNetwork::InitLayerWeights() {
+    StartupStageTimer weights_timer("layer weights init");
+    const int layer_count = static_cast<int>(layers_.size());
+    std::vector<Status> layer_status(layer_count);
+
+    const int max_num_threads = OMP_MAX_THREADS_NUM_;
+    OMP_SET_THREADS_(std::max(1, init_weights_threads_));
+    OMP_PARALLEL_FOR_DYNAMIC_
+    for (int index = 0; index < layer_count; index++) {
+        // memory policy and cpu affinity are per thread
+        NumaNodeGuard numa_guard(config_.numa_node);
+        layer_status[index] = numa_guard.GetStatus();
+        if (layer_status[index] == TNN_OK) {
+            layer_status[index] = InitWeightsOfLayer(index);
+        }
+    }
+    OMP_SET_THREADS_(max_num_threads);
+
+    for (int index = 0; index < layer_count; index++) {
+        if (layer_status[index] != TNN_OK) {
+            Status ret       = layer_status[index];
+            std::string name = layers_[index]->GetLayerName();
+            LOGE("Error Init layer %s (err: %d or 0x%X)\n", name.c_str(), (int)ret, (int)ret);
+            return Status(ret, "Init layer " + name + " failed, " + ret.description());
+        }
+    }
+    return TNN_OK;
+}
+
+Status DefaultNetwork::InitWeightsOfLayer(int index) {
+    // the layer type is recorded in InitLayers
+    StartupLayerTimer layer_weights_timer(layers_[index]->GetLayerName(), "");
+    MemoryTrackerScope memory_scope(memory_tracker_.get(), layer_memory_counters_[index].get());
+    return layers_[index]->InitWeights();
 }
 
 Status DefaultNetwork::GetForwardMemorySize(int &memory_size) {
@@ -249,6 +472,41 @@ Status DefaultNetwork::SetForwardMemory(void *memory) {
     return blob_manager_->SetForwardMemory(memory);
 }
 
+Status DefaultNetwork::GetMemoryReport(MemoryReport &report) {
+    report = MemoryReport();
+    if (!memory_tracker_ || !blob_manager_) {
+        LOGE("ERROR: network is not initialized\n");
+        return Status(TNNERR_NET_ERR, "network is not initialized");
+    }
+
+    for (int type = 0; type < MEMORY_TYPE_COUNT; ++type) {
+        report.usage[type] = memory_tracker_->GetCounter((MemoryType)type)->GetUsage();
+    }
+    report.total = memory_tracker_->GetTotalUsage();
+    if (weights_memory_tracker_) {
+        // weights are counted by the interpreter, the peak is an upper bound
+        auto weights = weights_memory_tracker_->GetCounter(MEMORY_TYPE_WEIGHTS)->GetUsage();
+
+        report.usage[MEMORY_TYPE_WEIGHTS] = weights;
+        report.total.current += weights.current;
+        report.total.peak += weights.peak;
+    }
+    report.forward_memory = blob_manager_->GetAllBlobMemorySize();
+
+    for (int index = 0; index < layers_.size(); ++index) {
+        LayerMemoryReport layer;
+        layer.layer_name = layers_[index]->GetLayerName();
+        layer.layer_type = layer_types_[index];
+        layer.usage      = layer_memory_counters_[index]->GetUsage();
+        report.layers.push_back(layer);
+    }
+    return TNN_OK;
+}
+
+MemoryTracker *DefaultNetwork::GetMemoryTracker() {
+    return memory_tracker_.get();
+}
+
 Status DefaultNetwork::GetAllInputBlobs(BlobMap &blobs) {
     blob_manager_->GetAllInputBlobs(blobs);
     return TNN_OK;
@@ -263,6 +521,13 @@ Status DefaultNetwork::GetAllOutputBlobs(BlobMap &blobs) {
     return TNN_OK;
 }
 
+Blob *DefaultNetwork::GetBlob(const std::string &name) {
+    if (!blob_manager_) {
+        return nullptr;
+    }
+    return blob_manager_->GetBlob(name);
+}
+
 /*
  * Reshape function is called when the input shape changes.
  * Memory allocation may be involved in Reshape function.
@@ -278,8 +543,9 @@ Status DefaultNetwork::Reshape(const InputShapesMap &inputs) {
     }
 
     Status ret = TNN_OK;
-    for (auto cur_layer : layers_) {
-        ret = cur_layer->Reshape();
+    for (int index = 0; index < layers_.size(); ++index) {
+        MemoryTrackerScope memory_scope(memory_tracker_.get(), layer_memory_counters_[index].get());
+        ret = layers_[index]->Reshape();
         if (ret != TNN_OK) {
             return ret;
         }
@@ -294,6 +560,8 @@ Status DefaultNetwork::DeInit() {
         }
     }
     layers_.clear();
+    layer_memory_counters_.clear();
+    layer_types_.clear();
 
     if (blob_manager_ != NULL) {
         delete blob_manager_;
@@ -356,7 +624,11 @@ Status DefaultNetwork::Forward() {
         }
 #endif  // DUMP_INPUT_BLOB
 
-        result = layer->Forward();
+        {
+            // buffers allocated by the layer in forward are counted to the layer
+            MemoryTrackerScope memory_scope(memory_tracker_.get(), layer_memory_counters_[cnt].get());
+            result = layer->Forward();
+        }
         LOGD("layer name: %s, forward result: %d \n", layer->GetLayerName().c_str(), (int)result);
         if (result != TNN_OK) {
             LOGE("Forward error %s, exit\n", result.description().c_str());
@@ -409,7 +681,10 @@ Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSta
         if (before != nullptr)
             before(inputs, layer_info.get());
 
-        result = layer->Forward();
+        {
+            MemoryTrackerScope memory_scope(memory_tracker_.get(), layer_memory_counters_[cnt].get());
+            result = layer->Forward();
+        }
         if (result != TNN_OK) {
             LOGE("Forward error %s, exit\n", result.description().c_str());
             return result;
@@ -436,8 +711,9 @@ Status DefaultNetwork::ForwardAsync(Callback call_back) {
     }
 
     context_->OnInstanceForwardBegin();
-    for (auto layer : layers_) {
-        result = layer->Forward();
+    for (int index = 0; index < layers_.size(); ++index) {
+        MemoryTrackerScope memory_scope(memory_tracker_.get(), layer_memory_counters_[index].get());
+        result = layers_[index]->Forward();
         if (result != TNN_OK) {
             LOGE("Forward error %s, exit\n", result.description().c_str());
             return result;
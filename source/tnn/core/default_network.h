@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 #define TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 
+#include <mutex>
 #include <vector>
 
 #include "tnn/core/abstract_device.h"
@@ -31,6 +32,7 @@
 #include "tnn/interpreter/net_resource.h"
 #include "tnn/interpreter/net_structure.h"
 #include "tnn/layer/base_layer.h"
+#include "tnn/utils/memory_tracker.h"
 
 namespace TNN_NS {
 
@@ -52,6 +54,12 @@ public:
     virtual Status Init(NetworkConfig &net_config, ModelConfig &model_config, AbstractModelInterpreter *interpreter,
                         InputShapesMap inputs_shape);
 
+    // @brief init net sharing net structure, net resource and layer weights
+    // of an initialized default network
+    // @param network initialized default network
+    // @param inputs_shape input shapes of the network
+    virtual Status InitFromNetwork(AbstractNetwork *network, InputShapesMap inputs_shape);
+
     // @brief reshape with input shape info
     // @inputs input shape info
     virtual Status Reshape(const InputShapesMap &inputs);
@@ -80,35 +88,79 @@ public:
     // @brief set forward memory when share memory mode is set from external
     virtual Status SetForwardMemory(void *memory);
 
+    // @brief get memory of the network by type and by layer
+    virtual Status GetMemoryReport(MemoryReport &report);
+
+    // @brief get the tracker counting memory of the network
+    virtual MemoryTracker *GetMemoryTracker();
+
     // @brief get all input blobs
     virtual Status GetAllInputBlobs(BlobMap &blobs);
 
     // @brief get all output blobs
     virtual Status GetAllOutputBlobs(BlobMap &blobs);
 
+    // @brief get a blob of the network by name
+    virtual Blob *GetBlob(const std::string &name);
+
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief bind threads run on device to cpu ids
+    virtual Status SetCpuAffinity(const std::vector<int> &cpu_list);
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
     virtual std::shared_ptr<ProfileResult> FinishProfile();
 #endif
 
+protected:
+    // @brief init weights of the layer at index, runs concurrently for different layers
+    // @param index index of the layer in layers_
+    virtual Status InitWeightsOfLayer(int index);
+
+    // threads initializing the layer weights, 1 initializes them in layer order
+    int init_weights_threads_;
+
 private:
-    virtual Status InitLayers(NetStructure *net_structure, NetResource *net_resource);
+    Status InitNetwork(NetworkConfig &net_config, NetStructure *net_structure, NetResource *net_resource,
+                       InputShapesMap inputs_shape, DefaultNetwork *shared_network);
+
+    virtual Status InitLayers(NetStructure *net_structure, NetResource *net_resource,
+                              DefaultNetwork *shared_network = nullptr);
+
+    Status InitLayerWeights();
+
+    Status GenerateResourceIfNeeded(LayerType type, LayerParam *param, const std::string &name,
+                                    std::vector<Blob *> inputs, NetResource *net_resource);
+
+    LayerResource *FindResource(const std::string &name, NetResource *net_resource);
+
+    static std::unique_lock<std::mutex> LockOptimizeMutex();
 
     AbstractDevice *device_ = nullptr;
     Context *context_       = nullptr;
 
     std::vector<BaseLayer *> layers_;
+    // memory counters of layers_, in the same order
+    std::vector<std::shared_ptr<MemoryCounter>> layer_memory_counters_;
+    std::vector<std::string> layer_types_;
+
+    // memory of this network and of the net resource shared with other networks
+    std::shared_ptr<MemoryTracker> memory_tracker_;
+    std::shared_ptr<MemoryTracker> weights_memory_tracker_;
 
     BlobManager *blob_manager_ = nullptr;
 
     NetStructure *net_structure_ = nullptr;
+    NetResource *net_resource_   = nullptr;
 
     NetworkConfig config_;
 
+    // generate missing resources, set by ModelConfig
+    bool benchmark_mode_ = false;
+
     static std::mutex optimize_mtx_;
 };
 
@@ -0,0 +1,634 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/core/incremental_forward.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/utils/blob_memory_size_utils.h"
+#include "tnn/utils/data_type_utils.h"
+
+namespace TNN_NS {
+
+// layers computing each output value from the input values at the same position
+static const std::set<LayerType> kPointwiseLayers = {
+    LAYER_BATCH_NORM, LAYER_BATCH_NORM_EX, LAYER_SCALE,       LAYER_RELU,       LAYER_RELU6,       LAYER_PRELU,
+    LAYER_ELU,        LAYER_SELU,          LAYER_SIGMOID,     LAYER_LOGSIGMOID, LAYER_TANH,        LAYER_CLIP,
+    LAYER_HARDSIGMOID, LAYER_HARDSWISH,    LAYER_SOFTPLUS,    LAYER_ABS,        LAYER_NEG,         LAYER_SIGN,
+    LAYER_FLOOR,      LAYER_EXP,           LAYER_LOG,         LAYER_SQRT,       LAYER_RSQRT,       LAYER_SQUARE,
+    LAYER_RECIPROCAL, LAYER_POWER,         LAYER_ADD,         LAYER_SUB,        LAYER_MUL,         LAYER_DIV,
+    LAYER_MAXIMUM,    LAYER_MINIMUM,       LAYER_SPLITING,    LAYER_DROPOUT,    LAYER_SHUFFLE_CHANNEL,
+    LAYER_REFORMAT,   LAYER_CONCAT,        LAYER_SOFTMAX,
+};
+
+static int FloorDiv(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+static int CeilDiv(int a, int b) {
+    return -FloorDiv(-a, b);
+}
+
+static int Gcd(int a, int b) {
+    return b == 0 ? a : Gcd(b, a % b);
+}
+
+// @brief spatial layout of a nchw or nc4hw4 blob
+struct BlobLayout {
+    int planes      = 0;
+    int height      = 0;
+    int width       = 0;
+    int pixel_bytes = 0;
+};
+
+static bool GetBlobLayout(Blob *blob, BlobLayout &layout) {
+    auto &desc = blob->GetBlobDesc();
+    int bytes  = DataTypeUtils::GetBytesSize(desc.data_type);
+    if (desc.dims.size() != 4 || bytes <= 0) {
+        return false;
+    }
+    if (desc.data_format == DATA_FORMAT_NCHW) {
+        layout.planes      = desc.dims[0] * desc.dims[1];
+        layout.pixel_bytes = bytes;
+    } else if (GetChannelPackSize(desc.data_format) > 1) {
+        const int pack     = GetChannelPackSize(desc.data_format);
+        layout.planes      = desc.dims[0] * UP_DIV(desc.dims[1], pack);
+        layout.pixel_bytes = bytes * pack;
+    } else {
+        return false;
+    }
+    layout.height = desc.dims[2];
+    layout.width  = desc.dims[3];
+    return true;
+}
+
+static char *GetBlobData(Blob *blob) {
+    auto handle = blob->GetHandle();
+    return static_cast<char *>(handle.base) + handle.bytes_offset;
+}
+
+static size_t GetBlobBytes(const BlobLayout &layout) {
+    return (size_t)layout.planes * layout.height * layout.width * layout.pixel_bytes;
+}
+
+// copy rows x cols pixels of all planes from (src_y, src_x) to (dst_y, dst_x)
+static void CopyRegion(const char *src, const BlobLayout &src_layout, int src_y, int src_x, char *dst,
+                       const BlobLayout &dst_layout, int dst_y, int dst_x, int rows, int cols) {
+    const size_t row_bytes = (size_t)cols * src_layout.pixel_bytes;
+    for (int p = 0; p < src_layout.planes; ++p) {
+        for (int r = 0; r < rows; ++r) {
+            const char *src_row =
+                src + (((size_t)p * src_layout.height + src_y + r) * src_layout.width + src_x) * src_layout.pixel_bytes;
+            char *dst_row =
+                dst + (((size_t)p * dst_layout.height + dst_y + r) * dst_layout.width + dst_x) * dst_layout.pixel_bytes;
+            memcpy(dst_row, src_row, row_bytes);
+        }
+    }
+}
+
+static bool IsSegmentChanged(const char *data, const char *previous, size_t bytes, bool is_float, float tolerance) {
+    if (!is_float || tolerance <= 0) {
+        return memcmp(data, previous, bytes) != 0;
+    }
+    const float *value          = reinterpret_cast<const float *>(data);
+    const float *previous_value = reinterpret_cast<const float *>(previous);
+    for (size_t i = 0; i < bytes / sizeof(float); ++i) {
+        if (!(std::fabs(value[i] - previous_value[i]) <= tolerance)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// @return bounding box of the changed tiles, empty if the blob is unchanged
+static BlobRegion CompareTiles(const char *data, const char *previous, const BlobLayout &layout, int tile,
+                               bool is_float, float tolerance) {
+    const int tiles_y = UP_DIV(layout.height, tile);
+    const int tiles_x = UP_DIV(layout.width, tile);
+    std::vector<char> changed(tiles_y * tiles_x, 0);
+    for (int p = 0; p < layout.planes; ++p) {
+        for (int y = 0; y < layout.height; ++y) {
+            const size_t row_offset = ((size_t)p * layout.height + y) * layout.width * layout.pixel_bytes;
+            char *changed_row       = changed.data() + (y / tile) * tiles_x;
+            for (int tx = 0; tx < tiles_x; ++tx) {
+                if (changed_row[tx]) {
+                    continue;
+                }
+                const size_t offset = row_offset + (size_t)tx * tile * layout.pixel_bytes;
+                const int cols      = std::min(tile, layout.width - tx * tile);
+                changed_row[tx] = IsSegmentChanged(data + offset, previous + offset, (size_t)cols * layout.pixel_bytes,
+                                                   is_float, tolerance);
+            }
+        }
+    }
+
+    BlobRegion region;
+    for (int ty = 0; ty < tiles_y; ++ty) {
+        for (int tx = 0; tx < tiles_x; ++tx) {
+            if (changed[ty * tiles_x + tx]) {
+                BlobRegion tile_region;
+                tile_region.y_begin = ty * tile;
+                tile_region.y_end   = std::min(layout.height, (ty + 1) * tile);
+                tile_region.x_begin = tx * tile;
+                tile_region.x_end   = std::min(layout.width, (tx + 1) * tile);
+                region.Merge(tile_region);
+            }
+        }
+    }
+    return region;
+}
+
+bool BlobRegion::IsEmpty() const {
+    return y_begin >= y_end || x_begin >= x_end;
+}
+
+void BlobRegion::Merge(const BlobRegion &region) {
+    if (region.IsEmpty()) {
+        return;
+    }
+    if (IsEmpty()) {
+        *this = region;
+        return;
+    }
+    y_begin = std::min(y_begin, region.y_begin);
+    y_end   = std::max(y_end, region.y_end);
+    x_begin = std::min(x_begin, region.x_begin);
+    x_end   = std::max(x_end, region.x_end);
+}
+
+IncrementalForward::IncrementalForward(const IncrementalConfig &config, Instance *instance, AbstractNetwork *network,
+                                       NetStructure *net_structure, NetResource *net_resource)
+    : config_(config),
+      instance_(instance),
+      network_(network),
+      net_structure_(net_structure),
+      net_resource_(net_resource) {
+    config_.tile_size = std::max(1, config_.tile_size);
+}
+
+IncrementalForward::~IncrementalForward() {}
+
+bool IncrementalForward::PlanLayer(LayerInfo *layer, LayerWindow &window) {
+    auto param = layer->param.get();
+    if (layer->type == LAYER_CONVOLUTION) {
+        auto conv_param = dynamic_cast<ConvLayerParam *>(param);
+        if (!conv_param || conv_param->pad_type != -1) {
+            return false;
+        }
+        window.kernel_y   = conv_param->kernels[1];
+        window.kernel_x   = conv_param->kernels[0];
+        window.stride_y   = conv_param->strides[1];
+        window.stride_x   = conv_param->strides[0];
+        window.pad_y      = conv_param->pads[2];
+        window.pad_x      = conv_param->pads[0];
+        window.dilation_y = conv_param->dialations[1];
+        window.dilation_x = conv_param->dialations[0];
+    } else if (layer->type == LAYER_POOLING) {
+        auto pool_param = dynamic_cast<PoolingLayerParam *>(param);
+        // global poolings depend on the whole input
+        if (!pool_param || pool_param->pad_type != -1 || pool_param->kernels_params[0] <= 0 ||
+            pool_param->kernels_params[1] <= 0 || pool_param->kernel_indexs[0] != -1 ||
+            pool_param->kernel_indexs[1] != -1) {
+            return false;
+        }
+        window.kernel_y = pool_param->kernels[1];
+        window.kernel_x = pool_param->kernels[0];
+        window.stride_y = pool_param->strides[1];
+        window.stride_x = pool_param->strides[0];
+        window.pad_y    = pool_param->pads[2];
+        window.pad_x    = pool_param->pads[0];
+    } else if (kPointwiseLayers.count(layer->type) == 0) {
+        return false;
+    } else if (layer->type == LAYER_CONCAT) {
+        auto concat_param = dynamic_cast<ConcatLayerParam *>(param);
+        if (!concat_param || concat_param->axis != 1) {
+            return false;
+        }
+    } else if (layer->type == LAYER_SOFTMAX) {
+        auto softmax_param = dynamic_cast<SoftmaxLayerParam *>(param);
+        if (!softmax_param || softmax_param->axis != 1) {
+            return false;
+        }
+    }
+
+    // element wise layers with weights broadcast along the spatial dims only
+    if (net_resource_) {
+        auto iter        = net_resource_->resource_map.find(layer->name);
+        auto element_res = iter != net_resource_->resource_map.end()
+                               ? dynamic_cast<EltwiseLayerResource *>(iter->second.get())
+                               : nullptr;
+        if (element_res) {
+            for (int i = 2; i < element_res->element_shape.size(); ++i) {
+                if (element_res->element_shape[i] > 1) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    if (window.stride_y <= 0 || window.stride_x <= 0 || window.dilation_y <= 0 || window.dilation_x <= 0) {
+        return false;
+    }
+
+    // all inputs must have the same size and stride
+    BlobPlan input_plan;
+    bool has_input = false;
+    for (auto &name : layer->inputs) {
+        auto iter = blob_plans_.find(name);
+        if (iter == blob_plans_.end()) {
+            return false;
+        }
+        auto &plan = iter->second;
+        if (has_input && (plan.height != input_plan.height || plan.width != input_plan.width ||
+                          plan.stride_y != input_plan.stride_y || plan.stride_x != input_plan.stride_x)) {
+            return false;
+        }
+        input_plan = plan;
+        has_input  = true;
+    }
+    if (!has_input) {
+        return false;
+    }
+
+    bool is_pointwise = kPointwiseLayers.count(layer->type) > 0;
+    for (auto &name : layer->outputs) {
+        Blob *blob = network_->GetBlob(name);
+        if (!blob || blob->GetBlobDesc().dims.size() != 4) {
+            return false;
+        }
+        BlobPlan plan;
+        plan.height   = blob->GetBlobDesc().dims[2];
+        plan.width    = blob->GetBlobDesc().dims[3];
+        plan.stride_y = input_plan.stride_y * window.stride_y;
+        plan.stride_x = input_plan.stride_x * window.stride_x;
+        if (is_pointwise && (plan.height != input_plan.height || plan.width != input_plan.width)) {
+            return false;
+        }
+        blob_plans_[name] = plan;
+    }
+    return true;
+}
+
+Status IncrementalForward::Prepare() {
+    previous_inputs_.clear();
+    clone_ = nullptr;
+    clone_dims_.clear();
+    network_reshape_needed_ = false;
+    partial_supported_      = false;
+    windows_.clear();
+    blob_plans_.clear();
+    input_name_.clear();
+    output_names_.clear();
+    align_y_ = 1;
+    align_x_ = 1;
+
+    BlobMap input_blobs;
+    Status ret = network_->GetAllInputBlobs(input_blobs);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    for (auto iter : input_blobs) {
+        BlobLayout layout;
+        if (!GetBlobLayout(iter.second, layout)) {
+            LOGE("ERROR: incremental forward only supports 4 dims nchw or nc4hw4 inputs, input: %s\n",
+                 iter.first.c_str());
+            return Status(TNNERR_PARAM_ERR, "incremental forward only supports 4 dims nchw or nc4hw4 inputs");
+        }
+    }
+
+    if (input_blobs.size() != 1 || input_blobs.begin()->second->GetBlobDesc().dims[0] != 1) {
+        LOGD("incremental forward skips unchanged inputs only, the model has several inputs or a batch\n");
+        return TNN_OK;
+    }
+    input_name_ = input_blobs.begin()->first;
+    BlobPlan input_plan;
+    input_plan.height        = input_blobs.begin()->second->GetBlobDesc().dims[2];
+    input_plan.width         = input_blobs.begin()->second->GetBlobDesc().dims[3];
+    blob_plans_[input_name_] = input_plan;
+
+    for (auto &layer : net_structure_->layers) {
+        LayerWindow window;
+        if (!PlanLayer(layer.get(), window)) {
+            LOGD("incremental forward skips unchanged inputs only, layer %s is not supported\n",
+                 layer->name.c_str());
+            return TNN_OK;
+        }
+        windows_.push_back(window);
+    }
+
+    BlobMap output_blobs;
+    ret = network_->GetAllOutputBlobs(output_blobs);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    for (auto iter : output_blobs) {
+        BlobLayout layout;
+        if (blob_plans_.count(iter.first) == 0 || !GetBlobLayout(iter.second, layout)) {
+            LOGD("incremental forward skips unchanged inputs only, output %s is not supported\n", iter.first.c_str());
+            return TNN_OK;
+        }
+        output_names_.push_back(iter.first);
+    }
+
+    // the input region starts at a multiple of the strides of all blobs, so
+    // that each blob of the clone is a region of the blob of the network
+    for (auto &iter : blob_plans_) {
+        align_y_ = align_y_ / Gcd(align_y_, iter.second.stride_y) * iter.second.stride_y;
+        align_x_ = align_x_ / Gcd(align_x_, iter.second.stride_x) * iter.second.stride_x;
+    }
+    partial_supported_ = true;
+    return TNN_OK;
+}
+
+bool IncrementalForward::CompareInputs(BlobRegion &changed) {
+    changed = BlobRegion();
+    BlobMap input_blobs;
+    network_->GetAllInputBlobs(input_blobs);
+    bool any_changed = false;
+    for (auto iter : input_blobs) {
+        BlobLayout layout;
+        GetBlobLayout(iter.second, layout);
+        auto &previous = previous_inputs_[iter.first];
+        if (previous.size() != GetBlobBytes(layout)) {
+            return true;
+        }
+        bool is_float     = iter.second->GetBlobDesc().data_type == DATA_TYPE_FLOAT;
+        BlobRegion region = CompareTiles(GetBlobData(iter.second), previous.data(), layout, config_.tile_size,
+                                         is_float, config_.tolerance);
+        if (!region.IsEmpty()) {
+            any_changed = true;
+            if (iter.first == input_name_) {
+                changed = region;
+            }
+        }
+    }
+    return any_changed;
+}
+
+void IncrementalForward::SaveInputs() {
+    BlobMap input_blobs;
+    network_->GetAllInputBlobs(input_blobs);
+    for (auto iter : input_blobs) {
+        BlobLayout layout;
+        GetBlobLayout(iter.second, layout);
+        const char *data = GetBlobData(iter.second);
+        previous_inputs_[iter.first].assign(data, data + GetBlobBytes(layout));
+    }
+}
+
+void IncrementalForward::SaveChangedInput(const BlobRegion &changed) {
+    // the outputs are up to date with the changed tiles only, the values
+    // under the tolerance elsewhere are still compared with the old ones
+    BlobMap input_blobs;
+    network_->GetAllInputBlobs(input_blobs);
+    Blob *input = input_blobs[input_name_];
+    BlobLayout layout;
+    GetBlobLayout(input, layout);
+    CopyRegion(GetBlobData(input), layout, changed.y_begin, changed.x_begin, previous_inputs_[input_name_].data(),
+               layout, changed.y_begin, changed.x_begin, changed.y_end - changed.y_begin,
+               changed.x_end - changed.x_begin);
+}
+
+Status IncrementalForward::ForwardFull() {
+    Status ret = TNN_OK;
+    if (network_reshape_needed_) {
+        ret = Invalidate();
+        if (ret != TNN_OK) {
+            return ret;
+        }
+    }
+
+    SaveInputs();
+    ret = network_->Forward();
+    if (ret != TNN_OK) {
+        previous_inputs_.clear();
+        return ret;
+    }
+    stats_.full_count++;
+    stats_.last_recompute_ratio = 1.0f;
+    return TNN_OK;
+}
+
+Status IncrementalForward::ForwardPartial(const BlobRegion &changed) {
+    // output regions changed by the input region
+    std::map<std::string, BlobRegion> changed_regions;
+    changed_regions[input_name_] = changed;
+    for (int i = 0; i < net_structure_->layers.size(); ++i) {
+        auto &layer = net_structure_->layers[i];
+        auto &w     = windows_[i];
+        BlobRegion input_region;
+        for (auto &name : layer->inputs) {
+            input_region.Merge(changed_regions[name]);
+        }
+        if (input_region.IsEmpty()) {
+            continue;
+        }
+        for (auto &name : layer->outputs) {
+            auto &plan = blob_plans_[name];
+            BlobRegion region;
+            region.y_begin = std::max(0, CeilDiv(input_region.y_begin + w.pad_y - (w.kernel_y - 1) * w.dilation_y,
+                                                 w.stride_y));
+            region.y_end   = std::min(plan.height, FloorDiv(input_region.y_end - 1 + w.pad_y, w.stride_y) + 1);
+            region.x_begin = std::max(0, CeilDiv(input_region.x_begin + w.pad_x - (w.kernel_x - 1) * w.dilation_x,
+                                                 w.stride_x));
+            region.x_end   = std::min(plan.width, FloorDiv(input_region.x_end - 1 + w.pad_x, w.stride_x) + 1);
+            changed_regions[name] = region;
+        }
+    }
+
+    // input regions the changed output regions depend on
+    std::map<std::string, BlobRegion> needed_regions;
+    for (auto &name : output_names_) {
+        needed_regions[name] = changed_regions[name];
+    }
+    for (int i = (int)net_structure_->layers.size() - 1; i >= 0; --i) {
+        auto &layer = net_structure_->layers[i];
+        auto &w     = windows_[i];
+        BlobRegion output_region;
+        for (auto &name : layer->outputs) {
+            output_region.Merge(needed_regions[name]);
+        }
+        if (output_region.IsEmpty()) {
+            continue;
+        }
+        for (auto &name : layer->inputs) {
+            auto &plan = blob_plans_[name];
+            BlobRegion region;
+            region.y_begin = std::max(0, output_region.y_begin * w.stride_y - w.pad_y);
+            region.y_end   = std::min(plan.height, (output_region.y_end - 1) * w.stride_y - w.pad_y +
+                                                     (w.kernel_y - 1) * w.dilation_y + 1);
+            region.x_begin = std::max(0, output_region.x_begin * w.stride_x - w.pad_x);
+            region.x_end   = std::min(plan.width, (output_region.x_end - 1) * w.stride_x - w.pad_x +
+                                                    (w.kernel_x - 1) * w.dilation_x + 1);
+            needed_regions[name].Merge(region);
+        }
+    }
+
+    auto &needed = needed_regions[input_name_];
+    if (needed.IsEmpty()) {
+        SaveChangedInput(changed);
+        stats_.skip_count++;
+        stats_.last_recompute_ratio = 0.0f;
+        return TNN_OK;
+    }
+
+    // the end is rounded to tiles to reuse the shapes of the clone
+    auto &input_plan = blob_plans_[input_name_];
+    const int tile   = config_.tile_size;
+    BlobRegion crop;
+    crop.y_begin = FloorDiv(needed.y_begin, align_y_) * align_y_;
+    crop.y_end   = std::min(input_plan.height, CeilDiv(needed.y_end, tile) * tile);
+    crop.x_begin = FloorDiv(needed.x_begin, align_x_) * align_x_;
+    crop.x_end   = std::min(input_plan.width, CeilDiv(needed.x_end, tile) * tile);
+    const int crop_height = crop.y_end - crop.y_begin;
+    const int crop_width  = crop.x_end - crop.x_begin;
+    const float ratio = (float)crop_height * crop_width / ((float)input_plan.height * input_plan.width);
+    if (ratio > config_.max_recompute_ratio) {
+        return ForwardFull();
+    }
+
+    Status ret = TNN_OK;
+    if (!clone_) {
+        clone_ = instance_->Clone(ret);
+        if (ret != TNN_OK || !clone_) {
+            clone_ = nullptr;
+            return ret;
+        }
+        if (num_threads_ > 0) {
+            clone_->SetCpuNumThreads(num_threads_);
+        }
+    }
+
+    BlobMap input_blobs, clone_input_blobs;
+    network_->GetAllInputBlobs(input_blobs);
+    clone_->GetAllInputBlobs(clone_input_blobs);
+    Blob *input       = input_blobs[input_name_];
+    Blob *clone_input = clone_input_blobs[input_name_];
+    DimsVector dims   = input->GetBlobDesc().dims;
+    dims[2]           = crop_height;
+    dims[3]           = crop_width;
+    if (dims != clone_dims_) {
+        InputShapesMap shapes;
+        shapes[input_name_]     = dims;
+        network_reshape_needed_ = true;
+        clone_dims_.clear();
+        ret = clone_->Reshape(shapes);
+        if (ret != TNN_OK) {
+            LOGD("incremental forward can not reshape to the crop %d x %d, compute the whole network\n",
+                 crop_height, crop_width);
+            return ForwardFull();
+        }
+        clone_dims_ = dims;
+    }
+
+    BlobLayout input_layout, clone_input_layout;
+    GetBlobLayout(input, input_layout);
+    GetBlobLayout(clone_input, clone_input_layout);
+    CopyRegion(GetBlobData(input), input_layout, crop.y_begin, crop.x_begin, GetBlobData(clone_input),
+               clone_input_layout, 0, 0, crop_height, crop_width);
+    ret = clone_->Forward();
+    if (ret != TNN_OK) {
+        previous_inputs_.clear();
+        return ret;
+    }
+
+    BlobMap output_blobs, clone_output_blobs;
+    network_->GetAllOutputBlobs(output_blobs);
+    clone_->GetAllOutputBlobs(clone_output_blobs);
+    for (auto &name : output_names_) {
+        auto &region = changed_regions[name];
+        if (region.IsEmpty()) {
+            continue;
+        }
+        auto &plan = blob_plans_[name];
+        BlobLayout output_layout, clone_output_layout;
+        GetBlobLayout(output_blobs[name], output_layout);
+        GetBlobLayout(clone_output_blobs[name], clone_output_layout);
+        const int origin_y = crop.y_begin / plan.stride_y;
+        const int origin_x = crop.x_begin / plan.stride_x;
+        if (region.y_begin < origin_y || region.x_begin < origin_x ||
+            region.y_end - origin_y > clone_output_layout.height ||
+            region.x_end - origin_x > clone_output_layout.width) {
+            LOGD("incremental forward output %s out of the computed region, compute the whole network\n",
+                 name.c_str());
+            return ForwardFull();
+        }
+        CopyRegion(GetBlobData(clone_output_blobs[name]), clone_output_layout, region.y_begin - origin_y,
+                   region.x_begin - origin_x, GetBlobData(output_blobs[name]), output_layout, region.y_begin,
+                   region.x_begin, region.y_end - region.y_begin, region.x_end - region.x_begin);
+    }
+
+    SaveChangedInput(changed);
+    stats_.partial_count++;
+    stats_.last_recompute_ratio = ratio;
+    return TNN_OK;
+}
+
+Status IncrementalForward::Forward() {
+    BlobRegion changed;
+    if (previous_inputs_.empty()) {
+        return ForwardFull();
+    }
+    if (!CompareInputs(changed)) {
+        stats_.skip_count++;
+        stats_.last_recompute_ratio = 0.0f;
+        return TNN_OK;
+    }
+    if (!partial_supported_ || changed.IsEmpty()) {
+        return ForwardFull();
+    }
+    return ForwardPartial(changed);
+}
+
+Status IncrementalForward::Invalidate() {
+    previous_inputs_.clear();
+    if (!network_reshape_needed_) {
+        return TNN_OK;
+    }
+
+    BlobMap input_blobs;
+    network_->GetAllInputBlobs(input_blobs);
+    InputShapesMap shapes;
+    for (auto iter : input_blobs) {
+        shapes[iter.first] = iter.second->GetBlobDesc().dims;
+    }
+    Status ret = network_->Reshape(shapes);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    network_reshape_needed_ = false;
+    clone_dims_.clear();
+    return TNN_OK;
+}
+
+Status IncrementalForward::SetCpuNumThreads(int num_threads) {
+    num_threads_ = num_threads;
+    if (clone_) {
+        return clone_->SetCpuNumThreads(num_threads);
+    }
+    return TNN_OK;
+}
+
+IncrementalStats IncrementalForward::GetStats() {
+    return stats_;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,139 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_CORE_INCREMENTAL_FORWARD_H_
+#define TNN_SOURCE_TNN_CORE_INCREMENTAL_FORWARD_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tnn/core/abstract_network.h"
+#include "tnn/core/common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+
+namespace TNN_NS {
+
+// @brief region [y_begin, y_end) x [x_begin, x_end) of the spatial dims of a blob
+struct BlobRegion {
+    int y_begin = 0;
+    int y_end   = 0;
+    int x_begin = 0;
+    int x_end   = 0;
+
+    bool IsEmpty() const;
+
+    // @brief extend the region to the bounding box of both regions
+    void Merge(const BlobRegion &region);
+};
+
+// @brief IncrementalForward computes the outputs of a network only where the
+// input changed since the previous forward. The changed input tiles are
+// propagated through the receptive fields of the layers to the output regions
+// they change, and back to the input region these output regions depend on.
+// The input region, aligned to the strides of the network, is computed by a
+// clone of the instance and the changed output regions are copied to the
+// outputs of the network, which keep the results of the previous forward.
+class IncrementalForward {
+public:
+    IncrementalForward(const IncrementalConfig &config, Instance *instance, AbstractNetwork *network,
+                       NetStructure *net_structure, NetResource *net_resource);
+
+    ~IncrementalForward();
+
+    // @brief plan the region propagation for the current input shapes, called
+    // after the network is initialized or reshaped
+    Status Prepare();
+
+    // @brief forward the network, only the changed regions if possible
+    Status Forward();
+
+    // @brief the next forward computes the whole network, called before the
+    // network is forwarded without the incremental forward
+    Status Invalidate();
+
+    // @brief set threads of the clone computing the changed regions
+    Status SetCpuNumThreads(int num_threads);
+
+    IncrementalStats GetStats();
+
+private:
+    // @brief receptive field of a layer, 1x1 for element wise layers
+    struct LayerWindow {
+        int kernel_y   = 1;
+        int kernel_x   = 1;
+        int stride_y   = 1;
+        int stride_x   = 1;
+        int pad_y      = 0;
+        int pad_x      = 0;
+        int dilation_y = 1;
+        int dilation_x = 1;
+    };
+
+    // @brief spatial size of a blob and its stride to the input
+    struct BlobPlan {
+        int height   = 0;
+        int width    = 0;
+        int stride_y = 1;
+        int stride_x = 1;
+    };
+
+    bool PlanLayer(LayerInfo *layer, LayerWindow &window);
+    Status ForwardFull();
+    Status ForwardPartial(const BlobRegion &changed);
+    // @brief compare the inputs with the previous ones
+    // @param changed bounding box of the changed tiles of the first input
+    // @return whether any input changed
+    bool CompareInputs(BlobRegion &changed);
+    void SaveInputs();
+    // @brief save the changed region of the single input
+    void SaveChangedInput(const BlobRegion &changed);
+
+    IncrementalConfig config_;
+    Instance *instance_          = nullptr;
+    AbstractNetwork *network_    = nullptr;
+    NetStructure *net_structure_ = nullptr;
+    NetResource *net_resource_   = nullptr;
+
+    // whether the changed regions can be computed alone
+    bool partial_supported_ = false;
+    std::vector<LayerWindow> windows_;
+    std::map<std::string, BlobPlan> blob_plans_;
+    std::string input_name_;
+    std::vector<std::string> output_names_;
+    // alignment of the input region keeping the strides of all blobs
+    int align_y_ = 1;
+    int align_x_ = 1;
+
+    // inputs of the previous forward, empty if the next forward computes the whole network
+    std::map<std::string, std::vector<char>> previous_inputs_;
+
+    // clone computing the changed regions, created on the first partial forward
+    std::shared_ptr<Instance> clone_;
+    DimsVector clone_dims_;
+    int num_threads_ = 0;
+    // the layer params shared with the clone hold the shapes of the clone,
+    // the network is reshaped before it computes the whole input again
+    bool network_reshape_needed_ = false;
+
+    IncrementalStats stats_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_CORE_INCREMENTAL_FORWARD_H_
@@ -18,11 +18,15 @@
 
 #include "tnn/core/abstract_network.h"
 #include "tnn/core/common.h"
+#include "tnn/core/incremental_forward.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/profile.h"
 #include "tnn/core/status.h"
 #include "tnn/interpreter/abstract_model_interpreter.h"
+#include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/memory_tracker.h"
+#include "tnn/utils/serving_metrics_inner.h"
 
 namespace TNN_NS {
 
@@ -34,6 +38,9 @@ namespace TNN_NS {
 Instance::Instance(NetworkConfig &net_config, ModelConfig &model_config) {
     net_config_   = net_config;
     model_config_ = model_config;
+    if (net_config.enable_metrics) {
+        metrics_ = std::make_shared<ServingMetrics>();
+    }
 }
 Instance::~Instance() {
     DeInit();
@@ -51,14 +58,72 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
         LOGE("ERROR: network_ is nil, network_type may not support\n");
         return Status(TNNERR_NET_ERR, "network_ is nil, network_type may not support");
     }
-    return network_->Init(net_config_, model_config_, interpreter.get(), inputs_shape);
+    Status ret = network_->Init(net_config_, model_config_, interpreter.get(), inputs_shape);
+    if (ret != TNN_OK || !net_config_.incremental_config.enable) {
+        return ret;
+    }
+
+    // the previous inputs and outputs are read and written on the host
+    auto device_type         = net_config_.device_type;
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (device_type != DEVICE_NAIVE && device_type != DEVICE_X86 && device_type != DEVICE_ARM) {
+        LOGE("ERROR: incremental forward only supports cpu devices\n");
+        return Status(TNNERR_DEVICE_NOT_SUPPORT, "incremental forward only supports cpu devices");
+    }
+    if (net_config_.share_memory_mode != SHARE_MEMORY_MODE_DEFAULT || !default_interpreter) {
+        LOGE("ERROR: incremental forward needs the default share memory mode and a tnn or ncnn model\n");
+        return Status(TNNERR_PARAM_ERR, "incremental forward needs the default share memory mode");
+    }
+    incremental_ = std::make_shared<IncrementalForward>(net_config_.incremental_config, this, network_.get(),
+                                                        default_interpreter->GetNetStructure(),
+                                                        default_interpreter->GetNetResource());
+    return incremental_->Prepare();
 }
 
 Status Instance::DeInit() {
-    network_ = nullptr;
+    incremental_ = nullptr;
+    network_     = nullptr;
     return TNN_OK;
 }
 
+/*
+ * The cloned instance holds the interpreter of this instance, net structure
+ * and net resource stay alive as long as one of the instances exists.
+ */
+std::shared_ptr<Instance> Instance::Clone(Status &status) {
+    if (!network_) {
+        LOGE("ERROR: instance is not initialized\n");
+        status = Status(TNNERR_NET_ERR, "instance is not initialized");
+        return nullptr;
+    }
+
+    // keep the input shapes set by reshape
+    BlobMap input_blobs;
+    status = network_->GetAllInputBlobs(input_blobs);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+    InputShapesMap inputs_shape;
+    for (auto iter : input_blobs) {
+        inputs_shape[iter.first] = iter.second->GetBlobDesc().dims;
+    }
+
+    auto instance          = std::make_shared<Instance>(net_config_, model_config_);
+    instance->interpreter_ = interpreter_;
+    instance->network_     = NetworkImplManager::GetNetworkImpl(net_config_.network_type);
+    if (!instance->network_) {
+        LOGE("ERROR: network_ is nil, network_type may not support\n");
+        status = Status(TNNERR_NET_ERR, "network_ is nil, network_type may not support");
+        return nullptr;
+    }
+
+    status = instance->network_->InitFromNetwork(network_.get(), inputs_shape);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+    return instance;
+}
+
 Status Instance::GetForwardMemorySize(int &memory_size) {
     return network_->GetForwardMemorySize(memory_size);
 }
@@ -67,8 +132,20 @@ Status Instance::SetForwardMemory(void *memory) {
     return network_->SetForwardMemory(memory);
 }
 
+Status Instance::GetMemoryReport(MemoryReport &report) {
+    if (!network_) {
+        LOGE("ERROR: instance is not initialized\n");
+        return Status(TNNERR_NET_ERR, "instance is not initialized");
+    }
+    return network_->GetMemoryReport(report);
+}
+
 Status Instance::Reshape(const InputShapesMap &inputs) {
-    return (Status)network_->Reshape(inputs);
+    Status ret = network_->Reshape(inputs);
+    if (ret != TNN_OK || !incremental_) {
+        return ret;
+    }
+    return incremental_->Prepare();
 }
 
 Status Instance::GetCommandQueue(void **command_queue) {
@@ -77,19 +154,61 @@ Status Instance::GetCommandQueue(void **command_queue) {
 
 Status Instance::Forward() {
     output_mats_convert_status_.clear();
-    return (Status)network_->Forward();
+    if (!metrics_) {
+        return incremental_ ? incremental_->Forward() : (Status)network_->Forward();
+    }
+    long long start = ServingMetrics::Now();
+    Status ret      = incremental_ ? incremental_->Forward() : network_->Forward();
+    metrics_->OnForward(start, ret == TNN_OK);
+    return ret;
 }
 
 #ifdef FORWARD_CALLBACK_ENABLE
 Status Instance::ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after) {
     output_mats_convert_status_.clear();
-    return (Status)network_->ForwardWithCallback(before, after);
+    if (incremental_) {
+        RETURN_ON_NEQ(incremental_->Invalidate(), TNN_OK);
+    }
+    if (!metrics_) {
+        return (Status)network_->ForwardWithCallback(before, after);
+    }
+    long long start = ServingMetrics::Now();
+    Status ret      = network_->ForwardWithCallback(before, after);
+    metrics_->OnForward(start, ret == TNN_OK);
+    return ret;
 }
 #endif  // end of FORWARD_CALLBACK_ENABLE
 
 Status Instance::ForwardAsync(Callback call_back) {
     output_mats_convert_status_.clear();
-    return (Status)network_->ForwardAsync(call_back);
+    if (incremental_) {
+        RETURN_ON_NEQ(incremental_->Invalidate(), TNN_OK);
+    }
+    if (!metrics_) {
+        return (Status)network_->ForwardAsync(call_back);
+    }
+    long long start = ServingMetrics::Now();
+    Status ret      = network_->ForwardAsync(call_back);
+    metrics_->OnForwardAsync(start, ret == TNN_OK);
+    return ret;
+}
+
+Status Instance::GetServingMetrics(ServingMetricsData &metrics) {
+    if (!metrics_) {
+        LOGE("ERROR: metrics are not enabled, set NetworkConfig::enable_metrics\n");
+        return Status(TNNERR_COMMON_ERROR, "metrics are not enabled");
+    }
+    metrics = metrics_->GetData();
+    return TNN_OK;
+}
+
+Status Instance::GetIncrementalStats(IncrementalStats &stats) {
+    if (!incremental_) {
+        LOGE("ERROR: incremental forward is not enabled, set NetworkConfig::incremental_config\n");
+        return Status(TNNERR_COMMON_ERROR, "incremental forward is not enabled");
+    }
+    stats = incremental_->GetStats();
+    return TNN_OK;
 }
 
 Status Instance::GetAllInputBlobs(BlobMap &blobs) {
@@ -101,9 +220,16 @@ Status Instance::GetAllOutputBlobs(BlobMap &blobs) {
 }
 
 Status Instance::SetCpuNumThreads(int num_threads) {
+    if (incremental_) {
+        RETURN_ON_NEQ(incremental_->SetCpuNumThreads(num_threads), TNN_OK);
+    }
     return network_->SetCpuNumThreads(num_threads);
 }
 
+Status Instance::SetCpuAffinity(const std::vector<int> &cpu_list) {
+    return network_->SetCpuAffinity(cpu_list);
+}
+
 // set input Mat
 Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param,
                              std::string input_name) {
@@ -144,9 +270,14 @@ Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param,
     void *command_queue = nullptr;
     network_->GetCommandQueue(&command_queue);
     
+    long long start = metrics_ ? ServingMetrics::Now() : 0;
+    MemoryTrackerScope memory_scope(network_->GetMemoryTracker(), MEMORY_TYPE_CONVERTER);
     status = blob_converter->ConvertFromMatAsync(*(mat.get()),
                                                  param,
                                                  command_queue);
+    if (metrics_) {
+        metrics_->OnConvertIn(start, status == TNN_OK);
+    }
     if (status != TNN_NS::TNN_OK) {
         LOGE("input_blob_convert.ConvertFromMatAsync Error: %s\n", status.description().c_str());
         return status;
@@ -197,6 +328,7 @@ Status Instance::GetOutputMat(std::shared_ptr<Mat>& mat, MatConvertParam param,
 
     if (need_allocate) {
         auto dims = output_blobs[output_name]->GetBlobDesc().dims;
+        MemoryTrackerScope memory_scope(network_->GetMemoryTracker(), MEMORY_TYPE_MAT);
         auto output_mat = std::make_shared<TNN_NS::Mat>(device, mat_type, dims);
         output_mats_[output_name] = output_mat;
     }
@@ -216,9 +348,14 @@ Status Instance::GetOutputMat(std::shared_ptr<Mat>& mat, MatConvertParam param,
     //get command queue
     void *command_queue = nullptr;
     network_->GetCommandQueue(&command_queue);
+    long long start = metrics_ ? ServingMetrics::Now() : 0;
+    MemoryTrackerScope memory_scope(network_->GetMemoryTracker(), MEMORY_TYPE_CONVERTER);
     status = blob_converter->ConvertToMat(*(mat.get()),
                                                  param,
                                                  command_queue);
+    if (metrics_) {
+        metrics_->OnConvertOut(start, status == TNN_OK);
+    }
     if (status == TNN_NS::TNN_OK) {
         //set output mat convert status
         output_mats_convert_status_[output_name] = 1;
@@ -15,6 +15,8 @@
 #include "tnn/core/tnn_impl_default.h"
 
 #include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/memory_tracker.h"
+#include "tnn/utils/numa_utils.h"
 
 namespace TNN_NS {
 
@@ -37,11 +39,20 @@ Status TNNImplDefault::Init(ModelConfig& config) {
         return Status(TNNERR_NET_ERR, "interpreter is nil");
     }
     interpreter_ = std::shared_ptr<AbstractModelInterpreter>(interpreter);
+
+    auto default_interpreter       = dynamic_cast<DefaultModelInterpreter*>(interpreter);
+    MemoryTracker* weights_tracker = nullptr;
+    if (default_interpreter) {
+        default_interpreter->SetBenchmarkMode(config.benchmark_mode);
+        weights_tracker = default_interpreter->GetMemoryTracker().get();
+    }
+    MemoryTrackerScope memory_scope(weights_tracker, MEMORY_TYPE_WEIGHTS);
     return interpreter_->Interpret(config.params);
 }
 
 Status TNNImplDefault::DeInit() {
     interpreter_ = nullptr;
+    numa_interpreters_.clear();
     return TNN_OK;
 }
 
@@ -54,9 +65,57 @@ Status TNNImplDefault::AddOutput(const std::string& layer_name, int output_index
     CHECK_PARAM_NULL(default_interpreter);
 
     default_interpreter->GetNetStructure()->outputs.insert(layer_name);
+    added_outputs_.push_back(layer_name);
     return TNN_OK;
 }
 
+std::shared_ptr<AbstractModelInterpreter> TNNImplDefault::GetInterpreter(int numa_node, Status& status) {
+    status = TNN_OK;
+    if (numa_node < 0) {
+        return interpreter_;
+    }
+
+    std::unique_lock<std::mutex> lck(numa_interpreters_mtx_);
+    if (numa_interpreters_.count(numa_node) > 0) {
+        return numa_interpreters_[numa_node];
+    }
+
+    // interpret the model again with weights allocated on the numa node
+    NumaNodeGuard numa_guard(numa_node);
+    status = numa_guard.GetStatus();
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(model_config_.model_type));
+    if (!interpreter) {
+        status = Status(TNNERR_NET_ERR, "interpreter is nil");
+        return nullptr;
+    }
+    auto default_interpreter       = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+    MemoryTracker* weights_tracker = nullptr;
+    if (default_interpreter) {
+        default_interpreter->SetBenchmarkMode(model_config_.benchmark_mode);
+        weights_tracker = default_interpreter->GetMemoryTracker().get();
+    }
+    {
+        MemoryTrackerScope memory_scope(weights_tracker, MEMORY_TYPE_WEIGHTS);
+        status = interpreter->Interpret(model_config_.params);
+    }
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+
+    if (default_interpreter) {
+        for (auto& output_name : added_outputs_) {
+            default_interpreter->GetNetStructure()->outputs.insert(output_name);
+        }
+    }
+
+    numa_interpreters_[numa_node] = interpreter;
+    return interpreter;
+}
+
 std::shared_ptr<Instance> TNNImplDefault::CreateInst(NetworkConfig& net_config, Status& status,
                                                      InputShapesMap inputs_shape) {
     if (!interpreter_) {
@@ -64,8 +123,13 @@ std::shared_ptr<Instance> TNNImplDefault::CreateInst(NetworkConfig& net_config,
         return nullptr;
     }
 
+    auto interpreter = GetInterpreter(net_config.numa_node, status);
+    if (status != TNN_OK) {
+        return nullptr;
+    }
+
     auto instance = std::make_shared<Instance>(net_config, model_config_);
-    status        = instance->Init(interpreter_, inputs_shape);
+    status        = instance->Init(interpreter, inputs_shape);
 
     if (status != TNN_OK) {
         return nullptr;
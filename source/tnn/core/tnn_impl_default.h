@@ -15,8 +15,11 @@
 #ifndef TNN_CORE_TNN_IMPL_DEFAULT_H_
 #define TNN_CORE_TNN_IMPL_DEFAULT_H_
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "tnn/core/common.h"
 #include "tnn/core/instance.h"
@@ -65,7 +68,18 @@ public:
         InputShapesMap inputs_shape = InputShapesMap());
 
 private:
+    // @brief get the interpreter holding weights for the numa node, the
+    // replica is created on first use with memory placed on the node.
+    std::shared_ptr<AbstractModelInterpreter> GetInterpreter(int numa_node, Status& status);
+
     std::shared_ptr<AbstractModelInterpreter> interpreter_;
+
+    // per numa node replicas of interpreter_
+    std::map<int, std::shared_ptr<AbstractModelInterpreter>> numa_interpreters_;
+    std::mutex numa_interpreters_mtx_;
+
+    // outputs added by AddOutput, replayed on numa replicas
+    std::vector<std::string> added_outputs_;
 };
 
 }  // namespace TNN_NS
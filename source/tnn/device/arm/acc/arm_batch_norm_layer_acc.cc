@@ -31,6 +31,14 @@ Status ArmBatchNormLayerAcc::Init(Context *context, LayerParam *param, LayerReso
     return allocateBufferParam(inputs, outputs);
 }
 
+Status ArmBatchNormLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto bn_acc = dynamic_cast<ArmBatchNormLayerAcc *>(acc);
+    CHECK_PARAM_NULL(bn_acc);
+    buffer_scale_ = bn_acc->buffer_scale_;
+    buffer_bias_  = bn_acc->buffer_bias_;
+    return TNN_OK;
+}
+
 Status ArmBatchNormLayerAcc::allocateBufferParam(const std::vector<Blob *> &inputs,
                                                  const std::vector<Blob *> &outputs) {
     auto dims_input  = inputs[0]->GetBlobDesc().dims;
@@ -19,6 +19,7 @@
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
@@ -187,9 +188,21 @@ Status ArmInnerProductLayerAcc::allocateBufferBias(const std::vector<Blob *> &in
     return TNN_OK;
 }
 
+Status ArmInnerProductLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto fc_acc = dynamic_cast<ArmInnerProductLayerAcc *>(acc);
+    CHECK_PARAM_NULL(fc_acc);
+    buffer_weight_ = fc_acc->buffer_weight_;
+    buffer_bias_   = fc_acc->buffer_bias_;
+    buffer_scale_  = fc_acc->buffer_scale_;
+    return TNN_OK;
+}
+
 Status ArmInnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    return ArmLayerAcc::Init(context, param, resource, inputs, outputs);
+}
+
+Status ArmInnerProductLayerAcc::InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
 
@@ -272,6 +285,22 @@ Status ArmInnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
     return TNNERR_LAYER_ERR;
 }
 
+double ArmInnerProductLayerAcc::GetFlops() {
+    if (input_dims_.empty() || output_dims_.size() < 2) {
+        return ArmLayerAcc::GetFlops();
+    }
+    return 2.0 * DimsVectorUtils::Count(input_dims_) * output_dims_[1] / 1000.0 / 1000.0;
+}
+
+double ArmInnerProductLayerAcc::GetBandwidth() {
+    if (input_dims_.size() < 2 || output_dims_.size() < 2) {
+        return ArmLayerAcc::GetBandwidth();
+    }
+    // weights dominate the memory traffic of small batch
+    double weight_count = 1.0 * DimsVectorUtils::Count(input_dims_, 1) * output_dims_[1];
+    return ArmLayerAcc::GetBandwidth() + weight_count * DataTypeUtils::GetBytesSize(data_type_) / 1000.0 / 1000.0;
+}
+
 REGISTER_ARM_ACC(InnerProduct, LAYER_INNER_PRODUCT)
 
 }  // namespace TNN_NS
@@ -28,6 +28,14 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual Status InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
+    virtual double GetFlops() override;
+
+    virtual double GetBandwidth() override;
+
     // alloc for fc weights and pack GOIHW16
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
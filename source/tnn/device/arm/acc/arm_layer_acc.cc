@@ -21,9 +21,16 @@
 #include "tnn/core/profile.h"
 #include "tnn/device/arm/acc/arm_layer_acc.h"
 #include "tnn/device/arm/arm_context.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
+// work a thread needs to pay off the fork/join cost of a parallel region
+static const double kMinMFlopsPerThread = 0.2;
+static const double kMinMBytesPerThread = 0.1;
+
 Status ArmLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                          const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     AbstractLayerAcc::Init(context, param, resource, inputs, outputs);
@@ -79,9 +86,37 @@ Status ArmLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector
     k_param_->oc_r4 = ROUND_UP(output_dim[1], 4);
     k_param_->oh    = output_dim[2];
     k_param_->ow    = output_dim[3];
+
+    UpdateMaxNumThreads(inputs, outputs);
     return TNN_OK;
 }
 
+double ArmLayerAcc::GetFlops() {
+    return DimsVectorUtils::Count(output_dims_) / 1000.0 / 1000.0;
+}
+
+double ArmLayerAcc::GetBandwidth() {
+    double count = DimsVectorUtils::Count(input_dims_) + DimsVectorUtils::Count(output_dims_);
+    return count * DataTypeUtils::GetBytesSize(data_type_) / 1000.0 / 1000.0;
+}
+
+void ArmLayerAcc::UpdateMaxNumThreads(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    input_dims_  = inputs[0]->GetBlobDesc().dims;
+    output_dims_ = outputs[0]->GetBlobDesc().dims;
+    data_type_   = outputs[0]->GetBlobDesc().data_type;
+
+    double flops     = GetFlops();
+    double bandwidth = GetBandwidth();
+    if (flops <= 0 && bandwidth <= 0) {
+        max_num_threads_ = 0;
+        return;
+    }
+
+    // threads are limited by the work of compute or memory, whichever is larger
+    double work_threads = MAX(flops / kMinMFlopsPerThread, bandwidth / kMinMBytesPerThread);
+    max_num_threads_    = work_threads < 1.0 ? 1 : (work_threads > OMP_CORES_ ? 0 : (int)work_threads);
+}
+
 bool ArmLayerAcc::DataTypeSupported(DataType data_type) {
     if (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_BFP16 || data_type == DATA_TYPE_INT8) {
         return true;
@@ -98,12 +133,23 @@ Status ArmLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector
     timer.Start();
 #endif
 
+    // run small layers with fewer threads
+    int num_threads       = context_->GetNumThreads();
+    int layer_num_threads = max_num_threads_ > 0 ? MIN(num_threads, max_num_threads_) : num_threads;
+    if (layer_num_threads != num_threads) {
+        OMP_SET_THREADS_(layer_num_threads);
+    }
+
     auto in_data_type = inputs[0]->GetBlobDesc().data_type;
     if (DataTypeSupported(in_data_type)) {
         status = this->DoForward(inputs, outputs);
     } else {
         LOGE("Error : arm layer acc got unsupported data type %d\n", in_data_type);
-        return Status(TNNERR_LAYER_ERR, "Error: arm layer acc got unsupported data type.");
+        status = Status(TNNERR_LAYER_ERR, "Error: arm layer acc got unsupported data type.");
+    }
+
+    if (layer_num_threads != num_threads) {
+        OMP_SET_THREADS_(num_threads);
     }
 
 #if TNN_PROFILE
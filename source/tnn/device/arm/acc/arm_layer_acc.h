@@ -58,6 +58,12 @@ public:
      */
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    // @brief estimated MFLOPs, one op per output element by default
+    virtual double GetFlops() override;
+
+    // @brief estimated MB read and written by the layer
+    virtual double GetBandwidth() override;
+
 #if TNN_PROFILE
     Timer timer;
 #endif
@@ -71,6 +77,16 @@ protected:
 
     virtual bool DataTypeSupported(DataType data_type);
 
+    // @brief choose the max threads for the layer from its work size, small
+    // layers run with fewer threads when fork/join costs more than it saves.
+    void UpdateMaxNumThreads(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // max threads used in forward, 0 means all threads of context
+    int max_num_threads_ = 0;
+    DimsVector input_dims_;
+    DimsVector output_dims_;
+    DataType data_type_ = DATA_TYPE_FLOAT;
+
 private:
     // @brief return device layer acc support data format
     virtual std::vector<DataFormat> SupportDataFormat(DataType data_type, int dims_size);
@@ -759,6 +759,48 @@ void DepthwiseConvI8(const int8_t* src, int8_t* dst, long dst_depth, long src_y_
     }
 }
 
+/*
+gemm of the int16 transformed input and weights of one winograd position, 4 tiles share each weight load
+*/
+void GemmInt16(int32_t* dst, const int16_t* src, const int16_t* weight, long tile, long ic_r4, long oc_r4) {
+    for (long dc = 0; dc < oc_r4; dc += 4) {
+        const auto weight_c = weight + dc * ic_r4;
+        long t              = 0;
+#ifdef TNN_USE_NEON
+        for (; t + 3 < tile; t += 4) {
+            const auto src_t = src + t * ic_r4;
+            int32x4_t acc0   = vdupq_n_s32(0);
+            int32x4_t acc1   = vdupq_n_s32(0);
+            int32x4_t acc2   = vdupq_n_s32(0);
+            int32x4_t acc3   = vdupq_n_s32(0);
+            for (long ic = 0; ic < ic_r4; ++ic) {
+                int16x4_t w = vld1_s16(weight_c + ic * 4);
+                acc0        = vmlal_n_s16(acc0, w, src_t[ic]);
+                acc1        = vmlal_n_s16(acc1, w, src_t[ic_r4 + ic]);
+                acc2        = vmlal_n_s16(acc2, w, src_t[2 * ic_r4 + ic]);
+                acc3        = vmlal_n_s16(acc3, w, src_t[3 * ic_r4 + ic]);
+            }
+            vst1q_s32(dst + t * oc_r4 + dc, acc0);
+            vst1q_s32(dst + (t + 1) * oc_r4 + dc, acc1);
+            vst1q_s32(dst + (t + 2) * oc_r4 + dc, acc2);
+            vst1q_s32(dst + (t + 3) * oc_r4 + dc, acc3);
+        }
+#endif
+        for (; t < tile; ++t) {
+            const auto src_t = src + t * ic_r4;
+            int32_t acc[4]   = {0, 0, 0, 0};
+            for (long ic = 0; ic < ic_r4; ++ic) {
+                for (long j = 0; j < 4; ++j) {
+                    acc[j] += (int32_t)src_t[ic] * (int32_t)weight_c[ic * 4 + j];
+                }
+            }
+            for (long j = 0; j < 4; ++j) {
+                dst[t * oc_r4 + dc + j] = acc[j];
+            }
+        }
+    }
+}
+
 void ReluInt8(int8_t* dst, const int8_t* src, long len) {
     long idx = 0;
 #ifdef TNN_USE_NEON
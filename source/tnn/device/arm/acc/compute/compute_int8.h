@@ -42,6 +42,9 @@ void Int8ToFloat(float* dst, const int8_t* src, const float* scale, long batch,
 
 void FloatToInt8(int8_t* dst, const float* src, const float* scale, long batch, long channel, long hw);
 
+// dst[tile][oc_r4] = src[tile][ic_r4] * weight, weight is [oc_r4/4][ic_r4][4], used by the int8 winograd
+void GemmInt16(int32_t* dst, const int16_t* src, const int16_t* weight, long tile, long ic_r4, long oc_r4);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
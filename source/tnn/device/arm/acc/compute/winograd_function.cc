@@ -19,6 +19,7 @@
 #include <arm_neon.h>
 #endif
 #include "tnn/device/arm/acc/Float4.h"
+#include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
 
@@ -371,4 +372,112 @@ void DstTransformInOne6x4BFP16(const void *src, void *dst, int w_stride, int h_s
                                   h_stride, ey);
 }
 
+// G = [2  0  0]
+//     [1  1  1]
+//     [1 -1  1]
+//     [0  0  2]
+// |G * g * GT| <= 9 * 128, the weights fit in int16
+void WeightTransform4x4Int8(const int8_t *src, int16_t *dst, int in_channel, int out_channel) {
+    const int ic_r4       = ROUND_UP(in_channel, 4);
+    const int oc_r4       = ROUND_UP(out_channel, 4);
+    const int unit_stride = oc_r4 * ic_r4;
+    memset(dst, 0, 16 * unit_stride * sizeof(int16_t));
+
+    for (int oc = 0; oc < out_channel; oc++) {
+        int16_t *dst_oz = dst + (oc / 4) * ic_r4 * 4 + oc % 4;
+        for (int ic = 0; ic < in_channel; ic++) {
+            const int8_t *g = src + (oc * in_channel + ic) * 9;
+            int16_t M[4][3];
+            for (int k = 0; k < 3; k++) {
+                M[0][k] = 2 * g[k];
+                M[1][k] = g[k] + g[3 + k] + g[6 + k];
+                M[2][k] = g[k] - g[3 + k] + g[6 + k];
+                M[3][k] = 2 * g[6 + k];
+            }
+            int16_t *dst_iz = dst_oz + ic * 4;
+            for (int i = 0; i < 4; i++) {
+                dst_iz[(i * 4 + 0) * unit_stride] = 2 * M[i][0];
+                dst_iz[(i * 4 + 1) * unit_stride] = M[i][0] + M[i][1] + M[i][2];
+                dst_iz[(i * 4 + 2) * unit_stride] = M[i][0] - M[i][1] + M[i][2];
+                dst_iz[(i * 4 + 3) * unit_stride] = 2 * M[i][2];
+            }
+        }
+    }
+}
+
+// B = [1  0  0  0]
+//     [0  1 -1  1]
+//     [-1 1  1  0]
+//     [0  0  0 -1]
+// |BT * d * B| <= 4 * 128, the transformed input fits in int16
+void SrcTransformInOne4x4Int8(const int8_t *src, int16_t *dst, int w_stride, int h_stride, int dst_stride) {
+    int16_t vec_src[4][4][4];
+    int16_t vec_mid[4][4][4];
+
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            const int8_t *src_ij = src + i * h_stride + j * w_stride;
+            for (int c = 0; c < 4; c++) {
+                vec_src[i][j][c] = src_ij[c];
+            }
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        for (int c = 0; c < 4; c++) {
+            vec_mid[0][i][c] = vec_src[i][0][c] - vec_src[i][2][c];
+            vec_mid[1][i][c] = vec_src[i][1][c] + vec_src[i][2][c];
+            vec_mid[2][i][c] = vec_src[i][2][c] - vec_src[i][1][c];
+            vec_mid[3][i][c] = vec_src[i][1][c] - vec_src[i][3][c];
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        int16_t *dst_0 = dst + (0 * 4 + i) * dst_stride;
+        int16_t *dst_1 = dst + (1 * 4 + i) * dst_stride;
+        int16_t *dst_2 = dst + (2 * 4 + i) * dst_stride;
+        int16_t *dst_3 = dst + (3 * 4 + i) * dst_stride;
+        for (int c = 0; c < 4; c++) {
+            dst_0[c] = vec_mid[i][0][c] - vec_mid[i][2][c];
+            dst_1[c] = vec_mid[i][1][c] + vec_mid[i][2][c];
+            dst_2[c] = vec_mid[i][2][c] - vec_mid[i][1][c];
+            dst_3[c] = vec_mid[i][1][c] - vec_mid[i][3][c];
+        }
+    }
+}
+
+// A = [1  0]
+//     [1  1]
+//     [1 -1]
+//     [0 -1]
+// the sums are 4 times the exact ones because of the scaled G, the division is exact.
+// An output sums 9 positions of up to 512 * 1152 * ic each, which overflows int32 from about 400 input channels,
+// so the transform runs in int64.
+void DstTransformInOne4x2Int8(const int32_t *src, int8_t *dst, int src_stride, int w_stride, int h_stride, int ey,
+                              int ex, const int32_t *bias, const float *scale) {
+    int64_t vec_mid[4][2][4];
+
+    for (int i = 0; i < 4; i++) {
+        const int32_t *src_0 = src + (0 * 4 + i) * src_stride;
+        const int32_t *src_1 = src + (1 * 4 + i) * src_stride;
+        const int32_t *src_2 = src + (2 * 4 + i) * src_stride;
+        const int32_t *src_3 = src + (3 * 4 + i) * src_stride;
+        for (int c = 0; c < 4; c++) {
+            vec_mid[i][0][c] = (int64_t)src_0[c] + src_1[c] + src_2[c];
+            vec_mid[i][1][c] = (int64_t)src_1[c] - src_2[c] - src_3[c];
+        }
+    }
+
+    for (int i = 0; i < ey; i++) {
+        for (int j = 0; j < ex; j++) {
+            int8_t *dst_ij = dst + i * h_stride + j * w_stride;
+            for (int c = 0; c < 4; c++) {
+                int64_t sum = j == 0 ? vec_mid[0][i][c] + vec_mid[1][i][c] + vec_mid[2][i][c]
+                                     : vec_mid[1][i][c] - vec_mid[2][i][c] - vec_mid[3][i][c];
+                dst_ij[c]   = float2int8(static_cast<float>(sum / 4 + bias[c]) * scale[c]);
+            }
+        }
+    }
+}
+
 }  // namespace TNN_NS
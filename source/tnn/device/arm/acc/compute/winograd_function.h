@@ -45,6 +45,16 @@ void DstTransformInOne4x2BFP16(const void *src, void *dst, int w_stride, int h_s
 void SrcTransformInOne6x6BFP16(const void *src, void *dst, int w_stride, int h_stride);
 void DstTransformInOne6x4BFP16(const void *src, void *dst, int w_stride, int h_stride, int ey);
 
+// int8 F(2x2, 3x3) with G scaled by 2 to stay integer, the transformed weights are 4 times the exact ones
+// dst: [16][oc/4][ic_r4][4] int16, zero padded
+void WeightTransform4x4Int8(const int8_t *src, int16_t *dst, int in_channel, int out_channel);
+// 4 channels of a 4x4 window to 16 positions of int16, position k is stored at dst + k * dst_stride
+void SrcTransformInOne4x4Int8(const int8_t *src, int16_t *dst, int w_stride, int h_stride, int dst_stride);
+// 4 channels of 16 int32 positions to the ey x ex int8 output, the sums are computed in int64, divided by 4
+// then requantized
+void DstTransformInOne4x2Int8(const int32_t *src, int8_t *dst, int src_stride, int w_stride, int h_stride, int ey,
+                              int ex, const int32_t *bias, const float *scale);
+
 }  // namespace TNN_NS
 
 #endif /* WinogradOptFunction_hpp */
@@ -0,0 +1,113 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_1x1.h"
+
+#include "tnn/device/arm/arm_common.h"
+#include "tnn/device/arm/arm_context.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+bool ArmConvInt8Layer1x1::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                     const std::vector<Blob *> &outputs) {
+    if (!param) {
+        return false;
+    }
+    if (inputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8) {
+        return false;
+    }
+
+    return param->group == 1 && param->kernels[0] == 1 && param->kernels[1] == 1 && param->pads[0] == 0 &&
+           param->pads[1] == 0 && param->pads[2] == 0 && param->pads[3] == 0;
+}
+
+ArmConvInt8Layer1x1::~ArmConvInt8Layer1x1() {}
+
+/*
+each pixel of the nhwc4 input is a row of the gemm input, the rows of a tile are read in place
+when they are contiguous and 8 aligned, otherwise they are copied to the zero padded pack buffer
+*/
+Status ArmConvInt8Layer1x1::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    auto input  = inputs[0];
+    auto output = outputs[0];
+
+    auto dims_input  = input->GetBlobDesc().dims;
+    auto dims_output = output->GetBlobDesc().dims;
+    const int batch    = dims_output[0];
+    const int ic       = dims_input[1];
+    const int ic_r4    = k_param_->ic_r4;
+    const int ic_calc  = ic < 4 ? ic : ic_r4;
+    const int stride_x = conv_param->strides[0];
+    const int stride_y = conv_param->strides[1];
+
+    int8_t *input_data  = reinterpret_cast<int8_t *>(GetBlobHandlePtr(input->GetHandle()));
+    int8_t *output_data = reinterpret_cast<int8_t *>(GetBlobHandlePtr(output->GetHandle()));
+
+    const int crs_div8       = UP_DIV(ic_calc, 8);
+    const int crs_r8         = crs_div8 * 8;
+    const bool read_in_place = stride_x == 1 && stride_y == 1 && ic_calc == crs_r8;
+    const int tile_count     = UP_DIV(k_param_->oh * k_param_->ow, NEON_INT8CONV_TILE_HW);
+    for (int n = 0; n < batch; ++n) {
+        const auto input_batch = input_data + n * k_param_->iw * k_param_->ih * ic_r4;
+        auto output_batch      = output_data + n * k_param_->ow * k_param_->oh * k_param_->oc_r4;
+
+        OMP_PARALLEL_FOR_GUIDED_
+        for (int t_idx = 0; t_idx < tile_count; t_idx++) {
+            int thread_id          = OMP_TID_;
+            const int hw_start     = t_idx * NEON_INT8CONV_TILE_HW;
+            const int real_hw_tile = MIN(k_param_->oh * k_param_->ow - hw_start, NEON_INT8CONV_TILE_HW);
+            auto gemm_work_space   = buffer_gemm_work_space_.force_to<int8_t *>();
+
+            const int8_t *input_kernel = nullptr;
+            if (read_in_place && real_hw_tile == NEON_INT8CONV_TILE_HW) {
+                input_kernel = input_batch + hw_start * ic_r4;
+            } else {
+                // the columns beyond ic_calc stay zero since the buffer is allocated
+                auto pack_kernel = buffer_im2col_.force_to<int8_t *>() + crs_r8 * NEON_INT8CONV_TILE_HW * thread_id;
+                for (int i = 0; i < real_hw_tile; ++i) {
+                    const int ox = (hw_start + i) % k_param_->ow;
+                    const int oy = (hw_start + i) / k_param_->ow;
+                    memcpy(pack_kernel + i * crs_r8,
+                           input_batch + (oy * stride_y * k_param_->iw + ox * stride_x) * ic_r4, ic_calc);
+                }
+                input_kernel = pack_kernel;
+            }
+            auto output_kernel = output_batch + hw_start * k_param_->oc_r4;
+            // gemm int8
+            if (real_hw_tile == NEON_INT8CONV_TILE_HW) {
+                GemmInt8(output_kernel, input_kernel, gemm_work_space, reinterpret_cast<int8_t *>(k_param_->fil_ptr),
+                         reinterpret_cast<int32_t *>(k_param_->bias), k_param_->scale, crs_div8, crs_r8,
+                         k_param_->oc_r4);
+            } else {
+                int8_t *outptr_tmp =
+                    buffer_tmpout_.force_to<int8_t *>() + k_param_->oc_r4 * NEON_INT8CONV_TILE_HW * thread_id;
+                GemmInt8(outptr_tmp, input_kernel, gemm_work_space, reinterpret_cast<int8_t *>(k_param_->fil_ptr),
+                         reinterpret_cast<int32_t *>(k_param_->bias), k_param_->scale, crs_div8, crs_r8,
+                         k_param_->oc_r4);
+                memcpy(output_kernel, outptr_tmp, real_hw_tile * k_param_->oc_r4);
+            }
+        }
+        // only support relu activation
+        if (conv_param->activation_type == ActivationType_ReLU) {
+            ReluInt8(output_batch, output_batch, k_param_->ow * k_param_->oh * k_param_->oc_r4);
+        }
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -262,28 +262,27 @@ Status ArmConvInt8LayerCommon::Init(Context *context, LayerParam *param, LayerRe
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
     CHECK_PARAM_NULL(conv_param);
 
+    // convs 1x1 without pads run ArmConvInt8Layer1x1
     auto dims_input = inputs[0]->GetBlobDesc().dims;
-    int kernel_x    = conv_param->kernels[0];
-    int kernel_y    = conv_param->kernels[1];
-    int stride_x    = conv_param->strides[0];
-    int stride_y    = conv_param->strides[1];
-    int pad_x       = conv_param->pads[0];
-    int pad_y       = conv_param->pads[2];
-
-    // fast mode
-    bool no_im2col = kernel_x == 1 && kernel_y == 1 && k_param_->ic_r4 % 8 == 0 && stride_x == 1 && stride_y == 1 &&
-                     pad_x == 0 && pad_y == 0 && dims_input[2] * dims_input[3] % 4 == 0;
-    if (!no_im2col) {
-        im_col_func_ = im2col;
-        if (dims_input[1] == 1)
-            im_col_func_ = im2col_smallc<1>;
-        else if (dims_input[1] == 2)
-            im_col_func_ = im2col_smallc<2>;
-        else if (dims_input[1] == 3)
-            im_col_func_ = im2col_smallc<3>;
-    } else {
-        im_col_func_ = nullptr;
-    }
+    im_col_func_    = im2col;
+    if (dims_input[1] == 1)
+        im_col_func_ = im2col_smallc<1>;
+    else if (dims_input[1] == 2)
+        im_col_func_ = im2col_smallc<2>;
+    else if (dims_input[1] == 3)
+        im_col_func_ = im2col_smallc<3>;
+    return TNN_OK;
+}
+
+/*
+im2col and gemm work space buffers are written in forward, only weights are shared
+*/
+Status ArmConvInt8LayerCommon::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto conv_acc = dynamic_cast<ArmConvInt8LayerCommon *>(acc);
+    CHECK_PARAM_NULL(conv_acc);
+    buffer_weight_ = conv_acc->buffer_weight_;
+    buffer_bias_   = conv_acc->buffer_bias_;
+    buffer_scale_  = conv_acc->buffer_scale_;
     return TNN_OK;
 }
 
@@ -314,17 +313,13 @@ Status ArmConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
         OMP_PARALLEL_FOR_GUIDED_
         for (int t_idx = 0; t_idx < tile_count; t_idx++) {
             int thread_id          = OMP_TID_;
-            int8_t *input_kernel   = nullptr;
             const int hw_start     = t_idx * NEON_INT8CONV_TILE_HW;
             const int real_hw_tile = MIN(k_param_->oh * k_param_->ow - hw_start, NEON_INT8CONV_TILE_HW);
             auto gemm_work_space   = buffer_gemm_work_space_.force_to<int8_t *>();
             // im2col
-            if (im_col_func_) {
-                input_kernel = buffer_im2col_.force_to<int8_t *>() + crs_div8 * NEON_INT8CONV_TILE_HW * 8 * thread_id;
-                im_col_func_(input_kernel, input_batch, conv_param, hw_start, real_hw_tile, crs_div8, k_param_.get());
-            } else {
-                input_kernel = input_batch + hw_start * ic_calc;
-            }
+            int8_t *input_kernel =
+                buffer_im2col_.force_to<int8_t *>() + crs_div8 * NEON_INT8CONV_TILE_HW * 8 * thread_id;
+            im_col_func_(input_kernel, input_batch, conv_param, hw_start, real_hw_tile, crs_div8, k_param_.get());
             auto output_kernel = output_batch + hw_start * k_param_->oc_r4;
             // gemm int8
             if (real_hw_tile == NEON_INT8CONV_TILE_HW) {
@@ -30,6 +30,8 @@ public:
                 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
 
@@ -0,0 +1,194 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_winograd.h"
+
+#include "tnn/device/arm/acc/compute/winograd_function.h"
+#include "tnn/device/arm/arm_common.h"
+#include "tnn/device/arm/arm_context.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// tiles transformed together, the gemm of each winograd position reuses its weights over them
+static const int kWinogradInt8Tile = 8;
+
+bool ArmConvInt8LayerWinograd::isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
+                                          const std::vector<Blob *> &outputs) {
+    if (!param) {
+        return false;
+    }
+    if (inputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8) {
+        return false;
+    }
+    if (param->group != 1 || param->kernels[0] != 3 || param->kernels[1] != 3 || param->strides[0] != 1 ||
+        param->strides[1] != 1 || param->dialations[0] != 1 || param->dialations[1] != 1) {
+        return false;
+    }
+
+    // the transforms do not pay off with few channels
+    // |transformed input * transformed weight| <= 512 * 1152, the int32 sums of the gemms hold about 3600 input
+    // channels, the output transform sums 9 of them in int64
+    const int ic = inputs[0]->GetBlobDesc().dims[1];
+    const int oc = outputs[0]->GetBlobDesc().dims[1];
+    return ic >= 8 && oc >= 8 && ROUND_UP(ic, 4) <= 2048;
+}
+
+ArmConvInt8LayerWinograd::~ArmConvInt8LayerWinograd() {}
+
+Status ArmConvInt8LayerWinograd::allocateBufferWeight(const std::vector<Blob *> &inputs,
+                                                      const std::vector<Blob *> &outputs) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (!buffer_weight_.GetBytesSize()) {
+        const int ic    = inputs[0]->GetBlobDesc().dims[1];
+        const int oc    = outputs[0]->GetBlobDesc().dims[1];
+        const int ic_r4 = ROUND_UP(ic, 4);
+        const int oc_r4 = ROUND_UP(oc, 4);
+
+        RawBuffer temp_buffer(16 * oc_r4 * ic_r4 * sizeof(int16_t));
+        WeightTransform4x4Int8(conv_res->filter_handle.force_to<int8_t *>(), temp_buffer.force_to<int16_t *>(), ic,
+                               oc);
+        buffer_weight_ = temp_buffer;
+    }
+    return TNN_OK;
+}
+
+Status ArmConvInt8LayerWinograd::allocateBufferParam(const std::vector<Blob *> &inputs,
+                                                     const std::vector<Blob *> &outputs) {
+    const int ic_r4     = ROUND_UP(inputs[0]->GetBlobDesc().dims[1], 4);
+    const int oc_r4     = ROUND_UP(outputs[0]->GetBlobDesc().dims[1], 4);
+    int max_num_threads = OMP_CORES_;
+
+    // per thread buffers of the transformed input and output of kWinogradInt8Tile tiles
+    if (!buffer_src_trans_.GetBytesSize()) {
+        buffer_src_trans_ = RawBuffer(16 * kWinogradInt8Tile * ic_r4 * sizeof(int16_t) * max_num_threads);
+    }
+    if (!buffer_dst_trans_.GetBytesSize()) {
+        buffer_dst_trans_ = RawBuffer(16 * kWinogradInt8Tile * oc_r4 * sizeof(int32_t) * max_num_threads);
+    }
+    // the zero padded 4x4 window of a tile at the border
+    if (!buffer_window_.GetBytesSize()) {
+        buffer_window_ = RawBuffer(16 * ic_r4 * max_num_threads);
+    }
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    return TNN_OK;
+}
+
+Status ArmConvInt8LayerWinograd::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferScale(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferParam(inputs, outputs), TNN_OK);
+
+    k_param_->scale   = buffer_scale_.force_to<float *>();
+    k_param_->bias    = buffer_bias_.force_to<void *>();
+    k_param_->fil_ptr = buffer_weight_.force_to<void *>();
+    return TNN_OK;
+}
+
+/*
+each block of tiles: src transform -> 16 int16 gemms, one per winograd position -> dst transform and requantize
+*/
+Status ArmConvInt8LayerWinograd::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    auto input  = inputs[0];
+    auto output = outputs[0];
+
+    const int batch = output->GetBlobDesc().dims[0];
+    const int ic_r4 = k_param_->ic_r4;
+    const int oc_r4 = k_param_->oc_r4;
+    const int ih    = k_param_->ih;
+    const int iw    = k_param_->iw;
+    const int oh    = k_param_->oh;
+    const int ow    = k_param_->ow;
+    const int pad_x = conv_param->pads[0];
+    const int pad_y = conv_param->pads[2];
+
+    const int tile_w      = UP_DIV(ow, 2);
+    const int tile_count  = UP_DIV(oh, 2) * tile_w;
+    const int block_count = UP_DIV(tile_count, kWinogradInt8Tile);
+    const int src_stride  = kWinogradInt8Tile * ic_r4;
+    const int dst_stride  = kWinogradInt8Tile * oc_r4;
+
+    int8_t *input_data    = reinterpret_cast<int8_t *>(GetBlobHandlePtr(input->GetHandle()));
+    int8_t *output_data   = reinterpret_cast<int8_t *>(GetBlobHandlePtr(output->GetHandle()));
+    const int16_t *weight = reinterpret_cast<int16_t *>(k_param_->fil_ptr);
+    const int32_t *bias   = reinterpret_cast<int32_t *>(k_param_->bias);
+    const float *scale    = k_param_->scale;
+    for (int n = 0; n < batch; ++n) {
+        const auto input_batch = input_data + n * iw * ih * ic_r4;
+        auto output_batch      = output_data + n * ow * oh * oc_r4;
+
+        OMP_PARALLEL_FOR_GUIDED_
+        for (int b_idx = 0; b_idx < block_count; b_idx++) {
+            int thread_id     = OMP_TID_;
+            auto src_trans    = buffer_src_trans_.force_to<int16_t *>() + 16 * src_stride * thread_id;
+            auto dst_trans    = buffer_dst_trans_.force_to<int32_t *>() + 16 * dst_stride * thread_id;
+            auto window       = buffer_window_.force_to<int8_t *>() + 16 * ic_r4 * thread_id;
+            const int t_start = b_idx * kWinogradInt8Tile;
+            const int t_count = MIN(tile_count - t_start, kWinogradInt8Tile);
+
+            for (int t = 0; t < t_count; ++t) {
+                const int sx = (t_start + t) % tile_w * 2 - pad_x;
+                const int sy = (t_start + t) / tile_w * 2 - pad_y;
+
+                const int8_t *src_tile = input_batch + (sy * iw + sx) * ic_r4;
+                int h_stride           = iw * ic_r4;
+                if (sx < 0 || sy < 0 || sx + 4 > iw || sy + 4 > ih) {
+                    memset(window, 0, 16 * ic_r4);
+                    for (int y = MAX(0, -sy); y < MIN(4, ih - sy); ++y) {
+                        for (int x = MAX(0, -sx); x < MIN(4, iw - sx); ++x) {
+                            memcpy(window + (y * 4 + x) * ic_r4, input_batch + ((sy + y) * iw + sx + x) * ic_r4,
+                                   ic_r4);
+                        }
+                    }
+                    src_tile = window;
+                    h_stride = 4 * ic_r4;
+                }
+                for (int c = 0; c < ic_r4; c += 4) {
+                    SrcTransformInOne4x4Int8(src_tile + c, src_trans + t * ic_r4 + c, ic_r4, h_stride, src_stride);
+                }
+            }
+
+            for (int k = 0; k < 16; ++k) {
+                GemmInt16(dst_trans + k * dst_stride, src_trans + k * src_stride, weight + k * oc_r4 * ic_r4,
+                          t_count, ic_r4, oc_r4);
+            }
+
+            for (int t = 0; t < t_count; ++t) {
+                const int ox  = (t_start + t) % tile_w * 2;
+                const int oy  = (t_start + t) / tile_w * 2;
+                const int ex  = MIN(2, ow - ox);
+                const int ey  = MIN(2, oh - oy);
+                auto dst_tile = output_batch + (oy * ow + ox) * oc_r4;
+                for (int c = 0; c < oc_r4; c += 4) {
+                    DstTransformInOne4x2Int8(dst_trans + t * oc_r4 + c, dst_tile + c, dst_stride, oc_r4, ow * oc_r4,
+                                             ey, ex, bias + c, scale + c);
+                }
+            }
+        }
+        // only support relu activation
+        if (conv_param->activation_type == ActivationType_ReLU) {
+            ReluInt8(output_batch, output_batch, ow * oh * oc_r4);
+        }
+    }
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -325,6 +325,17 @@ Status ArmConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
     return TNN_OK;
 }
 
+/*
+the winograd unit the shared weights are transformed with is kept, as packing is skipped
+*/
+Status ArmConvLayer3x3::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto conv_acc = dynamic_cast<ArmConvLayer3x3 *>(acc);
+    CHECK_PARAM_NULL(conv_acc);
+    src_unit_ = conv_acc->src_unit_;
+    dst_unit_ = conv_acc->dst_unit_;
+    return ArmConvLayerCommon::ShareWeightsFrom(acc);
+}
+
 Status ArmConvLayer3x3::Init(Context *context, LayerParam *param, LayerResource *resource,
                              const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     RETURN_ON_NEQ(ArmConvLayerCommon::Init(context, param, resource, inputs, outputs), TNN_OK);
@@ -30,6 +30,8 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
     template <typename T>
     Status Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
@@ -15,9 +15,12 @@
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_acc.h"
 
 #include <memory>
+#include <typeinfo>
 
+#include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_1x1.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_common.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_depthwise.h"
+#include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_winograd.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_1x1.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_3x3.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_c3.h"
@@ -26,6 +29,8 @@
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_depthwise_s1.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_group.h"
 #include "tnn/interpreter/raw_buffer.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
@@ -41,18 +46,12 @@ static std::shared_ptr<LayerResource> CreateFp32ConvResource(ConvLayerResource *
 
 Status ArmConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                              const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    Status ret;
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param);
     CHECK_PARAM_NULL(conv_param);
     ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource);
     CHECK_PARAM_NULL(conv_res);
 
-    if (conv_res->filter_handle.GetDataType() == DATA_TYPE_HALF) {
-        conv_acc_f32_resource_ = CreateFp32ConvResource(conv_res);
-        ret                    = ArmLayerAcc::Init(context, param, conv_acc_f32_resource_.get(), inputs, outputs);
-    } else {
-        ret = ArmLayerAcc::Init(context, param, resource, inputs, outputs);
-    }
+    Status ret = ArmLayerAcc::Init(context, param, resource, inputs, outputs);
     if (ret != TNN_OK)
         return ret;
 
@@ -70,11 +69,42 @@ Status ArmConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     if (!conv_acc_impl_) {
         return Status(TNNERR_NET_ERR, "Could not create conv impl_");
     }
+    return TNN_OK;
+}
+
+/*
+weights are converted and packed by the impl, impl init is independent of other layers
+*/
+Status ArmConvLayerAcc::InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerResource *conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (conv_res->filter_handle.GetDataType() == DATA_TYPE_HALF) {
+        if (shared_acc_ && shared_acc_->conv_acc_f32_resource_) {
+            conv_acc_f32_resource_ = shared_acc_->conv_acc_f32_resource_;
+        } else {
+            conv_acc_f32_resource_ = CreateFp32ConvResource(conv_res);
+        }
+        resource_ = conv_acc_f32_resource_.get();
+    }
+
+    // the same impl is selected for the same param and input shape, reuse its packed weights
+    auto shared_impl = shared_acc_ ? shared_acc_->conv_acc_impl_.get() : nullptr;
+    shared_acc_      = nullptr;
+    if (shared_impl && typeid(*shared_impl) == typeid(*conv_acc_impl_)) {
+        RETURN_ON_NEQ(conv_acc_impl_->ShareWeightsFrom(shared_impl), TNN_OK);
+    }
     return conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
 }
 
 ArmConvLayerAcc::~ArmConvLayerAcc() {}
 
+Status ArmConvLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    shared_acc_ = dynamic_cast<ArmConvLayerAcc *>(acc);
+    CHECK_PARAM_NULL(shared_acc_);
+    return TNN_OK;
+}
+
 /*
 get different impl based on conv params
 ArmConvInt8LayerCommon always as the last solution
@@ -84,6 +114,14 @@ void ArmConvLayerAcc::GetImpInt8(const std::vector<Blob *> &inputs, const std::v
         if (!dynamic_cast<ArmConvInt8LayerDepthwise *>(conv_acc_impl_.get())) {
             conv_acc_impl_ = std::make_shared<ArmConvInt8LayerDepthwise>();
         }
+    } else if (ArmConvInt8LayerWinograd::isPrefered(dynamic_cast<ConvLayerParam *>(param_), inputs, outputs)) {
+        if (!dynamic_cast<ArmConvInt8LayerWinograd *>(conv_acc_impl_.get())) {
+            conv_acc_impl_ = std::make_shared<ArmConvInt8LayerWinograd>();
+        }
+    } else if (ArmConvInt8Layer1x1::isPrefered(dynamic_cast<ConvLayerParam *>(param_), inputs, outputs)) {
+        if (!dynamic_cast<ArmConvInt8Layer1x1 *>(conv_acc_impl_.get())) {
+            conv_acc_impl_ = std::make_shared<ArmConvInt8Layer1x1>();
+        }
     } else if (ArmConvInt8LayerCommon::isPrefered(dynamic_cast<ConvLayerParam *>(param_), inputs, outputs)) {
         if (!dynamic_cast<ArmConvInt8LayerCommon *>(conv_acc_impl_.get())) {
             conv_acc_impl_ = std::make_shared<ArmConvInt8LayerCommon>();
@@ -124,6 +162,7 @@ void ArmConvLayerAcc::GetImpFP(const std::vector<Blob *> &inputs, const std::vec
 }
 
 Status ArmConvLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    UpdateMaxNumThreads(inputs, outputs);
     return conv_acc_impl_->Reshape(inputs, outputs);
 }
 
@@ -135,6 +174,26 @@ Status ArmConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     }
 }
 
+double ArmConvLayerAcc::GetFlops() {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    if (!conv_param || input_dims_.size() < 2) {
+        return ArmLayerAcc::GetFlops();
+    }
+    double ic_per_group = input_dims_[1] / conv_param->group;
+    return 2.0 * DimsVectorUtils::Count(output_dims_) * ic_per_group * conv_param->kernels[0] *
+           conv_param->kernels[1] / 1000.0 / 1000.0;
+}
+
+double ArmConvLayerAcc::GetBandwidth() {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    if (!conv_param || input_dims_.size() < 2 || output_dims_.size() < 2) {
+        return ArmLayerAcc::GetBandwidth();
+    }
+    double weight_count = 1.0 * output_dims_[1] * input_dims_[1] / conv_param->group * conv_param->kernels[0] *
+                          conv_param->kernels[1];
+    return ArmLayerAcc::GetBandwidth() + weight_count * DataTypeUtils::GetBytesSize(data_type_) / 1000.0 / 1000.0;
+}
+
 REGISTER_ARM_ACC(Conv, LAYER_CONVOLUTION)
 
 }  // namespace TNN_NS
@@ -32,6 +32,14 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual Status InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
+    virtual double GetFlops() override;
+
+    virtual double GetBandwidth() override;
+
 private:
     void GetImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
@@ -40,6 +48,8 @@ private:
 protected:
     std::shared_ptr<ArmLayerAcc> conv_acc_impl_           = nullptr;
     std::shared_ptr<LayerResource> conv_acc_f32_resource_ = nullptr;
+    // conv acc of another instance to share weights with, only valid until InitWeights
+    ArmConvLayerAcc *shared_acc_ = nullptr;
 };
 
 }  // namespace TNN_NS
@@ -105,6 +105,18 @@ Status ArmConvLayerCommon::allocateBufferBias(const std::vector<Blob *> &inputs,
     return TNN_OK;
 }
 
+/*
+weights packed by the same impl of another instance are reused,
+Init skips packing when buffer_weight_ and buffer_bias_ are not empty
+*/
+Status ArmConvLayerCommon::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto conv_acc = dynamic_cast<ArmConvLayerCommon *>(acc);
+    CHECK_PARAM_NULL(conv_acc);
+    buffer_weight_ = conv_acc->buffer_weight_;
+    buffer_bias_   = conv_acc->buffer_bias_;
+    return TNN_OK;
+}
+
 Status ArmConvLayerCommon::Init(Context *context, LayerParam *param, LayerResource *resource,
                                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     RETURN_ON_NEQ(ArmLayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
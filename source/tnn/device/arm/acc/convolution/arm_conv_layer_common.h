@@ -29,6 +29,8 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
     // always true as last solution
     static bool isPrefered(ConvLayerParam *param, const std::vector<Blob *> &inputs,
                            const std::vector<Blob *> &outputs);
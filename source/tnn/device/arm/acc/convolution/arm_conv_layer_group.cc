@@ -16,7 +16,9 @@
 
 #include <memory>
 
+#include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_1x1.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_common.h"
+#include "tnn/device/arm/acc/convolution/arm_conv_int8_layer_winograd.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_1x1.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_3x3.h"
 #include "tnn/device/arm/acc/convolution/arm_conv_layer_common.h"
@@ -110,7 +112,16 @@ ArmConvInt8LayerCommon always as the last solution
 */
 void ArmConvLayerGroup::CreateImpInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs,
                                       LayerParam *param, std::shared_ptr<ArmLayerAcc> &conv_acc_impl) {
-    if (!dynamic_cast<ArmConvInt8LayerCommon *>(conv_acc_impl.get())) {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param);
+    if (ArmConvInt8LayerWinograd::isPrefered(conv_param, inputs, outputs)) {
+        if (!dynamic_cast<ArmConvInt8LayerWinograd *>(conv_acc_impl.get())) {
+            conv_acc_impl = std::make_shared<ArmConvInt8LayerWinograd>();
+        }
+    } else if (ArmConvInt8Layer1x1::isPrefered(conv_param, inputs, outputs)) {
+        if (!dynamic_cast<ArmConvInt8Layer1x1 *>(conv_acc_impl.get())) {
+            conv_acc_impl = std::make_shared<ArmConvInt8Layer1x1>();
+        }
+    } else if (!dynamic_cast<ArmConvInt8LayerCommon *>(conv_acc_impl.get())) {
         conv_acc_impl = std::make_shared<ArmConvInt8LayerCommon>();
     }
 }
@@ -18,10 +18,14 @@
 #include "tnn/device/arm/acc/deconvolution/arm_deconv_layer_acc.h"
 
 #include <memory>
+#include <typeinfo>
+
 
 #include "tnn/device/arm/acc/deconvolution/arm_deconv_layer_stride.h"
 #include "tnn/device/arm/acc/deconvolution/arm_deconv_layer_common.h"
 #include "tnn/device/arm/acc/deconvolution/arm_deconv_layer_depthwise.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
 
@@ -37,20 +41,13 @@ static std::shared_ptr<LayerResource> CreateFp32DeconvResource(ConvLayerResource
 
 Status ArmDeconvLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    Status ret;
     ConvLayerParam *deconv_param = dynamic_cast<ConvLayerParam *>(param);
     CHECK_PARAM_NULL(deconv_param);
 
     ConvLayerResource *deconv_res = dynamic_cast<ConvLayerResource *>(resource);
     CHECK_PARAM_NULL(deconv_res);
 
-    if (deconv_res->filter_handle.GetDataType() == DATA_TYPE_HALF) {
-        deconv_acc_f32_resource_ = CreateFp32DeconvResource(deconv_res);
-        ret                      = ArmLayerAcc::Init(context, param, deconv_acc_f32_resource_.get(), inputs, outputs);
-    } else {
-        ret = ArmLayerAcc::Init(context, param, resource, inputs, outputs);
-    }
-
+    Status ret = ArmLayerAcc::Init(context, param, resource, inputs, outputs);
     if (ret != TNN_OK) {
         return ret;
     }
@@ -65,12 +62,42 @@ Status ArmDeconvLayerAcc::Init(Context *context, LayerParam *param, LayerResourc
     if (!deconv_acc_impl_) {
         return Status(TNNERR_NET_ERR, "Could not create conv impl_");
     }
+    return TNN_OK;
+}
 
+/*
+weights are converted and packed by the impl, impl init is independent of other layers
+*/
+Status ArmDeconvLayerAcc::InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerResource *deconv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(deconv_res);
+
+    if (deconv_res->filter_handle.GetDataType() == DATA_TYPE_HALF) {
+        if (shared_acc_ && shared_acc_->deconv_acc_f32_resource_) {
+            deconv_acc_f32_resource_ = shared_acc_->deconv_acc_f32_resource_;
+        } else {
+            deconv_acc_f32_resource_ = CreateFp32DeconvResource(deconv_res);
+        }
+        resource_ = deconv_acc_f32_resource_.get();
+    }
+
+    // the same impl is selected for the same param and input shape, reuse its packed weights
+    auto shared_impl = shared_acc_ ? shared_acc_->deconv_acc_impl_.get() : nullptr;
+    shared_acc_      = nullptr;
+    if (shared_impl && typeid(*shared_impl) == typeid(*deconv_acc_impl_)) {
+        RETURN_ON_NEQ(deconv_acc_impl_->ShareWeightsFrom(shared_impl), TNN_OK);
+    }
     return deconv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
 }
 
 ArmDeconvLayerAcc::~ArmDeconvLayerAcc() {}
 
+Status ArmDeconvLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    shared_acc_ = dynamic_cast<ArmDeconvLayerAcc *>(acc);
+    CHECK_PARAM_NULL(shared_acc_);
+    return TNN_OK;
+}
+
 void ArmDeconvLayerAcc::GetImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (ArmDeconvLayerDepthwise::isPrefered(dynamic_cast<ConvLayerParam *>(param_), inputs, outputs)) {
         if (!deconv_acc_impl_ || !dynamic_cast<ArmDeconvLayerDepthwise *>(deconv_acc_impl_.get())) {
@@ -88,6 +115,7 @@ void ArmDeconvLayerAcc::GetImpFP(const std::vector<Blob *> &inputs, const std::v
 }
 
 Status ArmDeconvLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    UpdateMaxNumThreads(inputs, outputs);
     return deconv_acc_impl_->Reshape(inputs, outputs);
 }
 
@@ -99,6 +127,26 @@ Status ArmDeconvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     }
 }
 
+double ArmDeconvLayerAcc::GetFlops() {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    if (!conv_param || output_dims_.size() < 2) {
+        return ArmLayerAcc::GetFlops();
+    }
+    double oc_per_group = output_dims_[1] / conv_param->group;
+    return 2.0 * DimsVectorUtils::Count(input_dims_) * oc_per_group * conv_param->kernels[0] *
+           conv_param->kernels[1] / 1000.0 / 1000.0;
+}
+
+double ArmDeconvLayerAcc::GetBandwidth() {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    if (!conv_param || input_dims_.size() < 2 || output_dims_.size() < 2) {
+        return ArmLayerAcc::GetBandwidth();
+    }
+    double weight_count = 1.0 * output_dims_[1] * input_dims_[1] / conv_param->group * conv_param->kernels[0] *
+                          conv_param->kernels[1];
+    return ArmLayerAcc::GetBandwidth() + weight_count * DataTypeUtils::GetBytesSize(data_type_) / 1000.0 / 1000.0;
+}
+
 REGISTER_ARM_ACC(Deconv, LAYER_DECONVOLUTION)
 
 }  // namespace TNN_NS
@@ -28,12 +28,22 @@ public:
     virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual Status InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
+    virtual double GetFlops() override;
+
+    virtual double GetBandwidth() override;
+
 private:
     void GetImpFP(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 protected:
     std::shared_ptr<ArmLayerAcc> deconv_acc_impl_           = nullptr;
     std::shared_ptr<LayerResource> deconv_acc_f32_resource_ = nullptr;
+    // deconv acc of another instance to share weights with, only valid until InitWeights
+    ArmDeconvLayerAcc *shared_acc_ = nullptr;
 };
 
 }  // namespace TNN_NS
@@ -15,6 +15,7 @@
 #include "tnn/device/arm/arm_context.h"
 #include "tnn/device/arm/arm_common.h"
 #include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/memory_tracker.h"
 #include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
@@ -28,7 +29,10 @@ Status ArmContext::GetCommandQueue(void** command_queue) {
 }
 
 Status ArmContext::OnInstanceForwardBegin() {
-    Context::OnInstanceForwardBegin();
+    Status ret = Context::OnInstanceForwardBegin();
+    if (ret != TNN_OK) {
+        return ret;
+    }
     OMP_SET_THREADS_(GetNumThreads());
     return TNN_OK;
 }
@@ -55,6 +59,8 @@ void* ArmContext::GetSharedWorkSpace(size_t size) {
 }
 
 void* ArmContext::GetSharedWorkSpace(size_t size, int index) {
+    // counted as workspace of the instance instead of the layer asking for it
+    MemoryTrackerScope memory_scope(MEMORY_TYPE_WORKSPACE);
     while(work_space_.size() < index + 1) {
         work_space_.push_back(RawBuffer(ROUND_UP(size, 64)));
     }
@@ -21,6 +21,7 @@
 #include "tnn/utils/blob_memory_size_utils.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/memory_tracker.h"
 
 namespace TNN_NS {
 
@@ -71,12 +72,14 @@ Status ArmDevice::Allocate(void **handle, BlobMemorySizeInfo &size_info) {
     if (handle) {
         int bytes_size = GetBlobMemoryBytesSize(size_info);
         *handle        = armMalloc(bytes_size + NEON_KERNEL_EXTRA_LOAD);
+        TrackDeviceMemory(*handle, bytes_size + NEON_KERNEL_EXTRA_LOAD);
     }
     return TNN_OK;
 }
 
 Status ArmDevice::Free(void *handle) {
     if (handle) {
+        UntrackDeviceMemory(handle);
         free(handle);
     }
     return TNN_OK;
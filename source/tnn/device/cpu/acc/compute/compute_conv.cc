@@ -0,0 +1,217 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/cpu/acc/compute/compute_conv.h"
+
+#include <algorithm>
+
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// dot of a kernel row inside the input row
+template <int KW>
+static inline float DotInner(const float *input, const float *weight) {
+    float sum = 0.0f;
+    for (int kw = 0; kw < KW; ++kw) {
+        sum += input[kw] * weight[kw];
+    }
+    return sum;
+}
+
+// dot of a kernel row starting at input column x, the columns out of the row are padding
+template <int KW>
+static inline float DotBorder(const float *input_row, const float *weight, int x, int width) {
+    float sum = 0.0f;
+    for (int kw = 0; kw < KW; ++kw) {
+        if (x + kw >= 0 && x + kw < width) {
+            sum += input_row[x + kw] * weight[kw];
+        }
+    }
+    return sum;
+}
+
+template <int KH, int KW, int SH, int SW>
+static void CpuConvSpecialized(const float *input, const float *weight, const float *bias, float *output,
+                               const DimsVector &dims_input, const DimsVector &dims_output, int pad_y, int pad_x,
+                               int group, int activation_type) {
+    const int batch          = dims_output[0];
+    const int output_channel = dims_output[1];
+    const int output_height  = dims_output[2];
+    const int output_width   = dims_output[3];
+    const int input_channel  = dims_input[1];
+    const int input_height   = dims_input[2];
+    const int input_width    = dims_input[3];
+    const int oc_per_group   = output_channel / group;
+    const int ic_per_group   = input_channel / group;
+    const int output_size    = output_height * output_width;
+
+    // output columns whose kernel row lies inside the input row
+    const int last_inner  = input_width + pad_x - KW;
+    const int inner_begin = std::min((pad_x + SW - 1) / SW, output_width);
+    int inner_end         = inner_begin;
+    if (last_inner >= 0) {
+        inner_end = std::max(inner_begin, std::min(output_width, last_inner / SW + 1));
+    }
+
+    OMP_PARALLEL_FOR_
+    for (int index = 0; index < batch * output_channel; ++index) {
+        const int n              = index / output_channel;
+        const int oc             = index % output_channel;
+        const float *input_group = input + (n * input_channel + oc / oc_per_group * ic_per_group) * input_height *
+                                               input_width;
+        const float *weight_oc   = weight + oc * ic_per_group * KH * KW;
+        float *output_oc         = output + index * output_size;
+        std::fill(output_oc, output_oc + output_size, bias ? bias[oc] : 0.0f);
+
+        for (int ic = 0; ic < ic_per_group; ++ic) {
+            const float *input_ic  = input_group + ic * input_height * input_width;
+            const float *weight_ic = weight_oc + ic * KH * KW;
+            for (int y = 0; y < output_height; ++y) {
+                float *output_row = output_oc + y * output_width;
+                for (int kh = 0; kh < KH; ++kh) {
+                    const int input_y = y * SH - pad_y + kh;
+                    if (input_y < 0 || input_y >= input_height) {
+                        continue;
+                    }
+                    const float *input_row = input_ic + input_y * input_width;
+                    const float *weight_kh = weight_ic + kh * KW;
+                    for (int x = 0; x < inner_begin; ++x) {
+                        output_row[x] += DotBorder<KW>(input_row, weight_kh, x * SW - pad_x, input_width);
+                    }
+                    for (int x = inner_begin; x < inner_end; ++x) {
+                        output_row[x] += DotInner<KW>(input_row + x * SW - pad_x, weight_kh);
+                    }
+                    for (int x = inner_end; x < output_width; ++x) {
+                        output_row[x] += DotBorder<KW>(input_row, weight_kh, x * SW - pad_x, input_width);
+                    }
+                }
+            }
+        }
+
+        if (activation_type == ActivationType_ReLU) {
+            for (int i = 0; i < output_size; ++i) {
+                output_oc[i] = std::max(output_oc[i], 0.0f);
+            }
+        } else if (activation_type == ActivationType_ReLU6) {
+            for (int i = 0; i < output_size; ++i) {
+                output_oc[i] = std::min(std::max(output_oc[i], 0.0f), 6.0f);
+            }
+        }
+    }
+}
+
+struct SpecializedConv {
+    int kernel_y;
+    int kernel_x;
+    int stride_y;
+    int stride_x;
+    CpuConvFunc func;
+};
+
+#define SPECIALIZED_CONV(kh, kw, sh, sw) {kh, kw, sh, sw, CpuConvSpecialized<kh, kw, sh, sw>}
+
+static const SpecializedConv kSpecializedConvs[] = {
+    SPECIALIZED_CONV(1, 1, 1, 1), SPECIALIZED_CONV(1, 1, 2, 2), SPECIALIZED_CONV(2, 2, 2, 2),
+    SPECIALIZED_CONV(3, 3, 1, 1), SPECIALIZED_CONV(3, 3, 2, 2), SPECIALIZED_CONV(5, 5, 1, 1),
+    SPECIALIZED_CONV(5, 5, 2, 2), SPECIALIZED_CONV(7, 7, 1, 1), SPECIALIZED_CONV(7, 7, 2, 2),
+    SPECIALIZED_CONV(1, 3, 1, 1), SPECIALIZED_CONV(3, 1, 1, 1), SPECIALIZED_CONV(1, 7, 1, 1),
+    SPECIALIZED_CONV(7, 1, 1, 1),
+};
+
+#undef SPECIALIZED_CONV
+
+CpuConvFunc GetSpecializedConvFunc(int kernel_y, int kernel_x, int stride_y, int stride_x, int dilation_y,
+                                   int dilation_x) {
+    if (dilation_y != 1 || dilation_x != 1) {
+        return nullptr;
+    }
+    for (const auto &conv : kSpecializedConvs) {
+        if (conv.kernel_y == kernel_y && conv.kernel_x == kernel_x && conv.stride_y == stride_y &&
+            conv.stride_x == stride_x) {
+            return conv.func;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+void CpuIm2Col(const T *input, int channels, int height, int width, int kernel_y, int kernel_x, int pad_y, int pad_x,
+               int stride_y, int stride_x, int dilation_y, int dilation_x, int output_height, int output_width,
+               float *col) {
+    const int kernel_size = kernel_y * kernel_x;
+    const int output_size = output_height * output_width;
+    OMP_PARALLEL_FOR_
+    for (int row = 0; row < channels * kernel_size; ++row) {
+        const int c      = row / kernel_size;
+        const int ky     = row % kernel_size / kernel_x;
+        const int kx     = row % kernel_x;
+        const T *src     = input + c * height * width;
+        float *dst       = col + (size_t)row * output_size;
+        for (int y = 0; y < output_height; ++y) {
+            const int input_y = y * stride_y - pad_y + ky * dilation_y;
+            float *dst_row    = dst + y * output_width;
+            if (input_y < 0 || input_y >= height) {
+                std::fill(dst_row, dst_row + output_width, 0.0f);
+                continue;
+            }
+            const T *src_row = src + input_y * width;
+            for (int x = 0; x < output_width; ++x) {
+                const int input_x = x * stride_x - pad_x + kx * dilation_x;
+                dst_row[x]        = input_x >= 0 && input_x < width ? (float)src_row[input_x] : 0.0f;
+            }
+        }
+    }
+}
+
+template void CpuIm2Col(const float *input, int channels, int height, int width, int kernel_y, int kernel_x,
+                        int pad_y, int pad_x, int stride_y, int stride_x, int dilation_y, int dilation_x,
+                        int output_height, int output_width, float *col);
+template void CpuIm2Col(const bfp16_t *input, int channels, int height, int width, int kernel_y, int kernel_x,
+                        int pad_y, int pad_x, int stride_y, int stride_x, int dilation_y, int dilation_x,
+                        int output_height, int output_width, float *col);
+
+void CpuCol2Im(const float *col, int channels, int height, int width, int kernel_y, int kernel_x, int pad_y,
+               int pad_x, int stride_y, int stride_x, int dilation_y, int dilation_x, int col_height, int col_width,
+               float *output) {
+    const int kernel_size = kernel_y * kernel_x;
+    const int col_size    = col_height * col_width;
+    // a channel of the output only takes the rows of col of the channel
+    OMP_PARALLEL_FOR_
+    for (int c = 0; c < channels; ++c) {
+        float *dst = output + c * height * width;
+        for (int k = 0; k < kernel_size; ++k) {
+            const int ky     = k / kernel_x;
+            const int kx     = k % kernel_x;
+            const float *src = col + ((size_t)c * kernel_size + k) * col_size;
+            for (int y = 0; y < col_height; ++y) {
+                const int output_y = y * stride_y - pad_y + ky * dilation_y;
+                if (output_y < 0 || output_y >= height) {
+                    continue;
+                }
+                float *dst_row       = dst + output_y * width;
+                const float *src_row = src + y * col_width;
+                for (int x = 0; x < col_width; ++x) {
+                    const int output_x = x * stride_x - pad_x + kx * dilation_x;
+                    if (output_x >= 0 && output_x < width) {
+                        dst_row[output_x] += src_row[x];
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace TNN_NS
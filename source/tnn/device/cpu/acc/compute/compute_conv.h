@@ -0,0 +1,50 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_CPU_COMPUTE_CONV_H_
+#define TNN_CPU_COMPUTE_CONV_H_
+
+#include "tnn/core/common.h"
+#include "tnn/utils/bfp16.h"
+
+namespace TNN_NS {
+
+// @brief float conv of nchw blobs with the weights in oihw, bias is null if the conv has no bias
+typedef void (*CpuConvFunc)(const float *input, const float *weight, const float *bias, float *output,
+                            const DimsVector &dims_input, const DimsVector &dims_output, int pad_y, int pad_x,
+                            int group, int activation_type);
+
+// @brief float conv specialized for the kernel size and the stride, the
+// compiler unrolls the kernel loops and vectorizes the unit stride rows.
+// @return the specialized conv, null if the shape is not specialized or the conv is dilated
+CpuConvFunc GetSpecializedConvFunc(int kernel_y, int kernel_x, int stride_y, int stride_x, int dilation_y,
+                                   int dilation_x);
+
+// @brief unfold the windows of a conv over the input (channels x height x width) into the columns of col,
+// col is (channels * kernel_y * kernel_x) x (output_height * output_width), the padding is zero.
+// The input is float or bfp16_t, col is float.
+template <typename T>
+void CpuIm2Col(const T *input, int channels, int height, int width, int kernel_y, int kernel_x, int pad_y, int pad_x,
+               int stride_y, int stride_x, int dilation_y, int dilation_x, int output_height, int output_width,
+               float *col);
+
+// @brief accumulate the columns of col back to the windows they come from in output, the reverse of CpuIm2Col.
+// The deconv computes col from its input and folds it into the output this way.
+void CpuCol2Im(const float *col, int channels, int height, int width, int kernel_y, int kernel_x, int pad_y,
+               int pad_x, int stride_y, int stride_x, int dilation_y, int dilation_x, int col_height, int col_width,
+               float *output);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_CPU_COMPUTE_CONV_H_
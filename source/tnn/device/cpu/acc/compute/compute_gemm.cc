@@ -0,0 +1,486 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/cpu/acc/compute/compute_gemm.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/omp_utils.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TNN_CPU_SGEMM_X86
+#include <immintrin.h>
+#endif
+
+namespace TNN_NS {
+
+// rows of the largest micro kernel
+static const int kSgemmMaxKernelRows = 14;
+// a panel of packed B of this depth takes 16KB, it stays in L1 while the micro kernels walk the block of A
+static const int kSgemmBlockK = 256;
+// bytes of the packed block of A, it stays in L2
+static const int kSgemmBlockABytes = 128 * 1024;
+
+// @brief micro kernel computing a tile of rows x kSgemmPanelWidth floats from a micro panel of packed A
+// (k x rows) and a panel of packed B (k x kSgemmPanelWidth)
+typedef void (*SgemmKernelFunc)(int k, const float *a, const float *b, float *tile);
+
+struct SgemmKernel {
+    int rows;
+    SgemmKernelFunc func;
+};
+
+static void SgemmKernelGeneric(int k, const float *a, const float *b, float *tile) {
+    float acc[4][kSgemmPanelWidth] = {{0.0f}};
+    for (int p = 0; p < k; ++p) {
+        for (int r = 0; r < 4; ++r) {
+            const float a_r = a[r];
+            for (int j = 0; j < kSgemmPanelWidth; ++j) {
+                acc[r][j] += a_r * b[j];
+            }
+        }
+        a += 4;
+        b += kSgemmPanelWidth;
+    }
+    memcpy(tile, acc, sizeof(acc));
+}
+
+#ifdef TNN_CPU_SGEMM_X86
+
+// 6x16 tile in 12 ymm accumulators
+#define SGEMM_AVX2_ROW(r)                                                                                             \
+    {                                                                                                                 \
+        __m256 a_r = _mm256_broadcast_ss(a + r);                                                                      \
+        c##r##0    = _mm256_fmadd_ps(a_r, b0, c##r##0);                                                               \
+        c##r##1    = _mm256_fmadd_ps(a_r, b1, c##r##1);                                                               \
+    }
+
+#define SGEMM_AVX2_STORE(r)                                                                                           \
+    _mm256_storeu_ps(tile + r * kSgemmPanelWidth, c##r##0);                                                          \
+    _mm256_storeu_ps(tile + r * kSgemmPanelWidth + 8, c##r##1);
+
+__attribute__((target("avx2,fma"))) static void SgemmKernelAvx2(int k, const float *a, const float *b, float *tile) {
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+    for (int p = 0; p < k; ++p) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+        SGEMM_AVX2_ROW(0);
+        SGEMM_AVX2_ROW(1);
+        SGEMM_AVX2_ROW(2);
+        SGEMM_AVX2_ROW(3);
+        SGEMM_AVX2_ROW(4);
+        SGEMM_AVX2_ROW(5);
+        a += 6;
+        b += kSgemmPanelWidth;
+    }
+    SGEMM_AVX2_STORE(0);
+    SGEMM_AVX2_STORE(1);
+    SGEMM_AVX2_STORE(2);
+    SGEMM_AVX2_STORE(3);
+    SGEMM_AVX2_STORE(4);
+    SGEMM_AVX2_STORE(5);
+}
+
+#undef SGEMM_AVX2_ROW
+#undef SGEMM_AVX2_STORE
+
+// 14x16 tile in 14 zmm accumulators, the rows of A are broadcast from memory
+#define SGEMM_AVX512_ROW(r) c##r = _mm512_fmadd_ps(_mm512_set1_ps(a[r]), b0, c##r);
+
+__attribute__((target("avx512f"))) static void SgemmKernelAvx512(int k, const float *a, const float *b,
+                                                                 float *tile) {
+    __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps(), c2 = _mm512_setzero_ps();
+    __m512 c3 = _mm512_setzero_ps(), c4 = _mm512_setzero_ps(), c5 = _mm512_setzero_ps();
+    __m512 c6 = _mm512_setzero_ps(), c7 = _mm512_setzero_ps(), c8 = _mm512_setzero_ps();
+    __m512 c9 = _mm512_setzero_ps(), c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+    __m512 c12 = _mm512_setzero_ps(), c13 = _mm512_setzero_ps();
+    for (int p = 0; p < k; ++p) {
+        __m512 b0 = _mm512_loadu_ps(b);
+        SGEMM_AVX512_ROW(0);
+        SGEMM_AVX512_ROW(1);
+        SGEMM_AVX512_ROW(2);
+        SGEMM_AVX512_ROW(3);
+        SGEMM_AVX512_ROW(4);
+        SGEMM_AVX512_ROW(5);
+        SGEMM_AVX512_ROW(6);
+        SGEMM_AVX512_ROW(7);
+        SGEMM_AVX512_ROW(8);
+        SGEMM_AVX512_ROW(9);
+        SGEMM_AVX512_ROW(10);
+        SGEMM_AVX512_ROW(11);
+        SGEMM_AVX512_ROW(12);
+        SGEMM_AVX512_ROW(13);
+        a += 14;
+        b += kSgemmPanelWidth;
+    }
+    __m512 c[kSgemmMaxKernelRows] = {c0, c1, c2, c3, c4, c5, c6, c7, c8, c9, c10, c11, c12, c13};
+    for (int r = 0; r < kSgemmMaxKernelRows; ++r) {
+        _mm512_storeu_ps(tile + r * kSgemmPanelWidth, c[r]);
+    }
+}
+
+#undef SGEMM_AVX512_ROW
+
+#endif  // TNN_CPU_SGEMM_X86
+
+/*
+ * With few rows of A, eg. the inner product of batch 1, the sgemm is bound by streaming B from memory.
+ * The gemv kernels below walk a panel of packed B once for all the rows, 16 output columns per pass,
+ * with A read in place and no packing or blocking of k.
+ */
+// rows of A taken by the gemv kernels
+static const int kSgemvMaxRows = 4;
+
+// @brief gemv kernel computing a tile of rows x kSgemmPanelWidth floats from the rows of A (rows x k, stored
+// with lda) and a panel of packed B (k x kSgemmPanelWidth)
+typedef void (*SgemvKernelFunc)(int rows, int k, const float *a, int lda, const float *b, float *tile);
+
+template <int ROWS>
+static void SgemvKernelGenericRows(int k, const float *a, int lda, const float *b, float *tile) {
+    float acc[ROWS][kSgemmPanelWidth] = {{0.0f}};
+    for (int p = 0; p < k; ++p) {
+        for (int r = 0; r < ROWS; ++r) {
+            const float a_r = a[r * lda + p];
+            for (int j = 0; j < kSgemmPanelWidth; ++j) {
+                acc[r][j] += a_r * b[j];
+            }
+        }
+        b += kSgemmPanelWidth;
+    }
+    memcpy(tile, acc, sizeof(acc));
+}
+
+#ifdef TNN_CPU_SGEMM_X86
+
+// two ymm accumulators per row
+template <int ROWS>
+__attribute__((target("avx2,fma"))) static void SgemvKernelAvx2Rows(int k, const float *a, int lda, const float *b,
+                                                                    float *tile) {
+    __m256 c[ROWS][2];
+    for (int r = 0; r < ROWS; ++r) {
+        c[r][0] = _mm256_setzero_ps();
+        c[r][1] = _mm256_setzero_ps();
+    }
+    for (int p = 0; p < k; ++p) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+        for (int r = 0; r < ROWS; ++r) {
+            __m256 a_r = _mm256_broadcast_ss(a + r * lda + p);
+            c[r][0]    = _mm256_fmadd_ps(a_r, b0, c[r][0]);
+            c[r][1]    = _mm256_fmadd_ps(a_r, b1, c[r][1]);
+        }
+        b += kSgemmPanelWidth;
+    }
+    for (int r = 0; r < ROWS; ++r) {
+        _mm256_storeu_ps(tile + r * kSgemmPanelWidth, c[r][0]);
+        _mm256_storeu_ps(tile + r * kSgemmPanelWidth + 8, c[r][1]);
+    }
+}
+
+// one zmm per row, the even and odd k go to separate accumulators to hide the latency of fma
+template <int ROWS>
+__attribute__((target("avx512f"))) static void SgemvKernelAvx512Rows(int k, const float *a, int lda,
+                                                                     const float *b, float *tile) {
+    __m512 c[ROWS][2];
+    for (int r = 0; r < ROWS; ++r) {
+        c[r][0] = _mm512_setzero_ps();
+        c[r][1] = _mm512_setzero_ps();
+    }
+    int p = 0;
+    for (; p + 1 < k; p += 2) {
+        __m512 b0 = _mm512_loadu_ps(b);
+        __m512 b1 = _mm512_loadu_ps(b + kSgemmPanelWidth);
+        for (int r = 0; r < ROWS; ++r) {
+            c[r][0] = _mm512_fmadd_ps(_mm512_set1_ps(a[r * lda + p]), b0, c[r][0]);
+            c[r][1] = _mm512_fmadd_ps(_mm512_set1_ps(a[r * lda + p + 1]), b1, c[r][1]);
+        }
+        b += 2 * kSgemmPanelWidth;
+    }
+    if (p < k) {
+        __m512 b0 = _mm512_loadu_ps(b);
+        for (int r = 0; r < ROWS; ++r) {
+            c[r][0] = _mm512_fmadd_ps(_mm512_set1_ps(a[r * lda + p]), b0, c[r][0]);
+        }
+    }
+    for (int r = 0; r < ROWS; ++r) {
+        _mm512_storeu_ps(tile + r * kSgemmPanelWidth, _mm512_add_ps(c[r][0], c[r][1]));
+    }
+}
+
+#endif  // TNN_CPU_SGEMM_X86
+
+#define SGEMV_KERNEL_DISPATCH(name)                                                                                   \
+    static void name(int rows, int k, const float *a, int lda, const float *b, float *tile) {                         \
+        switch (rows) {                                                                                               \
+            case 1:                                                                                                   \
+                return name##Rows<1>(k, a, lda, b, tile);                                                             \
+            case 2:                                                                                                   \
+                return name##Rows<2>(k, a, lda, b, tile);                                                             \
+            case 3:                                                                                                   \
+                return name##Rows<3>(k, a, lda, b, tile);                                                             \
+            default:                                                                                                  \
+                return name##Rows<4>(k, a, lda, b, tile);                                                             \
+        }                                                                                                             \
+    }
+
+SGEMV_KERNEL_DISPATCH(SgemvKernelGeneric)
+#ifdef TNN_CPU_SGEMM_X86
+SGEMV_KERNEL_DISPATCH(SgemvKernelAvx2)
+SGEMV_KERNEL_DISPATCH(SgemvKernelAvx512)
+#endif
+
+#undef SGEMV_KERNEL_DISPATCH
+
+// the widest gemv kernel the cpu supports, selected once
+static SgemvKernelFunc GetSgemvKernel() {
+    static const SgemvKernelFunc kernel = []() {
+#ifdef TNN_CPU_SGEMM_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SgemvKernelAvx512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SgemvKernelAvx2;
+        }
+#endif
+        return SgemvKernelGeneric;
+    }();
+    return kernel;
+}
+
+// the widest micro kernel the cpu supports, selected once
+static const SgemmKernel &GetSgemmKernel() {
+    static const SgemmKernel kernel = []() {
+#ifdef TNN_CPU_SGEMM_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SgemmKernel{14, SgemmKernelAvx512};
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SgemmKernel{6, SgemmKernelAvx2};
+        }
+#endif
+        return SgemmKernel{4, SgemmKernelGeneric};
+    }();
+    return kernel;
+}
+
+int GetSgemmPackedBSize(int k, int n) {
+    return UP_DIV(n, kSgemmPanelWidth) * kSgemmPanelWidth * k;
+}
+
+void PackSgemmB(const float *b, int ldb, bool trans_b, int k, int n, float *packed_b) {
+    const int panels = UP_DIV(n, kSgemmPanelWidth);
+    OMP_PARALLEL_FOR_
+    for (int panel = 0; panel < panels; ++panel) {
+        float *dst = packed_b + (size_t)panel * k * kSgemmPanelWidth;
+        for (int p = 0; p < k; ++p) {
+            for (int j = 0; j < kSgemmPanelWidth; ++j) {
+                const int col = panel * kSgemmPanelWidth + j;
+                float value   = 0.0f;
+                if (col < n) {
+                    value = trans_b ? b[(size_t)col * ldb + p] : b[(size_t)p * ldb + col];
+                }
+                dst[p * kSgemmPanelWidth + j] = value;
+            }
+        }
+    }
+}
+
+// pack the block of A into micro panels of the kernel rows, each holds its k columns one after another
+template <typename Ta>
+static void PackSgemmA(const Ta *a, int lda, bool trans_a, int m_begin, int m_size, int k_begin, int k_size,
+                       int kernel_rows, float *packed_a) {
+    for (int i = 0; i < m_size; i += kernel_rows) {
+        const int rows = std::min(kernel_rows, m_size - i);
+        float *dst     = packed_a + (size_t)i * k_size;
+        if (trans_a) {
+            for (int p = 0; p < k_size; ++p) {
+                const Ta *src = a + (size_t)(k_begin + p) * lda + m_begin + i;
+                for (int r = 0; r < rows; ++r) {
+                    dst[p * kernel_rows + r] = src[r];
+                }
+                for (int r = rows; r < kernel_rows; ++r) {
+                    dst[p * kernel_rows + r] = 0.0f;
+                }
+            }
+        } else {
+            for (int r = 0; r < rows; ++r) {
+                const Ta *src = a + (size_t)(m_begin + i + r) * lda + k_begin;
+                for (int p = 0; p < k_size; ++p) {
+                    dst[p * kernel_rows + r] = src[p];
+                }
+            }
+            for (int r = rows; r < kernel_rows; ++r) {
+                for (int p = 0; p < k_size; ++p) {
+                    dst[p * kernel_rows + r] = 0.0f;
+                }
+            }
+        }
+    }
+}
+
+static inline float Activate(float value, int activation_type) {
+    if (activation_type == ActivationType_ReLU) {
+        return std::max(value, 0.0f);
+    } else if (activation_type == ActivationType_ReLU6) {
+        return std::min(std::max(value, 0.0f), 6.0f);
+    }
+    return value;
+}
+
+// write the tile of rows x cols at (row, col) of C, the first block of k adds the bias and the last one activates
+template <typename Tc>
+static void StoreSgemmTile(const float *tile, int rows, int cols, int row, int col, Tc *c, int ldc, bool trans_c,
+                           const float *bias, bool first, bool last, int activation_type) {
+    if (trans_c) {
+        for (int j = 0; j < cols; ++j) {
+            Tc *dst          = c + (size_t)(col + j) * ldc + row;
+            const float base = bias ? bias[col + j] : 0.0f;
+            for (int r = 0; r < rows; ++r) {
+                float value = tile[r * kSgemmPanelWidth + j] + (first ? base : (float)dst[r]);
+                dst[r]      = last ? Activate(value, activation_type) : value;
+            }
+        }
+    } else {
+        for (int r = 0; r < rows; ++r) {
+            Tc *dst = c + (size_t)(row + r) * ldc + col;
+            for (int j = 0; j < cols; ++j) {
+                float value =
+                    tile[r * kSgemmPanelWidth + j] + (first ? (bias ? bias[col + j] : 0.0f) : (float)dst[j]);
+                dst[j] = last ? Activate(value, activation_type) : value;
+            }
+        }
+    }
+}
+
+// @brief the float rows of A read in place by the gemv kernels, null if A is gathered into rows
+static const float *GetSgemvRows(const float *a, int m, int lda, bool trans_a) {
+    // a single row stored k x 1 is contiguous if lda is 1
+    return !trans_a || (m == 1 && lda == 1) ? a : nullptr;
+}
+
+static const float *GetSgemvRows(const bfp16_t *a, int m, int lda, bool trans_a) {
+    return nullptr;
+}
+
+// C of at most kSgemvMaxRows rows, the panels of B run in parallel
+template <typename Ta, typename Tc>
+static void CpuSgemv(int m, int n, int k, const Ta *a, int lda, bool trans_a, const float *packed_b, Tc *c,
+                     int ldc, bool trans_c, const float *bias, int activation_type) {
+    // the gemv kernels read float rows of A, other rows are gathered once
+    const float *a_rows = GetSgemvRows(a, m, lda, trans_a);
+    std::vector<float> a_rows_buffer;
+    if (a_rows == nullptr) {
+        a_rows_buffer.resize((size_t)m * k);
+        for (int r = 0; r < m; ++r) {
+            for (int p = 0; p < k; ++p) {
+                a_rows_buffer[(size_t)r * k + p] = trans_a ? a[(size_t)p * lda + r] : a[(size_t)r * lda + p];
+            }
+        }
+        a_rows = a_rows_buffer.data();
+        lda    = k;
+    } else if (trans_a) {
+        lda = k;
+    }
+
+    const auto kernel = GetSgemvKernel();
+    const int panels  = UP_DIV(n, kSgemmPanelWidth);
+    OMP_PARALLEL_FOR_
+    for (int panel = 0; panel < panels; ++panel) {
+        float tile[kSgemvMaxRows * kSgemmPanelWidth];
+        const int n_begin = panel * kSgemmPanelWidth;
+        kernel(m, k, a_rows, lda, packed_b + (size_t)panel * k * kSgemmPanelWidth, tile);
+        StoreSgemmTile(tile, m, std::min(kSgemmPanelWidth, n - n_begin), 0, n_begin, c, ldc, trans_c, bias, true,
+                       true, activation_type);
+    }
+}
+
+template <typename Ta, typename Tc>
+void CpuSgemm(int m, int n, int k, const Ta *a, int lda, bool trans_a, const float *packed_b, Tc *c, int ldc,
+              bool trans_c, const float *bias, int activation_type) {
+    if (m <= 0 || n <= 0 || k <= 0) {
+        return;
+    }
+    if (m <= kSgemvMaxRows) {
+        return CpuSgemv(m, n, k, a, lda, trans_a, packed_b, c, ldc, trans_c, bias, activation_type);
+    }
+    const auto &kernel    = GetSgemmKernel();
+    const int kernel_rows = kernel.rows;
+
+    // partial sums of C are kept across the blocks of k, a bfp16 C would truncate them, so k is not blocked
+    const int block_k = std::is_same<Tc, float>::value ? std::min(k, kSgemmBlockK) : k;
+    int block_m       = kSgemmBlockABytes / (block_k * (int)sizeof(float)) / kernel_rows * kernel_rows;
+    block_m           = std::min(std::max(block_m, kernel_rows), UP_DIV(m, kernel_rows) * kernel_rows);
+
+    // the blocks of m are split to the threads first, the panels of n are split if they are fewer than the threads
+    const int threads  = OMP_MAX_THREADS_NUM_;
+    const int m_blocks = UP_DIV(m, block_m);
+    const int panels   = UP_DIV(n, kSgemmPanelWidth);
+    int n_split        = m_blocks >= threads ? 1 : std::min(panels, UP_DIV(threads, m_blocks));
+    const int panels_per_job = UP_DIV(panels, n_split);
+    n_split                  = UP_DIV(panels, panels_per_job);
+    const int jobs           = m_blocks * n_split;
+
+    std::vector<float> packed_a_buffer((size_t)threads * block_m * block_k);
+    OMP_PARALLEL_FOR_
+    for (int job = 0; job < jobs; ++job) {
+        const int m_begin     = job / n_split * block_m;
+        const int m_size      = std::min(block_m, m - m_begin);
+        const int panel_begin = job % n_split * panels_per_job;
+        const int panel_end   = std::min(panels, panel_begin + panels_per_job);
+        float *packed_a       = packed_a_buffer.data() + (size_t)OMP_TID_ * block_m * block_k;
+        float tile[kSgemmMaxKernelRows * kSgemmPanelWidth];
+
+        for (int k_begin = 0; k_begin < k; k_begin += block_k) {
+            const int k_size = std::min(block_k, k - k_begin);
+            const bool first = k_begin == 0;
+            const bool last  = k_begin + k_size >= k;
+            PackSgemmA(a, lda, trans_a, m_begin, m_size, k_begin, k_size, kernel_rows, packed_a);
+
+            for (int panel = panel_begin; panel < panel_end; ++panel) {
+                const float *panel_b = packed_b + ((size_t)panel * k + k_begin) * kSgemmPanelWidth;
+                const int n_begin    = panel * kSgemmPanelWidth;
+                const int n_size     = std::min(kSgemmPanelWidth, n - n_begin);
+                for (int i = 0; i < m_size; i += kernel_rows) {
+                    kernel.func(k_size, packed_a + (size_t)i * k_size, panel_b, tile);
+                    StoreSgemmTile(tile, std::min(kernel_rows, m_size - i), n_size, m_begin + i, n_begin, c, ldc,
+                                   trans_c, bias, first, last, activation_type);
+                }
+            }
+        }
+    }
+}
+
+template void CpuSgemm(int m, int n, int k, const float *a, int lda, bool trans_a, const float *packed_b, float *c,
+                       int ldc, bool trans_c, const float *bias, int activation_type);
+template void CpuSgemm(int m, int n, int k, const bfp16_t *a, int lda, bool trans_a, const float *packed_b,
+                       bfp16_t *c, int ldc, bool trans_c, const float *bias, int activation_type);
+template void CpuSgemm(int m, int n, int k, const float *a, int lda, bool trans_a, const float *packed_b, bfp16_t *c,
+                       int ldc, bool trans_c, const float *bias, int activation_type);
+template void CpuSgemm(int m, int n, int k, const bfp16_t *a, int lda, bool trans_a, const float *packed_b, float *c,
+                       int ldc, bool trans_c, const float *bias, int activation_type);
+
+}  // namespace TNN_NS
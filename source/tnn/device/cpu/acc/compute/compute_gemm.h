@@ -0,0 +1,50 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_CPU_COMPUTE_GEMM_H_
+#define TNN_CPU_COMPUTE_GEMM_H_
+
+#include "tnn/core/common.h"
+#include "tnn/utils/bfp16.h"
+
+namespace TNN_NS {
+
+// @brief columns of a panel of the packed B of CpuSgemm
+static const int kSgemmPanelWidth = 16;
+
+// @brief the number of floats of B (k x n) packed by PackSgemmB, n is padded to whole panels
+int GetSgemmPackedBSize(int k, int n);
+
+// @brief pack B (k x n) into panels of kSgemmPanelWidth columns, each panel holds its k rows one after
+// another and the columns beyond n are zero. B is the constant operand, eg. the weights, packed at init.
+// @param trans_b b is stored n x k, eg. the weights of inner product
+void PackSgemmB(const float *b, int ldb, bool trans_b, int k, int n, float *packed_b);
+
+// @brief C (m x n) = A (m x k) * B (k x n) + bias, with B packed by PackSgemmB.
+// Blocks of A are packed for the micro kernel of the cpu, avx512 and avx2 on x86, a portable kernel
+// otherwise. The blocks of C run in parallel with OpenMP over both m and n.
+// C of a few rows, eg. the inner product of batch 1, goes to gemv kernels streaming each panel of B once.
+// A and C are float or bfp16_t, the bfp16 values are converted when A is packed and C is stored, the math is fp32.
+// @param trans_a a is stored k x m, eg. the nchw input or the im2col buffer of a conv
+// @param trans_c c is stored n x m, eg. the nchw output of a conv
+// @param bias bias of the n columns, null if none
+// @param activation_type ActivationType_None, ActivationType_ReLU or ActivationType_ReLU6
+template <typename Ta, typename Tc>
+void CpuSgemm(int m, int n, int k, const Ta *a, int lda, bool trans_a, const float *packed_b, Tc *c, int ldc,
+              bool trans_c, const float *bias, int activation_type);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_CPU_COMPUTE_GEMM_H_
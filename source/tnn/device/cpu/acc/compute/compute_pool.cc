@@ -0,0 +1,289 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/device/cpu/acc/compute/compute_pool.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/omp_utils.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TNN_CPU_POOL_X86
+#endif
+
+#ifdef __GNUC__
+#define POOL_INLINE inline __attribute__((always_inline))
+#else
+#define POOL_INLINE inline
+#endif
+
+namespace TNN_NS {
+
+// channels of a packed block, the lanes of a ymm register
+static const int kPoolPack = 8;
+
+/*
+ * The loops over the kPoolPack lanes below are vectorized by the compiler. The kernels are inlined into one
+ * function for the portable build and one built for avx2, selected at runtime.
+ */
+template <int POOL_TYPE>
+static POOL_INLINE void PoolAccumulate(float *acc, const float *src) {
+    for (int j = 0; j < kPoolPack; ++j) {
+        acc[j] = POOL_TYPE == 0 ? (acc[j] < src[j] ? src[j] : acc[j]) : acc[j] + src[j];
+    }
+}
+
+// the windows entirely in the pads, eg. the last one of the ceil mode, have no input and store 0
+template <int POOL_TYPE>
+static POOL_INLINE void PoolStore(const float *acc, int count, float *dst) {
+    const float scale = count > 0 ? 1.0f / count : 0.0f;
+    for (int j = 0; j < kPoolPack; ++j) {
+        dst[j] = POOL_TYPE == 0 ? (count > 0 ? acc[j] : 0.0f) : acc[j] * scale;
+    }
+}
+
+/*
+ * pool a plane of packed input [ih][iw][8] into the packed output [oh][ow][8].
+ * The windows inside the input of KY x KX are unrolled, KY or KX of 0 takes the kernel size at runtime.
+ */
+template <int POOL_TYPE, int KY, int KX>
+static POOL_INLINE void PoolPackedPlane(const float *src, float *dst, int ih, int iw, int oh, int ow, int stride_y,
+                                        int stride_x, int kernel_y, int kernel_x, int pad_y, int pad_x) {
+    const float init = POOL_TYPE == 0 ? -FLT_MAX : 0.0f;
+    for (int y = 0; y < oh; ++y) {
+        const int h_origin = y * stride_y - pad_y;
+        const int h_begin  = std::max(h_origin, 0);
+        const int h_end    = std::min(h_origin + kernel_y, ih);
+        for (int x = 0; x < ow; ++x) {
+            const int w_origin = x * stride_x - pad_x;
+            const int w_begin  = std::max(w_origin, 0);
+            const int w_end    = std::min(w_origin + kernel_x, iw);
+            float acc[kPoolPack];
+            for (int j = 0; j < kPoolPack; ++j) {
+                acc[j] = init;
+            }
+            const bool inside = KY > 0 && KX > 0 && h_origin >= 0 && w_origin >= 0 && h_origin + KY <= ih &&
+                                w_origin + KX <= iw;
+            if (inside) {
+                const float *window = src + (h_origin * iw + w_origin) * kPoolPack;
+                for (int ky = 0; ky < KY; ++ky) {
+                    for (int kx = 0; kx < KX; ++kx) {
+                        PoolAccumulate<POOL_TYPE>(acc, window + (ky * iw + kx) * kPoolPack);
+                    }
+                }
+            } else {
+                for (int h = h_begin; h < h_end; ++h) {
+                    for (int w = w_begin; w < w_end; ++w) {
+                        PoolAccumulate<POOL_TYPE>(acc, src + (h * iw + w) * kPoolPack);
+                    }
+                }
+            }
+            PoolStore<POOL_TYPE>(acc, (h_end - h_begin) * (w_end - w_begin), dst + (y * ow + x) * kPoolPack);
+        }
+    }
+}
+
+// @brief the parameters of a pooling shared by the kernels
+struct PoolShape {
+    int ih, iw, oh, ow;
+    int stride_y, stride_x, kernel_y, kernel_x, pad_y, pad_x;
+    int pool_type;
+};
+
+static POOL_INLINE void PoolPackedPlaneImpl(const float *src, float *dst, const PoolShape &s) {
+    const bool stride_2 = s.stride_y == 2 && s.stride_x == 2;
+#define POOL_PLANE(pool_type, ky, kx)                                                                                  \
+    PoolPackedPlane<pool_type, ky, kx>(src, dst, s.ih, s.iw, s.oh, s.ow, s.stride_y, s.stride_x, s.kernel_y,          \
+                                       s.kernel_x, s.pad_y, s.pad_x)
+    if (s.pool_type == 0) {
+        if (stride_2 && s.kernel_y == 2 && s.kernel_x == 2) {
+            POOL_PLANE(0, 2, 2);
+        } else if (stride_2 && s.kernel_y == 3 && s.kernel_x == 3) {
+            POOL_PLANE(0, 3, 3);
+        } else {
+            POOL_PLANE(0, 0, 0);
+        }
+    } else {
+        if (stride_2 && s.kernel_y == 2 && s.kernel_x == 2) {
+            POOL_PLANE(1, 2, 2);
+        } else if (stride_2 && s.kernel_y == 3 && s.kernel_x == 3) {
+            POOL_PLANE(1, 3, 3);
+        } else {
+            POOL_PLANE(1, 0, 0);
+        }
+    }
+#undef POOL_PLANE
+}
+
+// accumulate kPoolPack values of float or bfp16 src, the bfp16 values are widened first
+template <int POOL_TYPE, typename T>
+static POOL_INLINE void PoolAccumulateValues(float *acc, const T *src) {
+    float values[kPoolPack];
+    for (int j = 0; j < kPoolPack; ++j) {
+        values[j] = src[j];
+    }
+    PoolAccumulate<POOL_TYPE>(acc, values);
+}
+
+// max or average of each plane of size, the planes are one after another
+template <typename T>
+static POOL_INLINE void GlobalPoolImpl(const T *src, T *dst, int planes, int size, int pool_type) {
+    for (int p = 0; p < planes; ++p) {
+        const T *plane = src + (size_t)p * size;
+        float acc[kPoolPack];
+        for (int j = 0; j < kPoolPack; ++j) {
+            acc[j] = pool_type == 0 ? -FLT_MAX : 0.0f;
+        }
+        int i = 0;
+        if (pool_type == 0) {
+            for (; i + kPoolPack <= size; i += kPoolPack) {
+                PoolAccumulateValues<0>(acc, plane + i);
+            }
+        } else {
+            for (; i + kPoolPack <= size; i += kPoolPack) {
+                PoolAccumulateValues<1>(acc, plane + i);
+            }
+        }
+        float result = acc[0];
+        for (int j = 1; j < kPoolPack; ++j) {
+            result = pool_type == 0 ? std::max(result, acc[j]) : result + acc[j];
+        }
+        for (; i < size; ++i) {
+            const float value = plane[i];
+            result            = pool_type == 0 ? std::max(result, value) : result + value;
+        }
+        dst[p] = pool_type == 0 ? result : result / size;
+    }
+}
+
+typedef void (*PoolPackedPlaneFunc)(const float *src, float *dst, const PoolShape &s);
+template <typename T>
+using GlobalPoolFunc = void (*)(const T *src, T *dst, int planes, int size, int pool_type);
+
+static void PoolPackedPlaneGeneric(const float *src, float *dst, const PoolShape &s) {
+    PoolPackedPlaneImpl(src, dst, s);
+}
+
+template <typename T>
+static void GlobalPoolGeneric(const T *src, T *dst, int planes, int size, int pool_type) {
+    GlobalPoolImpl(src, dst, planes, size, pool_type);
+}
+
+#ifdef TNN_CPU_POOL_X86
+__attribute__((target("avx2"))) static void PoolPackedPlaneAvx2(const float *src, float *dst, const PoolShape &s) {
+    PoolPackedPlaneImpl(src, dst, s);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) static void GlobalPoolAvx2(const T *src, T *dst, int planes, int size,
+                                                           int pool_type) {
+    GlobalPoolImpl(src, dst, planes, size, pool_type);
+}
+
+static bool CpuSupportsAvx2() {
+    static const bool support = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return support;
+}
+#endif  // TNN_CPU_POOL_X86
+
+static PoolPackedPlaneFunc GetPoolPackedPlaneFunc() {
+#ifdef TNN_CPU_POOL_X86
+    if (CpuSupportsAvx2()) {
+        return PoolPackedPlaneAvx2;
+    }
+#endif
+    return PoolPackedPlaneGeneric;
+}
+
+template <typename T>
+static GlobalPoolFunc<T> GetGlobalPoolFunc() {
+#ifdef TNN_CPU_POOL_X86
+    if (CpuSupportsAvx2()) {
+        return GlobalPoolAvx2<T>;
+    }
+#endif
+    return GlobalPoolGeneric<T>;
+}
+
+int GetCpuPoolingBufferSize(const DimsVector &dims_input, const DimsVector &dims_output) {
+    const int input_size  = dims_input[2] * dims_input[3];
+    const int output_size = dims_output[2] * dims_output[3];
+    return OMP_MAX_THREADS_NUM_ * (input_size + output_size) * kPoolPack;
+}
+
+template <typename T>
+void CpuPooling(const T *input, T *output, const DimsVector &dims_input, const DimsVector &dims_output,
+                int stride_y, int stride_x, int kernel_y, int kernel_x, int pad_y, int pad_x, int pool_type,
+                float *buffer) {
+    const int batch    = dims_output[0];
+    const int channels = dims_output[1];
+    PoolShape shape    = {dims_input[2], dims_input[3], dims_output[2], dims_output[3], stride_y, stride_x,
+                       kernel_y,      kernel_x,      pad_y,          pad_x,          pool_type};
+    const int input_size  = shape.ih * shape.iw;
+    const int output_size = shape.oh * shape.ow;
+
+    // the window of the global pooling is the whole plane, which is contiguous in nchw
+    if (output_size == 1 && pad_y == 0 && pad_x == 0 && kernel_y >= shape.ih && kernel_x >= shape.iw) {
+        auto global_pool = GetGlobalPoolFunc<T>();
+        const int planes = batch * channels;
+        const int chunk  = UP_DIV(planes, OMP_MAX_THREADS_NUM_);
+        OMP_PARALLEL_FOR_
+        for (int p = 0; p < planes; p += chunk) {
+            global_pool(input + (size_t)p * input_size, output + p, std::min(chunk, planes - p), input_size,
+                        pool_type);
+        }
+        return;
+    }
+
+    auto pool_plane  = GetPoolPackedPlaneFunc();
+    const int blocks = UP_DIV(channels, kPoolPack);
+    OMP_PARALLEL_FOR_
+    for (int job = 0; job < batch * blocks; ++job) {
+        const int n        = job / blocks;
+        const int c_begin  = job % blocks * kPoolPack;
+        const int c_size   = std::min(kPoolPack, channels - c_begin);
+        float *packed_src  = buffer + (size_t)OMP_TID_ * (input_size + output_size) * kPoolPack;
+        float *packed_dst  = packed_src + (size_t)input_size * kPoolPack;
+        const T *src_c     = input + ((size_t)n * channels + c_begin) * input_size;
+        T *dst_c           = output + ((size_t)n * channels + c_begin) * output_size;
+
+        // [c][h][w] to [h][w][8], the lanes beyond the channels are zero
+        for (int i = 0; i < input_size; ++i) {
+            for (int j = 0; j < kPoolPack; ++j) {
+                packed_src[i * kPoolPack + j] = j < c_size ? (float)src_c[(size_t)j * input_size + i] : 0.0f;
+            }
+        }
+        pool_plane(packed_src, packed_dst, shape);
+        for (int j = 0; j < c_size; ++j) {
+            for (int i = 0; i < output_size; ++i) {
+                dst_c[(size_t)j * output_size + i] = packed_dst[i * kPoolPack + j];
+            }
+        }
+    }
+}
+
+template void CpuPooling(const float *input, float *output, const DimsVector &dims_input,
+                         const DimsVector &dims_output, int stride_y, int stride_x, int kernel_y, int kernel_x,
+                         int pad_y, int pad_x, int pool_type, float *buffer);
+template void CpuPooling(const bfp16_t *input, bfp16_t *output, const DimsVector &dims_input,
+                         const DimsVector &dims_output, int stride_y, int stride_x, int kernel_y, int kernel_x,
+                         int pad_y, int pad_x, int pool_type, float *buffer);
+
+}  // namespace TNN_NS
@@ -0,0 +1,40 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_CPU_COMPUTE_POOL_H_
+#define TNN_CPU_COMPUTE_POOL_H_
+
+#include "tnn/core/common.h"
+#include "tnn/utils/bfp16.h"
+
+namespace TNN_NS {
+
+// @brief the number of floats of the buffer of CpuPooling, the packed blocks of each thread
+int GetCpuPoolingBufferSize(const DimsVector &dims_input, const DimsVector &dims_output);
+
+// @brief max (pool_type 0) or average (pool_type 1) pooling of nchw blobs. The windows are clipped to the
+// input, the average excludes the pads and the windows entirely in the pads output 0, as NaivePooling does.
+// Blocks of 8 channels are packed to [h][w][8] and pooled with 8 lanes at once, 2x2 and 3x3 windows of stride 2
+// are unrolled and the global pooling reduces each plane in place. The blocks run in parallel with OpenMP.
+// The blobs are float or bfp16_t, the bfp16 values are converted when a block is packed and stored, the math is fp32.
+// @param buffer GetCpuPoolingBufferSize floats, kept by the caller across forwards
+template <typename T>
+void CpuPooling(const T *input, T *output, const DimsVector &dims_input, const DimsVector &dims_output,
+                int stride_y, int stride_x, int kernel_y, int kernel_x, int pad_y, int pad_x, int pool_type,
+                float *buffer);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_CPU_COMPUTE_POOL_H_
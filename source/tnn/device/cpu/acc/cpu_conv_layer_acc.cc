@@ -15,12 +15,25 @@
 #include "tnn/device/cpu/acc/cpu_conv_layer_acc.h"
 
 #include "tnn/core/blob_int8.h"
+#include "tnn/utils/bfp16_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
 
 CpuConvLayerAcc::~CpuConvLayerAcc() {}
 
+/*
+weights packed by the same acc of another instance are reused,
+InitWeights skips packing when packed_weight_ already holds the packed weights
+*/
+Status CpuConvLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto conv_acc = dynamic_cast<CpuConvLayerAcc *>(acc);
+    CHECK_PARAM_NULL(conv_acc);
+    packed_weight_ = conv_acc->packed_weight_;
+    return TNN_OK;
+}
+
 Status CpuConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                              const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto status = CpuLayerAcc::Init(context, param, resource, inputs, outputs);
@@ -61,6 +74,47 @@ Status CpuConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
             }
             buffer_scale_ = temp_buffer;
         }
+    } else if ((outputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT ||
+                outputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) &&
+               inputs[0]->GetBlobDesc().dims.size() == 4) {
+        // bfp16 blobs run the float kernels, the weights stay fp32
+        const int group        = conv_param->group;
+        const int oc_per_group = outputs[0]->GetBlobDesc().dims[1] / group;
+        const int ic_per_group = inputs[0]->GetBlobDesc().dims[1] / group;
+        const int gemm_k       = ic_per_group * conv_param->kernels[1] * conv_param->kernels[0];
+        // convs of few channels per group, eg. depthwise convs, waste the panels of the sgemm
+        if (oc_per_group >= 8 && gemm_k >= 8) {
+            use_sgemm_ = true;
+        } else {
+            conv_func_ = GetSpecializedConvFunc(conv_param->kernels[1], conv_param->kernels[0], conv_param->strides[1],
+                                                conv_param->strides[0], conv_param->dialations[1],
+                                                conv_param->dialations[0]);
+        }
+    }
+    return TNN_OK;
+}
+
+Status CpuConvLayerAcc::InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (!use_sgemm_) {
+        return TNN_OK;
+    }
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    auto conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    const int group        = conv_param->group;
+    const int oc_per_group = outputs[0]->GetBlobDesc().dims[1] / group;
+    const int ic_per_group = inputs[0]->GetBlobDesc().dims[1] / group;
+    const int gemm_k       = ic_per_group * conv_param->kernels[1] * conv_param->kernels[0];
+    const int packed_size  = GetSgemmPackedBSize(gemm_k, oc_per_group);
+    if (packed_weight_.GetBytesSize() != group * packed_size * sizeof(float)) {
+        packed_weight_      = RawBuffer(group * packed_size * sizeof(float));
+        const float *weight = conv_res->filter_handle.force_to<float *>();
+        for (int g = 0; g < group; ++g) {
+            PackSgemmB(weight + g * oc_per_group * gemm_k, gemm_k, true, gemm_k, oc_per_group,
+                       packed_weight_.force_to<float *>() + g * packed_size);
+        }
     }
     return TNN_OK;
 }
@@ -89,7 +143,17 @@ Status CpuConvLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::ve
     DimsVector output_dims = output_blob->GetBlobDesc().dims;
     DimsVector input_dims  = input_blob->GetBlobDesc().dims;
 
-    if (data_type == DATA_TYPE_FLOAT) {
+    if (data_type == DATA_TYPE_FLOAT && use_sgemm_) {
+        return ForwardSgemm<float>(param, resource, input_blob, output_blob);
+    } else if (data_type == DATA_TYPE_BFP16 && use_sgemm_) {
+        return ForwardSgemm<bfp16_t>(param, resource, input_blob, output_blob);
+    } else if (data_type == DATA_TYPE_BFP16 && conv_func_) {
+        return ForwardConvFuncBFP16(param, resource, input_blob, output_blob);
+    } else if (data_type == DATA_TYPE_FLOAT && conv_func_) {
+        conv_func_(static_cast<float *>(input_ptr), static_cast<float *>(weight_ptr), static_cast<float *>(bias_ptr),
+                   static_cast<float *>(output_ptr), input_dims, output_dims, param->pads[2], param->pads[0],
+                   param->group, param->activation_type);
+    } else if (data_type == DATA_TYPE_FLOAT) {
         NaiveConv<float, float, float, float>(input_ptr, output_ptr, weight_ptr, bias_ptr, input_dims, output_dims,
                                             param->strides[1], param->strides[0], param->kernels[1], param->kernels[0],
                                             param->pads[2], param->pads[0], param->group, param->dialations[1],
@@ -111,6 +175,83 @@ Status CpuConvLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::ve
     return TNN_OK;
 }
 
+/*
+ * Each group of each batch is one sgemm, the output (oc x oh*ow) is the transposed C of
+ * the windows of the input (oh*ow x ic*kh*kw) by the transposed weights.
+ * The windows are the nchw input itself for the pointwise convs, im2col otherwise.
+ * T is float or bfp16_t, bfp16 blobs are converted to fp32 by im2col or the packing of A.
+ */
+template <typename T>
+Status CpuConvLayerAcc::ForwardSgemm(ConvLayerParam *param, ConvLayerResource *resource, Blob *input_blob,
+                                     Blob *output_blob) {
+    DimsVector input_dims  = input_blob->GetBlobDesc().dims;
+    DimsVector output_dims = output_blob->GetBlobDesc().dims;
+    const int batch        = output_dims[0];
+    const int group        = param->group;
+    const int oc_per_group = output_dims[1] / group;
+    const int ic_per_group = input_dims[1] / group;
+    const int input_size   = input_dims[2] * input_dims[3];
+    const int output_size  = output_dims[2] * output_dims[3];
+    const int kernel_y     = param->kernels[1];
+    const int kernel_x     = param->kernels[0];
+    const int gemm_k       = ic_per_group * kernel_y * kernel_x;
+    const int packed_size  = GetSgemmPackedBSize(gemm_k, oc_per_group);
+
+    const bool pointwise = kernel_y == 1 && kernel_x == 1 && param->strides[1] == 1 && param->strides[0] == 1 &&
+                           param->pads[2] == 0 && param->pads[0] == 0;
+    if (!pointwise && col_buffer_.GetBytesSize() < gemm_k * output_size * sizeof(float)) {
+        col_buffer_ = RawBuffer(gemm_k * output_size * sizeof(float));
+    }
+
+    const T *input      = static_cast<T *>(input_blob->GetHandle().base);
+    T *output           = static_cast<T *>(output_blob->GetHandle().base);
+    const float *bias   = param->bias ? resource->bias_handle.force_to<float *>() : nullptr;
+    const float *packed = packed_weight_.force_to<float *>();
+    float *col          = col_buffer_.force_to<float *>();
+    for (int n = 0; n < batch; ++n) {
+        for (int g = 0; g < group; ++g) {
+            const T *input_g    = input + (n * input_dims[1] + g * ic_per_group) * input_size;
+            T *output_g         = output + (n * output_dims[1] + g * oc_per_group) * output_size;
+            const float *bias_g = bias ? bias + g * oc_per_group : nullptr;
+            if (pointwise) {
+                CpuSgemm(output_size, oc_per_group, gemm_k, input_g, output_size, true, packed + g * packed_size,
+                         output_g, output_size, true, bias_g, param->activation_type);
+            } else {
+                CpuIm2Col(input_g, ic_per_group, input_dims[2], input_dims[3], kernel_y, kernel_x, param->pads[2],
+                          param->pads[0], param->strides[1], param->strides[0], param->dialations[1],
+                          param->dialations[0], output_dims[2], output_dims[3], col);
+                CpuSgemm(output_size, oc_per_group, gemm_k, (const float *)col, output_size, true,
+                         packed + g * packed_size, output_g, output_size, true, bias_g, param->activation_type);
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+// the specialized convs are fp32 only, the bfp16 blobs are converted around them
+Status CpuConvLayerAcc::ForwardConvFuncBFP16(ConvLayerParam *param, ConvLayerResource *resource, Blob *input_blob,
+                                             Blob *output_blob) {
+    DimsVector input_dims  = input_blob->GetBlobDesc().dims;
+    DimsVector output_dims = output_blob->GetBlobDesc().dims;
+    const int input_count  = DimsVectorUtils::Count(input_dims);
+    const int output_count = DimsVectorUtils::Count(output_dims);
+    if (input_float_buffer_.GetBytesSize() < input_count * sizeof(float)) {
+        input_float_buffer_ = RawBuffer(input_count * sizeof(float));
+    }
+    if (output_float_buffer_.GetBytesSize() < output_count * sizeof(float)) {
+        output_float_buffer_ = RawBuffer(output_count * sizeof(float));
+    }
+
+    float *input_float  = input_float_buffer_.force_to<float *>();
+    float *output_float = output_float_buffer_.force_to<float *>();
+    float *bias         = param->bias ? resource->bias_handle.force_to<float *>() : nullptr;
+    ConvertFromBFP16ToFloat(input_blob->GetHandle().base, input_float, input_count);
+    conv_func_(input_float, resource->filter_handle.force_to<float *>(), bias, output_float, input_dims, output_dims,
+               param->pads[2], param->pads[0], param->group, param->activation_type);
+    ConvertFromFloatToBFP16(output_float, output_blob->GetHandle().base, output_count);
+    return TNN_OK;
+}
+
 CpuTypeLayerAccRegister<TypeLayerAccCreator<CpuConvLayerAcc>> g_cpu_conv_layer_acc_register(LAYER_CONVOLUTION);
 
 }  // namespace TNN_NS
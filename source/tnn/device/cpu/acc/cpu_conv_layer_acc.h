@@ -18,6 +18,8 @@
 #include <vector>
 
 #include "tnn/core/blob.h"
+#include "tnn/device/cpu/acc/compute/compute_conv.h"
+#include "tnn/device/cpu/acc/compute/compute_gemm.h"
 #include "tnn/device/cpu/acc/cpu_layer_acc.h"
 #include "tnn/device/cpu/cpu_device.h"
 
@@ -31,12 +33,31 @@ class CpuConvLayerAcc : public CpuLayerAcc {
     Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
                 const std::vector<Blob *> &outputs);
 
+    virtual Status InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
     virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
     virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 private:
+    template <typename T>
+    Status ForwardSgemm(ConvLayerParam *param, ConvLayerResource *resource, Blob *input_blob, Blob *output_blob);
+    Status ForwardConvFuncBFP16(ConvLayerParam *param, ConvLayerResource *resource, Blob *input_blob,
+                                Blob *output_blob);
+
     RawBuffer buffer_scale_;
+    // specialized float conv selected at init, null to use the naive conv
+    CpuConvFunc conv_func_ = nullptr;
+    // float and bfp16 convs of enough channels per group run as sgemm
+    bool use_sgemm_ = false;
+    // weights of each group packed for CpuSgemm, empty if the float or bfp16 conv does not run as sgemm
+    RawBuffer packed_weight_;
+    RawBuffer col_buffer_;
+    // fp32 copies of the bfp16 input and output for conv_func_
+    RawBuffer input_float_buffer_;
+    RawBuffer output_float_buffer_;
 };
 
 }  // namespace TNN_NS
@@ -13,9 +13,12 @@
 // specific language governing permissions and limitations under the License.
 
 #include <algorithm>
+#include <type_traits>
 
 #include "tnn/utils/naive_compute.h"
+#include "tnn/device/cpu/acc/compute/compute_conv.h"
 #include "tnn/device/cpu/acc/cpu_deconv_layer_acc.h"
+#include "tnn/utils/bfp16_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
@@ -33,6 +36,17 @@ static int LeastCommonMultiple(int m, int n) {
 
 CpuDeconvLayerAcc::~CpuDeconvLayerAcc() {}
 
+/*
+weights packed by the same acc of another instance are reused,
+InitWeights skips packing when packed_weight_ already holds the packed weights
+*/
+Status CpuDeconvLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto deconv_acc = dynamic_cast<CpuDeconvLayerAcc *>(acc);
+    CHECK_PARAM_NULL(deconv_acc);
+    packed_weight_ = deconv_acc->packed_weight_;
+    return TNN_OK;
+}
+
 Status CpuDeconvLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto status = CpuLayerAcc::Init(context, param, resource, inputs, outputs);
@@ -44,6 +58,32 @@ Status CpuDeconvLayerAcc::Init(Context *context, LayerParam *param, LayerResourc
         LOGE("CpuDeconvLayerAcc dont support DATA_TYPE_INT8");
         return Status(TNNERR_PARAM_ERR, "CpuDeconvLayerAcc dont support DATA_TYPE_INT8");
     }
+
+    return TNN_OK;
+}
+
+Status CpuDeconvLayerAcc::InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    auto conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+    if ((outputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT ||
+         outputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) &&
+        inputs[0]->GetBlobDesc().dims.size() == 4) {
+        // weights of a group (ic x oc*kh*kw) are the B of the sgemm, they stay fp32 for bfp16 blobs
+        const int group        = conv_param->group;
+        const int ic_per_group = inputs[0]->GetBlobDesc().dims[1] / group;
+        const int gemm_n = outputs[0]->GetBlobDesc().dims[1] / group * conv_param->kernels[1] * conv_param->kernels[0];
+        const int packed_size = GetSgemmPackedBSize(ic_per_group, gemm_n);
+        if (packed_weight_.GetBytesSize() != group * packed_size * sizeof(float)) {
+            packed_weight_      = RawBuffer(group * packed_size * sizeof(float));
+            const float *weight = conv_res->filter_handle.force_to<float *>();
+            for (int g = 0; g < group; ++g) {
+                PackSgemmB(weight + g * ic_per_group * gemm_n, gemm_n, false, ic_per_group, gemm_n,
+                           packed_weight_.force_to<float *>() + g * packed_size);
+            }
+        }
+    }
     return TNN_OK;
 }
 
@@ -52,7 +92,11 @@ Status CpuDeconvLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::
 }
 
 Status CpuDeconvLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT && packed_weight_.GetBytesSize() > 0) {
+        return ForwardSgemm<float>(inputs, outputs);
+    } else if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16 && packed_weight_.GetBytesSize() > 0) {
+        return ForwardSgemm<bfp16_t>(inputs, outputs);
+    } else if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
         return Exec<float>(inputs, outputs);
     } else if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
         return Exec<bfp16_t>(inputs, outputs);
@@ -60,6 +104,79 @@ Status CpuDeconvLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::
     return Status(TNNERR_LAYER_ERR, "data type not support in deconv");
 }
 
+/*
+ * The columns of each group, (oc*kh*kw) x (ih*iw), are the transposed C of the input
+ * (ih*iw x ic) by the weights (ic x oc*kh*kw). They are folded into the output by col2im.
+ * T is float or bfp16_t, the bfp16 output of a group is folded in fp32 and converted once.
+ */
+template <typename T>
+Status CpuDeconvLayerAcc::ForwardSgemm(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param    = dynamic_cast<ConvLayerParam *>(param_);
+    auto resource = dynamic_cast<ConvLayerResource *>(resource_);
+    if (!param || !resource) {
+        return Status(TNNERR_MODEL_ERR, "Error: DeconvLayerParam or DeconvLayerResource is empty");
+    }
+
+    DimsVector input_dims  = inputs[0]->GetBlobDesc().dims;
+    DimsVector output_dims = outputs[0]->GetBlobDesc().dims;
+    const int batch        = output_dims[0];
+    const int group        = param->group;
+    const int oc_per_group = output_dims[1] / group;
+    const int ic_per_group = input_dims[1] / group;
+    const int input_size   = input_dims[2] * input_dims[3];
+    const int output_size  = output_dims[2] * output_dims[3];
+    const int kernel_y     = param->kernels[1];
+    const int kernel_x     = param->kernels[0];
+    const int gemm_n       = oc_per_group * kernel_y * kernel_x;
+    const int packed_size  = GetSgemmPackedBSize(ic_per_group, gemm_n);
+    const bool is_float    = std::is_same<T, float>::value;
+    if (col_buffer_.GetBytesSize() < gemm_n * input_size * sizeof(float)) {
+        col_buffer_ = RawBuffer(gemm_n * input_size * sizeof(float));
+    }
+    if (!is_float && output_float_buffer_.GetBytesSize() < oc_per_group * output_size * sizeof(float)) {
+        output_float_buffer_ = RawBuffer(oc_per_group * output_size * sizeof(float));
+    }
+
+    const T *input      = static_cast<T *>(inputs[0]->GetHandle().base);
+    T *output           = static_cast<T *>(outputs[0]->GetHandle().base);
+    const float *bias   = param->bias ? resource->bias_handle.force_to<float *>() : nullptr;
+    const float *packed = packed_weight_.force_to<float *>();
+    float *col          = col_buffer_.force_to<float *>();
+    for (int n = 0; n < batch; ++n) {
+        for (int g = 0; g < group; ++g) {
+            const T *input_g = input + (n * input_dims[1] + g * ic_per_group) * input_size;
+            T *output_g      = output + (n * output_dims[1] + g * oc_per_group) * output_size;
+            float *fold_g    = is_float ? (float *)output_g : output_float_buffer_.force_to<float *>();
+            CpuSgemm(input_size, gemm_n, ic_per_group, input_g, input_size, true, packed + g * packed_size, col,
+                     input_size, true, nullptr, ActivationType_None);
+
+            for (int oc = 0; oc < oc_per_group; ++oc) {
+                const float value = bias ? bias[g * oc_per_group + oc] : 0.0f;
+                std::fill(fold_g + oc * output_size, fold_g + (oc + 1) * output_size, value);
+            }
+            CpuCol2Im(col, oc_per_group, output_dims[2], output_dims[3], kernel_y, kernel_x, param->pads[2],
+                      param->pads[0], param->strides[1], param->strides[0], param->dialations[1],
+                      param->dialations[0], input_dims[2], input_dims[3], fold_g);
+
+            // post op : only support relu and relu6
+            const int count = oc_per_group * output_size;
+            if (param->activation_type == ActivationType_ReLU) {
+                for (int i = 0; i < count; ++i) {
+                    fold_g[i] = std::max(fold_g[i], 0.0f);
+                }
+            } else if (param->activation_type == ActivationType_ReLU6) {
+                for (int i = 0; i < count; ++i) {
+                    fold_g[i] = std::min(std::max(fold_g[i], 0.0f), 6.0f);
+                }
+            }
+            if (!is_float) {
+                ConvertFromFloatToBFP16(fold_g, output_g, count);
+            }
+        }
+    }
+    return TNN_OK;
+}
+
 template <typename T>
 Status CpuDeconvLayerAcc::Exec(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param    = dynamic_cast<ConvLayerParam *>(param_);
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "tnn/core/blob.h"
+#include "tnn/device/cpu/acc/compute/compute_gemm.h"
 #include "tnn/device/cpu/acc/cpu_layer_acc.h"
 #include "tnn/device/cpu/cpu_device.h"
 
@@ -31,6 +32,10 @@ class CpuDeconvLayerAcc : public CpuLayerAcc {
     Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
                 const std::vector<Blob *> &outputs);
 
+    virtual Status InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
+
     virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
     template <typename T>
@@ -39,7 +44,15 @@ class CpuDeconvLayerAcc : public CpuLayerAcc {
     virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 private:
+    template <typename T>
+    Status ForwardSgemm(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     RawBuffer buffer_scale_;
+    // weights of each group packed for CpuSgemm, empty if the outputs are not float or bfp16
+    RawBuffer packed_weight_;
+    RawBuffer col_buffer_;
+    // fp32 output of a group of a bfp16 deconv, col2im accumulates in fp32
+    RawBuffer output_float_buffer_;
 };
 
 }  // namespace TNN_NS
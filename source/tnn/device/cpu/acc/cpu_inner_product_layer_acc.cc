@@ -13,9 +13,9 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/core/blob_int8.h"
+#include "tnn/device/cpu/acc/compute/compute_gemm.h"
 #include "tnn/device/cpu/acc/cpu_layer_acc.h"
 #include "tnn/utils/bfp16.h"
-#include "tnn/utils/bfp16_utils.h"
 #include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
@@ -27,13 +27,29 @@ public:
     virtual ~CpuInnerProductLayerAcc(){};
     Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
                 const std::vector<Blob *> &outputs);
+
+    virtual Status InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+    virtual Status ShareWeightsFrom(AbstractLayerAcc *acc) override;
     virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 private:
     RawBuffer buffer_scale_;
+    // weights packed for CpuSgemm, empty if the outputs are not float or bfp16
+    RawBuffer packed_weight_;
 };
 
+/*
+weights packed by the same acc of another instance are reused,
+InitWeights skips packing when packed_weight_ already holds the packed weights
+*/
+Status CpuInnerProductLayerAcc::ShareWeightsFrom(AbstractLayerAcc *acc) {
+    auto fc_acc = dynamic_cast<CpuInnerProductLayerAcc *>(acc);
+    CHECK_PARAM_NULL(fc_acc);
+    packed_weight_ = fc_acc->packed_weight_;
+    return TNN_OK;
+}
+
 Status CpuInnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto status = CpuLayerAcc::Init(context, param, resource, inputs, outputs);
@@ -73,6 +89,27 @@ Status CpuInnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerR
     return TNN_OK;
 }
 
+Status CpuInnerProductLayerAcc::InitWeights(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT &&
+        outputs[0]->GetBlobDesc().data_type != DATA_TYPE_BFP16) {
+        return TNN_OK;
+    }
+    auto layer_param = dynamic_cast<InnerProductLayerParam *>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    auto layer_res = dynamic_cast<InnerProductLayerResource *>(resource_);
+    CHECK_PARAM_NULL(layer_res);
+
+    // weights (num_output x ic) are the transposed B of the sgemm, they stay fp32 for bfp16 blobs
+    const int num_output = layer_param->num_output;
+    const int ic         = layer_res->weight_handle.GetDataCount() / num_output;
+    if (packed_weight_.GetBytesSize() != GetSgemmPackedBSize(ic, num_output) * sizeof(float)) {
+        packed_weight_ = RawBuffer(GetSgemmPackedBSize(ic, num_output) * sizeof(float));
+        PackSgemmB(layer_res->weight_handle.force_to<float *>(), ic, true, ic, num_output,
+                   packed_weight_.force_to<float *>());
+    }
+    return TNN_OK;
+}
+
 Status CpuInnerProductLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     return TNN_OK;
 }
@@ -103,18 +140,16 @@ Status CpuInnerProductLayerAcc::Forward(const std::vector<Blob *> &inputs, const
 
     auto dims_input  = input_blob->GetBlobDesc().dims;
     auto dims_output = output_blob->GetBlobDesc().dims;
+    const int ic     = dims_input[1] * dims_input[2] * dims_input[3];
     if (output_blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
-        NaiveFC((float *)input_data, (float *)output_data, (float *)weight_data, (float *)bias_data, dims_input,
-                dims_output);
+        CpuSgemm(dims_output[0], num_output, ic, (float *)input_data, ic, false, packed_weight_.force_to<float *>(),
+                 (float *)output_data, num_output, false, (float *)bias_data, ActivationType_None);
     } else if (output_blob->GetBlobDesc().data_type == DATA_TYPE_INT8) {
         NaiveFC(input_data, output_data, weight_data, buffer_scale_.force_to<float *>(),
                 dims_output[1], bias_data, dims_input, dims_output);
     } else if (output_blob->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
-        RawBuffer weight_bf16 = RawBuffer(resource->weight_handle.GetDataCount() * sizeof(bfp16_t));
-        ConvertFromFloatToBFP16((float *)weight_data, weight_bf16.force_to<void *>(),
-                                resource->weight_handle.GetDataCount());
-        NaiveFC((bfp16_t *)input_data, (bfp16_t *)output_data, weight_bf16.force_to<bfp16_t *>(), (float *)bias_data,
-                dims_input, dims_output);
+        CpuSgemm(dims_output[0], num_output, ic, (bfp16_t *)input_data, ic, false, packed_weight_.force_to<float *>(),
+                 (bfp16_t *)output_data, num_output, false, (float *)bias_data, ActivationType_None);
     } else {
         return Status(TNNERR_MODEL_ERR, "blob type is unsupported");
     }
@@ -13,12 +13,24 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/utils/naive_compute.h"
+#include "tnn/device/cpu/acc/compute/compute_pool.h"
 #include "tnn/device/cpu/acc/cpu_layer_acc.h"
 #include "tnn/utils/bfp16.h"
 
 namespace TNN_NS {
 
-DECLARE_CPU_ACC(Pool, LAYER_POOLING);
+// DECLARE_CPU_ACC(Pool, LAYER_POOLING);
+
+class CpuPoolLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuPoolLayerAcc(){};
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    // packed blocks of CpuPooling, grown to the largest shape forwarded
+    RawBuffer buffer_;
+};
 
 Status CpuPoolLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     return TNN_OK;
@@ -47,14 +59,21 @@ Status CpuPoolLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::ve
     auto input_width = dims_input[3], input_height = dims_input[2];
     auto output_width = dims_output[3], output_height = dims_output[2], output_channel = dims_output[1];
 
+    if (output->GetBlobDesc().data_type == DATA_TYPE_FLOAT || output->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
+        const int buffer_size = GetCpuPoolingBufferSize(dims_input, dims_output);
+        if (buffer_.GetBytesSize() < buffer_size * sizeof(float)) {
+            buffer_ = RawBuffer(buffer_size * sizeof(float));
+        }
+    }
+
     if (output->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
-        NaivePooling<float, float>(reinterpret_cast<float *>(input->GetHandle().base),
-                                    reinterpret_cast<float *>(output->GetHandle().base), dims_input, dims_output,
-                                    stride_y, stride_x, kernel_y, kernel_x, pad_y, pad_x, pool_type);
+        CpuPooling(reinterpret_cast<float *>(input->GetHandle().base),
+                   reinterpret_cast<float *>(output->GetHandle().base), dims_input, dims_output, stride_y, stride_x,
+                   kernel_y, kernel_x, pad_y, pad_x, pool_type, buffer_.force_to<float *>());
     } else if (output->GetBlobDesc().data_type == DATA_TYPE_BFP16) {
-        NaivePooling<bfp16_t, float>(reinterpret_cast<bfp16_t *>(input->GetHandle().base),
-                                    reinterpret_cast<bfp16_t *>(output->GetHandle().base), dims_input, dims_output,
-                                    stride_y, stride_x, kernel_y, kernel_x, pad_y, pad_x, pool_type);
+        CpuPooling(reinterpret_cast<bfp16_t *>(input->GetHandle().base),
+                   reinterpret_cast<bfp16_t *>(output->GetHandle().base), dims_input, dims_output, stride_y, stride_x,
+                   kernel_y, kernel_x, pad_y, pad_x, pool_type, buffer_.force_to<float *>());
     } else if (output->GetBlobDesc().data_type == DATA_TYPE_INT8) {
         NaivePooling<int8_t, int32_t>(reinterpret_cast<int8_t *>(input->GetHandle().base),
                                     reinterpret_cast<int8_t *>(output->GetHandle().base), dims_input, dims_output,
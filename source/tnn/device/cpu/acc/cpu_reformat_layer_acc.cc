@@ -15,6 +15,7 @@
 #include "tnn/core/blob_int8.h"
 #include "tnn/utils/naive_compute.h"
 #include "tnn/device/cpu/acc/cpu_layer_acc.h"
+#include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
 #include "tnn/utils/dims_vector_utils.h"
 
@@ -54,18 +55,31 @@ class CpuReformatLayerAcc : public CpuLayerAcc {
 
 CpuReformatLayerAcc::~CpuReformatLayerAcc() {}
 
-Status CpuReformatLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
-                                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    auto reformat_param = dynamic_cast<ReformatLayerParam *>(param);
-    CHECK_PARAM_NULL(reformat_param);
-
+static Status SetReformatType(ReformatLayerParam *reformat_param) {
     if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
         reformat_param->type = DEQUANT_ONLY;
     } else if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->dst_type == DATA_TYPE_INT8) {
         reformat_param->type = QUANT_ONLY;
+    } else if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->dst_type == DATA_TYPE_FLOAT &&
+               reformat_param->src_format != reformat_param->dst_format) {
+        reformat_param->type = FORMAT_ONLY;
     } else {
         return Status(TNNERR_LAYER_ERR, "Error: cpu layer acc got unsupported data type.");
     }
+    return TNN_OK;
+}
+
+Status CpuReformatLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                 const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto reformat_param = dynamic_cast<ReformatLayerParam *>(param);
+    CHECK_PARAM_NULL(reformat_param);
+
+    RETURN_ON_NEQ(SetReformatType(reformat_param), TNN_OK);
+    if (reformat_param->type == FORMAT_ONLY) {
+        for (auto blob : outputs) {
+            blob->GetBlobDesc().data_format = reformat_param->dst_format;
+        }
+    }
     return CpuLayerAcc::Init(context, param, resource, inputs, outputs);
 }
 
@@ -73,14 +87,7 @@ Status CpuReformatLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std
     auto reformat_param = dynamic_cast<ReformatLayerParam *>(param_);
     CHECK_PARAM_NULL(reformat_param);
 
-    if (reformat_param->src_type == DATA_TYPE_INT8 && reformat_param->dst_type == DATA_TYPE_FLOAT) {
-        reformat_param->type = DEQUANT_ONLY;
-    } else if (reformat_param->src_type == DATA_TYPE_FLOAT && reformat_param->dst_type == DATA_TYPE_INT8) {
-        reformat_param->type = QUANT_ONLY;
-    } else {
-        return Status(TNNERR_LAYER_ERR, "Error: cpu layer acc got unsupported data type.");
-    }
-    return TNN_OK;
+    return SetReformatType(reformat_param);
 }
 
 Status CpuReformatLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
@@ -89,6 +96,29 @@ Status CpuReformatLayerAcc::Forward(const std::vector<Blob *> &inputs, const std
     auto dims       = outputs[0]->GetBlobDesc().dims;
     size_t datasize = DataTypeUtils::GetBytesSize(outputs[0]->GetBlobDesc().data_type);
 
+    if (param->type == FORMAT_ONLY) {
+        if (dims.size() != 4) {
+            return Status(TNNERR_LAYER_ERR, "Error: cpu reformat only support 4 dims blobs.");
+        }
+        auto src = reinterpret_cast<float *>(inputs[0]->GetHandle().base);
+        auto dst = reinterpret_cast<float *>(outputs[0]->GetHandle().base);
+        if (param->src_format == DATA_FORMAT_NCHW) {
+            return DataFormatConverter::ConvertFromNCHWToPackedFloat(src, dst, param->dst_format, dims[0], dims[1],
+                                                                     dims[2], dims[3]);
+        } else if (param->dst_format == DATA_FORMAT_NCHW) {
+            return DataFormatConverter::ConvertFromPackedToNCHWFloat(src, dst, param->src_format, dims[0], dims[1],
+                                                                     dims[2], dims[3]);
+        }
+        // between two packed formats through nchw
+        RawBuffer nchw_buffer(DimsVectorUtils::Count(dims) * sizeof(float));
+        RETURN_ON_NEQ(DataFormatConverter::ConvertFromPackedToNCHWFloat(src, nchw_buffer.force_to<float *>(),
+                                                                        param->src_format, dims[0], dims[1], dims[2],
+                                                                        dims[3]),
+                      TNN_OK);
+        return DataFormatConverter::ConvertFromNCHWToPackedFloat(nchw_buffer.force_to<float *>(), dst,
+                                                                 param->dst_format, dims[0], dims[1], dims[2], dims[3]);
+    }
+
     IntScaleResource *re;
     if (param->src_type == DATA_TYPE_INT8) {
         re = reinterpret_cast<BlobInt8 *>(inputs[0])->GetIntResource();
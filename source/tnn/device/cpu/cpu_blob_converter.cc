@@ -22,6 +22,8 @@
 #include "tnn/utils/naive_compute.h"
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/bfp16_utils.h"
+#include "tnn/utils/blob_memory_size_utils.h"
+#include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/dims_vector_utils.h"
 
 namespace TNN_NS {
@@ -240,6 +242,18 @@ Status CpuBlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param,
         }
     }
 
+    // the mats are nchw, float blobs packed by channels are unpacked first
+    RawBuffer nchw_buffer;
+    if (desc.data_type == DATA_TYPE_FLOAT && GetChannelPackSize(desc.data_format) > 1) {
+        nchw_buffer = RawBuffer(DimsVectorUtils::Count(dims) * sizeof(float));
+        ret = DataFormatConverter::ConvertFromPackedToNCHWFloat(blob_data, nchw_buffer.force_to<float *>(),
+                                                                desc.data_format, dims[0], dims[1], dims[2], dims[3]);
+        if (ret != TNN_OK) {
+            return ret;
+        }
+        blob_data = nchw_buffer.force_to<float *>();
+    }
+
     if (image.GetMatType() == NCHW_FLOAT) {
         memcpy(reinterpret_cast<float *>(image.GetData()), blob_data, DimsVectorUtils::Count(dims) * sizeof(float));
     } else if (image.GetMatType() == N8UC4) {
@@ -285,6 +299,13 @@ Status CpuBlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam para
         } else
             blob_data = new float[dims[0] * dims[1] * hw];
     }
+    // the mats are nchw, float blobs packed by channels are packed at last
+    RawBuffer nchw_buffer;
+    const bool packed_blob = desc.data_type == DATA_TYPE_FLOAT && GetChannelPackSize(desc.data_format) > 1;
+    if (packed_blob) {
+        nchw_buffer = RawBuffer(DimsVectorUtils::Count(dims) * sizeof(float));
+        blob_data   = nchw_buffer.force_to<float *>();
+    }
 
     if (image.GetMatType() == NCHW_FLOAT) {
         memcpy(blob_data, reinterpret_cast<float *>(image.GetData()), DimsVectorUtils::Count(dims) * sizeof(float));
@@ -335,6 +356,10 @@ Status CpuBlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam para
         auto real_blob_data = reinterpret_cast<int8_t *>(blob_->GetHandle().base);
         CPU_QUANT(blob_data, blob_scale, dims[1], real_blob_data, dims);
         delete[] blob_data;
+    } else if (packed_blob) {
+        return DataFormatConverter::ConvertFromNCHWToPackedFloat(blob_data,
+                                                                 reinterpret_cast<float *>(blob_->GetHandle().base),
+                                                                 desc.data_format, dims[0], dims[1], dims[2], dims[3]);
     }
     return TNN_OK;
 }
@@ -14,6 +14,8 @@
 
 #include "tnn/device/cpu/cpu_context.h"
 
+#include "tnn/utils/omp_utils.h"
+
 namespace TNN_NS {
 
 Status CpuContext::LoadLibrary(std::vector<std::string> path) {
@@ -25,6 +27,13 @@ Status CpuContext::GetCommandQueue(void** command_queue) {
 }
 
 Status CpuContext::OnInstanceForwardBegin() {
+    Status ret = Context::OnInstanceForwardBegin();
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    if (num_threads_ > 0) {
+        OMP_SET_THREADS_(num_threads_);
+    }
     return TNN_OK;
 }
 
@@ -36,4 +45,13 @@ Status CpuContext::Synchronize() {
     return TNN_OK;
 }
 
+Status CpuContext::SetNumThreads(int num_threads) {
+    num_threads_ = MIN(MAX(num_threads, 1), OMP_CORES_);
+    return TNN_OK;
+}
+
+int CpuContext::GetNumThreads() {
+    return num_threads_ > 0 ? num_threads_ : OMP_MAX_THREADS_NUM_;
+}
+
 }  // namespace TNN_NS
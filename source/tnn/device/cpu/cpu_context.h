@@ -39,6 +39,15 @@ public:
 
     // @brief wait for jobs in the current context to complete
     virtual Status Synchronize() override;
+
+    // @brief set threads run on cpu
+    virtual Status SetNumThreads(int num_threads) override;
+
+    // @brief get threads run on cpu, the openmp default if never set
+    virtual int GetNumThreads() override;
+
+private:
+    int num_threads_ = 0;
 };
 
 }  // namespace TNN_NS
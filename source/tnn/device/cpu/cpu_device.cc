@@ -15,6 +15,7 @@
 #include "tnn/device/cpu/cpu_device.h"
 #include "tnn/device/cpu/cpu_context.h"
 #include "tnn/utils/blob_memory_size_utils.h"
+#include "tnn/utils/memory_tracker.h"
 
 namespace TNN_NS {
 
@@ -43,13 +44,16 @@ Status CpuDevice::Allocate(void** handle, MatType mat_type, DimsVector dims) {
 
 Status CpuDevice::Allocate(void** handle, BlobMemorySizeInfo& size_info) {
     if (handle) {
-        *handle = malloc(GetBlobMemoryBytesSize(size_info));
+        int bytes_size = GetBlobMemoryBytesSize(size_info);
+        *handle        = malloc(bytes_size);
+        TrackDeviceMemory(*handle, bytes_size);
     }
     return TNN_OK;
 }
 
 Status CpuDevice::Free(void* handle) {
     if (handle) {
+        UntrackDeviceMemory(handle);
         free(handle);
     }
     return TNN_OK;
@@ -81,6 +81,7 @@ Status NpuNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config, Ab
     auto *default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter);
     net_structure_            = default_interpreter->GetNetStructure();
     model_name_               = NpuUtils::GetFileHash(model_config);
+    benchmark_mode_           = model_config.benchmark_mode;
     std::vector<std::shared_ptr<hiai::AiModelDescription>> model_desc;
     InputShapesMap instance_input_shapes_map = net_structure_->inputs_shape_map;
     InputShapesMap cpu_input_shape;
@@ -451,30 +452,25 @@ Status NpuNetwork::ConvertLayers(NetResource *net_resource) {
 
         // set layer nodes
         std::vector<std::shared_ptr<OperatorInfo>> input_ops;
-#ifdef BENCHMARK
-        std::vector<Blob *> input_blobs;
-        BlobDesc blob_desc;
-#endif
         for (std::string &name : layer_info->inputs) {
             input_ops.push_back(global_operator_map_[name]);
-#ifdef BENCHMARK
-            blob_desc.dims = global_operator_map_[name]->GetShape();
-            Blob *blob     = new Blob(blob_desc);
-            input_blobs.push_back(blob);
-#endif
         }
-#ifdef BENCHMARK
         // generate resource if null
-        if (net_resource->resource_map.count(layer_name) == 0) {
+        if (benchmark_mode_ && net_resource->resource_map.count(layer_name) == 0) {
+            std::vector<Blob *> input_blobs;
+            BlobDesc blob_desc;
+            for (auto &input_op : input_ops) {
+                blob_desc.dims = input_op->GetShape();
+                input_blobs.push_back(new Blob(blob_desc));
+            }
             LayerParam *layer_param  = layer_info->param.get();
             LayerResource *layer_res = nullptr;
             GenerateRandomResource(type, layer_param, &layer_res, input_blobs);
             net_resource->resource_map[layer_name] = std::shared_ptr<LayerResource>(layer_res);
+            for (auto &blob : input_blobs) {
+                delete (blob);
+            }
         }
-        for (auto &blob : input_blobs) {
-            delete (blob);
-        }
-#endif
         LayerResource *layer_resource = net_resource->resource_map[layer_name].get();
         /*
          * cur_layer->convert
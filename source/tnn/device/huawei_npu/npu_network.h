@@ -128,6 +128,8 @@ private:
     bool from_path_ = true;
     // the name of the model
     std::string model_name_;
+    // generate missing resources, set by ModelConfig
+    bool benchmark_mode_ = false;
     int version_num_ = 0;
     std::shared_ptr<hiai::AiModelMngerClient> client_;
     std::vector<std::shared_ptr<hiai::AiTensor>> input_tensor_;
@@ -17,8 +17,9 @@
 namespace TNN_NS {
 
 DefaultModelInterpreter::DefaultModelInterpreter() {
-    net_structure_ = new NetStructure();
-    net_resource_  = new NetResource();
+    net_structure_  = new NetStructure();
+    net_resource_   = new NetResource();
+    memory_tracker_ = std::make_shared<MemoryTracker>();
 }
 
 DefaultModelInterpreter::~DefaultModelInterpreter() {
@@ -34,4 +35,16 @@ NetResource *DefaultModelInterpreter::GetNetResource() {
     return net_resource_;
 }
 
+void DefaultModelInterpreter::SetBenchmarkMode(bool benchmark_mode) {
+    benchmark_mode_ = benchmark_mode;
+}
+
+bool DefaultModelInterpreter::IsBenchmarkMode() {
+    return benchmark_mode_;
+}
+
+std::shared_ptr<MemoryTracker> DefaultModelInterpreter::GetMemoryTracker() {
+    return memory_tracker_;
+}
+
 }  // namespace TNN_NS
@@ -19,6 +19,7 @@
 #include "tnn/interpreter/abstract_model_interpreter.h"
 #include "tnn/interpreter/net_resource.h"
 #include "tnn/interpreter/net_structure.h"
+#include "tnn/utils/memory_tracker.h"
 
 namespace TNN_NS {
 
@@ -41,9 +42,20 @@ public:
     //@brief GetNetResource return network weights data
     virtual NetResource *GetNetResource();
 
+    //@brief SetBenchmarkMode allow empty model content, set before Interpret
+    void SetBenchmarkMode(bool benchmark_mode);
+
+    //@brief IsBenchmarkMode return whether missing weights will be generated
+    bool IsBenchmarkMode();
+
+    //@brief GetMemoryTracker return the tracker counting memory of the net resource
+    std::shared_ptr<MemoryTracker> GetMemoryTracker();
+
 private:
     NetStructure *net_structure_;
     NetResource *net_resource_;
+    bool benchmark_mode_ = false;
+    std::shared_ptr<MemoryTracker> memory_tracker_;
 };
 
 }  // namespace TNN_NS
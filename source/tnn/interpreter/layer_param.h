@@ -264,7 +264,9 @@ typedef enum {
     DEQUANT_ONLY = 1,
     // data_type + layout for arm
     QUANT_NCHW4_2_NHWC   = 2,
-    DEQUANT_NHWC_2_NCHW4 = 3
+    DEQUANT_NHWC_2_NCHW4 = 3,
+    // only data_format, eg. nchw to the channel packed formats
+    FORMAT_ONLY = 4
     // to be continued
 } ReformatType;
 
@@ -15,6 +15,9 @@
 #include "tnn/interpreter/layer_resource_generator.h"
 
 #include <mutex>
+#include <random>
+
+#include "tnn/utils/data_type_utils.h"
 
 namespace TNN_NS {
 
@@ -28,11 +31,42 @@ std::map<LayerType, std::shared_ptr<LayerResourceGenerator>>& GetGlobalLayerReso
 Status GenerateRandomResource(LayerType type, LayerParam* param, LayerResource** resource, std::vector<Blob*>& inputs) {
     auto& layer_resource_generator_map = GetGlobalLayerResourceGeneratorMap();
     if (layer_resource_generator_map.count(type) > 0) {
-        auto generator = layer_resource_generator_map[type]->GenLayerResource(param, resource, inputs);
+        return layer_resource_generator_map[type]->GenLayerResource(param, resource, inputs);
     }
     return TNN_OK;
 }
 
+/*
+ * Fill the buffer with uniform random data in [low, high] according to its
+ * data type, so that the kernels run on non-trivial weights and scales.
+ */
+static void GenerateRandomData(RawBuffer& buffer, float low, float high) {
+    // resources may be generated by several networks at once
+    static std::mutex generator_mtx;
+    static std::mt19937 generator(2020);
+    std::unique_lock<std::mutex> lck(generator_mtx);
+    std::uniform_real_distribution<float> distribution(low, high);
+
+    const DataType data_type = buffer.GetDataType();
+    const int count          = buffer.GetBytesSize() / DataTypeUtils::GetBytesSize(data_type);
+    if (data_type == DATA_TYPE_INT8) {
+        auto data = buffer.force_to<int8_t*>();
+        for (int i = 0; i < count; ++i) {
+            data[i] = static_cast<int8_t>(distribution(generator));
+        }
+    } else if (data_type == DATA_TYPE_INT32) {
+        auto data = buffer.force_to<int32_t*>();
+        for (int i = 0; i < count; ++i) {
+            data[i] = static_cast<int32_t>(distribution(generator));
+        }
+    } else if (data_type == DATA_TYPE_FLOAT) {
+        auto data = buffer.force_to<float*>();
+        for (int i = 0; i < count; ++i) {
+            data[i] = distribution(generator);
+        }
+    }
+}
+
 /*
  * Generate conv resource
  */
@@ -53,13 +87,18 @@ class ConvolutionLayerResourceGenerator : public LayerResourceGenerator {
             layer_res->filter_handle.SetDataType(DATA_TYPE_INT8);
             layer_res->bias_handle.SetDataType(DATA_TYPE_INT32);
             layer_res->scale_handle.SetDataType(DATA_TYPE_FLOAT);
+            GenerateRandomData(layer_res->filter_handle, -127.f, 127.f);
+            GenerateRandomData(layer_res->bias_handle, -1024.f, 1024.f);
+            GenerateRandomData(layer_res->scale_handle, 0.001f, 0.01f);
         } else {
             layer_res->filter_handle =
                 RawBuffer(dims[1]* layer_param->output_channel * layer_param->kernels[0] *
                           layer_param->kernels[1] / layer_param->group * sizeof(float));
+            GenerateRandomData(layer_res->filter_handle, -1.f, 1.f);
 
             if (layer_param->bias) {
                 layer_res->bias_handle = RawBuffer(layer_param->output_channel * sizeof(float));
+                GenerateRandomData(layer_res->bias_handle, -1.f, 1.f);
             }
         }
 
@@ -93,11 +132,16 @@ class InnerProductLayerResourceGenerator : public LayerResourceGenerator {
             layer_res->weight_handle.SetDataType(DATA_TYPE_INT8);
             layer_res->bias_handle.SetDataType(DATA_TYPE_INT32);
             layer_res->scale_handle.SetDataType(DATA_TYPE_FLOAT);
+            GenerateRandomData(layer_res->weight_handle, -127.f, 127.f);
+            GenerateRandomData(layer_res->bias_handle, -1024.f, 1024.f);
+            GenerateRandomData(layer_res->scale_handle, 0.001f, 0.01f);
         } else {
             layer_res->weight_handle = RawBuffer(layer_param->num_output * dims[1] * dims[2] * dims[3] * sizeof(float));
+            GenerateRandomData(layer_res->weight_handle, -1.f, 1.f);
 
             if (layer_param->has_bias) {
                 layer_res->bias_handle = RawBuffer(layer_param->num_output * sizeof(float));
+                GenerateRandomData(layer_res->bias_handle, -1.f, 1.f);
             }
         }
 
@@ -118,6 +162,8 @@ class BatchnormLayerResourceGenerator : public LayerResourceGenerator {
 
         layer_res->scale_handle = RawBuffer(dims[1] * sizeof(float));
         layer_res->bias_handle  = RawBuffer(dims[1] * sizeof(float));
+        GenerateRandomData(layer_res->scale_handle, 0.5f, 1.5f);
+        GenerateRandomData(layer_res->bias_handle, -1.f, 1.f);
 
         *resource = layer_res;
         return TNN_OK;
@@ -136,6 +182,8 @@ class InstanceNormLayerResourceGenerator : public LayerResourceGenerator {
 
         layer_res->scale_handle = RawBuffer(dims[1] * sizeof(float));
         layer_res->bias_handle  = RawBuffer(dims[1] * sizeof(float));
+        GenerateRandomData(layer_res->scale_handle, 0.5f, 1.5f);
+        GenerateRandomData(layer_res->bias_handle, -1.f, 1.f);
 
         *resource = layer_res;
         return TNN_OK;
@@ -153,6 +201,7 @@ class PReluLayerResourceGenerator : public LayerResourceGenerator {
         auto dims = inputs[0]->GetBlobDesc().dims;
 
         layer_res->slope_handle = RawBuffer(dims[1] * sizeof(float));
+        GenerateRandomData(layer_res->slope_handle, 0.f, 0.5f);
 
         *resource = layer_res;
         return TNN_OK;
@@ -173,6 +222,8 @@ class BlobScaleLayerResourceGenerator : public LayerResourceGenerator {
         layer_res->bias_handle  = RawBuffer(dims[1] * sizeof(int32_t));
         layer_res->scale_handle.SetDataType(DATA_TYPE_FLOAT);
         layer_res->bias_handle.SetDataType(DATA_TYPE_INT32);
+        // int8 values of blobs in about [-8, 8]
+        GenerateRandomData(layer_res->scale_handle, 0.05f, 0.07f);
 
         *resource = layer_res;
         return TNN_OK;
@@ -196,6 +247,7 @@ class BinaryLayerResourceGenerator : public LayerResourceGenerator {
             // broad cast in channel
             layer_res->element_shape[1] = dims[1];
             layer_res->element_handle   = RawBuffer(dims[1] * sizeof(float));
+            GenerateRandomData(layer_res->element_handle, -1.f, 1.f);
 
             *resource = layer_res;
         }
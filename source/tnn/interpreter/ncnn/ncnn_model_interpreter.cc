@@ -24,6 +24,7 @@
 #include "tnn/interpreter/ncnn/ncnn_model_interpreter.h"
 #include "tnn/interpreter/ncnn/ncnn_param_utils.h"
 #include "tnn/interpreter/ncnn/optimizer/ncnn_optimizer_manager.h"
+#include "tnn/utils/startup_profile_inner.h"
 
 namespace TNN_NS {
 
@@ -36,15 +37,47 @@ namespace ncnn {
 
     Status NCNNModelInterpreter::Interpret(std::vector<std::string> params) {
         std::string proto_content = params.size() > 0 ? params[0] : "";
+        StartupStageTimer proto_timer("proto parse");
         RETURN_ON_ERROR(InterpretProto(proto_content));
+        proto_timer.Stop();
+
         std::string model_content = params.size() > 1 ? params[1] : "";
+        StartupStageTimer model_timer("resource deserialize");
         RETURN_ON_ERROR(InterpretModel(model_content));
         RETURN_ON_ERROR(NCNNOptimizerManager::Optimize(GetNetStructure(), GetNetResource()));
+        model_timer.Stop();
         RETURN_ON_ERROR(FindOutputs());
 
         return TNN_OK;
     }
 
+    // memory data weights are required by MemoryDataOptimizer before network init,
+    // generate them in benchmark mode
+    Status NCNNModelInterpreter::GenerateConstResource() {
+        NetResource *net_resource = GetNetResource();
+        NetStructure *structure   = GetNetStructure();
+
+        for (auto layer : structure->layers) {
+            auto const_param = dynamic_cast<ConstLayerParam *>(layer->param.get());
+            if (const_param == nullptr || net_resource->resource_map.count(layer->name) > 0) {
+                continue;
+            }
+
+            int weight_size = 1;
+            for (auto dim_i : const_param->dims) {
+                weight_size *= dim_i;
+            }
+            auto const_res           = std::make_shared<ConstLayerResource>();
+            const_res->weight_handle = RawBuffer(weight_size * sizeof(float));
+            for (int i = 0; i < weight_size; i++) {
+                const_res->weight_handle.force_to<float *>()[i] = 1.0;
+            }
+            net_resource->resource_map[layer->name] = const_res;
+        }
+
+        return TNN_OK;
+    }
+
     Status NCNNModelInterpreter::FindOutputs() {
         NetStructure *structure = GetNetStructure();
         auto layers             = structure->layers;
@@ -237,11 +270,10 @@ namespace ncnn {
 
         const auto model_length = model_content.length();
         if (model_length <= 0) {
-#ifdef BENCHMARK
-            return TNN_OK;
-#else
+            if (IsBenchmarkMode()) {
+                return GenerateConstResource();
+            }
             return Status(TNNERR_LOAD_MODEL, "model content is invalid");
-#endif
         }
 
         std::istringstream content_stream;
@@ -45,6 +45,7 @@ namespace ncnn {
         Status InterpretProto(std::string content);
         Status InterpretModel(std::string model_content);
         Status InterpretInput();
+        Status GenerateConstResource();
 
         Status FindOutputs();
         Status Convert(shared_ptr<LayerInfo> cur_layer, std::vector<std::shared_ptr<LayerInfo>> output_layers);
@@ -76,19 +76,7 @@ namespace ncnn {
 
             weights = const_res->weight_handle;
         } else {
-#ifdef BENCHMARK
-            // generate weights in benchmark mode
-            int weight_size = 1;
-            for (auto dim_i : const_param->dims) {
-                weight_size *= dim_i;
-            }
-            weights = RawBuffer(weight_size * sizeof(float));
-            for (int i = 0; i < weight_size; i++) {
-                weights.force_to<float *>()[i] = 1.0;
-            }
-#else
             return Status(TNNERR_NET_ERR, "Error: not found const weights.");
-#endif
         }
 
         ele_res->element_handle = weights;
@@ -47,6 +47,10 @@ struct NetStructure {
     std::set<std::string> outputs;
     std::vector<std::shared_ptr<LayerInfo>> layers;
     std::set<std::string> blobs;
+    // static nchw shapes of the blobs known by the converters, empty if unknown
+    std::map<std::string, DimsVector> blobs_shape_map;
+    // memory slots of the blobs produced by the layers for the shapes of blobs_shape_map, empty if not planned
+    std::map<std::string, int> blobs_memory_slot_map;
     ModelType source_model_type = MODEL_TYPE_TNN;
 };
 
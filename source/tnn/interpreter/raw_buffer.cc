@@ -19,10 +19,25 @@
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/bfp16_utils.h"
 #include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/memory_tracker.h"
 
 using namespace TNN_NS;
 
 namespace TNN_NS {
+
+// the buffer is counted to the memory tracker of the current scope until freed
+static shared_ptr<char> AllocateBuffer(int bytes_size) {
+    auto counter = GetCurrentMemoryCounter();
+    if (!counter) {
+        return shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
+    }
+    counter->Add(bytes_size);
+    return shared_ptr<char>(new char[bytes_size], [counter, bytes_size](char *p) {
+        counter->Sub(bytes_size);
+        delete[] p;
+    });
+}
+
 RawBuffer::~RawBuffer() {
     buff_ = nullptr;
 }
@@ -33,13 +48,13 @@ RawBuffer::RawBuffer() {
 }
 
 RawBuffer::RawBuffer(int bytes_size) {
-    buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
+    buff_ = AllocateBuffer(bytes_size);
     memset(buff_.get(), 0, bytes_size);
     bytes_size_ = bytes_size;
 }
 
 RawBuffer::RawBuffer(int bytes_size, char *buffer) {
-    buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
+    buff_ = AllocateBuffer(bytes_size);
     memcpy(buff_.get(), buffer, bytes_size);
     bytes_size_ = bytes_size;
 }
@@ -93,7 +108,7 @@ void RawBuffer::buffer(char *buf, int bytes_size) {
         return;
     }
     if (!buff_) {
-        buff_ = shared_ptr<char>(new char[bytes_size_], [](char *p) { delete[] p; });
+        buff_ = AllocateBuffer(bytes_size_);
     }
     memcpy(buff_.get(), buf, bytes_size);
     // buff_ = buf;
@@ -19,6 +19,7 @@
 #include "tnn/core/common.h"
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/utils/startup_profile_inner.h"
 
 namespace TNN_NS {
 
@@ -41,11 +42,15 @@ std::shared_ptr<Deserializer> ModelInterpreter::GetDeserializer(std::istream &is
 // Interpret the proto and model.
 Status ModelInterpreter::Interpret(std::vector<std::string> params) {
     auto proto_content = params.size() > 0 ? params[0] : "";
+    StartupStageTimer proto_timer("proto parse");
     Status status = InterpretProto(proto_content);
     if (status != TNN_OK) {
         return status;
     }
+    proto_timer.Stop();
+
     auto model_content = params.size() > 1 ? params[1] : "";
+    StartupStageTimer model_timer("resource deserialize");
     status = InterpretModel(model_content);
     return status;
 }
@@ -119,6 +124,13 @@ Status ModelInterpreter::InterpretProto(std::string content) {
         }
     }
 
+    // the blobs line is checked against the blobs of the layers
+    std::string blobs_content = cfg_arr[2];
+    ret                       = InterpretBlobs(blobs_content);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
     return TNN_OK;
 }
 
@@ -166,6 +178,66 @@ Status ModelInterpreter::InterpretOutput(const std::string &outputs_content) {
     return TNN_OK;
 }
 
+static bool ParseInt(const std::string &str, int &value) {
+    char *end = nullptr;
+    value     = (int)strtol(str.c_str(), &end, 10);
+    return !str.empty() && end != nullptr && *end == '\0';
+}
+
+Status ModelInterpreter::InterpretBlobs(const std::string &blobs_content) {
+    NetStructure *structure = GetNetStructure();
+    str_arr blobs_cfg_vec;
+    /*
+     * the blob line lists the blob names, it is not needed to build the net.
+     * Models packed with the blob memory plan list the static shape and the memory
+     * slot of each blob instead, separated by : symbol
+     * eg:
+     *  input -1 4 1 3 224 224 : conv1 0 4 1 32 112 112 : relu1 1 4 1 32 112 112
+     * the slot of the net inputs is -1.
+     */
+    Status ret = SplitUtils::SplitStr(blobs_content.c_str(), blobs_cfg_vec, ":", true, false);
+    if (ret != TNN_OK) {
+        return Status(TNNERR_INVALID_NETCFG, "split blob line error");
+    }
+
+    std::map<std::string, DimsVector> blobs_shape_map;
+    std::map<std::string, int> blobs_memory_slot_map;
+    for (const auto &blob_cfg : blobs_cfg_vec) {
+        str_arr blob_cfg_vec;
+        ret = SplitUtils::SplitStr(blob_cfg.c_str(), blob_cfg_vec, " ", true, false);
+        int slot = 0, rank = 0;
+        if (ret != TNN_OK || blob_cfg_vec.size() < 3 || !ParseInt(blob_cfg_vec[1], slot) ||
+            !ParseInt(blob_cfg_vec[2], rank) || blob_cfg_vec.size() != 3 + rank) {
+            // a list of blob names
+            return TNN_OK;
+        }
+        DimsVector dims;
+        for (int i = 3; i < blob_cfg_vec.size(); ++i) {
+            int dim = 0;
+            if (!ParseInt(blob_cfg_vec[i], dim)) {
+                return TNN_OK;
+            }
+            dims.push_back(dim);
+        }
+        auto blob_name             = Transfer(blob_cfg_vec[0]);
+        blobs_shape_map[blob_name] = dims;
+        if (slot >= 0) {
+            blobs_memory_slot_map[blob_name] = slot;
+        }
+    }
+
+    // the plan is kept only if it covers the whole net
+    for (const auto &name : structure->blobs) {
+        if (blobs_shape_map.count(name) == 0) {
+            LOGD("blob %s is not in the blob memory plan, ignore the plan\n", name.c_str());
+            return TNN_OK;
+        }
+    }
+    structure->blobs_shape_map       = blobs_shape_map;
+    structure->blobs_memory_slot_map = blobs_memory_slot_map;
+    return TNN_OK;
+}
+
 Status ModelInterpreter::InterpretLayer(const std::string &layer_str) {
     NetStructure *structure     = GetNetStructure();
     auto &layer_interpreter_map = GetLayerInterpreterMap();
@@ -251,12 +323,11 @@ Status ModelInterpreter::InterpretModel(std::string model_content) {
 
     const auto model_length = model_content.length();
     if (model_length <= 0) {
-#ifdef BENCHMARK
-        LOGD("model content is empty, will generate random data\n");
-        return TNN_OK;
-#else
+        if (IsBenchmarkMode()) {
+            LOGD("model content is empty, will generate random data\n");
+            return TNN_OK;
+        }
         return Status(TNNERR_LOAD_MODEL, "model content is invalid");
-#endif
     }
 
     std::istringstream content_stream;
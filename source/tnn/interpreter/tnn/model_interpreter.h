@@ -99,6 +99,7 @@ protected:
     virtual Status InterpretInput(const std::string& inputs_content);
     virtual Status InterpretOutput(const std::string& outputs_content);
     virtual Status InterpretLayer(const std::string& layer_str);
+    virtual Status InterpretBlobs(const std::string& blobs_content);
 
 protected:
     virtual std::string Transfer(std::string content);
@@ -17,6 +17,7 @@
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
 #include "tnn/interpreter/tnn/model_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/memory_manager/blob_memory_plan.h"
 
 namespace TNN_NS {
 
@@ -51,6 +52,10 @@ void ModelPacker::SetVersion(int version) {
     model_version_ = version;
 }
 
+void ModelPacker::SetEmbedMemoryPlan(bool embed_memory_plan) {
+    embed_memory_plan_ = embed_memory_plan;
+}
+
 std::shared_ptr<LayerInfo> ModelPacker::FindLayerInfo(std::string layer_name) {
     std::shared_ptr<LayerInfo> layer_info;
 
@@ -105,11 +110,11 @@ Status ModelPacker::PackProto(std::string file_path) {
     write_stream << ",\"" << std::endl;
 
     // 3rd line: all blobs  " <blob1> <blob2> ... ,"
-    write_stream << "\" ";
-    for (auto item : net_struc->blobs) {
-        write_stream << item << " ";
+    ret = PackBlobs(write_stream);
+    if (ret != TNN_OK) {
+        write_stream.close();
+        return ret;
     }
-    write_stream << ",\"" << std::endl;
 
     // 4th line: "<output_blob1> <output_blob2> .., ,"
     write_stream << "\"";
@@ -169,6 +174,46 @@ Status ModelPacker::PackProto(std::string file_path) {
     return TNN_OK;
 }
 
+Status ModelPacker::PackBlobs(std::ofstream &write_stream) {
+    NetStructure *net_struc = GetNetStructure();
+    if (!embed_memory_plan_) {
+        write_stream << "\" ";
+        for (auto item : net_struc->blobs) {
+            write_stream << item << " ";
+        }
+        write_stream << ",\"" << std::endl;
+        return TNN_OK;
+    }
+
+    // with the memory plan: "<blob1> <slot> <rank> <d0> <d1> ... : <blob2> ... ,"
+    std::map<std::string, int> blob_slots;
+    Status ret = GenerateBlobMemoryPlan(net_struc, blob_slots);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+    write_stream << "\"";
+    int idx = 0;
+    for (auto item : net_struc->blobs) {
+        auto shape_iter = net_struc->blobs_shape_map.find(item);
+        if (shape_iter == net_struc->blobs_shape_map.end()) {
+            LOGE("The shape of blob %s is unknown\n", item.c_str());
+            return Status(TNNERR_PACK_MODEL, "blob memory plan needs the shapes of all blobs");
+        }
+        auto slot_iter = blob_slots.find(item);
+        int slot       = slot_iter == blob_slots.end() ? -1 : slot_iter->second;
+
+        if (idx++ > 0) {
+            write_stream << ": ";
+        }
+        write_stream << Transfer(item) << " " << slot << " " << shape_iter->second.size() << " ";
+        for (auto dim : shape_iter->second) {
+            write_stream << dim << " ";
+        }
+    }
+    write_stream << ",\"" << std::endl;
+    return TNN_OK;
+}
+
 Status ModelPacker::PackModel(std::string file_path) {
     NetResource *net_resource = GetNetResource();
     NetStructure *net_struct  = GetNetStructure();
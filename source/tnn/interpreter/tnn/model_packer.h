@@ -32,15 +32,21 @@ public:
     // @brief set the model version to pack
     void SetVersion(int version);
 
+    // @brief embed the static blob shapes of net_structure->blobs_shape_map and the blob memory plan
+    // for them into the proto, the instances of the default input shape skip the memory planning
+    void SetEmbedMemoryPlan(bool embed_memory_plan);
+
 private:
     std::shared_ptr<LayerInfo> FindLayerInfo(std::string layer_name);
     Status PackProto(std::string file_path);
+    Status PackBlobs(std::ofstream &write_stream);
     Status PackModel(std::string file_path);
     Status PackResource(std::map<std::string, std::shared_ptr<LayerResource>> &resource_map, std::string &layer_name,
                         std::shared_ptr<Serializer> serializer, std::ofstream &write_stream);
 
 protected:
-    int model_version_ = 1;
+    int model_version_      = 1;
+    bool embed_memory_plan_ = false;
 
     virtual std::string Transfer(std::string content);
     virtual uint32_t GetMagicNumber();
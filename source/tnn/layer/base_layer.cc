@@ -34,7 +34,17 @@ BaseLayer::~BaseLayer() {
 }
 
 Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resource, std::vector<Blob*>& input_blobs,
-                       std::vector<Blob*>& output_blobs, AbstractDevice* device) {
+                       std::vector<Blob*>& output_blobs, AbstractDevice* device, BaseLayer* shared_layer) {
+    auto status = InitLayer(context, param, resource, input_blobs, output_blobs, device, shared_layer);
+    if (status != TNN_OK) {
+        return status;
+    }
+    return InitWeights();
+}
+
+Status BaseLayer::InitLayer(Context* context, LayerParam* param, LayerResource* resource,
+                            std::vector<Blob*>& input_blobs, std::vector<Blob*>& output_blobs, AbstractDevice* device,
+                            BaseLayer* shared_layer) {
     input_blobs_  = input_blobs;
     output_blobs_ = output_blobs;
 
@@ -65,6 +75,12 @@ Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resou
 
     layer_acc_ = device->CreateLayerAcc(type_);
     if (layer_acc_ != NULL) {
+        if (shared_layer != NULL && shared_layer->layer_acc_ != NULL) {
+            status = layer_acc_->ShareWeightsFrom(shared_layer->layer_acc_);
+            if (status != TNN_OK) {
+                return status;
+            }
+        }
         return layer_acc_->Init(context, param, resource, input_blobs_, output_blobs_);
     } else {
         LOGE("layer acc of type(%d) is nil\n", type_);
@@ -72,6 +88,15 @@ Status BaseLayer::Init(Context* context, LayerParam* param, LayerResource* resou
     }
 }
 
+Status BaseLayer::InitWeights() {
+    if (layer_acc_ != NULL) {
+        return layer_acc_->InitWeights(input_blobs_, output_blobs_);
+    } else {
+        LOGE("layer acc is nil\n");
+        return Status(TNNERR_LAYER_ERR, "layer acc is nil");
+    }
+}
+
 Status BaseLayer::InferOutputDataType() {
     // Init base type, will re write in different device acc
     // output data_type = input_data_tyep as default.
@@ -82,7 +107,10 @@ Status BaseLayer::InferOutputDataType() {
 }
 
 Status BaseLayer::Reshape() {
-    InferOutputShape();
+    auto status = InferOutputShape();
+    if (status != TNN_OK) {
+        return status;
+    }
     auto dims = output_blobs_[0]->GetBlobDesc().dims;
     for (auto item : dims) {
         if (item <= 0) {
@@ -38,10 +38,19 @@ public:
     // @brief virtual destructor
     virtual ~BaseLayer();
 
-    // @brief layer init
+    // @brief layer init, InitLayer followed by InitWeights
     // @param ...
+    // @param shared_layer initialized layer of another instance to share weights with
     Status Init(Context* context, LayerParam* param, LayerResource* resource, std::vector<Blob*>& inputs,
-                std::vector<Blob*>& outputs, AbstractDevice* device);
+                std::vector<Blob*>& outputs, AbstractDevice* device, BaseLayer* shared_layer = nullptr);
+
+    // @brief infer output blobs and init layer acc without weights,
+    // layers must be initialized in layer order
+    Status InitLayer(Context* context, LayerParam* param, LayerResource* resource, std::vector<Blob*>& inputs,
+                     std::vector<Blob*>& outputs, AbstractDevice* device, BaseLayer* shared_layer = nullptr);
+
+    // @brief init weights of layer acc after InitLayer, can run concurrently for different layers
+    Status InitWeights();
 
     //@brief Reshape recalculate the output tensor dims
     virtual Status Reshape();
@@ -0,0 +1,147 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/memory_manager/blob_memory_plan.h"
+
+#include <limits.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+void GetBlobLifetimes(NetStructure *net_structure, std::map<std::string, BlobLifetime> &lifetimes) {
+    const auto &inputs_shape_map = net_structure->inputs_shape_map;
+    const auto &layers           = net_structure->layers;
+
+    lifetimes.clear();
+    for (int layer_index = 0; layer_index < layers.size(); ++layer_index) {
+        for (const auto &name : layers[layer_index]->outputs) {
+            if (inputs_shape_map.count(name) > 0 || lifetimes.count(name) > 0) {
+                continue;
+            }
+            BlobLifetime lifetime;
+            lifetime.begin  = layer_index;
+            lifetime.end    = -1;
+            lifetimes[name] = lifetime;
+        }
+    }
+
+    for (int layer_index = 0; layer_index < layers.size(); ++layer_index) {
+        for (const auto &name : layers[layer_index]->inputs) {
+            auto iter = lifetimes.find(name);
+            if (iter != lifetimes.end() && layer_index > iter->second.begin) {
+                iter->second.end = std::max(iter->second.end, layer_index);
+            }
+        }
+    }
+
+    // the blobs not used by later layers and the net outputs are never released, same as the BlobManager
+    for (auto &iter : lifetimes) {
+        if (iter.second.end < 0 || net_structure->outputs.count(iter.first) > 0) {
+            iter.second.end = INT_MAX;
+        }
+    }
+}
+
+Status GenerateBlobMemoryPlan(NetStructure *net_structure, std::map<std::string, int> &blob_slots) {
+    std::map<std::string, BlobLifetime> lifetimes;
+    GetBlobLifetimes(net_structure, lifetimes);
+
+    blob_slots.clear();
+    // element count of each slot
+    std::vector<int> slot_counts;
+    std::vector<int> free_slots;
+    const auto &layers = net_structure->layers;
+    for (int layer_index = 0; layer_index < layers.size(); ++layer_index) {
+        auto layer_info = layers[layer_index].get();
+        for (const auto &name : layer_info->outputs) {
+            if (lifetimes.count(name) == 0 || blob_slots.count(name) > 0) {
+                continue;
+            }
+            auto shape_iter = net_structure->blobs_shape_map.find(name);
+            if (shape_iter == net_structure->blobs_shape_map.end() || DimsVectorUtils::Count(shape_iter->second) <= 0) {
+                LOGE("The shape of blob %s is unknown\n", name.c_str());
+                return Status(TNNERR_PARAM_ERR, "blob memory plan needs the shapes of all blobs");
+            }
+            const int count = DimsVectorUtils::Count(shape_iter->second);
+
+            // take the free slot of the closest size, as the BlobMemoryPool does
+            auto nearest = free_slots.end();
+            for (auto iter = free_slots.begin(); iter != free_slots.end(); ++iter) {
+                if (nearest == free_slots.end() ||
+                    std::abs(slot_counts[*iter] - count) < std::abs(slot_counts[*nearest] - count)) {
+                    nearest = iter;
+                }
+            }
+            int slot = 0;
+            if (nearest == free_slots.end()) {
+                slot = (int)slot_counts.size();
+                slot_counts.push_back(count);
+            } else {
+                slot              = *nearest;
+                slot_counts[slot] = std::max(slot_counts[slot], count);
+                free_slots.erase(nearest);
+            }
+            blob_slots[name] = slot;
+        }
+
+        // release the slots of the blobs last used by this layer
+        std::set<std::string> released;
+        for (const auto &name : layer_info->inputs) {
+            auto iter = lifetimes.find(name);
+            if (iter == lifetimes.end() || iter->second.end != layer_index || released.count(name) > 0) {
+                continue;
+            }
+            released.insert(name);
+            free_slots.push_back(blob_slots[name]);
+        }
+    }
+    return TNN_OK;
+}
+
+bool CheckBlobMemoryPlan(NetStructure *net_structure, const std::map<std::string, int> &blob_slots) {
+    std::map<std::string, BlobLifetime> lifetimes;
+    GetBlobLifetimes(net_structure, lifetimes);
+
+    std::map<int, std::vector<BlobLifetime>> slot_lifetimes;
+    for (const auto &iter : lifetimes) {
+        auto slot_iter = blob_slots.find(iter.first);
+        if (slot_iter == blob_slots.end()) {
+            return false;
+        }
+        slot_lifetimes[slot_iter->second].push_back(iter.second);
+    }
+
+    for (auto &iter : slot_lifetimes) {
+        auto &slot_blobs = iter.second;
+        std::sort(slot_blobs.begin(), slot_blobs.end(),
+                  [](const BlobLifetime &a, const BlobLifetime &b) { return a.begin < b.begin; });
+        for (int i = 1; i < slot_blobs.size(); ++i) {
+            // the memory of a blob is reused from the layer after its last use
+            if (slot_blobs[i].begin <= slot_blobs[i - 1].end) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace TNN_NS
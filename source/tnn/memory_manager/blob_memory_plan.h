@@ -0,0 +1,50 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_MEMORY_MANAGER_BLOB_MEMORY_PLAN_H_
+#define TNN_SOURCE_TNN_MEMORY_MANAGER_BLOB_MEMORY_PLAN_H_
+
+#include <map>
+#include <string>
+
+#include "tnn/core/status.h"
+#include "tnn/interpreter/net_structure.h"
+
+namespace TNN_NS {
+
+// @brief the layers between which a blob produced by a layer holds its memory
+struct BlobLifetime {
+    // index of the layer producing the blob
+    int begin = 0;
+    // index of the last layer using the blob, INT_MAX if the blob is kept until the end of forward
+    int end = 0;
+};
+
+// @brief get the lifetimes of the blobs produced by the layers, the net inputs are not included
+void GetBlobLifetimes(NetStructure *net_structure, std::map<std::string, BlobLifetime> &lifetimes);
+
+// @brief assign the blobs produced by the layers to memory slots with the static shapes of
+// net_structure->blobs_shape_map, blobs of disjoint lifetimes share a slot. The slots only depend on the
+// net, the bytes of each slot are computed by the device that runs it.
+// @param blob_slots the slot index of each blob
+Status GenerateBlobMemoryPlan(NetStructure *net_structure, std::map<std::string, int> &blob_slots);
+
+// @brief check every blob produced by the layers has a slot, and the blobs sharing a slot are not alive at the
+// same time. The net may have been changed by the optimizer after the plan was generated.
+bool CheckBlobMemoryPlan(NetStructure *net_structure, const std::map<std::string, int> &blob_slots);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_BLOB_MEMORY_PLAN_H_
@@ -0,0 +1,72 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/memory_manager/memory_arena_assign_strategy.h"
+
+#include <cstdint>
+
+#include "tnn/memory_manager/blob_memory_size_info.h"
+
+namespace TNN_NS {
+
+// the blob data in the arena is aligned for the simd loads of the layers
+static const int kArenaAlignment = 64;
+
+static int AlignedBytesSize(BlobMemory* blob_memory) {
+    BlobMemorySizeInfo size_info = blob_memory->GetBlobMemorySizeInfo();
+    int bytes_size               = GetBlobMemoryBytesSize(size_info);
+    return (bytes_size + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+}
+
+MemoryArenaAssignStrategy::MemoryArenaAssignStrategy(AbstractDevice* device) {
+    device_     = device;
+    arena_data_ = nullptr;
+}
+
+Status MemoryArenaAssignStrategy::AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library) {
+    // the arena starts with the padding to align the first blob memory
+    int arena_bytes_size = kArenaAlignment;
+    for (auto& iter : blob_memory_library) {
+        arena_bytes_size += AlignedBytesSize(iter);
+    }
+
+    BlobMemorySizeInfo arena_info;
+    arena_info.data_type = DATA_TYPE_INT8;
+    arena_info.dims.push_back(arena_bytes_size);
+    Status status = device_->Allocate(&arena_data_, arena_info);
+    if (status != TNN_OK) {
+        return status;
+    }
+    if (arena_data_ == nullptr) {
+        return Status(TNNERR_OUTOFMEMORY, "allocate blob memory arena failed");
+    }
+
+    char* blob_memory_data = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(arena_data_) + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment);
+    for (auto& iter : blob_memory_library) {
+        BlobHandle handle;
+        handle.base         = blob_memory_data;
+        handle.bytes_offset = 0;
+        iter->SetHandleFromExternal(handle);
+        blob_memory_data += AlignedBytesSize(iter);
+    }
+    return TNN_OK;
+}
+
+void* MemoryArenaAssignStrategy::GetArena() {
+    return arena_data_;
+}
+
+}  // namespace TNN_NS
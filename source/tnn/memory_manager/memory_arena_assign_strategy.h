@@ -0,0 +1,41 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_ARENA_ASSIGN_STRATEGY_H_
+#define TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_ARENA_ASSIGN_STRATEGY_H_
+
+#include "tnn/core/abstract_device.h"
+#include "tnn/memory_manager/memory_assign_strategy.h"
+
+namespace TNN_NS {
+
+// @brief allocate one arena of host memory for all the blob memory. The handle base of each blob memory
+// points to its own aligned data in the arena, the layers need not to add the bytes offset.
+class MemoryArenaAssignStrategy : public MemoryAssignStrategy {
+public:
+    explicit MemoryArenaAssignStrategy(AbstractDevice* device);
+    virtual Status AssignAllBlobMemory(std::set<BlobMemory*>& blob_memory_library);
+
+    // @brief the arena allocated by AssignAllBlobMemory, it is freed by the caller with the device
+    void* GetArena();
+
+private:
+    AbstractDevice* device_;
+    void* arena_data_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_MEMORY_MANAGER_MEMORY_ARENA_ASSIGN_STRATEGY_H_
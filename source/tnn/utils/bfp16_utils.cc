@@ -19,9 +19,62 @@
 #include "tnn/core/macro.h"
 #include "tnn/utils/bfp16.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TNN_BFP16_X86
+#include <immintrin.h>
+#endif
+
 namespace TNN_NS {
 
+#ifdef TNN_BFP16_X86
+/*
+ * bfp16 is the high half of fp32, the conversions are shifts of 16 bits.
+ * 16 floats are truncated and packed per loop, 8 bfp16 are expanded per loop.
+ */
+__attribute__((target("avx2"))) static int ConvertFromFloatToBFP16Avx2(float *fp32, uint16_t *bfp16, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i v0 = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i *)(fp32 + i)), 16);
+        __m256i v1 = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i *)(fp32 + i + 8)), 16);
+        // packus works in 128 bit lanes, permute the 64 bit parts back in order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v0, v1), 0xD8);
+        _mm256_storeu_si256((__m256i *)(bfp16 + i), packed);
+    }
+    for (; i < count; ++i) {
+        bfp16[i] = bfp16_t(fp32[i]).w;
+    }
+    return 0;
+}
+
+__attribute__((target("avx2"))) static int ConvertFromBFP16ToFloatAvx2(uint16_t *bfp16, float *fp32, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(bfp16 + i)));
+        _mm256_storeu_si256((__m256i *)(fp32 + i), _mm256_slli_epi32(v, 16));
+    }
+    for (; i < count; ++i) {
+        cvt_32b c;
+        c.u     = (uint32_t)bfp16[i] << 16;
+        fp32[i] = c.f;
+    }
+    return 0;
+}
+
+static bool CpuSupportsAvx2() {
+    static const bool support = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return support;
+}
+#endif  // TNN_BFP16_X86
+
 int ConvertFromFloatToBFP16(float *fp32, void *fp16, int count) {
+#ifdef TNN_BFP16_X86
+    if (CpuSupportsAvx2()) {
+        return ConvertFromFloatToBFP16Avx2(fp32, (uint16_t *)fp16, count);
+    }
+#endif
     bfp16_t *bfp16PTR = (bfp16_t *)fp16;
     for (int i = 0; i < count; ++i) {
         bfp16PTR[i] = fp32[i];
@@ -31,6 +84,11 @@ int ConvertFromFloatToBFP16(float *fp32, void *fp16, int count) {
 }
 
 int ConvertFromBFP16ToFloat(void *fp16, float *fp32, int count) {
+#ifdef TNN_BFP16_X86
+    if (CpuSupportsAvx2()) {
+        return ConvertFromBFP16ToFloatAvx2((uint16_t *)fp16, fp32, count);
+    }
+#endif
     bfp16_t *bfp16PTR = (bfp16_t *)fp16;
     for (int i = 0; i < count; ++i) {
         fp32[i] = float(bfp16PTR[i]);
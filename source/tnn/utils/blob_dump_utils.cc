@@ -20,6 +20,7 @@
 
 #include "tnn/core/blob_int8.h"
 #include "tnn/interpreter/layer_resource.h"
+#include "tnn/utils/blob_memory_size_utils.h"
 #include "tnn/utils/blob_transfer_utils.h"
 #include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/data_type_utils.h"
@@ -203,6 +204,10 @@ Status DumpDeviceBlob(Blob* dev_blob, Context* context, std::string fname_prefix
     if (dev_blob_desc.data_format == DATA_FORMAT_NC4HW4 || dev_blob_desc.data_format == DATA_FORMAT_NHWC4) {
         data_count = dev_blob_desc.dims[0] * ROUND_UP(dev_blob_desc.dims[1], 4) *
                      ROUND_UP(dev_blob_desc.dims[2] * dev_blob_desc.dims[3], 4);
+    } else if (dev_blob_desc.data_format == DATA_FORMAT_NC8HW8 || dev_blob_desc.data_format == DATA_FORMAT_NC16HW16) {
+        const int pack = GetChannelPackSize(dev_blob_desc.data_format);
+        data_count     = dev_blob_desc.dims[0] * ROUND_UP(dev_blob_desc.dims[1], pack) * dev_blob_desc.dims[2] *
+                     dev_blob_desc.dims[3];
     } else {
         data_count = DimsVectorUtils::Count(dev_blob_desc.dims);
     }
@@ -310,6 +315,17 @@ Status DumpDeviceBlob(Blob* dev_blob, Context* context, std::string fname_prefix
                 ret_code = dump_nc4hw4_float_blob(dev_blob->GetBlobDesc(), std::string(fname), cpu_data);
             }
         } break;
+        case DATA_FORMAT_NC8HW8:
+        case DATA_FORMAT_NC16HW16: {
+            if (dev_blob_desc.data_type == DATA_TYPE_INT8) {
+                return Status(TNNERR_PARAM_ERR, "unsupport data format");
+            }
+            auto& dims = dev_blob_desc.dims;
+            std::shared_ptr<float> nchw_ptr(new float[DimsVectorUtils::Count(dims)], [](float* p) { delete[] p; });
+            DataFormatConverter::ConvertFromPackedToNCHWFloat(cpu_data, nchw_ptr.get(), dev_blob_desc.data_format,
+                                                              dims[0], dims[1], dims[2], dims[3]);
+            ret_code = dump_ncdhw_float_blob(dev_blob->GetBlobDesc(), std::string(fname), nchw_ptr.get());
+        } break;
         default:
             break;
     }
@@ -20,12 +20,26 @@
 
 namespace TNN_NS {
 
+int GetChannelPackSize(DataFormat data_format) {
+    switch (data_format) {
+        case DATA_FORMAT_NC4HW4:
+            return 4;
+        case DATA_FORMAT_NC8HW8:
+            return 8;
+        case DATA_FORMAT_NC16HW16:
+            return 16;
+        default:
+            return 1;
+    }
+}
+
 BlobMemorySizeInfo Calculate1DMemorySize(BlobDesc& desc) {
     BlobMemorySizeInfo info;
     info.data_type = desc.data_type;
     int count      = 0;
-    if (desc.data_format == DATA_FORMAT_NC4HW4) {
-        count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * desc.dims[2] * desc.dims[3];
+    const int pack = GetChannelPackSize(desc.data_format);
+    if (pack > 1) {
+        count = desc.dims[0] * ROUND_UP(desc.dims[1], pack) * DimsVectorUtils::Count(desc.dims, 2);
     } else if (desc.data_format == DATA_FORMAT_NHWC4) {
         count = desc.dims[0] * ROUND_UP(desc.dims[1], 4) * ROUND_UP(desc.dims[2] * desc.dims[3], 4);
     } else {
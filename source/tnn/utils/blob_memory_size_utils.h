@@ -20,6 +20,9 @@
 
 namespace TNN_NS {
 
+// @brief channels packed together by the format, 4 for NC4HW4, 8 for NC8HW8, 16 for NC16HW16, 1 otherwise
+int GetChannelPackSize(DataFormat data_format);
+
 BlobMemorySizeInfo Calculate1DMemorySize(BlobDesc& desc);
 
 BlobMemorySizeInfo Calculate2DCLImageMemorySize(BlobDesc& desc);
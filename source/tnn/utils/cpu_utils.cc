@@ -14,6 +14,7 @@
 
 #include "tnn/utils/cpu_utils.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <vector>
 
@@ -28,10 +29,11 @@
 #endif
 
 #include "tnn/core/macro.h"
+#include "tnn/utils/numa_utils.h"
 
 namespace TNN_NS {
 
-#ifdef __ANDROID__
+#if defined(__ANDROID__) || defined(__linux__)
 static int GetMaxFreqOfCpu(int cpuid) {
     // first try, for all possible cpu
     char path[256];
@@ -174,24 +176,29 @@ static int SortCpuidByMaxFrequency(std::vector<int>& cpuids, int* little_cluster
 
     return 0;
 }
-#endif  // __ANDROID__
+#endif  // __ANDROID__ || __linux__
 
-static int SetSchedAffinity(const std::vector<int>& cpuids) {
 #if defined(__ANDROID__) || defined(__linux__)
-    // cpu_set_t definition
-    // ref
-    // http://stackoverflow.com/questions/16319725/android-set-thread-affinity
+// cpu_set_t definition
+// ref
+// http://stackoverflow.com/questions/16319725/android-set-thread-affinity
 #define TNN_CPU_SETSIZE 1024
 #define TNN_NCPUBITS (8 * sizeof(unsigned long))
-    typedef struct {
-        unsigned long __bits[TNN_CPU_SETSIZE / TNN_NCPUBITS];
-    } cpu_set_t;
+typedef struct {
+    unsigned long __bits[TNN_CPU_SETSIZE / TNN_NCPUBITS];
+} tnn_cpu_set_t;
 
 #define TNN_CPU_SET(cpu, cpusetp) ((cpusetp)->__bits[(cpu) / TNN_NCPUBITS] |= (1UL << ((cpu) % TNN_NCPUBITS)))
 
-#define TNN_CPU_ZERO(cpusetp) memset((cpusetp), 0, sizeof(cpu_set_t))
+#define TNN_CPU_ISSET(cpu, cpusetp) (((cpusetp)->__bits[(cpu) / TNN_NCPUBITS] & (1UL << ((cpu) % TNN_NCPUBITS))) != 0)
 
-    // set affinity for thread
+#define TNN_CPU_ZERO(cpusetp) memset((cpusetp), 0, sizeof(tnn_cpu_set_t))
+
+// memory policy modes, see linux/mempolicy.h
+#define TNN_MPOL_DEFAULT 0
+#define TNN_MPOL_PREFERRED 1
+
+static pid_t GetThreadId() {
 #ifdef __GLIBC__
     pid_t pid = syscall(SYS_gettid);
 #else
@@ -201,7 +208,15 @@ static int SetSchedAffinity(const std::vector<int>& cpuids) {
     pid_t pid = gettid();
 #endif
 #endif
-    cpu_set_t mask;
+    return pid;
+}
+#endif
+
+static int SetSchedAffinity(const std::vector<int>& cpuids) {
+#if defined(__ANDROID__) || defined(__linux__)
+    // set affinity for thread
+    pid_t pid = GetThreadId();
+    tnn_cpu_set_t mask;
     TNN_CPU_ZERO(&mask);
     for (int i = 0; i < (int)cpuids.size(); i++) {
         TNN_CPU_SET(cpuids[i], &mask);
@@ -216,15 +231,25 @@ static int SetSchedAffinity(const std::vector<int>& cpuids) {
     return 0;
 }
 
-Status CpuUtils::SetCpuPowersave(int powersave) {
-#ifdef __ANDROID__
-    static std::vector<int> sorted_cpuids;
-    static int little_cluster_offset = 0;
-    static int cpucount              = GetCpuCount();
+#if defined(__ANDROID__) || defined(__linux__)
+struct CpuClusterInfo {
+    // cpuids sorted as big core first
+    std::vector<int> sorted_cpuids;
+    int little_cluster_offset = 0;
+
+    CpuClusterInfo() {
+        // hybrid x86 cpus expose performance and efficient cores directly
+        std::vector<int> big_cpuids, little_cpuids;
+        if (NumaUtils::ReadCpuListFile("/sys/devices/cpu_core/cpus", big_cpuids) &&
+            NumaUtils::ReadCpuListFile("/sys/devices/cpu_atom/cpus", little_cpuids)) {
+            sorted_cpuids = big_cpuids;
+            sorted_cpuids.insert(sorted_cpuids.end(), little_cpuids.begin(), little_cpuids.end());
+            little_cluster_offset = (int)big_cpuids.size();
+            return;
+        }
 
-    if (sorted_cpuids.empty()) {
         // 0 ~ g_cpucount
-
+        int cpucount = GetCpuCount();
         sorted_cpuids.resize(cpucount);
         for (int i = 0; i < cpucount; i++) {
             sorted_cpuids[i] = i;
@@ -233,61 +258,148 @@ Status CpuUtils::SetCpuPowersave(int powersave) {
         // descent sort by max frequency
         SortCpuidByMaxFrequency(sorted_cpuids, &little_cluster_offset);
     }
+};
+#endif
+
+Status CpuUtils::GetCpuClusterList(int powersave, std::vector<int>& cpu_list) {
+    cpu_list.clear();
+#if defined(__ANDROID__) || defined(__linux__)
+    static CpuClusterInfo cluster_info;
+    auto& sorted_cpuids              = cluster_info.sorted_cpuids;
+    const int little_cluster_offset = cluster_info.little_cluster_offset;
 
     if (little_cluster_offset == 0 && powersave != 0) {
+        // SMP, all cpus are in the same cluster
         powersave = 0;
         fprintf(stderr, "SMP cpu powersave not supported\n");
     }
 
     // prepare affinity cpuid
-    std::vector<int> cpuids;
     if (powersave == 0) {
-        cpuids = sorted_cpuids;
+        cpu_list = sorted_cpuids;
     } else if (powersave == 1) {
-        cpuids = std::vector<int>(sorted_cpuids.begin() + little_cluster_offset, sorted_cpuids.end());
+        cpu_list = std::vector<int>(sorted_cpuids.begin() + little_cluster_offset, sorted_cpuids.end());
     } else if (powersave == 2) {
-        cpuids = std::vector<int>(sorted_cpuids.begin(), sorted_cpuids.begin() + little_cluster_offset);
+        cpu_list = std::vector<int>(sorted_cpuids.begin(), sorted_cpuids.begin() + little_cluster_offset);
     } else {
         fprintf(stderr, "powersave %d not supported\n", powersave);
         return TNNERR_SET_CPU_AFFINITY;
     }
+    return TNN_OK;
+#else
+    (void)powersave;  // Avoid unused parameter warning.
+    return TNNERR_SET_CPU_AFFINITY;
+#endif
+}
+
+Status CpuUtils::SetCpuPowersave(int powersave) {
+#if defined(__ANDROID__) || defined(__linux__)
+    std::vector<int> cpuids;
+    Status ret = GetCpuClusterList(powersave, cpuids);
+    if (ret != TNN_OK) {
+        return ret;
+    }
 
-#ifdef _OPENMP
     // set affinity for each thread
-    int num_threads = cpuids.size();
+    return SetCpuAffinityForThreads(cpuids, (int)cpuids.size());
+#else
+    // TODO
+    (void)powersave;  // Avoid unused parameter warning.
+    return TNNERR_SET_CPU_AFFINITY;
+#endif
+}
+
+Status CpuUtils::SetCpuAffinity(const std::vector<int>& cpu_list) {
+#if defined(__ANDROID__) || defined(__linux__)
+    if (0 != SetSchedAffinity(cpu_list)) {
+        return TNNERR_SET_CPU_AFFINITY;
+    }
+    return TNN_OK;
+#else
+    return TNNERR_SET_CPU_AFFINITY;
+#endif
+}
+
+Status CpuUtils::GetCpuAffinity(std::vector<int>& cpu_list) {
+    cpu_list.clear();
+#if defined(__ANDROID__) || defined(__linux__)
+    tnn_cpu_set_t mask;
+    TNN_CPU_ZERO(&mask);
+    int syscallret = syscall(__NR_sched_getaffinity, GetThreadId(), sizeof(mask), &mask);
+    if (syscallret < 0) {
+        return TNNERR_SET_CPU_AFFINITY;
+    }
+    for (int i = 0; i < TNN_CPU_SETSIZE; i++) {
+        if (TNN_CPU_ISSET(i, &mask)) {
+            cpu_list.push_back(i);
+        }
+    }
+    return TNN_OK;
+#else
+    return TNNERR_SET_CPU_AFFINITY;
+#endif
+}
+
+Status CpuUtils::SetCpuAffinityForThreads(const std::vector<int>& cpu_list, int num_threads) {
+#ifdef _OPENMP
+    // set affinity for each thread of the calling thread's omp team
+    num_threads = num_threads > 0 ? num_threads : 1;
     omp_set_num_threads(num_threads);
     std::vector<int> ssarets(num_threads, 0);
-#pragma omp parallel for
+#pragma omp parallel for schedule(static, 1)
     for (int i = 0; i < num_threads; i++) {
-        ssarets[i] = SetSchedAffinity(cpuids);
+        ssarets[i] = SetSchedAffinity(cpu_list);
     }
     for (int i = 0; i < num_threads; i++) {
         if (ssarets[i] != 0) {
             return TNNERR_SET_CPU_AFFINITY;
         }
     }
+    return TNN_OK;
 #else
-    int ssaret = SetSchedAffinity(cpuids);
-    if (ssaret != 0) {
-        return TNNERR_SET_CPU_AFFINITY;
-    }
+    (void)num_threads;
+    return SetCpuAffinity(cpu_list);
 #endif
+}
 
-    return TNN_OK;
+int CpuUtils::GetNumaNodeCount() {
+#if defined(__ANDROID__) || defined(__linux__)
+    return NumaUtils::GetNodeCount("/sys/devices/system/node");
 #else
-    // TODO
-    (void)powersave;  // Avoid unused parameter warning.
-    return TNNERR_SET_CPU_AFFINITY;
+    return 1;
 #endif
 }
 
-Status CpuUtils::SetCpuAffinity(const std::vector<int>& cpu_list) {
+Status CpuUtils::GetNumaNodeCpuList(int numa_node, std::vector<int>& cpu_list) {
+    cpu_list.clear();
 #if defined(__ANDROID__) || defined(__linux__)
-    if (0 != SetSchedAffinity(cpu_list)) {
-        return TNNERR_SET_CPU_AFFINITY;
+    return NumaUtils::GetNodeCpuList("/sys/devices/system/node", numa_node, cpu_list);
+#else
+    (void)numa_node;
+    return TNNERR_SET_CPU_AFFINITY;
+#endif
+}
+
+Status CpuUtils::SetNumaMemoryPolicy(int numa_node) {
+#if (defined(__ANDROID__) || defined(__linux__)) && defined(__NR_set_mempolicy)
+    int syscallret = 0;
+    if (numa_node < 0) {
+        syscallret = syscall(__NR_set_mempolicy, TNN_MPOL_DEFAULT, NULL, 0);
+    } else {
+        if (numa_node >= TNN_CPU_SETSIZE) {
+            return Status(TNNERR_PARAM_ERR, "invalid numa node");
+        }
+        tnn_cpu_set_t node_mask;
+        TNN_CPU_ZERO(&node_mask);
+        TNN_CPU_SET(numa_node, &node_mask);
+        syscallret = syscall(__NR_set_mempolicy, TNN_MPOL_PREFERRED, node_mask.__bits, TNN_CPU_SETSIZE);
+    }
+    if (syscallret) {
+        return Status(TNNERR_SET_CPU_AFFINITY, "failed to set numa memory policy");
     }
     return TNN_OK;
 #else
+    (void)numa_node;
     return TNNERR_SET_CPU_AFFINITY;
 #endif
 }
@@ -88,28 +88,29 @@ static Status ConvertWeightsFromGOIHWToGOIHW16(T *src, T *dst, int group, int in
     return TNN_OK;
 };
 
-template <class T>
-static Status ConvertFromNCHWToNCHW4(T *src, T *dst, int num, int channel, int height, int width) {
-    int round_channel = ROUND_UP(channel, 4);
+// the channels are packed by PACK, 4 for NC4HW4, 8 for NC8HW8 and 16 for NC16HW16
+template <class T, int PACK>
+static Status ConvertFromNCHWToNCHWx(T *src, T *dst, int num, int channel, int height, int width) {
+    int round_channel = ROUND_UP(channel, PACK);
     for (int n = 0; n < num; n++) {
         auto n_dst = dst + n * round_channel * height * width;
         auto n_src = src + n * channel * height * width;
         for (int c = 0; c < round_channel; c++) {
-            auto z = c / 4, r = c % 4;
-            auto z_dst = n_dst + z * height * width * 4 + r;
+            auto z = c / PACK, r = c % PACK;
+            auto z_dst = n_dst + z * height * width * PACK + r;
             auto z_src = n_src + c * height * width;
 #pragma clang loop vectorize(enable)
             for (int h = 0; h < height; h++) {
 #pragma clang loop vectorize(enable) unroll(enable)
                 for (int w = 0; w < width; w++) {
-                    // to   [c/4][h][w][4]
+                    // to   [c/x][h][w][x]
                     // from [c][h][w]
-                    // dst[(z * height * width + h * width + w) * 4 + r] =
+                    // dst[(z * height * width + h * width + w) * x + r] =
                     // src[ c * height * width + h * width + w];
                     if (c < channel)
-                        z_dst[(h * width + w) * 4] = z_src[h * width + w];
+                        z_dst[(h * width + w) * PACK] = z_src[h * width + w];
                     else
-                        z_dst[(h * width + w) * 4] = 0;
+                        z_dst[(h * width + w) * PACK] = 0;
                 }
             }
         }
@@ -140,23 +141,23 @@ static Status ConvertFromNCHWToNHWC4(T *src, T *dst, int num, int channel, int h
     return TNN_OK;
 };
 
-template <class T>
-static Status ConvertFromNCHW4ToNCHW(T *src, T *dst, int num, int channel, int height, int width) {
-    int round_channel = ROUND_UP(channel, 4);
+template <class T, int PACK>
+static Status ConvertFromNCHWxToNCHW(T *src, T *dst, int num, int channel, int height, int width) {
+    int round_channel = ROUND_UP(channel, PACK);
     for (int n = 0; n < num; n++) {
         auto n_src = src + n * round_channel * height * width;
         auto n_dst = dst + n * channel * height * width;
         for (int c = 0; c < channel; c++) {
-            auto z = c / 4, r = c % 4;
-            auto z_src = n_src + z * height * width * 4 + r;
+            auto z = c / PACK, r = c % PACK;
+            auto z_src = n_src + z * height * width * PACK + r;
             auto z_dst = n_dst + c * height * width;
 #pragma clang loop vectorize(enable)
             for (int h = 0; h < height; h++) {
 #pragma clang loop vectorize(enable) unroll(enable)
                 for (int w = 0; w < width; w++) {
                     // to [c][h][w]
-                    // from   [c/4][h][w][4]
-                    z_dst[h * width + w] = z_src[(h * width + w) * 4];
+                    // from   [c/x][h][w][x]
+                    z_dst[h * width + w] = z_src[(h * width + w) * PACK];
                 }
             }
         }
@@ -267,11 +268,11 @@ Status DataFormatConverter::ConvertFromInt8ToFloatNCHW(int8_t *src, float *dst,
 
 Status DataFormatConverter::ConvertFromNCHWToNCHW4Float(float *src, float *dst, int num, int channel, int height,
                                                         int width) {
-    return ConvertFromNCHWToNCHW4<float>(src, dst, num, channel, height, width);
+    return ConvertFromNCHWToNCHWx<float, 4>(src, dst, num, channel, height, width);
 }
 Status DataFormatConverter::ConvertFromNCHWToNCHW4Half(short *src, short *dst, int num, int channel, int height,
                                                        int width) {
-    return ConvertFromNCHWToNCHW4<short>(src, dst, num, channel, height, width);
+    return ConvertFromNCHWToNCHWx<short, 4>(src, dst, num, channel, height, width);
 }
 
 Status DataFormatConverter::ConvertFromNCHWToNHWC4Int8(int8_t *src, int8_t *dst, int num, int channel, int height,
@@ -280,12 +281,63 @@ Status DataFormatConverter::ConvertFromNCHWToNHWC4Int8(int8_t *src, int8_t *dst,
 }
 Status DataFormatConverter::ConvertFromNCHW4ToNCHWFloat(float *src, float *dst, int num, int channel, int height,
                                                         int width) {
-    return ConvertFromNCHW4ToNCHW<float>(src, dst, num, channel, height, width);
+    return ConvertFromNCHWxToNCHW<float, 4>(src, dst, num, channel, height, width);
 }
 Status DataFormatConverter::ConvertFromNCHW4ToNCHWHalf(short *src, short *dst, int num, int channel, int height,
                                                        int width) {
-    return ConvertFromNCHW4ToNCHW<short>(src, dst, num, channel, height, width);
+    return ConvertFromNCHWxToNCHW<short, 4>(src, dst, num, channel, height, width);
+}
+Status DataFormatConverter::ConvertFromNCHWToNCHW8Float(float *src, float *dst, int num, int channel, int height,
+                                                        int width) {
+    return ConvertFromNCHWToNCHWx<float, 8>(src, dst, num, channel, height, width);
+}
+Status DataFormatConverter::ConvertFromNCHWToNCHW16Float(float *src, float *dst, int num, int channel, int height,
+                                                         int width) {
+    return ConvertFromNCHWToNCHWx<float, 16>(src, dst, num, channel, height, width);
 }
+Status DataFormatConverter::ConvertFromNCHW8ToNCHWFloat(float *src, float *dst, int num, int channel, int height,
+                                                        int width) {
+    return ConvertFromNCHWxToNCHW<float, 8>(src, dst, num, channel, height, width);
+}
+Status DataFormatConverter::ConvertFromNCHW16ToNCHWFloat(float *src, float *dst, int num, int channel, int height,
+                                                         int width) {
+    return ConvertFromNCHWxToNCHW<float, 16>(src, dst, num, channel, height, width);
+}
+
+Status DataFormatConverter::ConvertFromNCHWToPackedFloat(float *src, float *dst, DataFormat dst_format, int num,
+                                                         int channel, int height, int width) {
+    switch (dst_format) {
+        case DATA_FORMAT_NCHW:
+            memcpy(dst, src, num * channel * height * width * sizeof(float));
+            return TNN_OK;
+        case DATA_FORMAT_NC4HW4:
+            return ConvertFromNCHWToNCHW4Float(src, dst, num, channel, height, width);
+        case DATA_FORMAT_NC8HW8:
+            return ConvertFromNCHWToNCHW8Float(src, dst, num, channel, height, width);
+        case DATA_FORMAT_NC16HW16:
+            return ConvertFromNCHWToNCHW16Float(src, dst, num, channel, height, width);
+        default:
+            return Status(TNNERR_PARAM_ERR, "unsupport data format");
+    }
+}
+
+Status DataFormatConverter::ConvertFromPackedToNCHWFloat(float *src, float *dst, DataFormat src_format, int num,
+                                                         int channel, int height, int width) {
+    switch (src_format) {
+        case DATA_FORMAT_NCHW:
+            memcpy(dst, src, num * channel * height * width * sizeof(float));
+            return TNN_OK;
+        case DATA_FORMAT_NC4HW4:
+            return ConvertFromNCHW4ToNCHWFloat(src, dst, num, channel, height, width);
+        case DATA_FORMAT_NC8HW8:
+            return ConvertFromNCHW8ToNCHWFloat(src, dst, num, channel, height, width);
+        case DATA_FORMAT_NC16HW16:
+            return ConvertFromNCHW16ToNCHWFloat(src, dst, num, channel, height, width);
+        default:
+            return Status(TNNERR_PARAM_ERR, "unsupport data format");
+    }
+}
+
 Status DataFormatConverter::ConvertFromNHWC4ToNCHWInt8(int8_t *src, int8_t *dst, int num, int channel, int height,
                                                        int width) {
     return ConvertFromNHWC4ToNCHW<int8_t>(src, dst, num, channel, height, width);
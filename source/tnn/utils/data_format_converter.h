@@ -44,6 +44,18 @@ public:
     static Status ConvertFromNCHW4ToNCHWHalf(short *src, short *dst, int num, int channel, int height, int width);
     static Status ConvertFromNHWC4ToNCHWInt8(int8_t *src, int8_t *dst, int num, int channel, int height, int width);
 
+    // @brief convert blobs from [n][c][h][w] to [n][c/8][h][w][8] and [n][c/16][h][w][16], and back
+    static Status ConvertFromNCHWToNCHW8Float(float *src, float *dst, int num, int channel, int height, int width);
+    static Status ConvertFromNCHWToNCHW16Float(float *src, float *dst, int num, int channel, int height, int width);
+    static Status ConvertFromNCHW8ToNCHWFloat(float *src, float *dst, int num, int channel, int height, int width);
+    static Status ConvertFromNCHW16ToNCHWFloat(float *src, float *dst, int num, int channel, int height, int width);
+
+    // @brief convert float blobs between nchw and the formats NCHW, NC4HW4, NC8HW8 or NC16HW16
+    static Status ConvertFromNCHWToPackedFloat(float *src, float *dst, DataFormat dst_format, int num, int channel,
+                                               int height, int width);
+    static Status ConvertFromPackedToNCHWFloat(float *src, float *dst, DataFormat src_format, int num, int channel,
+                                               int height, int width);
+
     static Status ConvertFromInt8ToFloatNCHW4(int8_t *src, float *dst, float *scale, int scale_len, int num,
                                               int channel, int height, int width);
     static Status ConvertFromInt8ToFloatNCHW(int8_t *src, float *dst, float *scale, int scale_len, int num, int channel,
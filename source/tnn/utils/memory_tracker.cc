@@ -0,0 +1,173 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/memory_tracker.h"
+
+#include <stdio.h>
+
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace TNN_NS {
+
+MemoryCounter::MemoryCounter(std::shared_ptr<MemoryCounter> parent) : current_(0), peak_(0), parent_(parent) {}
+
+void MemoryCounter::Add(long long bytes) {
+    long long current = current_.fetch_add(bytes) + bytes;
+    long long peak    = peak_.load();
+    while (current > peak && !peak_.compare_exchange_weak(peak, current)) {
+    }
+    if (parent_) {
+        parent_->Add(bytes);
+    }
+}
+
+void MemoryCounter::Sub(long long bytes) {
+    current_.fetch_sub(bytes);
+    if (parent_) {
+        parent_->Sub(bytes);
+    }
+}
+
+MemoryUsage MemoryCounter::GetUsage() {
+    MemoryUsage usage;
+    usage.current = current_.load();
+    usage.peak    = peak_.load();
+    return usage;
+}
+
+MemoryTracker::MemoryTracker() {
+    total_ = std::make_shared<MemoryCounter>(nullptr);
+    for (int i = 0; i < MEMORY_TYPE_COUNT; ++i) {
+        counters_.push_back(std::make_shared<MemoryCounter>(total_));
+    }
+}
+
+std::shared_ptr<MemoryCounter> MemoryTracker::GetCounter(MemoryType type) {
+    return counters_[type];
+}
+
+std::shared_ptr<MemoryCounter> MemoryTracker::CreateLayerCounter() {
+    return std::make_shared<MemoryCounter>(counters_[MEMORY_TYPE_LAYER]);
+}
+
+MemoryUsage MemoryTracker::GetTotalUsage() {
+    return total_->GetUsage();
+}
+
+// scope of the allocations on this thread
+static thread_local MemoryTracker *g_current_tracker = nullptr;
+static thread_local MemoryCounter *g_current_counter = nullptr;
+
+MemoryTrackerScope::MemoryTrackerScope(MemoryTracker *tracker, MemoryCounter *counter) {
+    last_tracker_     = g_current_tracker;
+    last_counter_     = g_current_counter;
+    g_current_tracker = tracker;
+    g_current_counter = tracker ? counter : nullptr;
+}
+
+MemoryTrackerScope::MemoryTrackerScope(MemoryTracker *tracker, MemoryType type)
+    : MemoryTrackerScope(tracker, tracker ? tracker->GetCounter(type).get() : nullptr) {}
+
+MemoryTrackerScope::MemoryTrackerScope(MemoryType type) : MemoryTrackerScope(g_current_tracker, type) {}
+
+MemoryTrackerScope::~MemoryTrackerScope() {
+    g_current_tracker = last_tracker_;
+    g_current_counter = last_counter_;
+}
+
+std::shared_ptr<MemoryCounter> GetCurrentMemoryCounter() {
+    return g_current_counter ? g_current_counter->shared_from_this() : nullptr;
+}
+
+struct DeviceMemoryRecords {
+    std::mutex mtx;
+    std::map<void *, std::pair<std::shared_ptr<MemoryCounter>, long long>> records;
+};
+
+static DeviceMemoryRecords &GetDeviceMemoryRecords() {
+    static DeviceMemoryRecords records;
+    return records;
+}
+
+void TrackDeviceMemory(void *handle, long long bytes) {
+    auto counter = GetCurrentMemoryCounter();
+    if (!counter || !handle) {
+        return;
+    }
+    counter->Add(bytes);
+    auto &records = GetDeviceMemoryRecords();
+    std::unique_lock<std::mutex> lck(records.mtx);
+    records.records[handle] = std::make_pair(counter, bytes);
+}
+
+void UntrackDeviceMemory(void *handle) {
+    auto &records = GetDeviceMemoryRecords();
+    std::unique_lock<std::mutex> lck(records.mtx);
+    auto iter = records.records.find(handle);
+    if (iter == records.records.end()) {
+        return;
+    }
+    iter->second.first->Sub(iter->second.second);
+    records.records.erase(iter);
+}
+
+const char *MemoryTypeToString(MemoryType type) {
+    switch (type) {
+        case MEMORY_TYPE_WEIGHTS:
+            return "weights";
+        case MEMORY_TYPE_LAYER:
+            return "layer";
+        case MEMORY_TYPE_BLOB:
+            return "blob";
+        case MEMORY_TYPE_WORKSPACE:
+            return "workspace";
+        case MEMORY_TYPE_CONVERTER:
+            return "converter";
+        case MEMORY_TYPE_MAT:
+            return "mat";
+        default:
+            return "unknown";
+    }
+}
+
+static std::string FormatUsage(const std::string &name, const MemoryUsage &usage) {
+    char line[256];
+    snprintf(line, sizeof(line), "%-40s %14.3f %14.3f\n", name.c_str(), usage.current / 1024.0,
+             usage.peak / 1024.0);
+    return line;
+}
+
+std::string MemoryReport::ToString() const {
+    std::stringstream ss;
+    char line[256];
+    snprintf(line, sizeof(line), "%-40s %14s %14s\n", "memory", "current(KB)", "peak(KB)");
+    ss << line;
+    for (int i = 0; i < MEMORY_TYPE_COUNT; ++i) {
+        ss << FormatUsage(std::string("  ") + MemoryTypeToString((MemoryType)i), usage[i]);
+    }
+    ss << FormatUsage("  total", total);
+    snprintf(line, sizeof(line), "%-40s %14.3f\n", "forward memory(KB)", forward_memory / 1024.0);
+    ss << line;
+
+    snprintf(line, sizeof(line), "%-40s %14s %14s\n", "layer", "current(KB)", "peak(KB)");
+    ss << line;
+    for (auto &layer : layers) {
+        ss << FormatUsage("  " + layer.layer_name + " (" + layer.layer_type + ")", layer.usage);
+    }
+    return ss.str();
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,96 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_MEMORY_TRACKER_H_
+#define TNN_SOURCE_TNN_UTILS_MEMORY_TRACKER_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tnn/utils/memory_report.h"
+
+namespace TNN_NS {
+
+// @brief MemoryCounter counts the bytes of one memory type or one layer,
+// bytes are also added to the parent counter.
+class MemoryCounter : public std::enable_shared_from_this<MemoryCounter> {
+public:
+    explicit MemoryCounter(std::shared_ptr<MemoryCounter> parent);
+
+    void Add(long long bytes);
+
+    void Sub(long long bytes);
+
+    MemoryUsage GetUsage();
+
+private:
+    std::atomic<long long> current_;
+    std::atomic<long long> peak_;
+    std::shared_ptr<MemoryCounter> parent_;
+};
+
+// @brief MemoryTracker holds the counters of an instance or an interpreter.
+// Counters of freed memory stay alive with the buffers, the tracker may be
+// released before the buffers it counts.
+class MemoryTracker {
+public:
+    MemoryTracker();
+
+    std::shared_ptr<MemoryCounter> GetCounter(MemoryType type);
+
+    // @brief create the counter of a layer, counted as MEMORY_TYPE_LAYER
+    std::shared_ptr<MemoryCounter> CreateLayerCounter();
+
+    MemoryUsage GetTotalUsage();
+
+private:
+    std::shared_ptr<MemoryCounter> total_;
+    std::vector<std::shared_ptr<MemoryCounter>> counters_;
+};
+
+// @brief MemoryTrackerScope counts the memory allocated by RawBuffer and the
+// cpu devices on this thread to the counter, until the scope ends.
+class MemoryTrackerScope {
+public:
+    // @param tracker  tracker of the scope, null to stop counting
+    // @param counter  counter of the allocations, one of the tracker
+    MemoryTrackerScope(MemoryTracker *tracker, MemoryCounter *counter);
+
+    // @param tracker  tracker of the scope, counted as type
+    MemoryTrackerScope(MemoryTracker *tracker, MemoryType type);
+
+    // @brief count as type of the tracker of the current scope, such as the
+    // shared workspace of a context
+    explicit MemoryTrackerScope(MemoryType type);
+
+    ~MemoryTrackerScope();
+
+private:
+    MemoryTracker *last_tracker_;
+    MemoryCounter *last_counter_;
+};
+
+// @brief counter of the current scope on this thread, null if not counted
+std::shared_ptr<MemoryCounter> GetCurrentMemoryCounter();
+
+// @brief count memory allocated by a device, it is uncounted by UntrackDeviceMemory
+void TrackDeviceMemory(void *handle, long long bytes);
+
+void UntrackDeviceMemory(void *handle);
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_MEMORY_TRACKER_H_
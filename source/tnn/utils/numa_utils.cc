@@ -0,0 +1,163 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/utils/numa_utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "tnn/core/macro.h"
+#include "tnn/utils/cpu_utils.h"
+
+namespace TNN_NS {
+
+// node count of the node masks passed to the kernel, same as the cpu sets
+#define TNN_NUMA_MAXNODE 1024
+#define TNN_NUMA_NBITS (8 * sizeof(unsigned long))
+
+void NumaUtils::ParseCpuList(const char* str, std::vector<int>& cpu_list) {
+    const char* p = str;
+    while (*p != '\0' && *p != '\n') {
+        char* end = nullptr;
+        int first = (int)strtol(p, &end, 10);
+        if (end == p) {
+            break;
+        }
+        int last = first;
+        p        = end;
+        if (*p == '-') {
+            last = (int)strtol(p + 1, &end, 10);
+            p    = end;
+        }
+        for (int i = first; i <= last; i++) {
+            cpu_list.push_back(i);
+        }
+        if (*p == ',') {
+            p++;
+        }
+    }
+}
+
+bool NumaUtils::ReadCpuListFile(const std::string& path, std::vector<int>& cpu_list) {
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) {
+        return false;
+    }
+    char line[1024] = {0};
+    char* s         = fgets(line, 1024, fp);
+    fclose(fp);
+    if (s) {
+        ParseCpuList(line, cpu_list);
+    }
+    return !cpu_list.empty();
+}
+
+int NumaUtils::GetNodeCount(const std::string& node_dir) {
+    std::vector<int> nodes;
+    if (!ReadCpuListFile(node_dir + "/possible", nodes)) {
+        return 1;
+    }
+    return nodes.back() + 1;
+}
+
+Status NumaUtils::GetNodeCpuList(const std::string& node_dir, int numa_node, std::vector<int>& cpu_list) {
+    cpu_list.clear();
+    if (!ReadCpuListFile(node_dir + "/node" + std::to_string(numa_node) + "/cpulist", cpu_list)) {
+        return Status(TNNERR_SET_CPU_AFFINITY, "numa node not found or has no cpu");
+    }
+    return TNN_OK;
+}
+
+Status NumaUtils::GetMemoryPolicy(int& mode, std::vector<unsigned long>& nodemask) {
+#if (defined(__ANDROID__) || defined(__linux__)) && defined(__NR_get_mempolicy)
+    nodemask.assign(TNN_NUMA_MAXNODE / TNN_NUMA_NBITS, 0);
+    if (syscall(__NR_get_mempolicy, &mode, nodemask.data(), TNN_NUMA_MAXNODE, NULL, 0)) {
+        return Status(TNNERR_SET_CPU_AFFINITY, "failed to get numa memory policy");
+    }
+    return TNN_OK;
+#else
+    (void)mode;
+    (void)nodemask;
+    return TNNERR_SET_CPU_AFFINITY;
+#endif
+}
+
+Status NumaUtils::SetMemoryPolicy(int mode, const std::vector<unsigned long>& nodemask) {
+#if (defined(__ANDROID__) || defined(__linux__)) && defined(__NR_set_mempolicy)
+    if (syscall(__NR_set_mempolicy, mode, nodemask.empty() ? NULL : nodemask.data(),
+                nodemask.size() * TNN_NUMA_NBITS)) {
+        return Status(TNNERR_SET_CPU_AFFINITY, "failed to set numa memory policy");
+    }
+    return TNN_OK;
+#else
+    (void)mode;
+    (void)nodemask;
+    return TNNERR_SET_CPU_AFFINITY;
+#endif
+}
+
+NumaNodeGuard::NumaNodeGuard(int numa_node) : numa_node_(numa_node) {
+    if (numa_node_ < 0) {
+        return;
+    }
+
+    std::vector<int> cpu_list;
+    status_ = CpuUtils::GetNumaNodeCpuList(numa_node_, cpu_list);
+    if (status_ != TNN_OK) {
+        LOGE("NumaNodeGuard get cpu list of numa node %d failed\n", numa_node_);
+        return;
+    }
+
+    CpuUtils::GetCpuAffinity(saved_cpu_list_);
+    status_ = CpuUtils::SetCpuAffinity(cpu_list);
+    if (status_ != TNN_OK) {
+        LOGE("NumaNodeGuard bind thread to numa node %d failed\n", numa_node_);
+        return;
+    }
+
+    // memory policy is best effort, kernels built without numa reject it,
+    // it is only changed when the previous one can be restored
+    if (NumaUtils::GetMemoryPolicy(saved_policy_mode_, saved_nodemask_) != TNN_OK) {
+        LOGD("NumaNodeGuard get memory policy failed\n");
+        return;
+    }
+    policy_saved_ = true;
+    if (CpuUtils::SetNumaMemoryPolicy(numa_node_) != TNN_OK) {
+        LOGD("NumaNodeGuard set memory policy of numa node %d failed\n", numa_node_);
+    }
+}
+
+NumaNodeGuard::~NumaNodeGuard() {
+    if (numa_node_ < 0 || status_ != TNN_OK) {
+        return;
+    }
+    if (policy_saved_) {
+        NumaUtils::SetMemoryPolicy(saved_policy_mode_, saved_nodemask_);
+    }
+    if (!saved_cpu_list_.empty()) {
+        CpuUtils::SetCpuAffinity(saved_cpu_list_);
+    }
+}
+
+Status NumaNodeGuard::GetStatus() {
+    return status_;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,75 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
+#define TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
+
+#include <string>
+#include <vector>
+
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// @brief NumaUtils reads the numa topology from sysfs and saves or restores
+// the memory policy of the calling thread
+class NumaUtils {
+public:
+    // @brief parse a sysfs cpu or node list like "0-3,8,10-11"
+    static void ParseCpuList(const char* str, std::vector<int>& cpu_list);
+
+    // @brief read a sysfs cpu or node list file, false if it is missing or empty
+    static bool ReadCpuListFile(const std::string& path, std::vector<int>& cpu_list);
+
+    // @brief get numa node count from the sysfs node dir, 1 if it is missing
+    static int GetNodeCount(const std::string& node_dir);
+
+    // @brief get cpu list of numa node from the sysfs node dir, offline nodes
+    // and memory only nodes are rejected
+    static Status GetNodeCpuList(const std::string& node_dir, int numa_node, std::vector<int>& cpu_list);
+
+    // @brief get memory policy mode and node mask of the calling thread
+    static Status GetMemoryPolicy(int& mode, std::vector<unsigned long>& nodemask);
+
+    // @brief set memory policy mode and node mask of the calling thread
+    static Status SetMemoryPolicy(int mode, const std::vector<unsigned long>& nodemask);
+};
+
+// @brief NumaNodeGuard binds the calling thread and its memory policy to a
+// numa node, so that memory allocated and first touched inside the scope is
+// placed on the node. The previous cpu affinity and memory policy are
+// restored on destruction.
+class NumaNodeGuard {
+public:
+    // @param numa_node numa node id, -1 does nothing
+    explicit NumaNodeGuard(int numa_node);
+
+    ~NumaNodeGuard();
+
+    // @brief status of binding the calling thread
+    Status GetStatus();
+
+private:
+    int numa_node_ = -1;
+    Status status_ = TNN_OK;
+    std::vector<int> saved_cpu_list_;
+    bool policy_saved_ = false;
+    int saved_policy_mode_ = 0;
+    std::vector<unsigned long> saved_nodemask_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_NUMA_UTILS_H_
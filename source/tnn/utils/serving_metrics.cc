@@ -0,0 +1,239 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/serving_metrics_inner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <sstream>
+
+namespace TNN_NS {
+
+// bounds of the buckets exported to prometheus, in ms
+static const double kExportBucketBounds[] = {0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500,
+                                             5000, 10000};
+
+LatencyHistogram::LatencyHistogram() : count_(0), sum_(0), min_(LLONG_MAX), max_(0) {
+    for (int i = 0; i < kBucketCount; ++i) {
+        counts_[i] = 0;
+    }
+}
+
+int LatencyHistogram::GetBucketIndex(long long us) {
+    if (us < kSubBucketCount) {
+        return static_cast<int>(std::max(us, 0LL));
+    }
+    int magnitude = 0;
+    while ((us >> (magnitude + 1)) > 0) {
+        magnitude++;
+    }
+    if (magnitude > kMaxMagnitude) {
+        return kBucketCount - 1;
+    }
+    // the kSubBucketBits bits below the leading one
+    int shift    = magnitude - kSubBucketBits;
+    int mantissa = static_cast<int>((us >> shift) & (kSubBucketCount - 1));
+    return kSubBucketCount + shift * kSubBucketCount + mantissa;
+}
+
+long long LatencyHistogram::GetBucketUpperBound(int index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    int shift       = (index - kSubBucketCount) / kSubBucketCount;
+    int mantissa    = (index - kSubBucketCount) % kSubBucketCount;
+    long long lower = static_cast<long long>(kSubBucketCount + mantissa) << shift;
+    return lower + (1LL << shift) - 1;
+}
+
+void LatencyHistogram::Record(long long us) {
+    us = std::max(us, 0LL);
+    counts_[GetBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(us, std::memory_order_relaxed);
+
+    long long min = min_.load(std::memory_order_relaxed);
+    while (us < min && !min_.compare_exchange_weak(min, us, std::memory_order_relaxed)) {
+    }
+    long long max = max_.load(std::memory_order_relaxed);
+    while (us > max && !max_.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+    }
+}
+
+LatencyHistogramData LatencyHistogram::GetData() {
+    // buckets are read one by one, a snapshot taken during Record may be off by the recording samples
+    std::vector<long long> counts(kBucketCount);
+    long long count = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        counts[i] = counts_[i].load(std::memory_order_relaxed);
+        count += counts[i];
+    }
+
+    LatencyHistogramData data;
+    data.count = count;
+    data.sum   = sum_.load(std::memory_order_relaxed) / 1000.0;
+    if (count > 0) {
+        data.min = min_.load(std::memory_order_relaxed) / 1000.0;
+        data.max = max_.load(std::memory_order_relaxed) / 1000.0;
+    }
+
+    auto percentile = [&](double percent) {
+        long long rank = std::max(1LL, static_cast<long long>(std::ceil(percent / 100.0 * count)));
+        long long seen = 0;
+        for (int i = 0; i < kBucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(std::max(GetBucketUpperBound(i) / 1000.0, data.min), data.max);
+            }
+        }
+        return data.max;
+    };
+    if (count > 0) {
+        data.p50  = percentile(50);
+        data.p90  = percentile(90);
+        data.p99  = percentile(99);
+        data.p999 = percentile(99.9);
+    }
+
+    // a bucket is counted in the bounds not less than its highest value
+    int index      = 0;
+    long long seen = 0;
+    for (auto bound : kExportBucketBounds) {
+        while (index < kBucketCount && GetBucketUpperBound(index) <= bound * 1000) {
+            seen += counts[index++];
+        }
+        data.bucket_bounds.push_back(bound);
+        data.bucket_counts.push_back(seen);
+    }
+    return data;
+}
+
+ServingMetrics::ServingMetrics() : forward_count_(0), error_count_(0), async_submit_end_(0) {}
+
+long long ServingMetrics::Now() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void ServingMetrics::OnForward(long long start, bool success) {
+    forward_.Record(Now() - start);
+    forward_count_.fetch_add(1, std::memory_order_relaxed);
+    if (!success) {
+        error_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ServingMetrics::OnForwardAsync(long long start, bool success) {
+    long long end = Now();
+    forward_.Record(end - start);
+    forward_count_.fetch_add(1, std::memory_order_relaxed);
+    if (success) {
+        async_submit_end_.store(end, std::memory_order_relaxed);
+    } else {
+        error_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ServingMetrics::OnConvertIn(long long start, bool success) {
+    convert_in_.Record(Now() - start);
+    if (!success) {
+        error_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ServingMetrics::OnConvertOut(long long start, bool success) {
+    long long end = Now();
+    convert_out_.Record(end - start);
+    if (!success) {
+        error_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // the first output collected after an async forward, conversion waits for the device queue
+    long long submit_end = async_submit_end_.exchange(0, std::memory_order_relaxed);
+    if (submit_end > 0) {
+        queue_.Record(end - submit_end);
+    }
+}
+
+ServingMetricsData ServingMetrics::GetData() {
+    ServingMetricsData data;
+    data.forward_count = forward_count_.load(std::memory_order_relaxed);
+    data.error_count   = error_count_.load(std::memory_order_relaxed);
+    data.convert_in    = convert_in_.GetData();
+    data.forward       = forward_.GetData();
+    data.convert_out   = convert_out_.GetData();
+    data.queue         = queue_.GetData();
+    return data;
+}
+
+static std::string EscapeLabelValue(const std::string& value) {
+    std::string escaped;
+    for (auto c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// labels of a sample, with an extra label such as le if not empty
+static std::string FormatLabels(const std::map<std::string, std::string>& labels, const std::string& extra = "") {
+    std::string text;
+    for (auto& label : labels) {
+        text += (text.empty() ? "" : ",") + label.first + "=\"" + EscapeLabelValue(label.second) + "\"";
+    }
+    if (!extra.empty()) {
+        text += (text.empty() ? "" : ",") + extra;
+    }
+    return text.empty() ? "" : "{" + text + "}";
+}
+
+static void WriteHistogram(std::stringstream& ss, const std::string& name, const std::string& help,
+                           const LatencyHistogramData& data, const std::map<std::string, std::string>& labels) {
+    ss << "# HELP " << name << " " << help << "\n";
+    ss << "# TYPE " << name << " histogram\n";
+    for (int i = 0; i < data.bucket_bounds.size(); ++i) {
+        std::stringstream le;
+        le << "le=\"" << data.bucket_bounds[i] / 1000.0 << "\"";
+        ss << name << "_bucket" << FormatLabels(labels, le.str()) << " " << data.bucket_counts[i] << "\n";
+    }
+    ss << name << "_bucket" << FormatLabels(labels, "le=\"+Inf\"") << " " << data.count << "\n";
+    ss << name << "_sum" << FormatLabels(labels) << " " << data.sum / 1000.0 << "\n";
+    ss << name << "_count" << FormatLabels(labels) << " " << data.count << "\n";
+}
+
+std::string ServingMetricsData::ToPrometheusText(const std::map<std::string, std::string>& labels) const {
+    std::stringstream ss;
+    ss << "# HELP tnn_forward_total Forward calls of the instance.\n";
+    ss << "# TYPE tnn_forward_total counter\n";
+    ss << "tnn_forward_total" << FormatLabels(labels) << " " << forward_count << "\n";
+    ss << "# HELP tnn_errors_total Failed forward calls and mat conversions of the instance.\n";
+    ss << "# TYPE tnn_errors_total counter\n";
+    ss << "tnn_errors_total" << FormatLabels(labels) << " " << error_count << "\n";
+    WriteHistogram(ss, "tnn_convert_in_latency_seconds", "Input mat conversion latency.", convert_in, labels);
+    WriteHistogram(ss, "tnn_forward_latency_seconds", "Forward latency, submission only for async forward.", forward,
+                   labels);
+    WriteHistogram(ss, "tnn_convert_out_latency_seconds", "Output mat conversion latency.", convert_out, labels);
+    WriteHistogram(ss, "tnn_queue_latency_seconds", "Time from async forward submission to its first output.",
+                   queue, labels);
+    return ss.str();
+}
+
+}  // namespace TNN_NS
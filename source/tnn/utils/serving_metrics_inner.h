@@ -0,0 +1,86 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_SERVING_METRICS_INNER_H_
+#define TNN_SOURCE_TNN_UTILS_SERVING_METRICS_INNER_H_
+
+#include <atomic>
+
+#include "tnn/utils/serving_metrics.h"
+
+namespace TNN_NS {
+
+// @brief LatencyHistogram is a lock free log-linear histogram of latencies in
+// us, like HdrHistogram. Each power of two range is split into
+// kSubBucketCount buckets, the relative error of a value is below 1/16.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void Record(long long us);
+
+    LatencyHistogramData GetData();
+
+private:
+    static const int kSubBucketBits  = 4;
+    static const int kSubBucketCount = 1 << kSubBucketBits;
+    // values up to 2^40 us, larger ones are put into the last bucket
+    static const int kMaxMagnitude = 40;
+    static const int kBucketCount  = kSubBucketCount * (kMaxMagnitude - kSubBucketBits + 2);
+
+    static int GetBucketIndex(long long us);
+
+    // @brief highest value of the bucket in us
+    static long long GetBucketUpperBound(int index);
+
+    std::atomic<long long> counts_[kBucketCount];
+    std::atomic<long long> count_;
+    std::atomic<long long> sum_;
+    std::atomic<long long> min_;
+    std::atomic<long long> max_;
+};
+
+// @brief ServingMetrics holds the counters and histograms of an instance,
+// updated without locks from the threads calling the instance.
+class ServingMetrics {
+public:
+    ServingMetrics();
+
+    // @brief time now in us, used as start of the On* functions
+    static long long Now();
+
+    void OnForward(long long start, bool success);
+
+    void OnForwardAsync(long long start, bool success);
+
+    void OnConvertIn(long long start, bool success);
+
+    void OnConvertOut(long long start, bool success);
+
+    ServingMetricsData GetData();
+
+private:
+    LatencyHistogram convert_in_;
+    LatencyHistogram forward_;
+    LatencyHistogram convert_out_;
+    LatencyHistogram queue_;
+    std::atomic<long long> forward_count_;
+    std::atomic<long long> error_count_;
+    // end of the last ForwardAsync submission whose output is not collected, 0 if none
+    std::atomic<long long> async_submit_end_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_SERVING_METRICS_INNER_H_
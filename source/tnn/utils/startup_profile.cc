@@ -0,0 +1,189 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/startup_profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#if defined(__ANDROID__) || defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "tnn/utils/startup_profile_inner.h"
+
+namespace TNN_NS {
+
+static std::atomic<bool> g_startup_profile_enabled(false);
+
+struct StartupProfileData {
+    std::mutex mtx;
+    std::vector<StartupStageData> stages;
+    std::vector<StartupLayerData> layers;
+    std::map<std::string, int> stage_index;
+    std::map<std::string, int> layer_index;
+};
+
+static StartupProfileData &GetStartupProfileData() {
+    static StartupProfileData data;
+    return data;
+}
+
+void StartupProfile::SetEnabled(bool enabled) {
+    g_startup_profile_enabled = enabled;
+}
+
+bool StartupProfile::IsEnabled() {
+    return g_startup_profile_enabled;
+}
+
+void StartupProfile::Reset() {
+    auto &data = GetStartupProfileData();
+    std::unique_lock<std::mutex> lck(data.mtx);
+    data.stages.clear();
+    data.layers.clear();
+    data.stage_index.clear();
+    data.layer_index.clear();
+}
+
+void StartupProfile::AddStage(const std::string &name, double time, long page_faults) {
+    auto &data = GetStartupProfileData();
+    std::unique_lock<std::mutex> lck(data.mtx);
+    if (data.stage_index.count(name) == 0) {
+        data.stage_index[name] = (int)data.stages.size();
+        StartupStageData stage;
+        stage.name = name;
+        data.stages.push_back(stage);
+    }
+    auto &stage = data.stages[data.stage_index[name]];
+    stage.time += time;
+    stage.page_faults += page_faults;
+}
+
+void StartupProfile::AddLayer(const std::string &layer_name, const std::string &layer_type, double time) {
+    auto &data = GetStartupProfileData();
+    std::unique_lock<std::mutex> lck(data.mtx);
+    if (data.layer_index.count(layer_name) == 0) {
+        data.layer_index[layer_name] = (int)data.layers.size();
+        StartupLayerData layer;
+        layer.layer_name = layer_name;
+        layer.layer_type = layer_type;
+        data.layers.push_back(layer);
+    }
+    data.layers[data.layer_index[layer_name]].time += time;
+}
+
+std::vector<StartupStageData> StartupProfile::GetStages() {
+    auto &data = GetStartupProfileData();
+    std::unique_lock<std::mutex> lck(data.mtx);
+    return data.stages;
+}
+
+std::vector<StartupLayerData> StartupProfile::GetLayers() {
+    auto &data = GetStartupProfileData();
+    std::vector<StartupLayerData> layers;
+    {
+        std::unique_lock<std::mutex> lck(data.mtx);
+        layers = data.layers;
+    }
+    std::stable_sort(layers.begin(), layers.end(),
+                     [](const StartupLayerData &a, const StartupLayerData &b) { return a.time > b.time; });
+    return layers;
+}
+
+long StartupProfile::GetPageFaults() {
+#if defined(__ANDROID__) || defined(__linux__) || defined(__APPLE__)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_minflt;
+    }
+#endif
+    return 0;
+}
+
+// innermost running stage of the thread, paused while a nested stage runs
+static thread_local StartupStageTimer *g_current_stage_timer = nullptr;
+
+StartupStageTimer::StartupStageTimer(const std::string &name) {
+    if (!StartupProfile::IsEnabled()) {
+        return;
+    }
+    name_    = name;
+    running_ = true;
+    parent_  = g_current_stage_timer;
+    if (parent_) {
+        parent_->Pause();
+    }
+    g_current_stage_timer = this;
+    page_faults_          = StartupProfile::GetPageFaults();
+    start_                = std::chrono::steady_clock::now();
+}
+
+StartupStageTimer::~StartupStageTimer() {
+    Stop();
+}
+
+void StartupStageTimer::Stop() {
+    if (!running_) {
+        return;
+    }
+    Pause();
+    running_ = false;
+    if (g_current_stage_timer == this) {
+        g_current_stage_timer = parent_;
+        if (parent_) {
+            parent_->Resume();
+        }
+    }
+}
+
+void StartupStageTimer::Pause() {
+    if (!running_ || paused_) {
+        return;
+    }
+    paused_     = true;
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+    StartupProfile::AddStage(name_, time, StartupProfile::GetPageFaults() - page_faults_);
+}
+
+void StartupStageTimer::Resume() {
+    if (!running_ || !paused_) {
+        return;
+    }
+    paused_      = false;
+    page_faults_ = StartupProfile::GetPageFaults();
+    start_       = std::chrono::steady_clock::now();
+}
+
+StartupLayerTimer::StartupLayerTimer(const std::string &layer_name, const std::string &layer_type) {
+    if (!StartupProfile::IsEnabled()) {
+        return;
+    }
+    layer_name_ = layer_name;
+    layer_type_ = layer_type;
+    running_    = true;
+    start_      = std::chrono::steady_clock::now();
+}
+
+StartupLayerTimer::~StartupLayerTimer() {
+    if (!running_) {
+        return;
+    }
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_).count();
+    StartupProfile::AddLayer(layer_name_, layer_type_, time);
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,63 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_UTILS_STARTUP_PROFILE_INNER_H_
+#define TNN_SOURCE_TNN_UTILS_STARTUP_PROFILE_INNER_H_
+
+#include <chrono>
+#include <string>
+
+#include "tnn/utils/startup_profile.h"
+
+namespace TNN_NS {
+
+// @brief StartupStageTimer adds the time and page faults of its scope to the
+// stage, it does nothing if StartupProfile is disabled. A stage started within
+// another one on the same thread is not counted in the enclosing stage.
+class StartupStageTimer {
+public:
+    explicit StartupStageTimer(const std::string &name);
+    ~StartupStageTimer();
+
+    // @brief add the stage now instead of at destruction
+    void Stop();
+
+private:
+    void Pause();
+    void Resume();
+
+    std::string name_;
+    bool running_     = false;
+    bool paused_      = false;
+    long page_faults_ = 0;
+    std::chrono::time_point<std::chrono::steady_clock> start_;
+    StartupStageTimer *parent_ = nullptr;
+};
+
+// @brief StartupLayerTimer adds the time of its scope to the layer
+class StartupLayerTimer {
+public:
+    StartupLayerTimer(const std::string &layer_name, const std::string &layer_type);
+    ~StartupLayerTimer();
+
+private:
+    std::string layer_name_;
+    std::string layer_type_;
+    bool running_ = false;
+    std::chrono::time_point<std::chrono::steady_clock> start_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_STARTUP_PROFILE_INNER_H_
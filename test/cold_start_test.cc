@@ -0,0 +1,280 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/cold_start_test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <sstream>
+
+#if defined(__ANDROID__) || defined(__linux__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "test/flags.h"
+#include "test/test.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/startup_profile.h"
+
+namespace TNN_NS {
+
+namespace test {
+
+    using std::chrono::steady_clock;
+
+    static const char* kTotalTag = "cold_start_total";
+    static const char* kStageTag = "cold_start_stage";
+    static const char* kLayerTag = "cold_start_layer";
+
+    // number of the slowest layers printed
+    static const int kTopLayerCount = 10;
+
+    static double ElapsedMs(steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(steady_clock::now() - start).count();
+    }
+
+    // stage time and page faults of all runs
+    struct ColdStartStage {
+        std::string name;
+        std::vector<double> times;
+        double page_faults = 0;
+    };
+
+    class ColdStartStages {
+    public:
+        void Add(const std::string& name, double time, double page_faults) {
+            if (index_.count(name) == 0) {
+                index_[name] = (int)stages_.size();
+                ColdStartStage stage;
+                stage.name = name;
+                stages_.push_back(stage);
+            }
+            auto& stage = stages_[index_[name]];
+            stage.times.push_back(time);
+            stage.page_faults += page_faults;
+        }
+
+        std::vector<ColdStartStage>& GetStages() {
+            return stages_;
+        }
+
+    private:
+        std::vector<ColdStartStage> stages_;
+        std::map<std::string, int> index_;
+    };
+
+    int RunColdStartOnce() {
+        StartupProfile::SetEnabled(true);
+
+        auto start       = steady_clock::now();
+        long page_faults = StartupProfile::GetPageFaults();
+        auto end_stage   = [&](const char* name) {
+            long faults = StartupProfile::GetPageFaults();
+            printf("%s\t%s\t%f\t%ld\n", kTotalTag, name, ElapsedMs(start), faults - page_faults);
+            start       = steady_clock::now();
+            page_faults = faults;
+        };
+
+        ModelConfig model_config = GetModelConfig();
+        end_stage("file read");
+
+        NetworkConfig network_config = GetNetworkConfig();
+        InputShapesMap input_shape   = GetInputShapesMap();
+
+        start       = steady_clock::now();
+        page_faults = StartupProfile::GetPageFaults();
+        TNN net;
+        Status ret = net.Init(model_config);
+        if (!CheckResult("init tnn", ret)) {
+            return -1;
+        }
+        end_stage("TNN::Init");
+
+        auto instance = net.CreateInst(network_config, ret, input_shape);
+        if (!CheckResult("create instance", ret)) {
+            return -1;
+        }
+        instance->SetCpuNumThreads(std::max(FLAGS_th, 1));
+        end_stage("CreateInst");
+
+        BlobMap input_blob_map;
+        BlobMap output_blob_map;
+        void* command_queue;
+        instance->GetAllInputBlobs(input_blob_map);
+        instance->GetAllOutputBlobs(output_blob_map);
+        instance->GetCommandQueue(&command_queue);
+
+        MatMap input_mat_map = CreateBlobMatMap(input_blob_map, FLAGS_it);
+        InitInputMatMap(input_mat_map);
+        auto input_converters_map = CreateBlobConverterMap(input_blob_map);
+        auto input_params_map     = CreateConvertParamMap(input_mat_map);
+
+        MatMap output_mat_map      = CreateBlobMatMap(output_blob_map, 0);
+        auto output_converters_map = CreateBlobConverterMap(output_blob_map);
+        auto output_params_map     = CreateConvertParamMap(output_mat_map);
+
+        // page faults of the first forward touch blob memory and packed weights
+        start       = steady_clock::now();
+        page_faults = StartupProfile::GetPageFaults();
+        for (auto element : input_converters_map) {
+            auto name = element.first;
+            element.second->ConvertFromMatAsync(*input_mat_map[name], input_params_map[name], command_queue);
+        }
+        ret = instance->ForwardAsync(nullptr);
+        for (auto element : output_converters_map) {
+            auto name = element.first;
+            element.second->ConvertToMat(*output_mat_map[name], output_params_map[name], command_queue);
+        }
+        if (!CheckResult("Forward", ret)) {
+            return -1;
+        }
+        end_stage("first forward");
+
+        for (auto& stage : StartupProfile::GetStages()) {
+            printf("%s\t%s\t%f\t%ld\n", kStageTag, stage.name.c_str(), stage.time, stage.page_faults);
+        }
+        for (auto& layer : StartupProfile::GetLayers()) {
+            printf("%s\t%s\t%s\t%f\n", kLayerTag, layer.layer_name.c_str(), layer.layer_type.c_str(), layer.time);
+        }
+        fflush(stdout);
+
+        FreeMatMapMemory(input_mat_map);
+        FreeMatMapMemory(output_mat_map);
+        return 0;
+    }
+
+    static std::vector<std::string> SplitString(const std::string& str, char delim) {
+        std::vector<std::string> fields;
+        std::stringstream ss(str);
+        std::string field;
+        while (std::getline(ss, field, delim)) {
+            fields.push_back(field);
+        }
+        return fields;
+    }
+
+    static void PrintStages(const char* title, std::vector<ColdStartStage>& stages, int runs) {
+        printf("%-32s %-10s %-10s %-10s %-12s\n", title, "avg(ms)", "min(ms)", "max(ms)", "page faults");
+        for (auto& stage : stages) {
+            double sum = 0;
+            for (auto time : stage.times) {
+                sum += time;
+            }
+            printf("  %-30s %-10.3f %-10.3f %-10.3f %-12.0f\n", stage.name.c_str(), sum / runs,
+                   *std::min_element(stage.times.begin(), stage.times.end()),
+                   *std::max_element(stage.times.begin(), stage.times.end()), stage.page_faults / runs);
+        }
+    }
+
+    int RunColdStartTest(const std::vector<std::string>& args) {
+#if defined(__ANDROID__) || defined(__linux__)
+        ColdStartStages totals;
+        ColdStartStages stages;
+        std::map<std::string, std::pair<std::string, double>> layers;
+
+        for (int i = 0; i < FLAGS_ic; ++i) {
+            int fds[2];
+            if (pipe(fds) != 0) {
+                printf("create pipe failed\n");
+                return -1;
+            }
+
+            auto start = steady_clock::now();
+            pid_t pid  = fork();
+            if (pid == 0) {
+                dup2(fds[1], STDOUT_FILENO);
+                close(fds[0]);
+                close(fds[1]);
+                std::vector<char*> argv;
+                for (auto& arg : args) {
+                    argv.push_back(const_cast<char*>(arg.c_str()));
+                }
+                std::string child_flag = "-csc";
+                argv.push_back(const_cast<char*>(child_flag.c_str()));
+                argv.push_back(nullptr);
+                execv("/proc/self/exe", argv.data());
+                _exit(127);
+            }
+            close(fds[1]);
+            if (pid < 0) {
+                close(fds[0]);
+                printf("fork failed\n");
+                return -1;
+            }
+
+            std::string output;
+            char buffer[4096];
+            ssize_t size = 0;
+            while ((size = read(fds[0], buffer, sizeof(buffer))) > 0) {
+                output.append(buffer, size);
+            }
+            close(fds[0]);
+
+            int status = 0;
+            waitpid(pid, &status, 0);
+            double process_time = ElapsedMs(start);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                printf("cold start run %d failed\n", i);
+                return -1;
+            }
+            totals.Add("process", process_time, 0);
+
+            for (auto& line : SplitString(output, '\n')) {
+                auto fields = SplitString(line, '\t');
+                if (fields.size() != 4) {
+                    continue;
+                }
+                if (fields[0] == kTotalTag) {
+                    totals.Add(fields[1], atof(fields[2].c_str()), atof(fields[3].c_str()));
+                } else if (fields[0] == kStageTag) {
+                    stages.Add(fields[1], atof(fields[2].c_str()), atof(fields[3].c_str()));
+                } else if (fields[0] == kLayerTag) {
+                    layers[fields[1]].first = fields[2];
+                    layers[fields[1]].second += atof(fields[3].c_str());
+                }
+            }
+        }
+
+        printf("cold start of %s, %d runs in fresh processes\n", FLAGS_mp.c_str(), FLAGS_ic);
+        PrintStages("total", totals.GetStages(), FLAGS_ic);
+        PrintStages("breakdown", stages.GetStages(), FLAGS_ic);
+
+        std::vector<std::pair<std::string, std::pair<std::string, double>>> sorted_layers(layers.begin(),
+                                                                                          layers.end());
+        std::stable_sort(sorted_layers.begin(), sorted_layers.end(),
+                         [](const std::pair<std::string, std::pair<std::string, double>>& a,
+                            const std::pair<std::string, std::pair<std::string, double>>& b) {
+                             return a.second.second > b.second.second;
+                         });
+        printf("%-32s %-16s %-10s\n", "slowest layer init", "type", "avg(ms)");
+        for (int i = 0; i < std::min((int)sorted_layers.size(), kTopLayerCount); ++i) {
+            printf("  %-30s %-16s %-10.3f\n", sorted_layers[i].first.c_str(), sorted_layers[i].second.first.c_str(),
+                   sorted_layers[i].second.second / FLAGS_ic);
+        }
+        return 0;
+#else
+        printf("cold start test needs fork and exec, run once in this process\n");
+        return RunColdStartOnce();
+#endif
+    }
+
+}  // namespace test
+
+}  // namespace TNN_NS
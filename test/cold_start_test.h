@@ -0,0 +1,37 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TEST_COLD_START_TEST_H_
+#define TNN_TEST_COLD_START_TEST_H_
+
+#include <string>
+#include <vector>
+
+namespace TNN_NS {
+
+namespace test {
+
+    // @brief run TNNTest with args again in a fresh process ic times, each one
+    // measures file read, TNN::Init, CreateInst and the first forward once.
+    // the startup stages and the slowest layers are summarized.
+    int RunColdStartTest(const std::vector<std::string>& args);
+
+    // @brief measure one cold start in this process and print the stages
+    int RunColdStartOnce();
+
+}  // namespace test
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_COLD_START_TEST_H_
@@ -52,4 +52,26 @@ DEFINE_string(pr, "AUTO", precision_message);
 
 DEFINE_string(is, "", input_shape_message);
 
+DEFINE_bool(bm, false, benchmark_mode_message);
+
+DEFINE_bool(tp, false, throughput_message);
+
+DEFINE_string(ni, "1", instance_count_list_message);
+
+DEFINE_string(tl, "", thread_num_list_message);
+
+DEFINE_string(nb, "1", batch_list_message);
+
+DEFINE_string(nc, "", client_count_list_message);
+
+DEFINE_bool(cs, false, cold_start_message);
+
+DEFINE_bool(csc, false, cold_start_child_message);
+
+DEFINE_string(bo, "", benchmark_output_message);
+
+DEFINE_bool(mr, false, memory_report_message);
+
+DEFINE_bool(sm, false, serving_metrics_message);
+
 }  // namespace TNN_NS
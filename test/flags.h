@@ -61,6 +61,29 @@ static const char input_shape_message[] = "input shape: name[n,c,h,w]";
 
 static const char network_type_message[] = "network type: NAIVE, NPU, COREML, SNPE, OPENVINO, default NAIVE";
 
+static const char benchmark_mode_message[] = "benchmark mode, generate weights missing in the model(default false)";
+
+static const char throughput_message[] = "throughput test, sweep instance count x threads per instance x batch";
+
+static const char instance_count_list_message[] = "instance count list of throughput test(eg: 1,2,4, default 1)";
+
+static const char thread_num_list_message[] = "threads per instance list of throughput test(eg: 1,2, default th)";
+
+static const char batch_list_message[] = "batch list of throughput test(eg: 1,8, default 1)";
+
+static const char client_count_list_message[] =
+    "client count list of throughput test, clients share the instances as a pool(eg: 8,16, default one per instance)";
+
+static const char cold_start_message[] = "cold start test, run ic times in fresh processes";
+
+static const char benchmark_output_message[] = "benchmark json output path, with the time of each iteration";
+
+static const char memory_report_message[] = "print memory report of the instance after forward";
+
+static const char serving_metrics_message[] = "enable instance metrics and print them in prometheus text";
+
+static const char cold_start_child_message[] = "run one cold start in this process, used by cs";
+
 DECLARE_bool(h);
 
 DECLARE_string(mt);
@@ -97,6 +120,28 @@ DECLARE_string(pr);
 
 DECLARE_string(is);
 
+DECLARE_bool(bm);
+
+DECLARE_bool(tp);
+
+DECLARE_string(ni);
+
+DECLARE_string(tl);
+
+DECLARE_string(nb);
+
+DECLARE_string(nc);
+
+DECLARE_bool(cs);
+
+DECLARE_bool(csc);
+
+DECLARE_string(bo);
+
+DECLARE_bool(mr);
+
+DECLARE_bool(sm);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_FLAGS_H_
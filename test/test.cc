@@ -25,8 +25,10 @@
 #include <sstream>
 #include <string>
 
+#include "test/cold_start_test.h"
 #include "test/flags.h"
 #include "test/test_utils.h"
+#include "test/throughput_test.h"
 #include "test/timer.h"
 #include "tnn/core/common.h"
 #include "tnn/core/instance.h"
@@ -51,17 +53,19 @@ namespace test {
 
     int Run(int argc, char* argv[]) {
         // parse command line params
+        std::vector<std::string> args(argv, argv + argc);
         if (!ParseAndCheckCommandLine(argc, argv))
             return -1;
+        if (FLAGS_csc) {
+            return RunColdStartOnce();
+        }
+        if (FLAGS_cs) {
+            return RunColdStartTest(args);
+        }
 #if (DUMP_INPUT_BLOB || DUMP_OUTPUT_BLOB)
         g_tnn_dump_directory = FLAGS_op;
 #endif
 
-        // Set the cpu affinity.
-        // usually, -dl 0-3 for little core, -dl 4-7 for big core
-        // only works when -dl flags were set. benchmark script not set -dl flags
-        SetCpuAffinity();
-
         ModelConfig model_config     = GetModelConfig();
         NetworkConfig network_config = GetNetworkConfig();
 
@@ -72,6 +76,9 @@ namespace test {
         TNN net;
         Status ret = net.Init(model_config);
         if (CheckResult("init tnn", ret)) {
+            if (FLAGS_tp) {
+                return RunThroughputTest(net, network_config, input_shape);
+            }
             auto instance = net.CreateInst(network_config, ret, input_shape);
             if (!CheckResult("create instance", ret)) {
                 return 0;
@@ -147,6 +154,21 @@ namespace test {
             }
  
             timer.Print();
+            if (!FLAGS_bo.empty()) {
+                timer.WriteJson(FLAGS_bo, FLAGS_dt, FLAGS_pr, FLAGS_th);
+            }
+            if (FLAGS_mr) {
+                MemoryReport memory_report;
+                if (CheckResult("memory report", instance->GetMemoryReport(memory_report))) {
+                    printf("%s", memory_report.ToString().c_str());
+                }
+            }
+            if (FLAGS_sm) {
+                ServingMetricsData metrics;
+                if (CheckResult("serving metrics", instance->GetServingMetrics(metrics))) {
+                    printf("%s", metrics.ToPrometheusText({{"model", model_name}}).c_str());
+                }
+            }
  
             FreeMatMapMemory(input_mat_map);
             FreeMatMapMemory(output_mat_map);
@@ -193,10 +215,21 @@ namespace test {
         printf("    -is \"<input shape>\"   \t%s \n", input_shape_message);
         printf("    -fc \"<format for compare>\t%s \n", output_format_cmp_message);
         printf("    -nt \"<network type>\t%s \n", output_format_cmp_message);
+        printf("    -bm                     \t%s \n", benchmark_mode_message);
+        printf("    -tp                     \t%s \n", throughput_message);
+        printf("    -ni \"<instance counts>\"\t%s \n", instance_count_list_message);
+        printf("    -tl \"<thread numbers>\" \t%s \n", thread_num_list_message);
+        printf("    -nb \"<batches>\"        \t%s \n", batch_list_message);
+        printf("    -nc \"<client counts>\"  \t%s \n", client_count_list_message);
+        printf("    -cs                     \t%s \n", cold_start_message);
+        printf("    -bo \"<path>\"          \t%s \n", benchmark_output_message);
+        printf("    -mr                     \t%s \n", memory_report_message);
+        printf("    -sm                     \t%s \n", serving_metrics_message);
     }
 
-    void SetCpuAffinity() {
-        // set cpu affinity, only work in arm mode
+    std::vector<int> GetCpuList() {
+        // cpu affinity of instance threads, only work in cpu mode
+        std::vector<int> device_list;
         if (!FLAGS_dl.empty()) {
             auto split = [=](const std::string str, char delim, std::vector<std::string>& str_vec) {
                 std::stringstream ss(str);
@@ -207,12 +240,11 @@ namespace test {
 
             std::vector<std::string> devices;
             split(FLAGS_dl, ',', devices);
-            std::vector<int> device_list;
             for (auto iter : devices) {
                 device_list.push_back(atoi(iter.c_str()));
             }
-            CpuUtils::SetCpuAffinity(device_list);
         }
+        return device_list;
     }
 
     InputShapesMap GetInputShapesMap() {
@@ -243,7 +275,8 @@ namespace test {
 
     ModelConfig GetModelConfig() {
         ModelConfig config;
-        config.model_type = ConvertModelType(FLAGS_mt);
+        config.model_type     = ConvertModelType(FLAGS_mt);
+        config.benchmark_mode = FLAGS_bm;
         if (config.model_type == MODEL_TYPE_TNN || config.model_type == MODEL_TYPE_OPENVINO ||
             config.model_type == MODEL_TYPE_NCNN) {
             std::string network_path = FLAGS_mp;
@@ -302,9 +335,15 @@ namespace test {
         if (FLAGS_lp.length() > 0) {
             config.library_path = {FLAGS_lp};
         }
+
+        // Set the cpu affinity.
+        // usually, -dl 0-3 for little core, -dl 4-7 for big core
+        // only works when -dl flags were set. benchmark script not set -dl flags
+        config.cpu_list = GetCpuList();
         //add for cache; When using Huawei NPU, 
 	//it is the path to store the om i.e. config.cache_path = "/data/local/tmp/npu_test/";
-        config.cache_path = "";
+        config.cache_path     = "";
+        config.enable_metrics = FLAGS_sm;
         return config;
     }
 
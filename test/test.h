@@ -32,7 +32,7 @@ namespace test {
 
     void ShowUsage();
 
-    void SetCpuAffinity();
+    std::vector<int> GetCpuList();
 
     InputShapesMap GetInputShapesMap();
 
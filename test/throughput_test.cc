@@ -0,0 +1,454 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/throughput_test.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <unistd.h>
+#endif
+
+#include "test/flags.h"
+#include "test/test.h"
+#include "tnn/core/instance.h"
+#include "tnn/utils/startup_profile.h"
+
+namespace TNN_NS {
+
+namespace test {
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
+
+    static float ElapsedMs(steady_clock::time_point start, steady_clock::time_point stop) {
+        return duration_cast<microseconds>(stop - start).count() / 1000.0f;
+    }
+
+    // resident memory of the process in bytes, 0 if unknown
+    static double GetProcessRss() {
+#if defined(__linux__) || defined(__ANDROID__)
+        std::ifstream statm("/proc/self/statm");
+        long size = 0, resident = 0;
+        if (statm >> size >> resident) {
+            return static_cast<double>(resident) * sysconf(_SC_PAGESIZE);
+        }
+#endif
+        return 0;
+    }
+
+    static float Percentile(std::vector<float>& sorted, float percent) {
+        if (sorted.empty()) {
+            return 0.f;
+        }
+        int index = static_cast<int>(percent / 100.f * (sorted.size() - 1) + 0.5f);
+        return sorted[std::min(std::max(index, 0), (int)sorted.size() - 1)];
+    }
+
+    static std::vector<int> ParseIntList(const std::string& str) {
+        std::vector<int> values;
+        std::stringstream ss(str);
+        std::string element;
+        while (std::getline(ss, element, ',')) {
+            if (!element.empty()) {
+                values.push_back(atoi(element.c_str()));
+            }
+        }
+        return values;
+    }
+
+    // instance with the mats and converters of its inputs and outputs
+    struct ThroughputInstance {
+        Status status;
+        float init_ms      = 0.f;
+        int forward_memory = 0;
+        std::shared_ptr<Instance> instance;
+        void* command_queue = nullptr;
+        MatMap input_mat_map;
+        MatMap output_mat_map;
+        std::map<std::string, std::shared_ptr<BlobConverter>> input_converters_map;
+        std::map<std::string, std::shared_ptr<BlobConverter>> output_converters_map;
+        std::map<std::string, MatConvertParam> input_params_map;
+        std::map<std::string, MatConvertParam> output_params_map;
+
+        Status Forward() {
+            for (auto element : input_converters_map) {
+                auto name = element.first;
+                element.second->ConvertFromMatAsync(*input_mat_map[name], input_params_map[name], command_queue);
+            }
+            Status ret = instance->ForwardAsync(nullptr);
+            for (auto element : output_converters_map) {
+                auto name = element.first;
+                element.second->ConvertToMat(*output_mat_map[name], output_params_map[name], command_queue);
+            }
+            return ret;
+        }
+    };
+
+    // state of a thread sending requests
+    struct ThroughputClient {
+        Status status;
+        std::vector<float> latencies;
+    };
+
+    // make all clients start forwarding at the same time
+    class StartBarrier {
+    public:
+        explicit StartBarrier(int count) : count_(count) {}
+
+        // called by clients, blocks until WaitAndRelease
+        void Arrive() {
+            std::unique_lock<std::mutex> lck(mtx_);
+            arrived_++;
+            cv_.notify_all();
+            cv_.wait(lck, [this] { return released_; });
+        }
+
+        // called by the main thread after all clients arrived
+        void WaitAndRelease() {
+            std::unique_lock<std::mutex> lck(mtx_);
+            cv_.wait(lck, [this] { return arrived_ >= count_; });
+            released_ = true;
+            cv_.notify_all();
+        }
+
+    private:
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        int count_     = 0;
+        int arrived_   = 0;
+        bool released_ = false;
+    };
+
+    // idle instances shared by the clients
+    class InstancePool {
+    public:
+        explicit InstancePool(int size) {
+            for (int i = size - 1; i >= 0; --i) {
+                idle_.push_back(i);
+            }
+        }
+
+        // blocks until an instance is idle
+        int Acquire() {
+            std::unique_lock<std::mutex> lck(mtx_);
+            cv_.wait(lck, [this] { return !idle_.empty(); });
+            int index = idle_.back();
+            idle_.pop_back();
+            return index;
+        }
+
+        void Release(int index) {
+            {
+                std::unique_lock<std::mutex> lck(mtx_);
+                idle_.push_back(index);
+            }
+            cv_.notify_one();
+        }
+
+    private:
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::vector<int> idle_;
+    };
+
+    static void CreateInstance(TNN& net, NetworkConfig network_config, InputShapesMap input_shape, int num_threads,
+                               ThroughputInstance& instance) {
+        auto init_start   = steady_clock::now();
+        instance.instance = net.CreateInst(network_config, instance.status, input_shape);
+        instance.init_ms  = ElapsedMs(init_start, steady_clock::now());
+        if (instance.status != TNN_OK || !instance.instance) {
+            return;
+        }
+        instance.instance->SetCpuNumThreads(num_threads);
+        instance.instance->GetForwardMemorySize(instance.forward_memory);
+
+        BlobMap input_blob_map;
+        BlobMap output_blob_map;
+        instance.instance->GetAllInputBlobs(input_blob_map);
+        instance.instance->GetAllOutputBlobs(output_blob_map);
+        instance.instance->GetCommandQueue(&instance.command_queue);
+
+        instance.input_mat_map = CreateBlobMatMap(input_blob_map, FLAGS_it);
+        InitInputMatMap(instance.input_mat_map);
+        instance.input_converters_map = CreateBlobConverterMap(input_blob_map);
+        instance.input_params_map     = CreateConvertParamMap(instance.input_mat_map);
+
+        instance.output_mat_map        = CreateBlobMatMap(output_blob_map, 0);
+        instance.output_converters_map = CreateBlobConverterMap(output_blob_map);
+        instance.output_params_map     = CreateConvertParamMap(instance.output_mat_map);
+
+        for (int i = 0; i < FLAGS_wc && instance.status == TNN_OK; ++i) {
+            instance.status = instance.Forward();
+        }
+    }
+
+    // send ic requests to the own instance, or to an idle instance of the pool
+    static void RunClient(std::vector<ThroughputInstance>& instances, InstancePool* pool, int own_instance,
+                          StartBarrier& barrier, ThroughputClient& client) {
+        barrier.Arrive();
+
+        for (int i = 0; i < FLAGS_ic && client.status == TNN_OK; ++i) {
+            auto start  = steady_clock::now();
+            int index   = pool ? pool->Acquire() : own_instance;
+            client.status = instances[index].Forward();
+            if (pool) {
+                pool->Release(index);
+            }
+            client.latencies.push_back(ElapsedMs(start, steady_clock::now()));
+        }
+    }
+
+    static double GetStageTime(const std::vector<StartupStageData>& stages, const std::string& name) {
+        for (auto& stage : stages) {
+            if (stage.name == name) {
+                return stage.time;
+            }
+        }
+        return 0;
+    }
+
+    /*
+     * The instances are created concurrently, one thread each, then the clients
+     * send requests at the same time. With pinned cpus, the threads of instance i
+     * are bound to their own cpus instead of sharing all cpus with the other
+     * instances.
+     */
+    static Status RunThroughputCase(TNN& net, NetworkConfig& network_config, InputShapesMap& input_shape, bool pinned,
+                                    ThroughputResult& result) {
+        const int instance_count = result.instance_count;
+        const int client_count   = result.client_count;
+        const int cores          = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+        std::vector<ThroughputInstance> instances(instance_count);
+        std::vector<std::thread> threads;
+
+        // optimize_mtx_ is measured by the startup stages of the creation
+        const bool profile_enabled = StartupProfile::IsEnabled();
+        StartupProfile::SetEnabled(true);
+        StartupProfile::Reset();
+        double rss_before = GetProcessRss();
+        for (int i = 0; i < instance_count; ++i) {
+            NetworkConfig config = network_config;
+            if (pinned) {
+                config.cpu_list.clear();
+                for (int t = 0; t < result.num_threads; ++t) {
+                    config.cpu_list.push_back((i * result.num_threads + t) % cores);
+                }
+            }
+            threads.push_back(std::thread(CreateInstance, std::ref(net), config, input_shape, result.num_threads,
+                                          std::ref(instances[i])));
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        auto stages = StartupProfile::GetStages();
+        StartupProfile::SetEnabled(profile_enabled);
+
+        Status ret = TNN_OK;
+        double forward_memory = 0;
+        for (auto& instance : instances) {
+            if (instance.status != TNN_OK && ret == TNN_OK) {
+                ret = instance.status;
+            }
+            result.init_ms = std::max(result.init_ms, instance.init_ms);
+            result.init_total_ms += instance.init_ms;
+            forward_memory += instance.forward_memory;
+        }
+        result.mutex_hold_ms =
+            static_cast<float>(GetStageTime(stages, "net optimize") + GetStageTime(stages, "benchmark resource generate"));
+        result.mutex_wait_ms = static_cast<float>(GetStageTime(stages, "optimize mutex wait"));
+
+        std::vector<ThroughputClient> clients(client_count);
+        float wall_ms = 0.f;
+        if (ret == TNN_OK) {
+            // clients drive their own instance if there are as many of them
+            std::shared_ptr<InstancePool> pool;
+            if (client_count != instance_count) {
+                pool = std::make_shared<InstancePool>(instance_count);
+            }
+            StartBarrier barrier(client_count);
+            threads.clear();
+            for (int i = 0; i < client_count; ++i) {
+                threads.push_back(
+                    std::thread(RunClient, std::ref(instances), pool.get(), i, std::ref(barrier), std::ref(clients[i])));
+            }
+            barrier.WaitAndRelease();
+            auto start = steady_clock::now();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            wall_ms = ElapsedMs(start, steady_clock::now());
+        }
+        double rss_after = GetProcessRss();
+
+        for (auto& instance : instances) {
+            FreeMatMapMemory(instance.input_mat_map);
+            FreeMatMapMemory(instance.output_mat_map);
+        }
+        if (ret != TNN_OK) {
+            return ret;
+        }
+
+        std::vector<float> latencies;
+        for (auto& client : clients) {
+            if (client.status != TNN_OK) {
+                return client.status;
+            }
+            latencies.insert(latencies.end(), client.latencies.begin(), client.latencies.end());
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        float latency_sum = 0.f;
+        for (auto latency : latencies) {
+            latency_sum += latency;
+        }
+        if (!latencies.empty()) {
+            result.latency_avg = latency_sum / latencies.size();
+        }
+        result.latency_p50    = Percentile(latencies, 50);
+        result.latency_p90    = Percentile(latencies, 90);
+        result.latency_p99    = Percentile(latencies, 99);
+        result.throughput     = wall_ms > 0 ? latencies.size() * result.batch * 1000.f / wall_ms : 0.f;
+        result.forward_memory = static_cast<float>(forward_memory / 1024 / 1024);
+        result.rss_growth     = static_cast<float>((rss_after - rss_before) / 1024 / 1024);
+        return TNN_OK;
+    }
+
+    static void PrintResults(std::vector<ThroughputResult>& results) {
+        const int cores = static_cast<int>(std::thread::hardware_concurrency());
+        printf("%-9s %-7s %-7s %-5s %-9s %-10s %-9s %-9s %-8s %-11s %-8s %-8s %-8s %-8s %-9s %-9s %-8s %-8s\n",
+               "instances", "clients", "threads", "batch", "init(ms)", "create(ms)", "lock(ms)", "wait(ms)", "lock(%)",
+               "infer/s", "avg(ms)", "p50(ms)", "p90(ms)", "p99(ms)", "fwd(MB)", "rss(MB)", "scaling", "pinned");
+        for (auto& result : results) {
+            // more threads than cores, instances contend for cpus
+            bool oversubscribed = cores > 0 && result.instance_count * result.num_threads > cores;
+            float lock_percent  = result.init_total_ms > 0 ? result.mutex_hold_ms * 100.f / result.init_total_ms : 0.f;
+            printf("%-9d %-7d %-7d %-5d %-9.3f %-10.3f %-9.3f %-9.3f %-8.2f %-11.3f %-8.3f %-8.3f %-8.3f %-8.3f %-9.3f "
+                   "%-9.3f %-8.3f %-8.3f%s\n",
+                   result.instance_count, result.client_count, result.num_threads, result.batch, result.init_ms,
+                   result.init_total_ms, result.mutex_hold_ms, result.mutex_wait_ms, lock_percent, result.throughput,
+                   result.latency_avg, result.latency_p50, result.latency_p90, result.latency_p99,
+                   result.forward_memory, result.rss_growth, result.scaling_efficiency,
+                   result.pinned_scaling_efficiency, oversubscribed ? "  oversubscribed" : "");
+        }
+        printf("init: longest concurrent instance creation, create: creation time summed over the instances.\n");
+        printf("lock: time holding optimize_mtx_ (net optimize, benchmark resource generate), serialized among the\n");
+        printf("      instances, lock(%%) of create. wait: time the instances waited for optimize_mtx_.\n");
+        printf("clients: threads sending ic requests each, if not equal to instances they share the instances as a\n");
+        printf("         pool and the latency includes waiting for an idle instance.\n");
+        printf("scaling: throughput / (instances x 1 instance throughput), the threads of all instances share the\n");
+        printf("         %d cores. pinned: the same with the threads of each instance pinned to their own cores,\n",
+               cores);
+        printf("         pinned well above scaling shows contention of the openmp thread teams.\n");
+    }
+
+    int RunThroughputTest(TNN& net, NetworkConfig& network_config, InputShapesMap& input_shape) {
+        auto instance_counts = ParseIntList(FLAGS_ni);
+        auto thread_counts   = FLAGS_tl.empty() ? std::vector<int>({std::max(FLAGS_th, 1)}) : ParseIntList(FLAGS_tl);
+        auto batches         = ParseIntList(FLAGS_nb);
+        auto client_counts   = ParseIntList(FLAGS_nc);
+
+        // the single instance case is the baseline of the scaling, it always runs first
+        for (auto& instance_count : instance_counts) {
+            instance_count = std::max(instance_count, 1);
+        }
+        instance_counts.erase(std::remove(instance_counts.begin(), instance_counts.end(), 1), instance_counts.end());
+        instance_counts.insert(instance_counts.begin(), 1);
+
+        // input shapes of the model if not specified
+        InputShapesMap model_input_shape = input_shape;
+        if (model_input_shape.empty()) {
+            Status ret    = TNN_OK;
+            auto instance = net.CreateInst(network_config, ret);
+            if (!CheckResult("create instance", ret)) {
+                return 0;
+            }
+            BlobMap input_blob_map;
+            instance->GetAllInputBlobs(input_blob_map);
+            for (auto element : input_blob_map) {
+                model_input_shape[element.first] = element.second->GetBlobDesc().dims;
+            }
+        }
+
+        std::vector<ThroughputResult> results;
+        for (auto batch : batches) {
+            InputShapesMap batch_input_shape = model_input_shape;
+            for (auto& element : batch_input_shape) {
+                if (!element.second.empty()) {
+                    element.second[0] = batch;
+                }
+            }
+
+            for (auto num_threads : thread_counts) {
+                float single_throughput        = 0.f;
+                float single_pinned_throughput = 0.f;
+                for (auto instance_count : instance_counts) {
+                    // one client per instance, or clients sharing a pool of the instances
+                    std::vector<int> case_client_counts = {instance_count};
+                    if (!client_counts.empty() && instance_count > 1) {
+                        case_client_counts = client_counts;
+                    }
+                    for (auto client_count : case_client_counts) {
+                        ThroughputResult result;
+                        result.instance_count = instance_count;
+                        result.client_count   = std::max(client_count, 1);
+                        result.num_threads    = std::max(num_threads, 1);
+                        result.batch          = batch;
+
+                        Status ret = RunThroughputCase(net, network_config, batch_input_shape, false, result);
+                        if (!CheckResult("throughput test", ret)) {
+                            return 0;
+                        }
+                        ThroughputResult pinned_result = result;
+                        ret = RunThroughputCase(net, network_config, batch_input_shape, true, pinned_result);
+                        if (!CheckResult("pinned throughput test", ret)) {
+                            return 0;
+                        }
+                        result.pinned_throughput = pinned_result.throughput;
+
+                        if (instance_count == 1) {
+                            single_throughput        = result.throughput;
+                            single_pinned_throughput = result.pinned_throughput;
+                        }
+                        if (single_throughput > 0) {
+                            result.scaling_efficiency = result.throughput / (instance_count * single_throughput);
+                        }
+                        if (single_pinned_throughput > 0) {
+                            result.pinned_scaling_efficiency =
+                                result.pinned_throughput / (instance_count * single_pinned_throughput);
+                        }
+                        results.push_back(result);
+                    }
+                }
+            }
+        }
+
+        PrintResults(results);
+        return 0;
+    }
+
+}  // namespace test
+
+}  // namespace TNN_NS
@@ -0,0 +1,66 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TEST_THROUGHPUT_TEST_H_
+#define TNN_TEST_THROUGHPUT_TEST_H_
+
+#include "tnn/core/common.h"
+#include "tnn/core/tnn.h"
+
+namespace TNN_NS {
+
+namespace test {
+
+    // @brief result of one instance count x threads x batch case
+    struct ThroughputResult {
+        int instance_count = 1;
+        // threads sending requests, they share the instances as a pool if not instance_count
+        int client_count = 1;
+        int num_threads  = 1;
+        int batch        = 1;
+        // longest instance creation, instances are created concurrently
+        float init_ms = 0.f;
+        // instance creation summed over the instances
+        float init_total_ms = 0.f;
+        // time the instances held and waited for the optimize mutex of DefaultNetwork
+        float mutex_hold_ms = 0.f;
+        float mutex_wait_ms = 0.f;
+        // inferences (samples) per second of all instances
+        float throughput = 0.f;
+        // latency of forward requests in ms
+        float latency_avg = 0.f;
+        float latency_p50 = 0.f;
+        float latency_p90 = 0.f;
+        float latency_p99 = 0.f;
+        // forward memory of all instances and growth of process rss in MB
+        float forward_memory = 0.f;
+        float rss_growth     = 0.f;
+        // throughput relative to instance_count times the single instance one
+        float scaling_efficiency = 0.f;
+        // the same with the threads of each instance pinned to their own cpus
+        float pinned_throughput         = 0.f;
+        float pinned_scaling_efficiency = 0.f;
+    };
+
+    // @brief sweep instance count x threads per instance x batch, each instance is
+    // driven by its own thread or clients share the instances as a pool. instances
+    // share the interpreter of net, the single instance case always runs as the
+    // baseline of the scaling.
+    int RunThroughputTest(TNN& net, NetworkConfig& network_config, InputShapesMap& input_shape);
+
+}  // namespace test
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_THROUGHPUT_TEST_H_
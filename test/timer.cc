@@ -15,6 +15,8 @@
 #include "test/timer.h"
 
 #include <cmath>
+#include <fstream>
+#include <sstream>
 
 namespace TNN_NS {
 
@@ -39,6 +41,7 @@ void Timer::Stop() {
     max_         = static_cast<float>(fmax(max_, delta));
     sum_ += delta;
     count_++;
+    times_.push_back(delta);
 }
 
 void Timer::Reset() {
@@ -46,6 +49,7 @@ void Timer::Reset() {
     max_ = FLT_MIN;
     sum_ = 0.0f;
     count_ = 0;
+    times_.clear();
     stop_ = start_ = system_clock::now();
 }
    
@@ -60,6 +64,36 @@ void Timer::Print() {
            min_str, max_str, avg_str);
 }
 
+const std::vector<float>& Timer::GetTimes() {
+    return times_;
+}
+
+bool Timer::WriteJson(std::string path, std::string device, std::string precision, int num_threads) {
+    std::stringstream ss;
+    ss << "{\n  \"results\": [\n    {\n";
+    ss << "      \"name\": \"" << timer_info_ << "\",\n";
+    ss << "      \"device\": \"" << device << "\",\n";
+    ss << "      \"data_type\": \"" << precision << "\",\n";
+    ss << "      \"threads\": " << num_threads << ",\n";
+    ss << "      \"iterations\": " << count_ << ",\n";
+    ss << "      \"time_min_ms\": " << (count_ > 0 ? min_ : 0) << ",\n";
+    ss << "      \"time_max_ms\": " << (count_ > 0 ? max_ : 0) << ",\n";
+    ss << "      \"time_avg_ms\": " << (count_ > 0 ? sum_ / count_ : 0) << ",\n";
+    ss << "      \"times_ms\": [";
+    for (int i = 0; i < times_.size(); ++i) {
+        ss << (i > 0 ? ", " : "") << times_[i];
+    }
+    ss << "]\n    }\n  ]\n}\n";
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        printf("open benchmark output file %s failed\n", path.c_str());
+        return false;
+    }
+    file << ss.str();
+    return true;
+}
+
 } // namespace test
 
 } // namespace TNN_NS
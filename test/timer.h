@@ -17,6 +17,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include "tnn/core/macro.h"
 
@@ -35,6 +36,12 @@ public:
     void Reset();
     void Print();
 
+    // @brief time of each Start/Stop in ms, in the order they are measured
+    const std::vector<float>& GetTimes();
+
+    // @brief write the result and all times as benchmark json, keys follow the layer benchmark results
+    bool WriteJson(std::string path, std::string device, std::string precision, int num_threads);
+
 private:
     float min_;
     float max_;
@@ -43,6 +50,7 @@ private:
     time_point<system_clock> start_;
     time_point<system_clock> stop_;
     int count_;
+    std::vector<float> times_;
 };
 
 } // namespace test
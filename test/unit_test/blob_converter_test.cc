@@ -251,4 +251,62 @@ TEST_P(BlobConverterTest, BlobConverterTest) {
     free(mat_out_dev_data);
 }
 
+class PackedBlobConverterTest : public ::testing::TestWithParam<std::tuple<int, int, DataFormat>> {};
+
+INSTANTIATE_TEST_SUITE_P(BlobConverterTest, PackedBlobConverterTest,
+                         ::testing::Combine(
+                            // channel
+                            testing::Values(3, 8, 17),
+                            // inputsize
+                            testing::Values(1, 5),
+                            // data format
+                            testing::Values(DATA_FORMAT_NC4HW4, DATA_FORMAT_NC8HW8, DATA_FORMAT_NC16HW16)));
+
+// the cpu blob converter packs and unpacks the float blobs of the channel packed formats
+TEST_P(PackedBlobConverterTest, PackedBlobConverterTest) {
+    int batch              = 2;
+    int channel            = std::get<0>(GetParam());
+    int input_size         = std::get<1>(GetParam());
+    DataFormat data_format = std::get<2>(GetParam());
+    int pack               = data_format == DATA_FORMAT_NC4HW4 ? 4 : (data_format == DATA_FORMAT_NC8HW8 ? 8 : 16);
+
+    DimsVector dims = {batch, channel, input_size, input_size};
+    int count       = DimsVectorUtils::Count(dims);
+    int hw          = input_size * input_size;
+    std::vector<float> mat_in_data(count), mat_out_data(count);
+    InitRandom(mat_in_data.data(), count, 0.0f, 1.0f);
+
+    AbstractDevice* cpu = GetDevice(DEVICE_NAIVE);
+    BlobDesc desc;
+    desc.dims        = dims;
+    desc.device_type = DEVICE_NAIVE;
+    desc.data_type   = DATA_TYPE_FLOAT;
+    desc.data_format = data_format;
+    Blob blob(desc);
+    ASSERT_EQ(TNN_OK, (int)BlobHandleAllocate(&blob, cpu));
+
+    BlobConverter converter(&blob);
+    Mat mat_in(DEVICE_NAIVE, NCHW_FLOAT, dims, mat_in_data.data());
+    ASSERT_EQ(TNN_OK, (int)converter.ConvertFromMat(mat_in, MatConvertParam(), NULL));
+
+    // [n][c/x][h][w][x]
+    int cmp_result  = 0;
+    float* blob_ptr = static_cast<float*>(blob.GetHandle().base);
+    for (int n = 0; n < batch; ++n) {
+        for (int c = 0; c < channel; ++c) {
+            for (int i = 0; i < hw; ++i) {
+                int packed_index = ((n * UP_DIV(channel, pack) + c / pack) * hw + i) * pack + c % pack;
+                cmp_result |= blob_ptr[packed_index] != mat_in_data[(n * channel + c) * hw + i];
+            }
+        }
+    }
+
+    Mat mat_out(DEVICE_NAIVE, NCHW_FLOAT, dims, mat_out_data.data());
+    ASSERT_EQ(TNN_OK, (int)converter.ConvertToMat(mat_out, MatConvertParam(), NULL));
+    cmp_result |= CompareData(mat_in_data.data(), mat_out_data.data(), count, 0.0f);
+    EXPECT_EQ(0, cmp_result);
+
+    BlobHandleFree(&blob, cpu);
+}
+
 }  // namespace TNN_NS
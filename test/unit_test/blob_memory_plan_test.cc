@@ -0,0 +1,261 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/memory_manager/blob_memory_plan.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static const int kInputSize = 16;
+
+// conv chain of 3x3 convs with relus, the relus are fused into the convs by the runtime optimizer
+static const char* kChainProto =
+    "\"1 0 1 4206624770 ,\"\n"
+    "\"input 1 3 16 16 ,\"\n"
+    "\" input conv0 relu0 conv1 output ,\"\n"
+    "\"output ,\"\n"
+    "\" 4 ,\"\n"
+    "\"Convolution conv0 1 1 input conv0 1 3 8 3 3 1 1 1 1 1 -1 1 1 ,\"\n"
+    "\"ReLU relu0 1 1 conv0 relu0 ,\"\n"
+    "\"Convolution conv1 1 1 relu0 conv1 1 8 8 3 3 1 1 1 1 1 -1 1 1 ,\"\n"
+    "\"ReLU relu1 1 1 conv1 output ,\"\n";
+
+// a residual keeps conv0 alive across the other layers
+static const char* kResidualProto =
+    "\"1 0 1 4206624770 ,\"\n"
+    "\"input 1 3 16 16 ,\"\n"
+    "\" input conv0 conv1 conv2 conv3 output ,\"\n"
+    "\"output ,\"\n"
+    "\" 5 ,\"\n"
+    "\"Convolution conv0 1 1 input conv0 1 3 8 3 3 1 1 1 1 1 -1 1 1 ,\"\n"
+    "\"Convolution conv1 1 1 conv0 conv1 1 8 8 3 3 1 1 1 1 1 -1 1 1 ,\"\n"
+    "\"Convolution conv2 1 1 conv1 conv2 1 8 8 3 3 1 1 1 1 1 -1 1 1 ,\"\n"
+    "\"Convolution conv3 1 1 conv2 conv3 1 8 8 1 1 1 1 0 0 1 -1 1 1 ,\"\n"
+    "\"Add add 2 1 conv3 conv0 output ,\"\n";
+
+class BlobMemoryPlanTest : public ::testing::Test {
+protected:
+    // interpret the proto, fill the static blob shapes and generate the conv weights
+    void Interpret(const std::string& proto) {
+        interpreter_ = std::make_shared<ModelInterpreter>();
+        interpreter_->SetBenchmarkMode(true);
+        ASSERT_EQ((int)interpreter_->Interpret({proto, ""}), TNN_OK);
+
+        auto structure = interpreter_->GetNetStructure();
+        auto resource  = interpreter_->GetNetResource();
+        structure->blobs_shape_map["input"] = {1, 3, kInputSize, kInputSize};
+        for (auto& layer_info : structure->layers) {
+            auto input_shape = structure->blobs_shape_map[layer_info->inputs[0]];
+            auto conv_param  = dynamic_cast<ConvLayerParam*>(layer_info->param.get());
+            if (conv_param == nullptr) {
+                structure->blobs_shape_map[layer_info->outputs[0]] = input_shape;
+                continue;
+            }
+            structure->blobs_shape_map[layer_info->outputs[0]] = {1, conv_param->output_channel, kInputSize,
+                                                                  kInputSize};
+
+            const int filter_count = conv_param->output_channel * conv_param->input_channel *
+                                     conv_param->kernels[0] * conv_param->kernels[1];
+            auto conv_resource           = std::make_shared<ConvLayerResource>();
+            conv_resource->filter_handle = RawBuffer(filter_count * sizeof(float));
+            conv_resource->bias_handle   = RawBuffer(conv_param->output_channel * sizeof(float));
+            InitRandom(conv_resource->filter_handle.force_to<float*>(), filter_count, -1.0f, 1.0f);
+            InitRandom(conv_resource->bias_handle.force_to<float*>(), conv_param->output_channel, -1.0f, 1.0f);
+            resource->resource_map[layer_info->name] = conv_resource;
+        }
+    }
+
+    // pack the interpreted model and read the packed proto and model back
+    std::vector<std::string> Pack(bool embed_memory_plan) {
+        const std::string proto_path = "blob_memory_plan_test.tnnproto";
+        const std::string model_path = "blob_memory_plan_test.tnnmodel";
+        ModelPacker packer(interpreter_->GetNetStructure(), interpreter_->GetNetResource());
+        packer.SetEmbedMemoryPlan(embed_memory_plan);
+        EXPECT_EQ((int)packer.Pack(proto_path, model_path), TNN_OK);
+
+        std::vector<std::string> params = {ReadFile(proto_path), ReadFile(model_path)};
+        std::remove(proto_path.c_str());
+        std::remove(model_path.c_str());
+        return params;
+    }
+
+    static std::string ReadFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    // forward the model with a random input of the given size
+    static std::vector<float> Forward(TNN& tnn, int input_size) {
+        NetworkConfig config;
+        config.device_type = ConvertDeviceType(FLAGS_dt);
+        Status status;
+        InputShapesMap input_shapes;
+        input_shapes["input"] = {1, 3, input_size, input_size};
+        auto instance         = tnn.CreateInst(config, status, input_shapes);
+        EXPECT_EQ((int)status, TNN_OK);
+        if (status != TNN_OK) {
+            return {};
+        }
+
+        std::vector<float> input_data(3 * input_size * input_size);
+        srand(input_size);
+        InitRandom(input_data.data(), input_data.size(), -1.0f, 1.0f);
+        auto input = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, input_shapes["input"], input_data.data());
+        EXPECT_EQ((int)instance->SetInputMat(input, MatConvertParam()), TNN_OK);
+        EXPECT_EQ((int)instance->Forward(), TNN_OK);
+        std::shared_ptr<Mat> output;
+        EXPECT_EQ((int)instance->GetOutputMat(output, MatConvertParam(), "", DEVICE_NAIVE), TNN_OK);
+        auto data = static_cast<float*>(output->GetData());
+        return std::vector<float>(data, data + DimsVectorUtils::Count(output->GetDims()));
+    }
+
+    // the model packed with the memory plan computes the same outputs as the one without
+    void CompareWithoutPlan(const std::vector<int>& input_sizes) {
+        TNN planned, unplanned;
+        ModelConfig model_config;
+        model_config.model_type = MODEL_TYPE_TNN;
+        model_config.params     = Pack(true);
+        ASSERT_EQ((int)planned.Init(model_config), TNN_OK);
+        model_config.params = Pack(false);
+        ASSERT_EQ((int)unplanned.Init(model_config), TNN_OK);
+
+        for (auto input_size : input_sizes) {
+            auto expected = Forward(unplanned, input_size);
+            auto actual   = Forward(planned, input_size);
+            ASSERT_FALSE(expected.empty());
+            ASSERT_EQ(actual.size(), expected.size());
+            for (int i = 0; i < expected.size(); ++i) {
+                ASSERT_EQ(actual[i], expected[i]) << "input size " << input_size << " output index " << i;
+            }
+        }
+    }
+
+    std::shared_ptr<ModelInterpreter> interpreter_;
+};
+
+TEST_F(BlobMemoryPlanTest, GenerateReusesReleasedSlots) {
+    Interpret(kResidualProto);
+    auto structure = interpreter_->GetNetStructure();
+    std::map<std::string, int> blob_slots;
+    ASSERT_EQ((int)GenerateBlobMemoryPlan(structure, blob_slots), TNN_OK);
+
+    EXPECT_EQ(blob_slots.count("input"), 0);
+    EXPECT_EQ(blob_slots.size(), 5);
+    // conv0 is alive until the add, conv1 is released by conv2 and reused by conv3
+    EXPECT_NE(blob_slots["conv1"], blob_slots["conv0"]);
+    EXPECT_NE(blob_slots["conv2"], blob_slots["conv0"]);
+    EXPECT_NE(blob_slots["conv2"], blob_slots["conv1"]);
+    EXPECT_EQ(blob_slots["conv3"], blob_slots["conv1"]);
+    EXPECT_TRUE(CheckBlobMemoryPlan(structure, blob_slots));
+}
+
+TEST_F(BlobMemoryPlanTest, GenerateNeedsAllShapes) {
+    Interpret(kResidualProto);
+    auto structure = interpreter_->GetNetStructure();
+    structure->blobs_shape_map.erase("conv2");
+    std::map<std::string, int> blob_slots;
+    EXPECT_NE((int)GenerateBlobMemoryPlan(structure, blob_slots), TNN_OK);
+}
+
+TEST_F(BlobMemoryPlanTest, CheckRejectsOverlappingLifetimes) {
+    Interpret(kResidualProto);
+    auto structure = interpreter_->GetNetStructure();
+    std::map<std::string, int> blob_slots;
+    ASSERT_EQ((int)GenerateBlobMemoryPlan(structure, blob_slots), TNN_OK);
+
+    // conv0 is still used by the add when conv2 is produced
+    auto overlapping     = blob_slots;
+    overlapping["conv2"] = overlapping["conv0"];
+    EXPECT_FALSE(CheckBlobMemoryPlan(structure, overlapping));
+
+    // an output can not share the memory of the input of its layer
+    overlapping           = blob_slots;
+    overlapping["output"] = overlapping["conv3"];
+    EXPECT_FALSE(CheckBlobMemoryPlan(structure, overlapping));
+
+    auto missing = blob_slots;
+    missing.erase("conv1");
+    EXPECT_FALSE(CheckBlobMemoryPlan(structure, missing));
+}
+
+TEST_F(BlobMemoryPlanTest, CheckRejectsPlanOfOptimizedNet) {
+    Interpret(kChainProto);
+    auto structure = interpreter_->GetNetStructure();
+    std::map<std::string, int> blob_slots;
+    ASSERT_EQ((int)GenerateBlobMemoryPlan(structure, blob_slots), TNN_OK);
+    ASSERT_TRUE(CheckBlobMemoryPlan(structure, blob_slots));
+
+    // fusing the relus makes conv1 read relu0 and write the output, which the plan put in the same slot
+    ASSERT_EQ((int)optimizer::NetOptimizerManager::Optimize(structure, interpreter_->GetNetResource(), DEVICE_ARM),
+              TNN_OK);
+    ASSERT_EQ(structure->layers.size(), 2);
+    ASSERT_EQ(blob_slots["relu0"], blob_slots["output"]);
+    EXPECT_FALSE(CheckBlobMemoryPlan(structure, blob_slots));
+}
+
+TEST_F(BlobMemoryPlanTest, ProtoRoundTrip) {
+    Interpret(kResidualProto);
+    auto structure = interpreter_->GetNetStructure();
+    std::map<std::string, int> blob_slots;
+    ASSERT_EQ((int)GenerateBlobMemoryPlan(structure, blob_slots), TNN_OK);
+
+    auto params = Pack(true);
+    ModelInterpreter interpreter;
+    ASSERT_EQ((int)interpreter.Interpret(params), TNN_OK);
+    auto packed_structure = interpreter.GetNetStructure();
+    EXPECT_EQ(packed_structure->blobs_shape_map, structure->blobs_shape_map);
+    EXPECT_EQ(packed_structure->blobs_memory_slot_map, blob_slots);
+    EXPECT_EQ(packed_structure->blobs, structure->blobs);
+
+    // a model packed without the plan lists the blob names only
+    ModelInterpreter plain_interpreter;
+    ASSERT_EQ((int)plain_interpreter.Interpret(Pack(false)), TNN_OK);
+    EXPECT_TRUE(plain_interpreter.GetNetStructure()->blobs_shape_map.empty());
+    EXPECT_TRUE(plain_interpreter.GetNetStructure()->blobs_memory_slot_map.empty());
+    EXPECT_EQ(plain_interpreter.GetNetStructure()->blobs, structure->blobs);
+}
+
+TEST_F(BlobMemoryPlanTest, PackedModelMatchesUnplanned) {
+    // the planned shape uses the arena, the other input size falls back to the memory pool
+    Interpret(kResidualProto);
+    CompareWithoutPlan({kInputSize, 24});
+}
+
+TEST_F(BlobMemoryPlanTest, OptimizedModelFallsBack) {
+    // the runtime optimizer fuses the relus, the instance must not use the stale plan
+    Interpret(kChainProto);
+    CompareWithoutPlan({kInputSize});
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,120 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/device/cpu/acc/compute/compute_pool.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/naive_compute.h"
+
+namespace TNN_NS {
+
+// the layer tests compare a device with the cpu device, the cpu pooling is checked against NaivePooling here
+class CpuPoolingTest : public ::testing::TestWithParam<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(CpuPoolingTest, CpuPoolingTest,
+                         ::testing::Combine(
+                             // channels, input size
+                             testing::Values(3, 8, 13), testing::Values(7, 10),
+                             // kernel, stride, pad
+                             testing::Values(2, 3), testing::Values(1, 2), testing::Values(0, 1)));
+
+TEST_P(CpuPoolingTest, MatchesNaivePooling) {
+    const int channels   = std::get<0>(GetParam());
+    const int input_size = std::get<1>(GetParam());
+    const int kernel     = std::get<2>(GetParam());
+    const int stride     = std::get<3>(GetParam());
+    const int pad        = std::get<4>(GetParam());
+    if (pad >= kernel) {
+        GTEST_SKIP();
+    }
+
+    // the ceil mode may add a last window entirely in the pads
+    const int output_size = (int)std::ceil((input_size + 2 * pad - kernel) / (float)stride) + 1;
+    DimsVector dims_input  = {2, channels, input_size, input_size};
+    DimsVector dims_output = {2, channels, output_size, output_size};
+
+    std::vector<float> input(DimsVectorUtils::Count(dims_input));
+    InitRandom(input.data(), input.size(), -2.0f, -1.0f);
+    std::vector<float> buffer(GetCpuPoolingBufferSize(dims_input, dims_output));
+
+    for (int pool_type : {0, 1}) {
+        std::vector<float> expected(DimsVectorUtils::Count(dims_output));
+        NaivePooling<float, float>(input.data(), expected.data(), dims_input, dims_output, stride, stride, kernel,
+                                   kernel, pad, pad, pool_type);
+
+        std::vector<float> output(expected.size());
+        CpuPooling(input.data(), output.data(), dims_input, dims_output, stride, stride, kernel, kernel, pad, pad,
+                   pool_type, buffer.data());
+        for (int i = 0; i < expected.size(); ++i) {
+            // the average of an empty window is 0 here and nan in NaivePooling
+            if (std::isnan(expected[i])) {
+                continue;
+            }
+            ASSERT_NEAR(output[i], expected[i], 1e-5f) << "pool type " << pool_type << " index " << i;
+        }
+
+        // bfp16 blobs are pooled in fp32 without copies of the blobs
+        std::vector<bfp16_t> input_bfp16(input.begin(), input.end());
+        std::vector<bfp16_t> expected_bfp16(expected.size()), output_bfp16(expected.size());
+        NaivePooling<bfp16_t, float>(input_bfp16.data(), expected_bfp16.data(), dims_input, dims_output, stride,
+                                     stride, kernel, kernel, pad, pad, pool_type);
+        CpuPooling(input_bfp16.data(), output_bfp16.data(), dims_input, dims_output, stride, stride, kernel, kernel,
+                   pad, pad, pool_type, buffer.data());
+        for (int i = 0; i < expected.size(); ++i) {
+            if (std::isnan(expected[i])) {
+                continue;
+            }
+            ASSERT_NEAR(float(output_bfp16[i]), float(expected_bfp16[i]), 1e-2f)
+                << "bfp16 pool type " << pool_type << " index " << i;
+        }
+    }
+}
+
+TEST(CpuPoolingGlobalTest, MatchesNaivePooling) {
+    DimsVector dims_input  = {2, 11, 7, 7};
+    DimsVector dims_output = {2, 11, 1, 1};
+    std::vector<float> input(DimsVectorUtils::Count(dims_input));
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+    std::vector<float> buffer(GetCpuPoolingBufferSize(dims_input, dims_output));
+
+    for (int pool_type : {0, 1}) {
+        std::vector<float> expected(DimsVectorUtils::Count(dims_output));
+        NaivePooling<float, float>(input.data(), expected.data(), dims_input, dims_output, 1, 1, 7, 7, 0, 0,
+                                   pool_type);
+        std::vector<float> output(expected.size());
+        CpuPooling(input.data(), output.data(), dims_input, dims_output, 1, 1, 7, 7, 0, 0, pool_type, buffer.data());
+        for (int i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(output[i], expected[i], 1e-5f) << "pool type " << pool_type << " index " << i;
+        }
+
+        std::vector<bfp16_t> input_bfp16(input.begin(), input.end());
+        std::vector<bfp16_t> expected_bfp16(expected.size()), output_bfp16(expected.size());
+        NaivePooling<bfp16_t, float>(input_bfp16.data(), expected_bfp16.data(), dims_input, dims_output, 1, 1, 7, 7,
+                                     0, 0, pool_type);
+        CpuPooling(input_bfp16.data(), output_bfp16.data(), dims_input, dims_output, 1, 1, 7, 7, 0, 0, pool_type,
+                   buffer.data());
+        for (int i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(float(output_bfp16[i]), float(expected_bfp16[i]), 1e-2f)
+                << "bfp16 pool type " << pool_type << " index " << i;
+        }
+    }
+}
+
+}  // namespace TNN_NS
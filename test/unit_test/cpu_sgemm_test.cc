@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/device/cpu/acc/compute/compute_gemm.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/utils/naive_compute.h"
+
+namespace TNN_NS {
+
+// the layer tests compare a device with the cpu device, the cpu sgemm is checked against the naive compute here
+class CpuSgemmTest : public ::testing::TestWithParam<std::tuple<int, int, int>> {
+protected:
+    static std::vector<float> PackB(const std::vector<float>& weight, int k, int n) {
+        std::vector<float> packed_b(GetSgemmPackedBSize(k, n));
+        PackSgemmB(weight.data(), k, true, k, n, packed_b.data());
+        return packed_b;
+    }
+
+    static void ExpectNear(const std::vector<float>& actual, const std::vector<float>& expected, float tolerance) {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (int i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(actual[i], expected[i], tolerance * std::max(1.0f, std::fabs(expected[i]))) << "index " << i;
+        }
+    }
+};
+
+// m covers the gemv rows and the blocks of the micro kernels, n and k the partial panels
+INSTANTIATE_TEST_SUITE_P(CpuSgemmTest, CpuSgemmTest,
+                         ::testing::Combine(testing::Values(1, 3, 4, 5, 17, 64), testing::Values(1, 16, 21, 50),
+                                            testing::Values(1, 9, 64, 300)));
+
+TEST_P(CpuSgemmTest, InnerProduct) {
+    const int batch      = std::get<0>(GetParam());
+    const int num_output = std::get<1>(GetParam());
+    const int ic         = std::get<2>(GetParam());
+
+    std::vector<float> input(batch * ic), weight(num_output * ic), bias(num_output);
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+    InitRandom(weight.data(), weight.size(), -1.0f, 1.0f);
+    InitRandom(bias.data(), bias.size(), -1.0f, 1.0f);
+
+    std::vector<float> expected(batch * num_output);
+    NaiveFC(input.data(), expected.data(), weight.data(), bias.data(), {batch, ic, 1, 1}, {batch, num_output, 1, 1});
+
+    auto packed_b = PackB(weight, ic, num_output);
+    std::vector<float> output(batch * num_output);
+    CpuSgemm(batch, num_output, ic, input.data(), ic, false, packed_b.data(), output.data(), num_output, false,
+             bias.data(), ActivationType_None);
+    ExpectNear(output, expected, 1e-4f);
+
+    // bfp16 input and output, the math stays fp32
+    std::vector<bfp16_t> input_bfp16(input.begin(), input.end());
+    std::vector<float> input_rounded(input_bfp16.begin(), input_bfp16.end());
+    NaiveFC(input_rounded.data(), expected.data(), weight.data(), bias.data(), {batch, ic, 1, 1},
+            {batch, num_output, 1, 1});
+    std::vector<bfp16_t> output_bfp16(batch * num_output);
+    CpuSgemm(batch, num_output, ic, input_bfp16.data(), ic, false, packed_b.data(), output_bfp16.data(), num_output,
+             false, bias.data(), ActivationType_None);
+    ExpectNear(std::vector<float>(output_bfp16.begin(), output_bfp16.end()), expected, 1e-2f);
+}
+
+TEST_P(CpuSgemmTest, PointwiseConv) {
+    // the nchw input is A stored k x m and the nchw output is C stored n x m
+    const int hw = std::get<0>(GetParam());
+    const int oc = std::get<1>(GetParam());
+    const int ic = std::get<2>(GetParam());
+
+    std::vector<float> input(ic * hw), weight(oc * ic), bias(oc);
+    InitRandom(input.data(), input.size(), -1.0f, 1.0f);
+    InitRandom(weight.data(), weight.size(), -1.0f, 1.0f);
+    InitRandom(bias.data(), bias.size(), -1.0f, 1.0f);
+    auto packed_b = PackB(weight, ic, oc);
+
+    for (int activation_type : {ActivationType_None, ActivationType_ReLU, ActivationType_ReLU6}) {
+        std::vector<float> expected(oc * hw);
+        NaiveConv<float, float, float, float>(input.data(), expected.data(), weight.data(), bias.data(),
+                                              {1, ic, 1, hw}, {1, oc, 1, hw}, 1, 1, 1, 1, 0, 0, 1, 1,
+                                              activation_type, nullptr, 0);
+
+        std::vector<float> output(oc * hw);
+        CpuSgemm(hw, oc, ic, input.data(), hw, true, packed_b.data(), output.data(), hw, true, bias.data(),
+                 activation_type);
+        ExpectNear(output, expected, 1e-4f);
+    }
+}
+
+}  // namespace TNN_NS
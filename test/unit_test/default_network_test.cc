@@ -0,0 +1,138 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/default_network.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/utils/blob_converter.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+// layers with weights converted or packed in InitWeights, none of them is fused by the optimizer
+static const char* kWeightsProto =
+    "\"1 0 1 4206624770 ,\"\n"
+    "\"input 1 3 16 16 ,\"\n"
+    "\" input conv0 deconv0 conv1 output ,\"\n"
+    "\"output ,\"\n"
+    "\" 4 ,\"\n"
+    "\"Convolution conv0 1 1 input conv0 1 3 16 3 3 1 1 1 1 1 -1 1 1 ,\"\n"
+    "\"Deconvolution deconv0 1 1 conv0 deconv0 1 16 8 4 4 2 2 1 1 1 -1 1 1 ,\"\n"
+    "\"Convolution conv1 1 1 deconv0 conv1 1 8 16 1 1 1 1 0 0 1 -1 1 1 ,\"\n"
+    "\"InnerProduct fc 1 1 conv1 output 10 1 0 1 ,\"\n";
+
+// default network initializing the layer weights with the given threads,
+// the layers in failed_layers fail with the given status
+class InitWeightsNetwork : public DefaultNetwork {
+public:
+    InitWeightsNetwork(int num_threads, const std::map<int, int>& failed_layers) : failed_layers_(failed_layers) {
+        init_weights_threads_ = num_threads;
+    }
+
+protected:
+    virtual Status InitWeightsOfLayer(int index) override {
+        auto iter = failed_layers_.find(index);
+        if (iter != failed_layers_.end()) {
+            return Status(iter->second, "injected failure");
+        }
+        return DefaultNetwork::InitWeightsOfLayer(index);
+    }
+
+    std::map<int, int> failed_layers_;
+};
+
+// more threads than layers, also on machines of few cores
+static const int kParallelThreads = 4;
+
+class DefaultNetworkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        model_config_.model_type     = MODEL_TYPE_TNN;
+        model_config_.params         = {kWeightsProto, ""};
+        model_config_.benchmark_mode = true;
+        // the networks share the interpreter and so the weights generated by the first one
+        interpreter_ = std::make_shared<ModelInterpreter>();
+        interpreter_->SetBenchmarkMode(true);
+        ASSERT_EQ((int)interpreter_->Interpret(model_config_.params), TNN_OK);
+        network_config_.device_type = ConvertDeviceType(FLAGS_dt);
+    }
+
+    Status InitNetwork(InitWeightsNetwork& network) {
+        return network.Init(network_config_, model_config_, interpreter_.get(), InputShapesMap());
+    }
+
+    std::vector<float> Forward(InitWeightsNetwork& network) {
+        void* command_queue = nullptr;
+        EXPECT_EQ((int)network.GetCommandQueue(&command_queue), TNN_OK);
+        BlobMap input_blobs, output_blobs;
+        network.GetAllInputBlobs(input_blobs);
+        network.GetAllOutputBlobs(output_blobs);
+
+        std::vector<float> input_data(3 * 16 * 16);
+        srand(16);
+        InitRandom(input_data.data(), input_data.size(), -1.0f, 1.0f);
+        Mat input(DEVICE_NAIVE, NCHW_FLOAT, {1, 3, 16, 16}, input_data.data());
+        BlobConverter input_converter(input_blobs["input"]);
+        EXPECT_EQ((int)input_converter.ConvertFromMat(input, MatConvertParam(), command_queue), TNN_OK);
+        EXPECT_EQ((int)network.Forward(), TNN_OK);
+
+        auto output_dims = output_blobs["output"]->GetBlobDesc().dims;
+        std::vector<float> output_data(DimsVectorUtils::Count(output_dims));
+        Mat output(DEVICE_NAIVE, NCHW_FLOAT, output_dims, output_data.data());
+        BlobConverter output_converter(output_blobs["output"]);
+        EXPECT_EQ((int)output_converter.ConvertToMat(output, MatConvertParam(), command_queue), TNN_OK);
+        return output_data;
+    }
+
+    ModelConfig model_config_;
+    NetworkConfig network_config_;
+    std::shared_ptr<ModelInterpreter> interpreter_;
+};
+
+TEST_F(DefaultNetworkTest, ParallelInitWeightsMatchesSerial) {
+    InitWeightsNetwork parallel_network(kParallelThreads, {});
+    ASSERT_EQ((int)InitNetwork(parallel_network), TNN_OK);
+    InitWeightsNetwork serial_network(1, {});
+    ASSERT_EQ((int)InitNetwork(serial_network), TNN_OK);
+
+    auto parallel_output = Forward(parallel_network);
+    auto serial_output   = Forward(serial_network);
+    ASSERT_EQ(parallel_output.size(), 10);
+    ASSERT_EQ(serial_output.size(), parallel_output.size());
+    EXPECT_EQ(memcmp(parallel_output.data(), serial_output.data(), serial_output.size() * sizeof(float)), 0);
+}
+
+TEST_F(DefaultNetworkTest, InitWeightsReportsFirstFailedLayer) {
+    // the failure of deconv0 is reported whichever layer fails first in time
+    const std::map<int, int> failed_layers = {{3, TNNERR_PARAM_ERR}, {1, TNNERR_LAYER_ERR}, {2, TNNERR_MODEL_ERR}};
+    for (int num_threads : {1, kParallelThreads}) {
+        InitWeightsNetwork network(num_threads, failed_layers);
+        Status status = InitNetwork(network);
+        EXPECT_EQ((int)status, TNNERR_LAYER_ERR) << "threads " << num_threads;
+        EXPECT_NE(status.description().find("deconv0"), std::string::npos) << status.description();
+        EXPECT_NE(status.description().find("injected failure"), std::string::npos) << status.description();
+    }
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,209 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/tnn.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static const int kInputChannel = 3;
+static const int kInputSize    = 64;
+
+// proto of a network from input "input" through the layers to the output "output"
+static std::string IncrementalTestProto(const std::vector<std::string>& layers) {
+    std::string proto = "\"1 0 1 4206624770 ,\"\n";
+    proto += "\"input 1 " + std::to_string(kInputChannel) + " " + std::to_string(kInputSize) + " " +
+             std::to_string(kInputSize) + " ,\"\n";
+    proto += "\" input";
+    for (int i = 0; i < layers.size(); ++i) {
+        proto += i + 1 < layers.size() ? " blob" + std::to_string(i) : " output";
+    }
+    proto += " ,\"\n\"output ,\"\n\" " + std::to_string(layers.size()) + " ,\"\n";
+    for (int i = 0; i < layers.size(); ++i) {
+        auto input  = i == 0 ? std::string("input") : "blob" + std::to_string(i - 1);
+        auto output = i + 1 < layers.size() ? "blob" + std::to_string(i) : std::string("output");
+        auto space  = layers[i].find(' ');
+        auto type   = layers[i].substr(0, space);
+        auto args   = space == std::string::npos ? std::string() : layers[i].substr(space);
+        proto += "\"" + type + " layer" + std::to_string(i) + " 1 1 " + input + " " + output + args + " ,\"\n";
+    }
+    return proto;
+}
+
+class IncrementalForwardTest : public ::testing::Test {
+protected:
+    // the incremental instance and a reference instance computing every frame,
+    // both created from the same model so that they share the generated weights
+    void Init(const std::vector<std::string>& layers, float max_recompute_ratio = 0.5f) {
+        InitProto(IncrementalTestProto(layers), max_recompute_ratio, 8);
+    }
+
+    void InitProto(const std::string& proto, float max_recompute_ratio, int tile_size) {
+        ModelConfig model_config;
+        model_config.model_type     = MODEL_TYPE_TNN;
+        model_config.params         = {proto, ""};
+        model_config.benchmark_mode = true;
+        ASSERT_EQ((int)tnn_.Init(model_config), TNN_OK);
+
+        NetworkConfig config;
+        config.device_type = ConvertDeviceType(FLAGS_dt);
+        Status status;
+        reference_ = tnn_.CreateInst(config, status);
+        ASSERT_EQ((int)status, TNN_OK);
+
+        config.incremental_config.enable              = true;
+        config.incremental_config.tile_size           = tile_size;
+        config.incremental_config.max_recompute_ratio = max_recompute_ratio;
+        instance_ = tnn_.CreateInst(config, status);
+        ASSERT_EQ((int)status, TNN_OK);
+
+        frame_.resize(kInputChannel * kInputSize * kInputSize);
+        InitRandom(frame_.data(), frame_.size(), -1.0f, 1.0f);
+    }
+
+    // change the input in the rows and cols [begin, end)
+    void ChangeFrame(int begin, int end) {
+        for (int c = 0; c < kInputChannel; ++c) {
+            for (int y = begin; y < end; ++y) {
+                for (int x = begin; x < end; ++x) {
+                    frame_[(c * kInputSize + y) * kInputSize + x] += 0.5f;
+                }
+            }
+        }
+    }
+
+    // forward both instances with the current frame and compare the outputs
+    void ForwardAndCompare() {
+        std::vector<float> outputs[2];
+        std::shared_ptr<Instance> instances[2] = {instance_, reference_};
+        for (int i = 0; i < 2; ++i) {
+            auto input = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT,
+                                               DimsVector({1, kInputChannel, kInputSize, kInputSize}), frame_.data());
+            ASSERT_EQ((int)instances[i]->SetInputMat(input, MatConvertParam()), TNN_OK);
+            ASSERT_EQ((int)instances[i]->Forward(), TNN_OK);
+            std::shared_ptr<Mat> output;
+            ASSERT_EQ((int)instances[i]->GetOutputMat(output, MatConvertParam(), "", DEVICE_NAIVE), TNN_OK);
+            auto data = static_cast<float*>(output->GetData());
+            outputs[i].assign(data, data + DimsVectorUtils::Count(output->GetDims()));
+        }
+        ASSERT_EQ(outputs[0].size(), outputs[1].size());
+        for (int i = 0; i < outputs[0].size(); ++i) {
+            ASSERT_NEAR(outputs[0][i], outputs[1][i], 1e-4f * std::max(1.0f, std::fabs(outputs[1][i])))
+                << "output index " << i;
+        }
+    }
+
+    IncrementalStats GetStats() {
+        IncrementalStats stats;
+        EXPECT_EQ((int)instance_->GetIncrementalStats(stats), TNN_OK);
+        return stats;
+    }
+
+    // first frame computes the whole network, a small change only its region
+    void RunPartial(const std::vector<std::string>& layers) {
+        Init(layers);
+        ForwardAndCompare();
+        ChangeFrame(20, 28);
+        ForwardAndCompare();
+        ChangeFrame(40, 44);
+        ForwardAndCompare();
+
+        auto stats = GetStats();
+        EXPECT_EQ(stats.full_count, 1);
+        EXPECT_EQ(stats.partial_count, 2);
+        EXPECT_GT(stats.last_recompute_ratio, 0.0f);
+        EXPECT_LT(stats.last_recompute_ratio, 0.5f);
+    }
+
+    TNN tnn_;
+    std::shared_ptr<Instance> instance_;
+    std::shared_ptr<Instance> reference_;
+    std::vector<float> frame_;
+};
+
+TEST_F(IncrementalForwardTest, ConvChain) {
+    RunPartial({"Convolution 1 3 8 3 3 1 1 1 1 1 -1 1 1", "ReLU", "Convolution 1 8 8 3 3 1 1 1 1 1 -1 1 1",
+                "Convolution 1 8 4 1 1 1 1 0 0 1 -1 1 1"});
+}
+
+TEST_F(IncrementalForwardTest, PoolChain) {
+    RunPartial({"Convolution 1 3 8 3 3 1 1 1 1 1 -1 1 1", "Pooling 0 2 2 2 2 0 0 -1 -1 -1 0",
+                "Pooling 1 3 3 1 1 1 1 -1 -1 -1 0", "Convolution 1 8 4 3 3 1 1 1 1 1 -1 1 1"});
+}
+
+TEST_F(IncrementalForwardTest, Stride2Chain) {
+    RunPartial({"Convolution 1 3 8 3 3 2 2 1 1 1 -1 1 1", "ReLU", "Convolution 1 8 8 3 3 2 2 1 1 1 -1 1 1",
+                "Convolution 1 8 4 3 3 1 1 1 1 1 -1 1 1"});
+}
+
+TEST_F(IncrementalForwardTest, ThresholdFallback) {
+    Init({"Convolution 1 3 8 3 3 1 1 1 1 1 -1 1 1", "Convolution 1 8 4 3 3 2 2 1 1 1 -1 1 1"}, 0.25f);
+    ForwardAndCompare();
+    ChangeFrame(0, 48);
+    ForwardAndCompare();
+
+    auto stats = GetStats();
+    EXPECT_EQ(stats.full_count, 2);
+    EXPECT_EQ(stats.partial_count, 0);
+    EXPECT_FLOAT_EQ(stats.last_recompute_ratio, 1.0f);
+}
+
+TEST_F(IncrementalForwardTest, UnchangedInputSkip) {
+    Init({"Convolution 1 3 8 3 3 1 1 1 1 1 -1 1 1", "Pooling 0 2 2 2 2 0 0 -1 -1 -1 0"});
+    ForwardAndCompare();
+    ForwardAndCompare();
+    ForwardAndCompare();
+
+    auto stats = GetStats();
+    EXPECT_EQ(stats.full_count, 1);
+    EXPECT_EQ(stats.partial_count, 0);
+    EXPECT_EQ(stats.skip_count, 2);
+}
+
+TEST_F(IncrementalForwardTest, CropReshapeFallback) {
+    // both branches give 32 x 32 for the whole input, but 5 and 4 rows for a crop of 9 rows
+    std::string proto = "\"1 0 1 4206624770 ,\"\n";
+    proto += "\"input 1 3 64 64 ,\"\n";
+    proto += "\" input blob0 blob1 output ,\"\n";
+    proto += "\"output ,\"\n";
+    proto += "\" 3 ,\"\n";
+    proto += "\"Convolution layer0 1 1 input blob0 1 3 4 3 3 2 2 1 1 1 -1 1 1 ,\"\n";
+    proto += "\"Convolution layer1 1 1 input blob1 1 3 4 2 2 2 2 0 0 1 -1 1 1 ,\"\n";
+    proto += "\"Concat layer2 2 1 blob0 blob1 output 1 ,\"\n";
+    InitProto(proto, 0.5f, 3);
+    ForwardAndCompare();
+
+    // the rows [25, 32) are needed, rounded to the crop [24, 33) the branches can not be concatenated
+    ChangeFrame(27, 30);
+    ForwardAndCompare();
+    ChangeFrame(27, 30);
+    ForwardAndCompare();
+
+    auto stats = GetStats();
+    EXPECT_EQ(stats.full_count, 3);
+    EXPECT_EQ(stats.partial_count, 0);
+    EXPECT_FLOAT_EQ(stats.last_recompute_ratio, 1.0f);
+}
+
+}  // namespace TNN_NS
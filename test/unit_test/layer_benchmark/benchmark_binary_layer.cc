@@ -0,0 +1,93 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_benchmark/layer_benchmark.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class BinaryLayerBenchmark
+    : public LayerBenchmark,
+      public ::testing::WithParamInterface<std::tuple<LayerType, int, int, int, int, int, DataType>> {
+    float GetCalcMflops(LayerParam* param, std::vector<Blob*> inputs, std::vector<Blob*> outputs) {
+        return 1.0f * DimsVectorUtils::Count(outputs[0]->GetBlobDesc().dims) / 1000.f / 1000.f;
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, BinaryLayerBenchmark,
+                         ::testing::Combine(  // layer type
+                             testing::Values(LAYER_ADD, LAYER_MUL),
+                             // batch
+                             testing::Values(1, 4),
+                             // channel
+                             testing::Values(32, 256),
+                             // hw
+                             testing::Values(14, 56),
+                             // broadcast, 0 two inputs of the same shape, 1 channel weights
+                             testing::Values(0, 1),
+                             // threads
+                             testing::Values(1, 4),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_INT8)));
+
+TEST_P(BinaryLayerBenchmark, BinaryLayer) {
+    // get param
+    LayerType layer_type = std::get<0>(GetParam());
+    int batch            = std::get<1>(GetParam());
+    int channel          = std::get<2>(GetParam());
+    int input_size       = std::get<3>(GetParam());
+    int broadcast        = std::get<4>(GetParam());
+    int threads          = std::get<5>(GetParam());
+    DataType data_type   = std::get<6>(GetParam());
+    DeviceType dev       = ConvertDeviceType(FLAGS_dt);
+
+    if (data_type == DATA_TYPE_INT8) {
+        // only single batch and non-broadcasting add is implemented
+        if (DEVICE_ARM != dev || layer_type != LAYER_ADD || batch != 1 || broadcast != 0) {
+            GTEST_SKIP();
+        }
+    }
+
+    // param
+    MultidirBroadcastLayerParam param;
+    param.name = "Binary";
+
+    std::shared_ptr<EltwiseLayerResource> resource = nullptr;
+    std::vector<BlobDesc> inputs_desc;
+    if (broadcast == 0) {
+        param.weight_input_index = -1;
+        inputs_desc              = CreateInputBlobsDesc(batch, channel, input_size, 2, data_type);
+    } else {
+        param.weight_input_index = 1;
+        inputs_desc              = CreateInputBlobsDesc(batch, channel, input_size, 1, data_type);
+
+        resource.reset(new EltwiseLayerResource());
+        RawBuffer buffer(channel * sizeof(float));
+        InitRandom(buffer.force_to<float*>(), channel, 1.0f);
+        resource->element_handle = buffer;
+        resource->element_shape  = {1, channel, 1, 1};
+    }
+    auto outputs_desc = CreateOutputBlobsDesc(1, data_type);
+
+    Benchmark(layer_type, &param, resource.get(), inputs_desc, outputs_desc, threads,
+              {{"layer_type", layer_type},
+               {"batch", batch},
+               {"channel", channel},
+               {"input_size", input_size},
+               {"broadcast", broadcast}});
+}
+
+}  // namespace TNN_NS
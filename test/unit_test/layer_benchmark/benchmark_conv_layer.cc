@@ -0,0 +1,116 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_benchmark/layer_benchmark.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+
+namespace TNN_NS {
+
+class ConvLayerBenchmark
+    : public LayerBenchmark,
+      public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, int, DataType>> {
+    float GetCalcMflops(LayerParam* param, std::vector<Blob*> inputs, std::vector<Blob*> outputs) {
+        ConvLayerParam* conv_param = dynamic_cast<ConvLayerParam*>(param);
+        auto dims_input            = inputs[0]->GetBlobDesc().dims;
+        auto dims_output           = outputs[0]->GetBlobDesc().dims;
+        return 2.0f * dims_output[0] * dims_output[1] * dims_input[1] / conv_param->group * dims_output[2] *
+               dims_output[3] * conv_param->kernels[0] * conv_param->kernels[1] / 1000.f / 1000.f;
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, ConvLayerBenchmark,
+                         ::testing::Combine(  // batch
+                             testing::Values(1, 4),
+                             // channel
+                             testing::Values(16, 64, 256),
+                             // hw
+                             testing::Values(14, 56),
+                             // kernel
+                             testing::Values(1, 3),
+                             // stride
+                             testing::Values(1, 2),
+                             // depthwise
+                             testing::Values(0, 1),
+                             // threads
+                             testing::Values(1, 4),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16, DATA_TYPE_INT8)));
+
+TEST_P(ConvLayerBenchmark, ConvLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int channel        = std::get<1>(GetParam());
+    int input_size     = std::get<2>(GetParam());
+    int kernel         = std::get<3>(GetParam());
+    int stride         = std::get<4>(GetParam());
+    int depthwise      = std::get<5>(GetParam());
+    int threads        = std::get<6>(GetParam());
+    DataType data_type = std::get<7>(GetParam());
+    int group          = depthwise ? channel : 1;
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    if (data_type != DATA_TYPE_FLOAT && DEVICE_ARM != dev) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, 1, data_type);
+    auto outputs_desc = CreateOutputBlobsDesc(1, data_type);
+
+    // param
+    ConvLayerParam param;
+    param.name           = "Conv";
+    param.input_channel  = channel;
+    param.output_channel = channel;
+    param.group          = group;
+    param.kernels        = {kernel, kernel};
+    param.dialations     = {1, 1};
+    param.strides        = {stride, stride};
+    param.pads           = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+    param.bias           = 1;
+
+    // resource
+    ConvLayerResource resource;
+    int filter_count = channel * channel * kernel * kernel / group;
+    if (data_type == DATA_TYPE_INT8) {
+        RawBuffer filter(filter_count * sizeof(int8_t));
+        RawBuffer bias(channel * sizeof(int32_t));
+        RawBuffer scale(channel * sizeof(float));
+        InitRandom(filter.force_to<int8_t*>(), filter_count, (int8_t)8);
+        filter.SetDataType(DATA_TYPE_INT8);
+        InitRandom(bias.force_to<int32_t*>(), channel, (int32_t)8);
+        InitRandom(scale.force_to<float*>(), channel, 1.0f);
+        resource.filter_handle = filter;
+        resource.bias_handle   = bias;
+        resource.scale_handle  = scale;
+    } else {
+        RawBuffer filter(filter_count * sizeof(float));
+        RawBuffer bias(channel * sizeof(float));
+        InitRandom(filter.force_to<float*>(), filter_count, 1.0f);
+        InitRandom(bias.force_to<float*>(), channel, 1.0f);
+        resource.filter_handle = filter;
+        resource.bias_handle   = bias;
+    }
+
+    Benchmark(LAYER_CONVOLUTION, &param, &resource, inputs_desc, outputs_desc, threads,
+              {{"batch", batch},
+               {"channel", channel},
+               {"input_size", input_size},
+               {"kernel", kernel},
+               {"stride", stride},
+               {"group", group}});
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,109 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_benchmark/layer_benchmark.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class InnerProductLayerBenchmark
+    : public LayerBenchmark,
+      public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, DataType>> {
+    float GetCalcMflops(LayerParam* param, std::vector<Blob*> inputs, std::vector<Blob*> outputs) {
+        auto dims_input  = inputs[0]->GetBlobDesc().dims;
+        auto dims_output = outputs[0]->GetBlobDesc().dims;
+        return 2.0f * dims_input[0] * DimsVectorUtils::Count(dims_input, 1) * dims_output[1] / 1000.f / 1000.f;
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, InnerProductLayerBenchmark,
+                         ::testing::Combine(  // batch
+                             testing::Values(1, 8),
+                             // input channel
+                             testing::Values(64, 512),
+                             // hw
+                             testing::Values(1, 7),
+                             // output channel
+                             testing::Values(128, 1000),
+                             // threads
+                             testing::Values(1, 4),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16, DATA_TYPE_INT8)));
+
+TEST_P(InnerProductLayerBenchmark, InnerProductLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int input_channel  = std::get<1>(GetParam());
+    int input_size     = std::get<2>(GetParam());
+    int output_channel = std::get<3>(GetParam());
+    int threads        = std::get<4>(GetParam());
+    DataType data_type = std::get<5>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    if (data_type != DATA_TYPE_FLOAT && DEVICE_ARM != dev) {
+        GTEST_SKIP();
+    }
+
+    if (data_type == DATA_TYPE_INT8 && input_size != 1) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, input_channel, input_size, 1, data_type);
+    auto outputs_desc = CreateOutputBlobsDesc(1, data_type);
+    if (data_type == DATA_TYPE_INT8) {
+        // assign output dims to ensure output resourse be created correctly
+        outputs_desc[0].dims = {batch, output_channel, 1, 1};
+    }
+
+    // param
+    InnerProductLayerParam param;
+    param.name       = "InnerProduct";
+    param.num_output = output_channel;
+    param.has_bias   = 1;
+    param.axis       = 1;
+
+    // resource
+    InnerProductLayerResource resource;
+    int filter_count = output_channel * input_channel * input_size * input_size;
+    if (data_type == DATA_TYPE_INT8) {
+        RawBuffer filter(filter_count * sizeof(int8_t));
+        RawBuffer bias(output_channel * sizeof(int32_t));
+        RawBuffer scale(output_channel * sizeof(float));
+        InitRandom(filter.force_to<int8_t*>(), filter_count, (int8_t)8);
+        filter.SetDataType(DATA_TYPE_INT8);
+        InitRandom(bias.force_to<int32_t*>(), output_channel, (int32_t)8);
+        InitRandom(scale.force_to<float*>(), output_channel, 1.0f);
+        resource.weight_handle = filter;
+        resource.bias_handle   = bias;
+        resource.scale_handle  = scale;
+    } else {
+        RawBuffer filter(filter_count * sizeof(float));
+        RawBuffer bias(output_channel * sizeof(float));
+        InitRandom(filter.force_to<float*>(), filter_count, 1.0f);
+        InitRandom(bias.force_to<float*>(), output_channel, 1.0f);
+        resource.weight_handle = filter;
+        resource.bias_handle   = bias;
+    }
+
+    Benchmark(LAYER_INNER_PRODUCT, &param, &resource, inputs_desc, outputs_desc, threads,
+              {{"batch", batch},
+               {"input_channel", input_channel},
+               {"input_size", input_size},
+               {"output_channel", output_channel}});
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,104 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_benchmark/layer_benchmark.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class PoolingLayerBenchmark
+    : public LayerBenchmark,
+      public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, int, DataType>> {
+    float GetCalcMflops(LayerParam* param, std::vector<Blob*> inputs, std::vector<Blob*> outputs) {
+        PoolingLayerParam* pool_param = dynamic_cast<PoolingLayerParam*>(param);
+        auto dims_output              = outputs[0]->GetBlobDesc().dims;
+        return 1.0f * DimsVectorUtils::Count(dims_output) * pool_param->kernels[0] * pool_param->kernels[1] / 1000.f /
+               1000.f;
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, PoolingLayerBenchmark,
+                         ::testing::Combine(  // batch
+                             testing::Values(1, 4),
+                             // channel
+                             testing::Values(32, 256),
+                             // hw
+                             testing::Values(14, 56),
+                             // kernel, 0 means global pooling
+                             testing::Values(0, 2, 3),
+                             // stride
+                             testing::Values(1, 2),
+                             // pool type, 0 max, 1 average
+                             testing::Values(0, 1),
+                             // threads
+                             testing::Values(1, 4),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT, DATA_TYPE_BFP16, DATA_TYPE_INT8)));
+
+TEST_P(PoolingLayerBenchmark, PoolingLayer) {
+    // get param
+    int batch          = std::get<0>(GetParam());
+    int channel        = std::get<1>(GetParam());
+    int input_size     = std::get<2>(GetParam());
+    int kernel         = std::get<3>(GetParam());
+    int stride         = std::get<4>(GetParam());
+    int pool_type      = std::get<5>(GetParam());
+    int threads        = std::get<6>(GetParam());
+    DataType data_type = std::get<7>(GetParam());
+    DeviceType dev     = ConvertDeviceType(FLAGS_dt);
+
+    if (data_type != DATA_TYPE_FLOAT && DEVICE_ARM != dev) {
+        GTEST_SKIP();
+    }
+
+    if (kernel == 0 && stride != 1) {
+        GTEST_SKIP();
+    }
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, 1, data_type);
+    auto outputs_desc = CreateOutputBlobsDesc(1, data_type);
+
+    // param
+    PoolingLayerParam param;
+    param.name = "Pooling";
+    if (kernel == 0) {
+        param.kernels_params = {0, 0};
+        param.kernels        = {input_size, input_size};
+        param.strides        = {1, 1};
+        param.pads           = {0, 0, 0, 0};
+    } else {
+        param.kernels_params = {kernel, kernel};
+        param.kernels        = {kernel, kernel};
+        param.strides        = {stride, stride};
+        int pad              = (kernel == 3) ? 1 : 0;
+        param.pads           = {pad, pad, pad, pad};
+    }
+    param.pad_type  = -1;
+    param.pool_type = pool_type;
+    param.kernel_indexs.push_back(-1);
+    param.kernel_indexs.push_back(-1);
+
+    Benchmark(LAYER_POOLING, &param, nullptr, inputs_desc, outputs_desc, threads,
+              {{"batch", batch},
+               {"channel", channel},
+               {"input_size", input_size},
+               {"kernel", kernel},
+               {"stride", stride},
+               {"pool_type", pool_type}});
+}
+
+}  // namespace TNN_NS
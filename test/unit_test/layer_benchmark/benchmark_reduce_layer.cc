@@ -0,0 +1,74 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_benchmark/layer_benchmark.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class ReduceLayerBenchmark
+    : public LayerBenchmark,
+      public ::testing::WithParamInterface<std::tuple<LayerType, int, int, int, int, int, DataType>> {
+    float GetCalcMflops(LayerParam* param, std::vector<Blob*> inputs, std::vector<Blob*> outputs) {
+        return 1.0f * DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims) / 1000.f / 1000.f;
+    }
+};
+
+INSTANTIATE_TEST_SUITE_P(LayerBenchmark, ReduceLayerBenchmark,
+                         ::testing::Combine(  // layer type
+                             testing::Values(LAYER_REDUCE_SUM, LAYER_REDUCE_MEAN, LAYER_REDUCE_MAX),
+                             // batch
+                             testing::Values(1, 4),
+                             // channel
+                             testing::Values(32, 256),
+                             // hw
+                             testing::Values(14, 56),
+                             // axis
+                             testing::Values(1, 2, 3),
+                             // threads
+                             testing::Values(1, 4),
+                             // data_type
+                             testing::Values(DATA_TYPE_FLOAT)));
+
+TEST_P(ReduceLayerBenchmark, ReduceLayer) {
+    // get param
+    LayerType layer_type = std::get<0>(GetParam());
+    int batch            = std::get<1>(GetParam());
+    int channel          = std::get<2>(GetParam());
+    int input_size       = std::get<3>(GetParam());
+    int axis             = std::get<4>(GetParam());
+    int threads          = std::get<5>(GetParam());
+    DataType data_type   = std::get<6>(GetParam());
+
+    // blob desc
+    auto inputs_desc  = CreateInputBlobsDesc(batch, channel, input_size, 1, data_type);
+    auto outputs_desc = CreateOutputBlobsDesc(1, data_type);
+
+    // param
+    ReduceLayerParam param;
+    param.name      = "Reduce";
+    param.keep_dims = 1;
+    param.axis      = {axis};
+
+    Benchmark(layer_type, &param, nullptr, inputs_desc, outputs_desc, threads,
+              {{"layer_type", layer_type},
+               {"batch", batch},
+               {"channel", channel},
+               {"input_size", input_size},
+               {"axis", axis}});
+}
+
+}  // namespace TNN_NS
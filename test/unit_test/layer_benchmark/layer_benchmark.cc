@@ -0,0 +1,163 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_benchmark/layer_benchmark.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "tnn/utils/data_type_utils.h"
+
+namespace TNN_NS {
+
+std::vector<LayerBenchmarkResult>& LayerBenchmark::GetResults() {
+    static std::vector<LayerBenchmarkResult> results;
+    return results;
+}
+
+LayerBenchmark::LayerBenchmark() {
+    run_cpu_layer_ = false;
+}
+
+void LayerBenchmark::Benchmark(LayerType type, LayerParam* param, LayerResource* resource,
+                               std::vector<BlobDesc>& inputs_desc, std::vector<BlobDesc>& outputs_desc,
+                               int num_threads, const LayerBenchmarkParams& params) {
+    Status status = Init(type, param, resource, inputs_desc, outputs_desc);
+    if (status != TNN_OK) {
+        EXPECT_EQ((int)status, TNN_OK);
+        DeInit();
+        return;
+    }
+
+    // threads only take effect in reshape and forward
+    device_context_->SetNumThreads(num_threads);
+
+    status = Reshape();
+    if (status != TNN_OK) {
+        EXPECT_EQ((int)status, TNN_OK);
+        DeInit();
+        return;
+    }
+
+    status = Forward();
+    if (status != TNN_OK) {
+        EXPECT_EQ((int)status, TNN_OK);
+        DeInit();
+        return;
+    }
+
+    auto test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+
+    LayerBenchmarkResult result;
+    result.name        = std::string(test_info->test_suite_name()) + "/" + test_info->name();
+    result.device      = FLAGS_dt;
+    result.data_type   = DataTypeUtils::GetDataTypeString(device_inputs_[0]->GetBlobDesc().data_type);
+    result.num_threads = num_threads;
+    result.params      = params;
+    for (auto blob : device_inputs_) {
+        result.input_dims.push_back(blob->GetBlobDesc().dims);
+    }
+    for (auto blob : device_outputs_) {
+        result.output_dims.push_back(blob->GetBlobDesc().dims);
+    }
+    result.iterations = FLAGS_ic;
+    result.time_min   = time_min_;
+    result.time_max   = time_max_;
+    result.time_avg   = time_avg_;
+    result.times      = times_;
+    if (time_avg_ > 0) {
+        // MFLOPs per ms is GFLOP/s, MB per ms is GB/s
+        float mflops     = GetCalcMflops(param_, cpu_layer_->GetInputBlobs(), cpu_layer_->GetOutputBlobs());
+        result.gflops    = mflops / time_avg_;
+        result.bandwidth = GetCalcDramThrp(time_avg_);
+    }
+    GetResults().push_back(result);
+
+    status = DeInit();
+    if (status != TNN_OK) {
+        EXPECT_EQ((int)status, TNN_OK);
+        return;
+    }
+}
+
+static std::string DimsToJson(const DimsVector& dims) {
+    std::stringstream ss;
+    ss << "[";
+    for (int i = 0; i < dims.size(); ++i) {
+        ss << (i > 0 ? ", " : "") << dims[i];
+    }
+    ss << "]";
+    return ss.str();
+}
+
+static std::string DimsListToJson(const std::vector<DimsVector>& dims_list) {
+    std::stringstream ss;
+    ss << "[";
+    for (int i = 0; i < dims_list.size(); ++i) {
+        ss << (i > 0 ? ", " : "") << DimsToJson(dims_list[i]);
+    }
+    ss << "]";
+    return ss.str();
+}
+
+Status LayerBenchmark::WriteResults(std::string path) {
+    std::stringstream ss;
+    ss << "{\n  \"results\": [";
+    auto& results = GetResults();
+    for (int i = 0; i < results.size(); ++i) {
+        auto& result = results[i];
+        ss << (i > 0 ? "," : "") << "\n    {\n";
+        ss << "      \"name\": \"" << result.name << "\",\n";
+        ss << "      \"device\": \"" << result.device << "\",\n";
+        ss << "      \"data_type\": \"" << result.data_type << "\",\n";
+        ss << "      \"threads\": " << result.num_threads << ",\n";
+        ss << "      \"params\": {";
+        for (int p = 0; p < result.params.size(); ++p) {
+            ss << (p > 0 ? ", " : "") << "\"" << result.params[p].first << "\": " << result.params[p].second;
+        }
+        ss << "},\n";
+        ss << "      \"input_dims\": " << DimsListToJson(result.input_dims) << ",\n";
+        ss << "      \"output_dims\": " << DimsListToJson(result.output_dims) << ",\n";
+        ss << "      \"iterations\": " << result.iterations << ",\n";
+        ss << "      \"time_min_ms\": " << result.time_min << ",\n";
+        ss << "      \"time_max_ms\": " << result.time_max << ",\n";
+        ss << "      \"time_avg_ms\": " << result.time_avg << ",\n";
+        ss << "      \"gflops\": " << result.gflops << ",\n";
+        ss << "      \"bandwidth_gbps\": " << result.bandwidth << ",\n";
+        ss << "      \"times_ms\": [";
+        for (int t = 0; t < result.times.size(); ++t) {
+            ss << (t > 0 ? ", " : "") << result.times[t];
+        }
+        ss << "]\n";
+        ss << "    }";
+    }
+    ss << "\n  ]\n}\n";
+
+    if (path.empty()) {
+        std::cout << ss.str();
+        return TNN_OK;
+    }
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        LOGE("open benchmark output file %s failed\n", path.c_str());
+        return Status(TNNERR_COMMON_ERROR, "open benchmark output file failed");
+    }
+    file << ss.str();
+    file.close();
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,69 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TEST_UNIT_TEST_LAYER_BENCHMARK_LAYER_BENCHMARK_H_
+#define TNN_TEST_UNIT_TEST_LAYER_BENCHMARK_LAYER_BENCHMARK_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test/unit_test/layer_test/layer_test.h"
+
+namespace TNN_NS {
+
+// @brief layer params of a benchmark case, in the order they are reported
+typedef std::vector<std::pair<std::string, int>> LayerBenchmarkParams;
+
+struct LayerBenchmarkResult {
+    std::string name;
+    std::string device;
+    std::string data_type;
+    int num_threads = 1;
+    LayerBenchmarkParams params;
+    std::vector<DimsVector> input_dims;
+    std::vector<DimsVector> output_dims;
+    int iterations = 0;
+    // time cost in ms
+    float time_min = 0.f;
+    float time_max = 0.f;
+    float time_avg = 0.f;
+    // time of each iteration, used to compare results statistically
+    std::vector<float> times;
+    // computation in GFLOP/s and memory traffic in GB/s
+    float gflops    = 0.f;
+    float bandwidth = 0.f;
+};
+
+// @brief LayerBenchmark times the device layer only, the cpu reference
+// layer is not run and results are not compared.
+class LayerBenchmark : public LayerTest {
+public:
+    // @brief results of all benchmark cases run in the process
+    static std::vector<LayerBenchmarkResult>& GetResults();
+
+    // @brief write all results as json, to stdout if path is empty
+    static Status WriteResults(std::string path);
+
+protected:
+    LayerBenchmark();
+
+    // @brief init layers with num_threads on device, forward FLAGS_wc + FLAGS_ic times and record the result
+    void Benchmark(LayerType type, LayerParam* param, LayerResource* resource, std::vector<BlobDesc>& inputs_desc,
+                   std::vector<BlobDesc>& outputs_desc, int num_threads, const LayerBenchmarkParams& params);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_UNIT_TEST_LAYER_BENCHMARK_LAYER_BENCHMARK_H_
@@ -0,0 +1,57 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+#include "test/flags.h"
+#include "test/unit_test/layer_benchmark/layer_benchmark.h"
+
+namespace TNN_NS {
+
+void ShowUsage() {
+    printf("    -dt \"<device type>\"  %s \n", device_type_message);
+    printf("    -lp \"<dependent library path>\"  %s \n", library_path_message);
+    printf("    -ic \"<number>\"        %s \n", iterations_count_message);
+    printf("    -wc \"<number>\"        %s \n", warm_up_count_message);
+    printf("    -op \"<path>\"          json result path, print to stdout if not set \n");
+    printf("    --gtest_filter=\"<pattern>\"  select benchmark cases, eg. *ConvLayerBenchmark* \n");
+}
+
+bool ParseAndCheckCommandLine(int argc, char *argv[]) {
+    gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+    if (FLAGS_h) {
+        ShowUsage();
+        return false;
+    }
+
+    return true;
+}
+
+}  // namespace TNN_NS
+
+GTEST_API_ int main(int argc, char **argv) {
+    int result = 0;
+    try {
+        ::testing::InitGoogleTest(&argc, argv);
+        if (TNN_NS::ParseAndCheckCommandLine(argc, argv)) {
+            LOGD("run layer benchmark for device type: %s \n", TNN_NS::FLAGS_dt.c_str());
+            result = RUN_ALL_TESTS();
+            TNN_NS::Status ret = TNN_NS::LayerBenchmark::WriteResults(TNN_NS::FLAGS_op);
+            if (ret != TNN_NS::TNN_OK) {
+                result = -1;
+            }
+        }
+    } catch (std::exception e) {
+    }
+    return result;
+}
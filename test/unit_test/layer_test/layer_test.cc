@@ -354,10 +354,26 @@ Status LayerTest::Reshape() {
 Status LayerTest::Forward() {
     Status status;
 #ifndef TNN_UNIT_TEST_BENCHMARK
-    status = cpu_layer_->Forward();
-    EXPECT_EQ_OR_RETURN(status, TNN_OK);
+    if (run_cpu_layer_) {
+        status = cpu_layer_->Forward();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+    }
 #endif
 
+    for (int i = 0; i < FLAGS_wc; ++i) {
+        status = device_context_->OnInstanceForwardBegin();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+
+        status = device_layer_->Forward();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+
+        status = device_context_->OnInstanceForwardEnd();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+
+        status = device_context_->Synchronize();
+        EXPECT_EQ_OR_RETURN(status, TNN_OK);
+    }
+
 #if TNN_PROFILE && defined(TNN_UNIT_TEST_BENCHMARK)
     device_context_->StartProfile();
 #endif
@@ -366,6 +382,7 @@ Status LayerTest::Forward() {
     struct timeval time2;
     gettimeofday(&time1, &zone);
     float min = FLT_MAX, max = FLT_MIN, sum = 0.0f;
+    times_.clear();
     for (int i = 0; i < FLAGS_ic; ++i) {
         gettimeofday(&time1, &zone);
 
@@ -386,7 +403,11 @@ Status LayerTest::Forward() {
         min         = fmin(min, delta);
         max         = fmax(max, delta);
         sum += delta;
+        times_.push_back(delta);
     }
+    time_min_ = min;
+    time_max_ = max;
+    time_avg_ = sum / (float)FLAGS_ic;
 #if TNN_PROFILE && defined(TNN_UNIT_TEST_BENCHMARK)
     auto profile_result = device_context_->FinishProfile();
     auto result_str = profile_result->GetProfilingData();
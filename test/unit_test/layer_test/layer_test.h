@@ -43,14 +43,15 @@ protected:
 
     static void TearDownTestCase();
 
-private:
     Status Init(LayerType, LayerParam* param, LayerResource* resource, std::vector<BlobDesc>& inputs_desc,
                 std::vector<BlobDesc>& outputs_desc);
     Status Reshape();
     Status Forward();
-    Status Compare();
     Status DeInit();
 
+private:
+    Status Compare();
+
 protected:
     static AbstractDevice* cpu_;
     static AbstractDevice* device_;
@@ -65,6 +66,15 @@ protected:
     std::vector<Blob*> device_inputs_;
     std::vector<Blob*> device_outputs_;
     int ensure_input_positive_ = 0;
+    // run cpu reference layer in Forward
+    bool run_cpu_layer_ = true;
+
+    // device layer time cost of the last Forward in ms
+    float time_min_ = 0.f;
+    float time_max_ = 0.f;
+    float time_avg_ = 0.f;
+    // time of each timed iteration in ms
+    std::vector<float> times_;
 
 private:
     Status CreateLayers(LayerType type);
@@ -81,6 +91,7 @@ private:
     Status AllocateInputBlobs();
     Status AllocateOutputBlobs();
 
+protected:
     virtual float GetCalcMflops(LayerParam* param, std::vector<Blob*> inputs, std::vector<Blob*> outputs) {
         return 0.f;
     }
@@ -0,0 +1,161 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/numa_utils.h"
+
+namespace TNN_NS {
+
+static std::vector<int> ParseCpuList(const char* str) {
+    std::vector<int> cpu_list;
+    NumaUtils::ParseCpuList(str, cpu_list);
+    return cpu_list;
+}
+
+TEST(NumaUtilsTest, ParseCpuList) {
+    EXPECT_EQ(ParseCpuList("0"), std::vector<int>({0}));
+    EXPECT_EQ(ParseCpuList("0-3\n"), std::vector<int>({0, 1, 2, 3}));
+    EXPECT_EQ(ParseCpuList("1,5,7\n"), std::vector<int>({1, 5, 7}));
+    EXPECT_EQ(ParseCpuList("0-1,8,10-11\n"), std::vector<int>({0, 1, 8, 10, 11}));
+    EXPECT_EQ(ParseCpuList("12-12"), std::vector<int>({12}));
+    // memory only nodes have an empty cpu list
+    EXPECT_TRUE(ParseCpuList("").empty());
+    EXPECT_TRUE(ParseCpuList("\n").empty());
+    EXPECT_TRUE(ParseCpuList("x").empty());
+}
+
+// fake sysfs node dir: node 0 and 1 have cpus, node 2 is offline and node 3 is memory only
+class NumaTopologyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char dir[] = "/tmp/tnn_numa_XXXXXX";
+        ASSERT_NE(mkdtemp(dir), nullptr);
+        node_dir_ = dir;
+        WriteFile("possible", "0-3\n");
+        WriteFile("online", "0-1,3\n");
+        WriteFile("node0/cpulist", "0-3,8-11\n");
+        WriteFile("node1/cpulist", "4-7,12\n");
+        WriteFile("node3/cpulist", "\n");
+    }
+
+    void TearDown() override {
+        for (auto file : files_) {
+            remove(file.c_str());
+        }
+        for (auto it = dirs_.rbegin(); it != dirs_.rend(); ++it) {
+            rmdir(it->c_str());
+        }
+        rmdir(node_dir_.c_str());
+    }
+
+    void WriteFile(const std::string& name, const char* content) {
+        auto slash = name.find('/');
+        if (slash != std::string::npos) {
+            auto dir = node_dir_ + "/" + name.substr(0, slash);
+            mkdir(dir.c_str(), 0755);
+            dirs_.push_back(dir);
+        }
+        auto path = node_dir_ + "/" + name;
+        FILE* fp  = fopen(path.c_str(), "wb");
+        ASSERT_NE(fp, nullptr);
+        fputs(content, fp);
+        fclose(fp);
+        files_.push_back(path);
+    }
+
+    std::string node_dir_;
+    std::vector<std::string> files_;
+    std::vector<std::string> dirs_;
+};
+
+TEST_F(NumaTopologyTest, NodeCount) {
+    // offline nodes still count, node ids index the possible nodes
+    EXPECT_EQ(NumaUtils::GetNodeCount(node_dir_), 4);
+    EXPECT_EQ(NumaUtils::GetNodeCount(node_dir_ + "/missing"), 1);
+}
+
+TEST_F(NumaTopologyTest, NodeCpuList) {
+    std::vector<int> cpu_list;
+    ASSERT_EQ((int)NumaUtils::GetNodeCpuList(node_dir_, 0, cpu_list), TNN_OK);
+    EXPECT_EQ(cpu_list, std::vector<int>({0, 1, 2, 3, 8, 9, 10, 11}));
+    ASSERT_EQ((int)NumaUtils::GetNodeCpuList(node_dir_, 1, cpu_list), TNN_OK);
+    EXPECT_EQ(cpu_list, std::vector<int>({4, 5, 6, 7, 12}));
+
+    // offline, memory only and out of range nodes are rejected with an empty list
+    for (int numa_node : {2, 3, 4, -1}) {
+        EXPECT_NE((int)NumaUtils::GetNodeCpuList(node_dir_, numa_node, cpu_list), TNN_OK) << "node " << numa_node;
+        EXPECT_TRUE(cpu_list.empty()) << "node " << numa_node;
+    }
+}
+
+TEST(NumaUtilsTest, CpuUtilsMatchesSysfs) {
+    const int node_count = CpuUtils::GetNumaNodeCount();
+    ASSERT_GE(node_count, 1);
+    EXPECT_EQ(node_count, NumaUtils::GetNodeCount("/sys/devices/system/node"));
+
+    std::vector<int> cpu_list;
+    if (CpuUtils::GetNumaNodeCpuList(0, cpu_list) != TNN_OK) {
+        GTEST_SKIP() << "no numa node 0";
+    }
+    EXPECT_FALSE(cpu_list.empty());
+    EXPECT_NE((int)CpuUtils::GetNumaNodeCpuList(node_count, cpu_list), TNN_OK);
+}
+
+TEST(NumaUtilsTest, GuardRestoresMemoryPolicy) {
+    int default_mode = 0;
+    std::vector<unsigned long> default_nodemask;
+    std::vector<int> cpu_list;
+    if (NumaUtils::GetMemoryPolicy(default_mode, default_nodemask) != TNN_OK ||
+        CpuUtils::GetNumaNodeCpuList(0, cpu_list) != TNN_OK) {
+        GTEST_SKIP() << "numa memory policy not supported";
+    }
+
+    // a policy set by the caller survives the guard instead of being reset to the default one
+    const int mpol_bind = 2;
+    std::vector<unsigned long> nodemask(default_nodemask.size(), 0);
+    nodemask[0] = 1;
+    if (NumaUtils::SetMemoryPolicy(mpol_bind, nodemask) != TNN_OK) {
+        GTEST_SKIP() << "numa memory policy not supported";
+    }
+
+    std::vector<int> saved_cpu_list;
+    ASSERT_EQ((int)CpuUtils::GetCpuAffinity(saved_cpu_list), TNN_OK);
+    {
+        NumaNodeGuard guard(0);
+        ASSERT_EQ((int)guard.GetStatus(), TNN_OK);
+    }
+
+    int mode = 0;
+    std::vector<unsigned long> restored_nodemask;
+    ASSERT_EQ((int)NumaUtils::GetMemoryPolicy(mode, restored_nodemask), TNN_OK);
+    EXPECT_EQ(mode, mpol_bind);
+    EXPECT_EQ(restored_nodemask, nodemask);
+
+    std::vector<int> restored_cpu_list;
+    ASSERT_EQ((int)CpuUtils::GetCpuAffinity(restored_cpu_list), TNN_OK);
+    EXPECT_EQ(restored_cpu_list, saved_cpu_list);
+
+    ASSERT_EQ((int)NumaUtils::SetMemoryPolicy(default_mode, default_nodemask), TNN_OK);
+}
+
+}  // namespace TNN_NS
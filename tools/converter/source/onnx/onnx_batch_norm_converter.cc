@@ -0,0 +1,82 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <cmath>
+#include <cstring>
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(BatchNorm);
+
+std::string OnnxBatchNormConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "BatchNormCxx";
+}
+
+int OnnxBatchNormConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return context.GetRank(node.input(0));
+}
+
+TNN_NS::Status OnnxBatchNormConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                            const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param       = new TNN_NS::LayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->type      = cur_layer->type_str;
+    param->name      = cur_layer->name;
+    param->quantized = false;
+    // 5 inputs: input tensor, scale, bias, mean, var. the outputs of the training mode are not supported
+    std::vector<std::vector<float>> inputs(4);
+    for (int i = 0; i < inputs.size(); ++i) {
+        auto tensor = node.input_size() == 5 ? context.GetConstant(node.input(i + 1)) : nullptr;
+        if (tensor == nullptr || !GetTensorFloats(*tensor, inputs[i]) || inputs[i].size() != inputs[0].size()) {
+            LOGE("Onnx BatchNormalization only support constant float inputs\n");
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+    }
+    if (cur_layer->outputs.size() != 1) {
+        LOGE("Onnx BatchNormalization do not support the outputs of training\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    const float epsilon = GetAttributeFloat(node, "epsilon", 1e-5f);
+    const auto& gamma   = inputs[0];
+    const auto& beta    = inputs[1];
+    const auto& mean    = inputs[2];
+    const auto& var     = inputs[3];
+
+    // y = (x - mean) / sqrt(var + epsilon) * gamma + beta is x * scale + bias
+    const int channels = gamma.size();
+    TNN_NS::RawBuffer scale_handle(channels * sizeof(float));
+    TNN_NS::RawBuffer bias_handle(channels * sizeof(float));
+    auto scale = scale_handle.force_to<float*>();
+    auto bias  = bias_handle.force_to<float*>();
+    for (int c = 0; c < channels; ++c) {
+        scale[c] = gamma[c] / std::sqrt(var[c] + epsilon);
+        bias[c]  = beta[c] - mean[c] * scale[c];
+    }
+    auto layer_resource                        = new TNN_NS::BatchNormLayerResource;
+    layer_resource->name                       = cur_layer->name;
+    layer_resource->scale_handle               = scale_handle;
+    layer_resource->bias_handle                = bias_handle;
+    net_resource.resource_map[cur_layer->name] = std::shared_ptr<TNN_NS::LayerResource>(layer_resource);
+    cur_layer->inputs.resize(1);
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(BatchNorm, BatchNormalization);
+
+}  // namespace TNN_CONVERTER
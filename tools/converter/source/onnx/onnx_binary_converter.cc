@@ -0,0 +1,115 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <algorithm>
+#include <cstring>
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Binary);
+
+std::string OnnxBinaryConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return node.op_type();
+}
+
+int OnnxBinaryConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    int rank = -1;
+    for (const auto& input : node.input()) {
+        auto tensor = context.GetConstant(input);
+        rank        = std::max(rank, tensor != nullptr ? tensor->dims_size() : context.GetRank(input));
+    }
+    return rank;
+}
+
+// the runtime broadcasts the elements of a constant by their count: one element, one per channel or one per
+// element of a batch. the onnx broadcast aligns the trailing dims, check that both agree.
+static bool IsSupportedBroadcast(const onnx::TensorProto& tensor, int rank, const TNN_NS::DimsVector& dims) {
+    if (GetTensorCount(tensor) == 1) {
+        return true;
+    }
+    if (tensor.dims_size() > rank) {
+        return false;
+    }
+    std::vector<int64_t> onnx_dims(rank - tensor.dims_size(), 1);
+    onnx_dims.insert(onnx_dims.end(), tensor.dims().begin(), tensor.dims().end());
+    TNN_NS::DimsVector element_dims;
+    if (!ConvertShapeFormatOnnx(onnx_dims, element_dims)) {
+        return false;
+    }
+    const TNN_NS::DimsVector channel_dims = {1, dims[1], 1, 1};
+    const TNN_NS::DimsVector batch_dims   = {1, dims[1], dims[2], dims[3]};
+    return element_dims == channel_dims || element_dims == batch_dims;
+}
+
+TNN_NS::Status OnnxBinaryConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                         const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param                = new TNN_NS::MultidirBroadcastLayerParam;
+    auto cur_layer            = net_structure.layers.back();
+    cur_layer->param          = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->type               = cur_layer->type_str;
+    param->name               = cur_layer->name;
+    param->quantized          = false;
+    param->weight_input_index = -1;
+    if (node.input_size() != 2) {
+        LOGE("Onnx %s only support two inputs\n", node.op_type().c_str());
+        return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+    }
+    for (int i = 0; i < node.input_size(); ++i) {
+        if (context.GetConstant(node.input(i)) != nullptr) {
+            param->weight_input_index = i;
+        }
+    }
+    if (param->weight_input_index == -1) {
+        // the tnn blobs pad the trailing dims, inputs of different ranks broadcast differently
+        if (context.GetRank(node.input(0)) != context.GetRank(node.input(1))) {
+            LOGE("Onnx %s do not support inputs of different ranks\n", node.op_type().c_str());
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        return TNN_NS::TNN_CONVERT_OK;
+    }
+
+    const auto& input_name = node.input(1 - param->weight_input_index);
+    auto weight_tensor     = context.GetConstant(node.input(param->weight_input_index));
+    auto shape_iter        = net_structure.blobs_shape_map.find(input_name);
+    std::vector<float> weight;
+    if (!GetTensorFloats(*weight_tensor, weight) || weight.empty() ||
+        shape_iter == net_structure.blobs_shape_map.end()) {
+        LOGE("Onnx %s only support constant float operands\n", node.op_type().c_str());
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    if (!IsSupportedBroadcast(*weight_tensor, context.GetRank(input_name), shape_iter->second)) {
+        LOGE("Onnx %s do not support the broadcast of its constant operand\n", node.op_type().c_str());
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    auto layer_resource  = new TNN_NS::EltwiseLayerResource;
+    layer_resource->name = cur_layer->name;
+    TNN_NS::RawBuffer element_handle(weight.size() * sizeof(float));
+    ::memcpy(element_handle.force_to<float*>(), weight.data(), weight.size() * sizeof(float));
+    layer_resource->element_handle             = element_handle;
+    net_resource.resource_map[cur_layer->name] = std::shared_ptr<TNN_NS::LayerResource>(layer_resource);
+    cur_layer->inputs.resize(1);
+    cur_layer->inputs[0] = input_name;
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Binary, Add);
+REGISTER_ONNX_CONVERTER(Binary, Sub);
+REGISTER_ONNX_CONVERTER(Binary, Mul);
+REGISTER_ONNX_CONVERTER(Binary, Div);
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,84 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <cfloat>
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Clip);
+
+// the bounds are attributes before opset 11 and optional inputs since
+static bool GetClipBounds(const onnx::NodeProto& node, const OnnxGraphContext& context, float& min, float& max) {
+    min = GetAttributeFloat(node, "min", -FLT_MAX);
+    max = GetAttributeFloat(node, "max", FLT_MAX);
+    for (int i = 1; i < node.input_size() && i < 3; ++i) {
+        if (node.input(i).empty()) {
+            continue;
+        }
+        auto tensor = context.GetConstant(node.input(i));
+        std::vector<float> values;
+        if (tensor == nullptr || !GetTensorFloats(*tensor, values) || values.size() != 1) {
+            return false;
+        }
+        (i == 1 ? min : max) = values[0];
+    }
+    return true;
+}
+
+std::string OnnxClipConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    float min, max;
+    if (GetClipBounds(node, context, min, max) && min == 0.0f) {
+        if (max == 6.0f) {
+            return "ReLU6";
+        } else if (max == FLT_MAX) {
+            return "ReLU";
+        }
+    }
+    return "Clip";
+}
+
+int OnnxClipConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return context.GetRank(node.input(0));
+}
+
+TNN_NS::Status OnnxClipConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                       const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto cur_layer = net_structure.layers.back();
+    float min, max;
+    if (!GetClipBounds(node, context, min, max)) {
+        LOGE("Onnx Clip only support constant bounds\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    if (cur_layer->type == TNN_NS::LAYER_CLIP) {
+        auto param       = new TNN_NS::ClipLayerParam;
+        cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+        param->min       = min;
+        param->max       = max;
+    } else {
+        cur_layer->param = std::make_shared<TNN_NS::LayerParam>();
+    }
+    cur_layer->param->type      = cur_layer->type_str;
+    cur_layer->param->name      = cur_layer->name;
+    cur_layer->param->quantized = false;
+    cur_layer->inputs.resize(1);
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Clip, Clip);
+
+}  // namespace TNN_CONVERTER
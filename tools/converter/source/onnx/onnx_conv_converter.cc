@@ -0,0 +1,140 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Conv);
+
+std::string OnnxConvConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "Convolution";
+}
+
+int OnnxConvConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return 4;
+}
+
+// the tnn proto keeps one pad per spatial axis, the extra pads of asymmetric onnx pads go to a pad layer
+static void InsertPadLayer(TNN_NS::NetStructure& net_structure, const std::vector<int>& pads) {
+    auto& layers   = net_structure.layers;
+    auto cur_layer = layers.back();
+
+    auto pad_layer      = std::make_shared<TNN_NS::LayerInfo>();
+    pad_layer->type     = TNN_NS::LAYER_PAD;
+    pad_layer->type_str = "Pad";
+    pad_layer->name     = cur_layer->name + "_pad";
+    pad_layer->inputs.push_back(cur_layer->inputs[0]);
+    pad_layer->outputs.push_back(pad_layer->name);
+    auto pad_param              = new TNN_NS::PadLayerParam;
+    pad_layer->param            = std::shared_ptr<TNN_NS::LayerParam>(pad_param);
+    pad_layer->param->type      = pad_layer->type_str;
+    pad_layer->param->name      = pad_layer->name;
+    pad_layer->param->quantized = false;
+    pad_param->type             = 0;
+    pad_param->pads             = {pads[0], pads[1], pads[2], pads[3], 0, 0};
+    pad_param->value            = 0.0f;
+
+    cur_layer->inputs[0] = pad_layer->name;
+    layers.insert(layers.end() - 1, pad_layer);
+}
+
+TNN_NS::Status OnnxConvConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                       const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param       = new TNN_NS::ConvLayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->name      = cur_layer->name;
+    param->type      = cur_layer->type_str;
+    param->quantized = false;
+    // 3|2 inputs: input tensor, weight, (bias)
+    const int input_size = node.input_size();
+    auto weight_tensor   = input_size > 1 ? context.GetConstant(node.input(1)) : nullptr;
+    std::vector<float> weight;
+    if (weight_tensor == nullptr || weight_tensor->dims_size() != 4 || !GetTensorFloats(*weight_tensor, weight)) {
+        LOGE("Onnx Conv only support the constant float weights of 2d convolutions\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    // co ci/group kh kw
+    const int co = weight_tensor->dims(0);
+    const int kh = weight_tensor->dims(2);
+    const int kw = weight_tensor->dims(3);
+
+    param->group          = GetAttributeInt(node, "group", 1);
+    param->input_channel  = weight_tensor->dims(1) * param->group;
+    param->output_channel = co;
+    param->kernels        = {kw, kh};
+    auto strides          = GetAttributeInts(node, "strides");
+    auto dilations        = GetAttributeInts(node, "dilations");
+    param->strides        = strides.size() == 2 ? std::vector<int>{(int)strides[1], (int)strides[0]}
+                                                : std::vector<int>{1, 1};
+    param->dialations     = dilations.size() == 2 ? std::vector<int>{(int)dilations[1], (int)dilations[0]}
+                                                  : std::vector<int>{1, 1};
+
+    const auto auto_pad = GetAttributeString(node, "auto_pad", "NOTSET");
+    param->pads         = {0, 0, 0, 0};
+    if (auto_pad == "SAME_UPPER") {
+        // tensorflow pad same
+        param->pad_type = 0;
+    } else if (auto_pad == "VALID") {
+        param->pad_type = -1;
+    } else if (auto_pad == "NOTSET") {
+        param->pad_type = -1;
+        // onnx pads [h_begin w_begin h_end w_end]
+        auto onnx_pads = GetAttributeInts(node, "pads");
+        if (onnx_pads.size() == 4) {
+            std::vector<int> pads = {(int)onnx_pads[1], (int)onnx_pads[3], (int)onnx_pads[0], (int)onnx_pads[2]};
+            const int pad_w       = std::min(pads[0], pads[1]);
+            const int pad_h       = std::min(pads[2], pads[3]);
+            param->pads           = {pad_w, pad_w, pad_h, pad_h};
+            if (pads != param->pads) {
+                InsertPadLayer(net_structure, {pads[0] - pad_w, pads[1] - pad_w, pads[2] - pad_h, pads[3] - pad_h});
+            }
+        }
+    } else {
+        LOGE("Onnx Conv do not support auto_pad %s\n", auto_pad.c_str());
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+
+    // weight
+    auto layer_resource  = new TNN_NS::ConvLayerResource;
+    layer_resource->name = cur_layer->name;
+    TNN_NS::RawBuffer filter_handle(weight.size() * sizeof(float));
+    ::memcpy(filter_handle.force_to<float*>(), weight.data(), weight.size() * sizeof(float));
+    layer_resource->filter_handle = filter_handle;
+    // bias
+    if (input_size == 3 && !node.input(2).empty()) {
+        auto bias_tensor = context.GetConstant(node.input(2));
+        std::vector<float> bias;
+        if (bias_tensor == nullptr || !GetTensorFloats(*bias_tensor, bias) || bias.size() != co) {
+            LOGE("Onnx Conv only support constant float bias\n");
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        param->bias = 1;
+        TNN_NS::RawBuffer bias_handle(co * sizeof(float));
+        ::memcpy(bias_handle.force_to<float*>(), bias.data(), co * sizeof(float));
+        layer_resource->bias_handle = bias_handle;
+    }
+    net_resource.resource_map[cur_layer->name] = std::shared_ptr<TNN_NS::LayerResource>(layer_resource);
+    cur_layer->inputs.resize(1);
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Conv, Conv);
+
+}  // namespace TNN_CONVERTER
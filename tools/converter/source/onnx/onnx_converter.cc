@@ -0,0 +1,468 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "onnx_converter.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl.h>
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+
+#include "onnx_utils.h"
+#include "tnn/core/macro.h"
+#include "utils/shape_inference.h"
+
+namespace TNN_CONVERTER {
+
+Onnx2Tnn::Onnx2Tnn(std::string model_path) {
+    onnx_model_path_ = model_path;
+}
+
+// @brief the elements of a constant tensor, integer tensors are computed as integers
+struct ConstantValues {
+    std::vector<int64_t> dims;
+    std::vector<double> values;
+    bool is_float = true;
+};
+
+static bool GetConstantValues(const onnx::TensorProto* tensor, ConstantValues& constant) {
+    if (tensor == nullptr) {
+        return false;
+    }
+    constant.dims.assign(tensor->dims().begin(), tensor->dims().end());
+    constant.is_float =
+        tensor->data_type() == onnx::TensorProto::FLOAT || tensor->data_type() == onnx::TensorProto::DOUBLE;
+    if (constant.is_float) {
+        std::vector<float> values;
+        if (!GetTensorFloats(*tensor, values)) {
+            return false;
+        }
+        constant.values.assign(values.begin(), values.end());
+    } else {
+        std::vector<int64_t> values;
+        if (!GetTensorInts(*tensor, values)) {
+            return false;
+        }
+        constant.values.assign(values.begin(), values.end());
+    }
+    return true;
+}
+
+static onnx::TensorProto MakeTensor(const ConstantValues& constant) {
+    if (constant.is_float) {
+        return MakeFloatTensor(constant.dims, std::vector<float>(constant.values.begin(), constant.values.end()));
+    }
+    return MakeIntTensor(constant.dims, std::vector<int64_t>(constant.values.begin(), constant.values.end()));
+}
+
+// the axes of Unsqueeze, Squeeze and Slice are attributes before opset 13 and inputs since
+static std::vector<int64_t> GetAxes(const onnx::NodeProto& node, const OnnxGraphContext& context, int input_index) {
+    if (node.input_size() > input_index && !node.input(input_index).empty()) {
+        std::vector<int64_t> axes;
+        auto tensor = context.GetConstant(node.input(input_index));
+        if (tensor != nullptr) {
+            GetTensorInts(*tensor, axes);
+        }
+        return axes;
+    }
+    return GetAttributeInts(node, "axes");
+}
+
+static bool FoldBinary(const std::string& op_type, const ConstantValues& a, const ConstantValues& b,
+                       ConstantValues& result) {
+    const int count_a = a.values.size();
+    const int count_b = b.values.size();
+    if (count_a != count_b && count_a != 1 && count_b != 1) {
+        return false;
+    }
+    result.is_float = a.is_float || b.is_float;
+    result.dims     = count_a >= count_b ? a.dims : b.dims;
+    result.values.resize(std::max(count_a, count_b));
+    for (int i = 0; i < result.values.size(); ++i) {
+        const double x = a.values[count_a == 1 ? 0 : i];
+        const double y = b.values[count_b == 1 ? 0 : i];
+        if (op_type == "Add") {
+            result.values[i] = x + y;
+        } else if (op_type == "Sub") {
+            result.values[i] = x - y;
+        } else if (op_type == "Mul") {
+            result.values[i] = x * y;
+        } else {
+            if (y == 0) {
+                return false;
+            }
+            result.values[i] = result.is_float ? x / y : static_cast<double>(static_cast<int64_t>(x / y));
+        }
+    }
+    return true;
+}
+
+static bool FoldSlice(const onnx::NodeProto& node, const OnnxGraphContext& context, const ConstantValues& data,
+                      ConstantValues& result) {
+    std::vector<int64_t> starts, ends, steps;
+    if (node.input_size() > 2) {
+        auto starts_tensor = context.GetConstant(node.input(1));
+        auto ends_tensor   = context.GetConstant(node.input(2));
+        if (starts_tensor == nullptr || ends_tensor == nullptr || !GetTensorInts(*starts_tensor, starts) ||
+            !GetTensorInts(*ends_tensor, ends)) {
+            return false;
+        }
+        if (node.input_size() > 4 && !node.input(4).empty()) {
+            auto steps_tensor = context.GetConstant(node.input(4));
+            if (steps_tensor == nullptr || !GetTensorInts(*steps_tensor, steps)) {
+                return false;
+            }
+        }
+    } else {
+        starts = GetAttributeInts(node, "starts");
+        ends   = GetAttributeInts(node, "ends");
+    }
+    // only the slices of the 1-d tensors of the shape computations are folded
+    const int64_t size = data.values.size();
+    if (data.dims.size() != 1 || starts.size() != 1 || ends.size() != 1) {
+        return false;
+    }
+    const auto axes = GetAxes(node, context, 3);
+    if (!axes.empty() && !(axes.size() == 1 && ConvertAxisFormatOnnx(axes[0], 1) == 0)) {
+        return false;
+    }
+    const int64_t step = steps.empty() ? 1 : steps[0];
+    if (step == 0) {
+        return false;
+    }
+    int64_t start = starts[0] < 0 ? starts[0] + size : starts[0];
+    int64_t end   = ends[0] < 0 ? ends[0] + size : ends[0];
+    if (step > 0) {
+        start = std::min(std::max<int64_t>(start, 0), size);
+        end   = std::min(std::max<int64_t>(end, 0), size);
+    } else {
+        start = std::min(std::max<int64_t>(start, -1), size - 1);
+        end   = std::min(std::max<int64_t>(end, -1), size - 1);
+    }
+    result.is_float = data.is_float;
+    result.values.clear();
+    for (int64_t i = start; step > 0 ? i < end : i > end; i += step) {
+        result.values.push_back(data.values[i]);
+    }
+    result.dims = {static_cast<int64_t>(result.values.size())};
+    return true;
+}
+
+bool Onnx2Tnn::FoldConstantNode(TNN_NS::NetStructure& net_structure, const onnx::NodeProto& node) {
+    const auto& op_type = node.op_type();
+    if (node.output_size() != 1) {
+        return false;
+    }
+    if (op_type == "Constant") {
+        auto attribute = GetAttribute(node, "value");
+        if (attribute != nullptr && attribute->has_t()) {
+            AddConstant(node.output(0), attribute->t());
+            return true;
+        }
+        attribute = GetAttribute(node, "value_float");
+        if (attribute != nullptr) {
+            AddConstant(node.output(0), MakeFloatTensor({}, {attribute->f()}));
+            return true;
+        }
+        attribute = GetAttribute(node, "value_floats");
+        if (attribute != nullptr) {
+            std::vector<float> values(attribute->floats().begin(), attribute->floats().end());
+            AddConstant(node.output(0), MakeFloatTensor({static_cast<int64_t>(values.size())}, values));
+            return true;
+        }
+        attribute = GetAttribute(node, "value_int");
+        if (attribute != nullptr) {
+            AddConstant(node.output(0), MakeIntTensor({}, {attribute->i()}));
+            return true;
+        }
+        attribute = GetAttribute(node, "value_ints");
+        if (attribute != nullptr) {
+            std::vector<int64_t> values(attribute->ints().begin(), attribute->ints().end());
+            AddConstant(node.output(0), MakeIntTensor({static_cast<int64_t>(values.size())}, values));
+            return true;
+        }
+        return false;
+    }
+    if (op_type == "Shape") {
+        // the shapes are static, the shape of a computed tensor is known once its producer is converted
+        std::vector<int64_t> dims;
+        auto tensor = context_.GetConstant(node.input(0));
+        if (tensor != nullptr) {
+            dims.assign(tensor->dims().begin(), tensor->dims().end());
+        } else {
+            const int rank = context_.GetRank(node.input(0));
+            auto iter      = net_structure.blobs_shape_map.find(node.input(0));
+            if (rank < 0 || iter == net_structure.blobs_shape_map.end()) {
+                return false;
+            }
+            dims.assign(iter->second.begin(), iter->second.begin() + rank);
+        }
+        AddConstant(node.output(0), MakeIntTensor({static_cast<int64_t>(dims.size())}, dims));
+        return true;
+    }
+
+    // the other nodes are folded if all their inputs are constants
+    std::vector<ConstantValues> inputs(node.input_size());
+    for (int i = 0; i < node.input_size(); ++i) {
+        if (!node.input(i).empty() && !GetConstantValues(context_.GetConstant(node.input(i)), inputs[i])) {
+            return false;
+        }
+    }
+    if (inputs.empty()) {
+        return false;
+    }
+    ConstantValues result = inputs[0];
+    if (op_type == "Identity") {
+    } else if (op_type == "Cast") {
+        const int64_t to = GetAttributeInt(node, "to", onnx::TensorProto::FLOAT);
+        if (to == onnx::TensorProto::FLOAT || to == onnx::TensorProto::DOUBLE) {
+            result.is_float = true;
+        } else if (to == onnx::TensorProto::INT32 || to == onnx::TensorProto::INT64) {
+            result.is_float = false;
+            for (auto& value : result.values) {
+                value = static_cast<double>(static_cast<int64_t>(value));
+            }
+        } else {
+            return false;
+        }
+    } else if (op_type == "Add" || op_type == "Sub" || op_type == "Mul" || op_type == "Div") {
+        if (inputs.size() != 2 || !FoldBinary(op_type, inputs[0], inputs[1], result)) {
+            return false;
+        }
+    } else if (op_type == "Unsqueeze") {
+        auto axes = GetAxes(node, context_, 1);
+        const int rank = result.dims.size() + axes.size();
+        for (auto& axis : axes) {
+            axis = ConvertAxisFormatOnnx(axis, rank);
+        }
+        std::sort(axes.begin(), axes.end());
+        for (const auto axis : axes) {
+            if (axis < 0 || axis > result.dims.size()) {
+                return false;
+            }
+            result.dims.insert(result.dims.begin() + axis, 1);
+        }
+    } else if (op_type == "Squeeze") {
+        auto axes = GetAxes(node, context_, 1);
+        std::vector<int64_t> dims;
+        for (int i = 0; i < result.dims.size(); ++i) {
+            bool squeezed = axes.empty() && result.dims[i] == 1;
+            for (const auto axis : axes) {
+                squeezed = squeezed || ConvertAxisFormatOnnx(axis, result.dims.size()) == i;
+            }
+            if (!squeezed) {
+                dims.push_back(result.dims[i]);
+            }
+        }
+        result.dims = dims;
+    } else if (op_type == "Gather") {
+        // gathering the elements of a 1-d tensor
+        if (inputs.size() != 2 || result.dims.size() != 1 || GetAttributeInt(node, "axis", 0) != 0) {
+            return false;
+        }
+        const auto& indices = inputs[1];
+        result.dims         = indices.dims;
+        result.values.clear();
+        for (const auto index : indices.values) {
+            const int64_t position = index < 0 ? index + inputs[0].dims[0] : index;
+            if (position < 0 || position >= inputs[0].values.size()) {
+                return false;
+            }
+            result.values.push_back(inputs[0].values[position]);
+        }
+    } else if (op_type == "Concat") {
+        // concatenating 1-d tensors
+        result.values.clear();
+        for (const auto& input : inputs) {
+            if (input.dims.size() != 1) {
+                return false;
+            }
+            result.is_float = result.is_float && input.is_float;
+            result.values.insert(result.values.end(), input.values.begin(), input.values.end());
+        }
+        result.dims = {static_cast<int64_t>(result.values.size())};
+    } else if (op_type == "Slice") {
+        if (!FoldSlice(node, context_, inputs[0], result)) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    AddConstant(node.output(0), MakeTensor(result));
+    return true;
+}
+
+void Onnx2Tnn::AddConstant(const std::string& name, onnx::TensorProto tensor) {
+    folded_constants_.push_back(std::move(tensor));
+    context_.constants[name] = &folded_constants_.back();
+}
+
+std::string Onnx2Tnn::ResolveName(const std::string& name) {
+    auto iter = forwarded_names_.find(name);
+    return iter == forwarded_names_.end() ? name : iter->second;
+}
+
+TNN_NS::Status Onnx2Tnn::ConvertInputs(TNN_NS::NetStructure& net_structure) {
+    const auto& graph = onnx_model_->graph();
+    for (const auto& input : graph.input()) {
+        const auto& name = input.name();
+        // before ir version 4 the initializers are listed as the inputs too
+        if (context_.GetConstant(name) != nullptr) {
+            continue;
+        }
+        // dynamic dims are converted to 1, the shapes of the converted model are static
+        std::vector<int64_t> onnx_dims;
+        for (const auto& dim : input.type().tensor_type().shape().dim()) {
+            onnx_dims.push_back(dim.has_dim_value() && dim.dim_value() > 0 ? dim.dim_value() : 1);
+        }
+        TNN_NS::DimsVector dims;
+        if (!ConvertShapeFormatOnnx(onnx_dims, dims)) {
+            LOGE("The OnnxConverter do not support input %s of rank %d\n", name.c_str(), (int)onnx_dims.size());
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        if (net_structure.inputs_shape_map.find(name) != net_structure.inputs_shape_map.end()) {
+            LOGE("The model conflict between same input names %s\n", name.c_str());
+            return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+        }
+        net_structure.inputs_shape_map[name] = dims;
+        net_structure.blobs_shape_map[name]  = dims;
+        context_.ranks[name]                 = onnx_dims.size();
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+TNN_NS::Status Onnx2Tnn::Convert2Tnn(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource) {
+    auto status = ReadModel(onnx_model_path_);
+    if (status != TNN_NS::TNN_CONVERT_OK) {
+        return status;
+    }
+    const auto& graph = onnx_model_->graph();
+    for (const auto& opset : onnx_model_->opset_import()) {
+        if (opset.domain().empty() || opset.domain() == "ai.onnx") {
+            context_.opset_version = opset.version();
+        }
+    }
+
+    // set const
+    for (const auto& initializer : graph.initializer()) {
+        if (initializer.has_data_location() && initializer.data_location() == onnx::TensorProto::EXTERNAL) {
+            LOGE("Onnx converter does not support the external data of initializer %s\n", initializer.name().c_str());
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        context_.constants[initializer.name()] = &initializer;
+    }
+
+    // set input
+    status = ConvertInputs(net_structure);
+    if (status != TNN_NS::TNN_CONVERT_OK) {
+        return status;
+    }
+
+    // convert layer
+    auto& layers = net_structure.layers;
+    for (int i = 0; i < graph.node_size(); ++i) {
+        onnx::NodeProto node = graph.node(i);
+        for (int j = 0; j < node.input_size(); ++j) {
+            node.set_input(j, ResolveName(node.input(j)));
+        }
+        if (FoldConstantNode(net_structure, node)) {
+            continue;
+        }
+        if (node.op_type() == "Identity" || node.op_type() == "Dropout") {
+            forwarded_names_[node.output(0)] = node.input(0);
+            continue;
+        }
+        auto converter = OnnxOpConverterManager::get()->search(node.op_type());
+        if (converter == nullptr) {
+            LOGE("The OnnxConverter do not support layer:%s\n", node.output(0).c_str());
+            LOGE("The unsupported operator type is:%s\n", node.op_type().c_str());
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        auto cur_layer = std::make_shared<TNN_NS::LayerInfo>();
+        // the layer is named after the first output of the node
+        cur_layer->name              = node.output(0);
+        std::string type_name        = converter->TNNOpType(node, context_);
+        TNN_NS::LayerType layer_type = TNN_NS::GlobalConvertLayerType(type_name);
+        cur_layer->type              = layer_type;
+        cur_layer->type_str          = type_name;
+        for (const auto& input : node.input()) {
+            if (!input.empty()) {
+                cur_layer->inputs.push_back(input);
+            }
+        }
+        for (const auto& output : node.output()) {
+            if (!output.empty()) {
+                cur_layer->outputs.push_back(output);
+            }
+        }
+        const int first_layer = layers.size();
+        layers.push_back(cur_layer);
+        status = converter->exec(net_structure, net_resource, node, context_);
+        if (status != TNN_NS::TNN_CONVERT_OK) {
+            LOGE("Onnx converter %s failed!\n", node.op_type().c_str());
+            return status;
+        }
+
+        // the shapes are inferred while converting, the converters and the folding of the following nodes use them
+        for (int j = first_layer; j < layers.size(); ++j) {
+            status = InferLayerShapes(net_structure, net_resource, layers[j]);
+            if (status != TNN_NS::TNN_CONVERT_OK) {
+                return status;
+            }
+        }
+        const int rank = converter->OutputRank(node, context_);
+        for (const auto& output : node.output()) {
+            context_.ranks[output] = rank;
+        }
+    }
+
+    // set output
+    auto& outputs = net_structure.outputs;
+    for (const auto& output : graph.output()) {
+        const auto name = ResolveName(output.name());
+        if (context_.GetConstant(name) != nullptr) {
+            LOGE("The OnnxConverter do not support constant output %s\n", name.c_str());
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        if (outputs.find(name) != outputs.end()) {
+            LOGE("The model conflict between same output names %s\n", name.c_str());
+            return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+        }
+        outputs.insert(name);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+TNN_NS::Status Onnx2Tnn::ReadModel(std::string onnx_model_path) {
+    std::ifstream input_file(onnx_model_path, std::ios::binary);
+    if (!input_file.is_open()) {
+        LOGE("Onnx converter can not open %s\n", onnx_model_path.c_str());
+        return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+    }
+    // the default limit of protobuf rejects large models
+    google::protobuf::io::IstreamInputStream input_stream(&input_file);
+    google::protobuf::io::CodedInputStream coded_stream(&input_stream);
+    coded_stream.SetTotalBytesLimit(INT_MAX);
+
+    onnx_model_.reset(new onnx::ModelProto);
+    if (!onnx_model_->ParseFromCodedStream(&coded_stream)) {
+        LOGE("Onnx converter can not parse %s\n", onnx_model_path.c_str());
+        return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,54 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_CONVERTER_H_
+#define TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_CONVERTER_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "onnx.pb.h"
+#include "onnx_op_converter.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+
+namespace TNN_CONVERTER {
+class Onnx2Tnn {
+public:
+    Onnx2Tnn(std::string model_path);
+    ~Onnx2Tnn(){};
+    TNN_NS::Status Convert2Tnn(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource);
+
+private:
+    TNN_NS::Status ReadModel(std::string onnx_model_path);
+    TNN_NS::Status ConvertInputs(TNN_NS::NetStructure& net_structure);
+    // @brief evaluate the node at conversion time if all its inputs are constants or static shapes
+    bool FoldConstantNode(TNN_NS::NetStructure& net_structure, const onnx::NodeProto& node);
+    void AddConstant(const std::string& name, onnx::TensorProto tensor);
+    // @brief the name of the tensor computing the input, nodes forwarding their input are removed
+    std::string ResolveName(const std::string& name);
+
+    std::string onnx_model_path_;
+    std::unique_ptr<onnx::ModelProto> onnx_model_;
+    OnnxGraphContext context_;
+    // tensors computed by the folded constant nodes
+    std::list<onnx::TensorProto> folded_constants_;
+    std::map<std::string, std::string> forwarded_names_;
+};
+};  // namespace TNN_CONVERTER
+
+#endif  // TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_CONVERTER_H_
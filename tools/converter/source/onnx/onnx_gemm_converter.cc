@@ -0,0 +1,103 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include <cstring>
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Gemm);
+
+std::string OnnxGemmConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "InnerProduct";
+}
+
+int OnnxGemmConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return 2;
+}
+
+// Gemm and MatMul of a 2-d input by constant weights
+TNN_NS::Status OnnxGemmConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                       const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param       = new TNN_NS::InnerProductLayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->name      = cur_layer->name;
+    param->type      = cur_layer->type_str;
+    param->quantized = false;
+
+    const bool is_gemm = node.op_type() == "Gemm";
+    const float alpha  = is_gemm ? GetAttributeFloat(node, "alpha", 1.0f) : 1.0f;
+    const float beta   = is_gemm ? GetAttributeFloat(node, "beta", 1.0f) : 1.0f;
+    const bool trans_a = is_gemm && GetAttributeInt(node, "transA", 0) != 0;
+    const bool trans_b = is_gemm && GetAttributeInt(node, "transB", 0) != 0;
+    auto weight_tensor = node.input_size() > 1 ? context.GetConstant(node.input(1)) : nullptr;
+    std::vector<float> weight;
+    if (trans_a || context.GetRank(node.input(0)) != 2 || weight_tensor == nullptr ||
+        weight_tensor->dims_size() != 2 || !GetTensorFloats(*weight_tensor, weight)) {
+        LOGE("Onnx %s only support a 2d input multiplied by constant float weights\n", node.op_type().c_str());
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    // the weights of inner product are [num_output, k]
+    const int k          = trans_b ? weight_tensor->dims(1) : weight_tensor->dims(0);
+    const int num_output = trans_b ? weight_tensor->dims(0) : weight_tensor->dims(1);
+    const auto& dims     = net_structure.blobs_shape_map[node.input(0)];
+    if (dims.size() != 4 || dims[1] * dims[2] * dims[3] != k) {
+        LOGE("Onnx %s input does not match its weights\n", node.op_type().c_str());
+        return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+    }
+    param->num_output = num_output;
+    param->axis       = 1;
+    param->transpose  = 0;
+
+    auto layer_resource  = new TNN_NS::InnerProductLayerResource;
+    layer_resource->name = cur_layer->name;
+    TNN_NS::RawBuffer weight_handle(num_output * k * sizeof(float));
+    auto weight_data = weight_handle.force_to<float*>();
+    for (int o = 0; o < num_output; ++o) {
+        for (int i = 0; i < k; ++i) {
+            weight_data[o * k + i] = alpha * (trans_b ? weight[o * k + i] : weight[i * num_output + o]);
+        }
+    }
+    layer_resource->weight_handle = weight_handle;
+
+    // the bias broadcasts along the rows of the output
+    if (is_gemm && node.input_size() > 2 && !node.input(2).empty()) {
+        auto bias_tensor = context.GetConstant(node.input(2));
+        std::vector<float> bias;
+        if (bias_tensor == nullptr || !GetTensorFloats(*bias_tensor, bias) ||
+            (bias.size() != 1 && bias.size() != num_output)) {
+            LOGE("Onnx Gemm only support constant float bias of the output channels\n");
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        TNN_NS::RawBuffer bias_handle(num_output * sizeof(float));
+        auto bias_data = bias_handle.force_to<float*>();
+        for (int o = 0; o < num_output; ++o) {
+            bias_data[o] = beta * bias[bias.size() == 1 ? 0 : o];
+        }
+        layer_resource->bias_handle = bias_handle;
+        param->has_bias             = 1;
+    }
+    net_resource.resource_map[cur_layer->name] = std::shared_ptr<TNN_NS::LayerResource>(layer_resource);
+    cur_layer->inputs.resize(1);
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Gemm, Gemm);
+REGISTER_ONNX_CONVERTER(Gemm, MatMul);
+
+}  // namespace TNN_CONVERTER
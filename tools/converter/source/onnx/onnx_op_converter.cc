@@ -0,0 +1,63 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "onnx_op_converter.h"
+
+namespace TNN_CONVERTER {
+
+const onnx::TensorProto* OnnxGraphContext::GetConstant(const std::string& name) const {
+    auto iter = constants.find(name);
+    if (iter == constants.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+int OnnxGraphContext::GetRank(const std::string& name) const {
+    auto iter = ranks.find(name);
+    if (iter == ranks.end()) {
+        return -1;
+    }
+    return iter->second;
+}
+
+OnnxOpConverterManager* OnnxOpConverterManager::onnx_op_converter_manager_ = nullptr;
+
+OnnxOpConverterManager* OnnxOpConverterManager::get() {
+    if (onnx_op_converter_manager_ == nullptr) {
+        onnx_op_converter_manager_ = new OnnxOpConverterManager;
+    }
+    return onnx_op_converter_manager_;
+}
+
+OnnxOpConverter* OnnxOpConverterManager::search(const std::string& op_type) {
+    auto iter = onnx_op_converter_map_.find(op_type);
+    if (iter == onnx_op_converter_map_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+OnnxOpConverterManager::~OnnxOpConverterManager() {
+    for (auto& it : onnx_op_converter_map_) {
+        delete it.second;
+    }
+    onnx_op_converter_map_.clear();
+}
+
+void OnnxOpConverterManager::insert(const std::string& op_type, OnnxOpConverter* t) {
+    onnx_op_converter_map_.insert(std::make_pair(op_type, t));
+}
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,94 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_OP_CONVERTER_H_
+#define TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_OP_CONVERTER_H_
+
+#include <map>
+#include <string>
+
+#include "onnx.pb.h"
+#include "tnn/interpreter/net_resource.h"
+#include "tnn/interpreter/net_structure.h"
+
+namespace TNN_CONVERTER {
+
+// @brief the onnx tensors known when a node is converted
+struct OnnxGraphContext {
+    // the initializers and the outputs of the folded constant nodes
+    std::map<std::string, const onnx::TensorProto*> constants;
+    // rank of the onnx tensors, their tnn blobs are padded to 4 dims
+    std::map<std::string, int> ranks;
+    // version of the default onnx operator set of the model
+    int opset_version = 1;
+
+    // @brief the constant tensor of the name, nullptr if it is computed at runtime
+    const onnx::TensorProto* GetConstant(const std::string& name) const;
+    // @brief the onnx rank of the tensor, -1 if unknown
+    int GetRank(const std::string& name) const;
+};
+
+class OnnxOpConverter {
+public:
+    OnnxOpConverter()          = default;
+    virtual ~OnnxOpConverter() = default;
+
+    // the layer of the node is the last layer of the net structure, its inputs and outputs are those of the node
+    virtual TNN_NS::Status exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                const onnx::NodeProto& node, const OnnxGraphContext& context) = 0;
+    virtual std::string TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) = 0;
+    // @brief the onnx rank of the first output of the node
+    virtual int OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) = 0;
+};
+
+class OnnxOpConverterManager {
+public:
+    static OnnxOpConverterManager* get();
+    void insert(const std::string& op_type, OnnxOpConverter* onnx_op_converter);
+    OnnxOpConverter* search(const std::string& op_type);
+    OnnxOpConverterManager(){};
+    ~OnnxOpConverterManager();
+
+private:
+    static OnnxOpConverterManager* onnx_op_converter_manager_;
+    std::map<std::string, OnnxOpConverter*> onnx_op_converter_map_;
+};
+
+template <class T>
+class OnnxOpConverterRegister {
+public:
+    explicit OnnxOpConverterRegister(const std::string& op_type) {
+        T* converter                                      = new T;
+        OnnxOpConverterManager* onnx_op_converter_manager = OnnxOpConverterManager::get();
+        onnx_op_converter_manager->insert(op_type, converter);
+    };
+    ~OnnxOpConverterRegister(){};
+};
+
+#define DECLARE_ONNX_OP_CONVERTER(onnx_type)                                                                           \
+    class Onnx##onnx_type##Converter : public OnnxOpConverter {                                                        \
+    public:                                                                                                            \
+        Onnx##onnx_type##Converter() {}                                                                                \
+        virtual ~Onnx##onnx_type##Converter() {}                                                                       \
+        virtual TNN_NS::Status exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,            \
+                                    const onnx::NodeProto& node, const OnnxGraphContext& context);                     \
+        virtual std::string TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context);                   \
+        virtual int OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context);                          \
+    }
+
+#define REGISTER_ONNX_CONVERTER(converter_suffix, onnx_type)                                                           \
+    OnnxOpConverterRegister<Onnx##converter_suffix##Converter> g_onnx_converter_##onnx_type##_(#onnx_type)
+}  // namespace TNN_CONVERTER
+
+#endif  // TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_OP_CONVERTER_H_
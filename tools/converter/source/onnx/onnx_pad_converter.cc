@@ -0,0 +1,80 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Pad);
+
+std::string OnnxPadConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "Pad";
+}
+
+int OnnxPadConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return context.GetRank(node.input(0));
+}
+
+TNN_NS::Status OnnxPadConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                      const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param                  = new TNN_NS::PadLayerParam;
+    auto cur_layer              = net_structure.layers.back();
+    cur_layer->param            = std::shared_ptr<TNN_NS::LayerParam>(param);
+    cur_layer->param->type      = cur_layer->type_str;
+    cur_layer->param->name      = cur_layer->name;
+    cur_layer->param->quantized = false;
+
+    // the pads and the value are attributes before opset 11 and inputs since
+    std::vector<int64_t> onnx_pads = GetAttributeInts(node, "pads");
+    float value                    = GetAttributeFloat(node, "value", 0.0f);
+    if (node.input_size() > 1) {
+        auto pads_tensor = context.GetConstant(node.input(1));
+        if (pads_tensor == nullptr || !GetTensorInts(*pads_tensor, onnx_pads)) {
+            LOGE("Onnx Pad only support constant pads\n");
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+    }
+    if (node.input_size() > 2 && !node.input(2).empty()) {
+        auto value_tensor = context.GetConstant(node.input(2));
+        std::vector<float> values;
+        if (value_tensor == nullptr || !GetTensorFloats(*value_tensor, values) || values.size() != 1) {
+            LOGE("Onnx Pad only support constant value\n");
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        value = values[0];
+    }
+    const auto mode = GetAttributeString(node, "mode", "constant");
+    // 0:const 1:reflect 2:edge, the tnn proto keeps zero padding values only
+    param->type = mode == "constant" ? 0 : mode == "reflect" ? 1 : mode == "edge" ? 2 : -1;
+    if (param->type == -1 || value != 0.0f) {
+        LOGE("Onnx Pad do not support mode %s with value %f\n", mode.c_str(), value);
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    // onnx pads [n_begin c_begin h_begin w_begin n_end c_end h_end w_end] of 4-d tensors
+    if (onnx_pads.size() != 8 || onnx_pads[0] != 0 || onnx_pads[4] != 0) {
+        LOGE("Onnx Pad only support padding the channels and the spatial dims of 4-d tensors\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    param->pads = {(int)onnx_pads[3], (int)onnx_pads[7], (int)onnx_pads[2],
+                   (int)onnx_pads[6], (int)onnx_pads[1], (int)onnx_pads[5]};
+    param->value = value;
+    cur_layer->inputs.resize(1);
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Pad, Pad);
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,95 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Pool);
+
+std::string OnnxPoolConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "Pooling";
+}
+
+int OnnxPoolConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return 4;
+}
+
+TNN_NS::Status OnnxPoolConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                       const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param       = new TNN_NS::PoolingLayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->name      = cur_layer->name;
+    param->type      = cur_layer->type_str;
+    param->quantized = false;
+
+    const auto& op_type = node.op_type();
+    // pool_type 0: MaxPool, 1: AveragePool
+    param->pool_type     = op_type == "MaxPool" || op_type == "GlobalMaxPool" ? 0 : 1;
+    param->pad_type      = -1;
+    param->kernel_indexs = {-1, -1};
+    if (op_type == "GlobalAveragePool" || op_type == "GlobalMaxPool") {
+        // kernels of 0 pool the whole input
+        param->kernels   = {0, 0};
+        param->strides   = {1, 1};
+        param->pads      = {0, 0, 0, 0};
+        param->ceil_mode = 0;
+    } else {
+        auto kernels = GetAttributeInts(node, "kernel_shape");
+        if (kernels.size() != 2 || cur_layer->outputs.size() != 1) {
+            LOGE("Onnx %s only support 2d pooling\n", op_type.c_str());
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+        auto strides     = GetAttributeInts(node, "strides");
+        param->kernels   = {(int)kernels[1], (int)kernels[0]};
+        param->strides   = strides.size() == 2 ? std::vector<int>{(int)strides[1], (int)strides[0]}
+                                               : std::vector<int>{1, 1};
+        param->ceil_mode = GetAttributeInt(node, "ceil_mode", 0);
+        param->pads      = {0, 0, 0, 0};
+
+        const auto auto_pad = GetAttributeString(node, "auto_pad", "NOTSET");
+        // onnx pads [h_begin w_begin h_end w_end], the tnn proto keeps symmetric pooling pads only
+        auto onnx_pads = GetAttributeInts(node, "pads");
+        if (auto_pad == "SAME_UPPER") {
+            param->pad_type = 0;
+        } else if (auto_pad == "NOTSET" && onnx_pads.size() == 4) {
+            if (onnx_pads[0] != onnx_pads[2] || onnx_pads[1] != onnx_pads[3]) {
+                LOGE("Onnx %s do not support asymmetric pads\n", op_type.c_str());
+                return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+            }
+            param->pads = {(int)onnx_pads[1], (int)onnx_pads[3], (int)onnx_pads[0], (int)onnx_pads[2]};
+            // the average of tnn excludes the pads
+            if (param->pool_type == 1 && GetAttributeInt(node, "count_include_pad", 0) != 0 &&
+                (onnx_pads[0] != 0 || onnx_pads[1] != 0)) {
+                LOGE("Onnx %s do not support count_include_pad\n", op_type.c_str());
+                return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+            }
+        } else if (auto_pad != "NOTSET" && auto_pad != "VALID") {
+            LOGE("Onnx %s do not support auto_pad %s\n", op_type.c_str(), auto_pad.c_str());
+            return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+        }
+    }
+    param->kernels_params = param->kernels;
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Pool, MaxPool);
+REGISTER_ONNX_CONVERTER(Pool, AveragePool);
+REGISTER_ONNX_CONVERTER(Pool, GlobalAveragePool);
+REGISTER_ONNX_CONVERTER(Pool, GlobalMaxPool);
+
+}  // namespace TNN_CONVERTER
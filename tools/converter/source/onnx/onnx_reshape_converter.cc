@@ -0,0 +1,100 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Reshape);
+
+DECLARE_ONNX_OP_CONVERTER(Flatten);
+
+// the shape is an input since opset 5
+static bool GetReshapeShape(const onnx::NodeProto& node, const OnnxGraphContext& context, std::vector<int64_t>& shape) {
+    if (node.input_size() < 2) {
+        shape = GetAttributeInts(node, "shape");
+        return !shape.empty();
+    }
+    auto tensor = context.GetConstant(node.input(1));
+    return tensor != nullptr && GetTensorInts(*tensor, shape);
+}
+
+static void CreateReshapeParam(const std::shared_ptr<TNN_NS::LayerInfo>& cur_layer, const std::vector<int>& shape) {
+    auto param          = new TNN_NS::ReshapeLayerParam;
+    cur_layer->param    = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->name         = cur_layer->name;
+    param->type         = cur_layer->type_str;
+    param->quantized    = false;
+    param->reshape_type = 0;
+    param->axis         = 0;
+    param->num_axes     = shape.size();
+    param->shape        = shape;
+    cur_layer->inputs.resize(1);
+}
+
+std::string OnnxReshapeConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "Reshape";
+}
+
+int OnnxReshapeConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    std::vector<int64_t> shape;
+    GetReshapeShape(node, context, shape);
+    return shape.size();
+}
+
+TNN_NS::Status OnnxReshapeConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                          const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    std::vector<int64_t> onnx_shape;
+    TNN_NS::DimsVector shape;
+    if (!GetReshapeShape(node, context, onnx_shape) || !ConvertShapeFormatOnnx(onnx_shape, shape)) {
+        LOGE("Onnx Reshape only support constant shapes of rank 4 at most\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    // 0 copies the input dim and -1 is inferred as in onnx, the padded trailing dims are 1
+    CreateReshapeParam(net_structure.layers.back(), shape);
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+std::string OnnxFlattenConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "Reshape";
+}
+
+int OnnxFlattenConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return 2;
+}
+
+TNN_NS::Status OnnxFlattenConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                          const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    const int rank   = context.GetRank(node.input(0));
+    const int axis   = ConvertAxisFormatOnnx(GetAttributeInt(node, "axis", 1), rank);
+    const auto& dims = net_structure.blobs_shape_map[node.input(0)];
+    if (axis < 0 || axis > rank || dims.size() != 4) {
+        LOGE("Onnx Flatten has invalid axis\n");
+        return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+    }
+    // the output is [outer, -1, 1, 1], the batch is kept if it is the outer dim
+    int outer = 1;
+    for (int i = 0; i < axis; ++i) {
+        outer *= dims[i];
+    }
+    CreateReshapeParam(net_structure.layers.back(), {axis == 1 ? 0 : outer, -1, 1, 1});
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Reshape, Reshape);
+REGISTER_ONNX_CONVERTER(Flatten, Flatten);
+
+}  // namespace TNN_CONVERTER
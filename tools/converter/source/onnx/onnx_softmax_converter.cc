@@ -0,0 +1,61 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Softmax);
+
+std::string OnnxSoftmaxConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "Softmax";
+}
+
+int OnnxSoftmaxConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return context.GetRank(node.input(0));
+}
+
+TNN_NS::Status OnnxSoftmaxConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                          const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param       = new TNN_NS::SoftmaxLayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->name      = cur_layer->name;
+    param->type      = cur_layer->type_str;
+    param->quantized = false;
+
+    const int rank   = context.GetRank(node.input(0));
+    const auto& dims = net_structure.blobs_shape_map[node.input(0)];
+    param->axis      = ConvertAxisFormatOnnx(GetAttributeInt(node, "axis", context.opset_version < 13 ? 1 : -1), rank);
+    if (param->axis < 0 || param->axis >= rank || dims.size() != 4) {
+        LOGE("Onnx Softmax has invalid axis\n");
+        return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+    }
+    // before opset 13 the softmax is computed over all the dims from the axis, the tnn softmax over the axis only
+    if (context.opset_version < 13) {
+        for (int i = param->axis + 1; i < dims.size(); ++i) {
+            if (dims[i] != 1) {
+                LOGE("Onnx Softmax do not support the coerced dims of opset %d\n", context.opset_version);
+                return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+            }
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Softmax, Softmax);
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,60 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "onnx_op_converter.h"
+#include "onnx_utils.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Transpose);
+
+std::string OnnxTransposeConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return "Permute";
+}
+
+int OnnxTransposeConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return context.GetRank(node.input(0));
+}
+
+TNN_NS::Status OnnxTransposeConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                            const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param       = new TNN_NS::PermuteLayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->name      = cur_layer->name;
+    param->type      = cur_layer->type_str;
+    param->quantized = false;
+
+    const int rank = context.GetRank(node.input(0));
+    auto perm      = GetAttributeInts(node, "perm");
+    // the default permutation reverses the dims
+    for (int i = perm.empty() ? 0 : rank; i < rank; ++i) {
+        perm.push_back(rank - 1 - i);
+    }
+    if (rank < 0 || rank > 4 || perm.size() != rank) {
+        LOGE("Onnx Transpose only support tensors of rank 4 at most\n");
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    // the trailing dims padded to the tnn blob stay in place
+    param->orders.assign(perm.begin(), perm.end());
+    for (int i = rank; i < 4; ++i) {
+        param->orders.push_back(i);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Transpose, Transpose);
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,63 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "onnx_op_converter.h"
+
+namespace TNN_CONVERTER {
+
+DECLARE_ONNX_OP_CONVERTER(Unary);
+
+std::string OnnxUnaryConverter::TNNOpType(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    static const std::map<std::string, std::string> tnn_op_types = {
+        {"Relu", "ReLU"}, {"Sigmoid", "Sigmoid"}, {"Tanh", "Tanh"}, {"Exp", "Exp"},     {"Log", "Log"},
+        {"Abs", "Abs"},   {"Neg", "Neg"},         {"Sqrt", "Sqrt"}, {"Floor", "Floor"}, {"Ceil", "Ceil"},
+        {"Sin", "Sin"},   {"Cos", "Cos"},
+    };
+    auto iter = tnn_op_types.find(node.op_type());
+    if (iter == tnn_op_types.end()) {
+        return "";
+    }
+    return iter->second;
+}
+
+int OnnxUnaryConverter::OutputRank(const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    return context.GetRank(node.input(0));
+}
+
+TNN_NS::Status OnnxUnaryConverter::exec(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                        const onnx::NodeProto& node, const OnnxGraphContext& context) {
+    auto param       = new TNN_NS::LayerParam;
+    auto cur_layer   = net_structure.layers.back();
+    cur_layer->param = std::shared_ptr<TNN_NS::LayerParam>(param);
+    param->type      = cur_layer->type_str;
+    param->name      = cur_layer->name;
+    param->quantized = false;
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_ONNX_CONVERTER(Unary, Relu);
+REGISTER_ONNX_CONVERTER(Unary, Sigmoid);
+REGISTER_ONNX_CONVERTER(Unary, Tanh);
+REGISTER_ONNX_CONVERTER(Unary, Exp);
+REGISTER_ONNX_CONVERTER(Unary, Log);
+REGISTER_ONNX_CONVERTER(Unary, Abs);
+REGISTER_ONNX_CONVERTER(Unary, Neg);
+REGISTER_ONNX_CONVERTER(Unary, Sqrt);
+REGISTER_ONNX_CONVERTER(Unary, Floor);
+REGISTER_ONNX_CONVERTER(Unary, Ceil);
+REGISTER_ONNX_CONVERTER(Unary, Sin);
+REGISTER_ONNX_CONVERTER(Unary, Cos);
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,167 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "onnx_utils.h"
+
+#include <cstring>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_CONVERTER {
+
+template <typename T, typename U>
+static bool ReadRawData(const onnx::TensorProto& tensor, std::vector<U>& values) {
+    const std::string& raw_data = tensor.raw_data();
+    if (raw_data.size() % sizeof(T) != 0) {
+        return false;
+    }
+    const int count = raw_data.size() / sizeof(T);
+    values.resize(count);
+    for (int i = 0; i < count; ++i) {
+        T value;
+        memcpy(&value, raw_data.data() + i * sizeof(T), sizeof(T));
+        values[i] = static_cast<U>(value);
+    }
+    return true;
+}
+
+template <typename U>
+static bool ReadTensorData(const onnx::TensorProto& tensor, std::vector<U>& values) {
+    // the data of models over 2GB is stored in external files, it is not supported
+    if (tensor.has_data_location() && tensor.data_location() == onnx::TensorProto::EXTERNAL) {
+        LOGE("Onnx converter does not support the external data of tensor %s\n", tensor.name().c_str());
+        return false;
+    }
+    switch (tensor.data_type()) {
+        case onnx::TensorProto::FLOAT:
+            if (tensor.has_raw_data()) {
+                return ReadRawData<float>(tensor, values);
+            }
+            values.assign(tensor.float_data().begin(), tensor.float_data().end());
+            return true;
+        case onnx::TensorProto::DOUBLE:
+            if (tensor.has_raw_data()) {
+                return ReadRawData<double>(tensor, values);
+            }
+            values.assign(tensor.double_data().begin(), tensor.double_data().end());
+            return true;
+        case onnx::TensorProto::INT32:
+            if (tensor.has_raw_data()) {
+                return ReadRawData<int32_t>(tensor, values);
+            }
+            values.assign(tensor.int32_data().begin(), tensor.int32_data().end());
+            return true;
+        case onnx::TensorProto::INT64:
+            if (tensor.has_raw_data()) {
+                return ReadRawData<int64_t>(tensor, values);
+            }
+            values.assign(tensor.int64_data().begin(), tensor.int64_data().end());
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool GetTensorFloats(const onnx::TensorProto& tensor, std::vector<float>& values) {
+    if (!ReadTensorData(tensor, values)) {
+        return false;
+    }
+    return values.size() == GetTensorCount(tensor);
+}
+
+bool GetTensorInts(const onnx::TensorProto& tensor, std::vector<int64_t>& values) {
+    if (!ReadTensorData(tensor, values)) {
+        return false;
+    }
+    return values.size() == GetTensorCount(tensor);
+}
+
+int64_t GetTensorCount(const onnx::TensorProto& tensor) {
+    int64_t count = 1;
+    for (const auto dim : tensor.dims()) {
+        count *= dim;
+    }
+    return count;
+}
+
+onnx::TensorProto MakeFloatTensor(const std::vector<int64_t>& dims, const std::vector<float>& values) {
+    onnx::TensorProto tensor;
+    tensor.set_data_type(onnx::TensorProto::FLOAT);
+    for (const auto dim : dims) {
+        tensor.add_dims(dim);
+    }
+    for (const auto value : values) {
+        tensor.add_float_data(value);
+    }
+    return tensor;
+}
+
+onnx::TensorProto MakeIntTensor(const std::vector<int64_t>& dims, const std::vector<int64_t>& values) {
+    onnx::TensorProto tensor;
+    tensor.set_data_type(onnx::TensorProto::INT64);
+    for (const auto dim : dims) {
+        tensor.add_dims(dim);
+    }
+    for (const auto value : values) {
+        tensor.add_int64_data(value);
+    }
+    return tensor;
+}
+
+const onnx::AttributeProto* GetAttribute(const onnx::NodeProto& node, const std::string& name) {
+    for (const auto& attribute : node.attribute()) {
+        if (attribute.name() == name) {
+            return &attribute;
+        }
+    }
+    return nullptr;
+}
+
+int64_t GetAttributeInt(const onnx::NodeProto& node, const std::string& name, int64_t default_value) {
+    auto attribute = GetAttribute(node, name);
+    return attribute != nullptr && attribute->has_i() ? attribute->i() : default_value;
+}
+
+float GetAttributeFloat(const onnx::NodeProto& node, const std::string& name, float default_value) {
+    auto attribute = GetAttribute(node, name);
+    return attribute != nullptr && attribute->has_f() ? attribute->f() : default_value;
+}
+
+std::string GetAttributeString(const onnx::NodeProto& node, const std::string& name, const std::string& default_value) {
+    auto attribute = GetAttribute(node, name);
+    return attribute != nullptr && attribute->has_s() ? attribute->s() : default_value;
+}
+
+std::vector<int64_t> GetAttributeInts(const onnx::NodeProto& node, const std::string& name) {
+    auto attribute = GetAttribute(node, name);
+    if (attribute == nullptr) {
+        return {};
+    }
+    return std::vector<int64_t>(attribute->ints().begin(), attribute->ints().end());
+}
+
+bool ConvertShapeFormatOnnx(const std::vector<int64_t>& onnx_dims, TNN_NS::DimsVector& dims) {
+    if (onnx_dims.size() > 4) {
+        return false;
+    }
+    dims.assign(onnx_dims.begin(), onnx_dims.end());
+    dims.resize(4, 1);
+    return true;
+}
+
+int ConvertAxisFormatOnnx(int64_t axis, int rank) {
+    return static_cast<int>(axis < 0 ? axis + rank : axis);
+}
+
+}  // namespace TNN_CONVERTER
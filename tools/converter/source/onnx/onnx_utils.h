@@ -0,0 +1,56 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_UTILS_H_
+#define TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_UTILS_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "onnx.pb.h"
+#include "tnn/core/common.h"
+
+namespace TNN_CONVERTER {
+
+// @brief the elements of a float, double, int32 or int64 tensor, from the typed fields or the raw data
+bool GetTensorFloats(const onnx::TensorProto& tensor, std::vector<float>& values);
+
+bool GetTensorInts(const onnx::TensorProto& tensor, std::vector<int64_t>& values);
+
+int64_t GetTensorCount(const onnx::TensorProto& tensor);
+
+onnx::TensorProto MakeFloatTensor(const std::vector<int64_t>& dims, const std::vector<float>& values);
+
+onnx::TensorProto MakeIntTensor(const std::vector<int64_t>& dims, const std::vector<int64_t>& values);
+
+const onnx::AttributeProto* GetAttribute(const onnx::NodeProto& node, const std::string& name);
+
+int64_t GetAttributeInt(const onnx::NodeProto& node, const std::string& name, int64_t default_value);
+
+float GetAttributeFloat(const onnx::NodeProto& node, const std::string& name, float default_value);
+
+std::string GetAttributeString(const onnx::NodeProto& node, const std::string& name, const std::string& default_value);
+
+std::vector<int64_t> GetAttributeInts(const onnx::NodeProto& node, const std::string& name);
+
+// @brief pad the onnx dims of rank <= 4 with trailing ones into the dims of a tnn blob
+bool ConvertShapeFormatOnnx(const std::vector<int64_t>& onnx_dims, TNN_NS::DimsVector& dims);
+
+// @brief map a negative axis of a tensor of the rank into [0, rank)
+int ConvertAxisFormatOnnx(int64_t axis, int rank);
+
+}  // namespace TNN_CONVERTER
+
+#endif  // TNN_TOOLS_CONVERTER_SOURCE_ONNX_ONNX_UTILS_H_
@@ -0,0 +1,48 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <set>
+
+#include "tnn_optimize_pass.h"
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(EliminateUnusedLayers);
+
+std::string TnnOptimizeEliminateUnusedLayersPass::PassName() {
+    return "EliminateUnusedLayers";
+}
+
+TNN_NS::Status TnnOptimizeEliminateUnusedLayersPass::exec(tnn::NetStructure& net_structure,
+                                                          tnn::NetResource& net_resource) {
+    auto& layers = net_structure.layers;
+    // visit the layers backward, the consumers of a layer are removed before it
+    std::set<std::string> used_blobs(net_structure.outputs.begin(), net_structure.outputs.end());
+    for (int index = (int)layers.size() - 1; index >= 0; --index) {
+        auto& layer = layers[index];
+        bool used   = false;
+        for (auto& output : layer->outputs) {
+            used = used || used_blobs.count(output) > 0;
+        }
+        if (!used) {
+            net_resource.resource_map.erase(layer->name);
+            layers.erase(layers.begin() + index);
+            continue;
+        }
+        used_blobs.insert(layer->inputs.begin(), layer->inputs.end());
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(EliminateUnusedLayers);
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,141 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+
+#include "tnn_optimize_pass.h"
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(FoldConstants);
+
+std::string TnnOptimizeFoldConstantsPass::PassName() {
+    return "FoldConstants";
+}
+
+// the constants of the converted models are the float elements of the binary layers,
+// the pass folds the computations on them into fewer layers:
+// x - c is x + (-c), x / c is x * (1 / c), (x + a) + b is x + (a + b) and (x * a) * b is x * (a * b).
+
+static TNN_NS::EltwiseLayerResource* GetConstOperand(TNN_NS::NetResource& net_resource,
+                                                     const std::shared_ptr<TNN_NS::LayerInfo>& layer) {
+    if (layer->type != TNN_NS::LAYER_ADD && layer->type != TNN_NS::LAYER_SUB && layer->type != TNN_NS::LAYER_MUL &&
+        layer->type != TNN_NS::LAYER_DIV) {
+        return nullptr;
+    }
+    if (layer->inputs.size() != 1 || layer->outputs.size() != 1 ||
+        dynamic_cast<TNN_NS::MultidirBroadcastLayerParam*>(layer->param.get()) == nullptr) {
+        return nullptr;
+    }
+    auto iter = net_resource.resource_map.find(layer->name);
+    if (iter == net_resource.resource_map.end()) {
+        return nullptr;
+    }
+    auto resource = dynamic_cast<TNN_NS::EltwiseLayerResource*>(iter->second.get());
+    if (resource == nullptr || resource->element_handle.GetDataType() != TNN_NS::DATA_TYPE_FLOAT ||
+        resource->element_handle.GetDataCount() == 0) {
+        return nullptr;
+    }
+    return resource;
+}
+
+static void SetLayerType(const std::shared_ptr<TNN_NS::LayerInfo>& layer, TNN_NS::LayerType type,
+                         const std::string& type_str) {
+    layer->type        = type;
+    layer->type_str    = type_str;
+    layer->param->type = type_str;
+}
+
+// rewrite x - c into x + (-c) and x / c into x * (1 / c)
+static void NormalizeBinary(const std::shared_ptr<TNN_NS::LayerInfo>& layer, TNN_NS::EltwiseLayerResource* resource) {
+    auto param = dynamic_cast<TNN_NS::MultidirBroadcastLayerParam*>(layer->param.get());
+    if (param->weight_input_index != 1) {
+        return;
+    }
+    const int count = resource->element_handle.GetDataCount();
+    auto data       = resource->element_handle.force_to<float*>();
+    if (layer->type == TNN_NS::LAYER_SUB) {
+        for (int i = 0; i < count; ++i) {
+            data[i] = -data[i];
+        }
+        SetLayerType(layer, TNN_NS::LAYER_ADD, "Add");
+    } else if (layer->type == TNN_NS::LAYER_DIV) {
+        if (std::find(data, data + count, 0.0f) != data + count) {
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            data[i] = 1.0f / data[i];
+        }
+        SetLayerType(layer, TNN_NS::LAYER_MUL, "Mul");
+    }
+}
+
+// merge the constant of the layer into the constant of its consumer of the same type
+static bool MergeIntoConsumer(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                              const std::shared_ptr<TNN_NS::LayerInfo>& layer, TNN_NS::EltwiseLayerResource* resource) {
+    if (layer->type != TNN_NS::LAYER_ADD && layer->type != TNN_NS::LAYER_MUL) {
+        return false;
+    }
+    auto consumer = GetSingleConsumerLayer(net_structure, layer->outputs[0]);
+    if (consumer == nullptr || consumer->type != layer->type) {
+        return false;
+    }
+    auto consumer_resource = GetConstOperand(net_resource, consumer);
+    if (consumer_resource == nullptr || consumer_resource->element_shape != resource->element_shape) {
+        return false;
+    }
+    // the constants broadcast in the same way if they have the same count, one element broadcasts to any
+    const int count          = resource->element_handle.GetDataCount();
+    const int consumer_count = consumer_resource->element_handle.GetDataCount();
+    if (count != consumer_count && count != 1 && consumer_count != 1) {
+        return false;
+    }
+    const int merged_count = std::max(count, consumer_count);
+    auto data              = resource->element_handle.force_to<float*>();
+    auto consumer_data     = consumer_resource->element_handle.force_to<float*>();
+    TNN_NS::RawBuffer merged_handle(merged_count * sizeof(float));
+    auto merged_data = merged_handle.force_to<float*>();
+    for (int i = 0; i < merged_count; ++i) {
+        const float a  = data[count == 1 ? 0 : i];
+        const float b  = consumer_data[consumer_count == 1 ? 0 : i];
+        merged_data[i] = layer->type == TNN_NS::LAYER_ADD ? a + b : a * b;
+    }
+    consumer_resource->element_handle = merged_handle;
+    consumer->inputs[0]               = layer->inputs[0];
+    net_resource.resource_map.erase(layer->name);
+    return true;
+}
+
+TNN_NS::Status TnnOptimizeFoldConstantsPass::exec(tnn::NetStructure& net_structure, tnn::NetResource& net_resource) {
+    for (auto& layer : net_structure.layers) {
+        auto resource = GetConstOperand(net_resource, layer);
+        if (resource != nullptr) {
+            NormalizeBinary(layer, resource);
+        }
+    }
+
+    auto& layers = net_structure.layers;
+    for (auto iter = layers.begin(); iter != layers.end();) {
+        auto layer    = *iter;
+        auto resource = GetConstOperand(net_resource, layer);
+        if (resource != nullptr && MergeIntoConsumer(net_structure, net_resource, layer, resource)) {
+            iter = layers.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(FoldConstants);
+}  // namespace TNN_CONVERTER
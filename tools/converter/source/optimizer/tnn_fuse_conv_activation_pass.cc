@@ -0,0 +1,68 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+
+#include "tnn_optimize_pass.h"
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(FuseConvActivation);
+
+std::string TnnOptimizeFuseConvActivationPass::PassName() {
+    return "FuseConvActivation";
+}
+
+// the activation of the conv followed by the activation layer, None if it cannot be fused
+static int FuseActivation(int conv_activation, TNN_NS::LayerType layer_type) {
+    if (layer_type == TNN_NS::LAYER_RELU) {
+        // relu after relu6 changes nothing
+        return conv_activation == TNN_NS::ActivationType_None ? TNN_NS::ActivationType_ReLU : conv_activation;
+    }
+    if (layer_type == TNN_NS::LAYER_RELU6) {
+        return TNN_NS::ActivationType_ReLU6;
+    }
+    return TNN_NS::ActivationType_None;
+}
+
+TNN_NS::Status TnnOptimizeFuseConvActivationPass::exec(tnn::NetStructure& net_structure,
+                                                       tnn::NetResource& net_resource) {
+    auto& layers = net_structure.layers;
+    for (int index = 0; index < layers.size(); ++index) {
+        auto conv_layer = layers[index];
+        auto conv_param = dynamic_cast<TNN_NS::ConvLayerParam*>(conv_layer->param.get());
+        if (conv_layer->type != TNN_NS::LAYER_CONVOLUTION || conv_param == nullptr || conv_param->quantized ||
+            conv_layer->outputs.size() != 1) {
+            continue;
+        }
+        // the tflite front-end keeps the fused activation of a conv and adds the activation layer too
+        while (true) {
+            auto activation_layer = GetSingleConsumerLayer(net_structure, conv_layer->outputs[0]);
+            if (activation_layer == nullptr || activation_layer->inputs.size() != 1 ||
+                activation_layer->outputs.size() != 1) {
+                break;
+            }
+            int activation_type = FuseActivation(conv_param->activation_type, activation_layer->type);
+            if (activation_type == TNN_NS::ActivationType_None) {
+                break;
+            }
+            conv_param->activation_type = activation_type;
+            conv_layer->outputs         = activation_layer->outputs;
+            layers.erase(std::find(layers.begin(), layers.end(), activation_layer));
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(FuseConvActivation);
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,75 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn_optimize_pass.h"
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(FuseConvPad);
+
+std::string TnnOptimizeFuseConvPadPass::PassName() {
+    return "FuseConvPad";
+}
+
+// zero padding of the spatial dims only
+static bool IsSpatialZeroPad(TNN_NS::PadLayerParam* pad_param) {
+    if (pad_param == nullptr || pad_param->type != 0 || pad_param->value != 0.0f || pad_param->pads.size() < 4) {
+        return false;
+    }
+    for (int i = 4; i < pad_param->pads.size(); ++i) {
+        if (pad_param->pads[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TNN_NS::Status TnnOptimizeFuseConvPadPass::exec(tnn::NetStructure& net_structure, tnn::NetResource& net_resource) {
+    auto& layers = net_structure.layers;
+    for (auto iter = layers.begin(); iter != layers.end();) {
+        auto& layer    = *iter;
+        auto pad_param = dynamic_cast<TNN_NS::PadLayerParam*>(layer->param.get());
+        if (layer->type != TNN_NS::LAYER_PAD || layer->inputs.size() != 1 || layer->outputs.size() != 1 ||
+            !IsSpatialZeroPad(pad_param)) {
+            iter++;
+            continue;
+        }
+        auto conv_layer = GetSingleConsumerLayer(net_structure, layer->outputs[0]);
+        if (conv_layer == nullptr || conv_layer->type != TNN_NS::LAYER_CONVOLUTION || conv_layer->inputs.size() != 1) {
+            iter++;
+            continue;
+        }
+        // pads of pad_type -1 are explicit, the others are computed from the input size
+        auto conv_param = dynamic_cast<TNN_NS::ConvLayerParam*>(conv_layer->param.get());
+        if (conv_param == nullptr || conv_param->pad_type != -1 || conv_param->pads.size() != 4) {
+            iter++;
+            continue;
+        }
+        // pads of both in order [w_begin w_end h_begin h_end], the tnn proto keeps symmetric conv pads only
+        std::vector<int> pads(4);
+        for (int i = 0; i < 4; ++i) {
+            pads[i] = conv_param->pads[i] + pad_param->pads[i];
+        }
+        if (pads[0] != pads[1] || pads[2] != pads[3]) {
+            iter++;
+            continue;
+        }
+        conv_param->pads = pads;
+        conv_layer->inputs[0] = layer->inputs[0];
+        iter                  = layers.erase(iter);
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(FuseConvPad);
+}  // namespace TNN_CONVERTER
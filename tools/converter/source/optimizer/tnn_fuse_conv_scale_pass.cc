@@ -0,0 +1,153 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+
+#include "tnn_optimize_pass.h"
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(FuseConvScale);
+
+std::string TnnOptimizeFuseConvScalePass::PassName() {
+    return "FuseConvScale";
+}
+
+// @brief per channel scale and bias of a layer following a conv, empty if none
+struct ChannelAffine {
+    std::vector<float> scale;
+    std::vector<float> bias;
+};
+
+static bool GetFloats(TNN_NS::RawBuffer& buffer, int channels, std::vector<float>& values) {
+    const int count = buffer.GetDataCount();
+    if (count == 0) {
+        values.clear();
+        return true;
+    }
+    if (buffer.GetDataType() != TNN_NS::DATA_TYPE_FLOAT || (count != 1 && count != channels)) {
+        return false;
+    }
+    auto data = buffer.force_to<float*>();
+    values.resize(channels);
+    for (int i = 0; i < channels; ++i) {
+        values[i] = data[count == 1 ? 0 : i];
+    }
+    return true;
+}
+
+// batch norm and scale layers, and mul and add layers with per channel constants
+static bool GetChannelAffine(TNN_NS::NetResource& net_resource, const std::shared_ptr<TNN_NS::LayerInfo>& layer,
+                             int channels, ChannelAffine& affine) {
+    if (layer->inputs.size() != 1 || layer->outputs.size() != 1) {
+        return false;
+    }
+    auto iter = net_resource.resource_map.find(layer->name);
+    if (iter == net_resource.resource_map.end()) {
+        return false;
+    }
+    if (layer->type == TNN_NS::LAYER_BATCH_NORM || layer->type == TNN_NS::LAYER_SCALE) {
+        auto resource = dynamic_cast<TNN_NS::BatchNormLayerResource*>(iter->second.get());
+        return resource != nullptr && GetFloats(resource->scale_handle, channels, affine.scale) &&
+               !affine.scale.empty() && GetFloats(resource->bias_handle, channels, affine.bias);
+    }
+    if (layer->type == TNN_NS::LAYER_MUL || layer->type == TNN_NS::LAYER_ADD) {
+        auto param    = dynamic_cast<TNN_NS::MultidirBroadcastLayerParam*>(layer->param.get());
+        auto resource = dynamic_cast<TNN_NS::EltwiseLayerResource*>(iter->second.get());
+        if (param == nullptr || resource == nullptr) {
+            return false;
+        }
+        // an explicit element shape must broadcast along the channels
+        auto& shape = resource->element_shape;
+        if (!shape.empty() && !(shape.size() == 4 && shape[0] == 1 && shape[2] == 1 && shape[3] == 1)) {
+            return false;
+        }
+        auto& values = layer->type == TNN_NS::LAYER_MUL ? affine.scale : affine.bias;
+        return GetFloats(resource->element_handle, channels, values) && !values.empty();
+    }
+    return false;
+}
+
+// conv(x) * scale + bias is a conv with the weights and the bias of each output channel scaled
+static void FoldChannelAffine(TNN_NS::ConvLayerParam* conv_param, TNN_NS::ConvLayerResource* conv_resource,
+                              const ChannelAffine& affine) {
+    const int channels     = conv_param->output_channel;
+    const int weight_count = conv_resource->filter_handle.GetDataCount() / channels;
+    auto weight            = conv_resource->filter_handle.force_to<float*>();
+
+    std::vector<float> bias(channels, 0.0f);
+    if (conv_param->bias) {
+        auto conv_bias = conv_resource->bias_handle.force_to<float*>();
+        bias.assign(conv_bias, conv_bias + channels);
+    }
+    for (int oc = 0; oc < channels; ++oc) {
+        if (!affine.scale.empty()) {
+            for (int i = 0; i < weight_count; ++i) {
+                weight[oc * weight_count + i] *= affine.scale[oc];
+            }
+            bias[oc] *= affine.scale[oc];
+        }
+        if (!affine.bias.empty()) {
+            bias[oc] += affine.bias[oc];
+        }
+    }
+
+    TNN_NS::RawBuffer bias_handle(channels * sizeof(float));
+    memcpy(bias_handle.force_to<float*>(), bias.data(), channels * sizeof(float));
+    conv_resource->bias_handle = bias_handle;
+    conv_param->bias           = 1;
+}
+
+TNN_NS::Status TnnOptimizeFuseConvScalePass::exec(tnn::NetStructure& net_structure, tnn::NetResource& net_resource) {
+    auto& layers = net_structure.layers;
+    for (int index = 0; index < layers.size(); ++index) {
+        auto conv_layer = layers[index];
+        auto conv_param = dynamic_cast<TNN_NS::ConvLayerParam*>(conv_layer->param.get());
+        if (conv_layer->type != TNN_NS::LAYER_CONVOLUTION || conv_param == nullptr || conv_param->quantized ||
+            conv_layer->outputs.size() != 1) {
+            continue;
+        }
+        auto iter = net_resource.resource_map.find(conv_layer->name);
+        if (iter == net_resource.resource_map.end()) {
+            continue;
+        }
+        auto conv_resource = dynamic_cast<TNN_NS::ConvLayerResource*>(iter->second.get());
+        const int channels = conv_param->output_channel;
+        if (conv_resource == nullptr || conv_resource->filter_handle.GetDataType() != TNN_NS::DATA_TYPE_FLOAT ||
+            channels <= 0 || conv_resource->filter_handle.GetDataCount() % channels != 0) {
+            continue;
+        }
+        if (conv_param->bias && (conv_resource->bias_handle.GetDataType() != TNN_NS::DATA_TYPE_FLOAT ||
+                                 conv_resource->bias_handle.GetDataCount() != channels)) {
+            continue;
+        }
+
+        // the activation of the conv is applied after the scale
+        while (conv_param->activation_type == TNN_NS::ActivationType_None) {
+            auto scale_layer = GetSingleConsumerLayer(net_structure, conv_layer->outputs[0]);
+            ChannelAffine affine;
+            if (scale_layer == nullptr || !GetChannelAffine(net_resource, scale_layer, channels, affine)) {
+                break;
+            }
+            FoldChannelAffine(conv_param, conv_resource, affine);
+            conv_layer->outputs = scale_layer->outputs;
+            net_resource.resource_map.erase(scale_layer->name);
+            layers.erase(std::find(layers.begin(), layers.end(), scale_layer));
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(FuseConvScale);
+}  // namespace TNN_CONVERTER
@@ -14,6 +14,8 @@
 
 #include "tnn_optimize_pass.h"
 
+#include <algorithm>
+
 namespace TNN_CONVERTER {
 
 TnnOptimizePassManager* TnnOptimizePassManager::tnn_optimize_pass_manager_ = nullptr;
@@ -43,4 +45,27 @@ TnnOptimizePass* TnnOptimizePassManager::search(const std::string pass_name) {
 void TnnOptimizePassManager::insert(const std::string pass_name, TnnOptimizePass* t) {
     tnn_optimize_pass_map_.insert(std::make_pair(pass_name, t));
 }
+
+std::vector<std::shared_ptr<TNN_NS::LayerInfo>> GetConsumerLayers(TNN_NS::NetStructure& net_structure,
+                                                                  const std::string& blob) {
+    std::vector<std::shared_ptr<TNN_NS::LayerInfo>> consumers;
+    for (auto& layer : net_structure.layers) {
+        if (std::find(layer->inputs.begin(), layer->inputs.end(), blob) != layer->inputs.end()) {
+            consumers.push_back(layer);
+        }
+    }
+    return consumers;
+}
+
+std::shared_ptr<TNN_NS::LayerInfo> GetSingleConsumerLayer(TNN_NS::NetStructure& net_structure,
+                                                          const std::string& blob) {
+    if (net_structure.outputs.count(blob) > 0) {
+        return nullptr;
+    }
+    auto consumers = GetConsumerLayers(net_structure, blob);
+    if (consumers.size() != 1) {
+        return nullptr;
+    }
+    return consumers[0];
+}
 }  // namespace TNN_CONVERTER
\ No newline at end of file
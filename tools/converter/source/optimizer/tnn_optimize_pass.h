@@ -63,6 +63,15 @@ public:
 
 #define REGISTER_OPTIMIZE_PASS(pass_name)                                                                              \
     TnnOptimizePassRegister<TnnOptimize##pass_name##Pass> g_tnn_optimize_##pass_name##_pass_(#pass_name)
+
+// @brief layers taking the blob as an input
+std::vector<std::shared_ptr<TNN_NS::LayerInfo>> GetConsumerLayers(TNN_NS::NetStructure& net_structure,
+                                                                  const std::string& blob);
+
+// @brief the only layer taking the blob as an input, null if the blob is an output of the net or has more
+// consumers. the blob can be removed if it is merged into its consumer.
+std::shared_ptr<TNN_NS::LayerInfo> GetSingleConsumerLayer(TNN_NS::NetStructure& net_structure,
+                                                          const std::string& blob);
 }  // namespace TNN_CONVERTER
 
 #endif  // TNN_TOOLS_CONVERTER_SOURCE_OPTIMIZER_TNN_OPTIMIZE_PASS_H_
@@ -19,14 +19,21 @@
 namespace TNN_CONVERTER {
 
 TNN_NS::Status TnnOptimizer::Optimize(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource) {
-    std::vector<std::string> optimize_pass = {"EliminateSqueeze", "TransformReduceMean"};
+    // constants are folded before they are fused into the convs, the activations are fused last
+    std::vector<std::string> optimize_pass = {"EliminateSqueeze",   "TransformReduceMean", "PropagateLayout",
+                                              "FuseConvPad",        "FoldConstants",       "FuseConvScale",
+                                              "FuseConvActivation", "EliminateUnusedLayers"};
     for (auto pass_name : optimize_pass) {
         auto pass = TnnOptimizePassManager::get()->search(pass_name);
         if (pass == nullptr) {
             LOGE("Unsupport optimize pass %s\n", pass_name.c_str());
             return TNN_NS::TNNERR_CONVERT_UNSUPPORT_PASS;
         }
-        pass->exec(net_structure, net_resource);
+        auto status = pass->exec(net_structure, net_resource);
+        if (status != TNN_NS::TNN_CONVERT_OK) {
+            LOGE("Optimize pass %s failed\n", pass_name.c_str());
+            return status;
+        }
     }
     return TNN_NS::TNN_CONVERT_OK;
 }
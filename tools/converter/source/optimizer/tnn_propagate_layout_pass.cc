@@ -0,0 +1,158 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/data_format_converter.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn_optimize_pass.h"
+namespace TNN_CONVERTER {
+
+DECLARE_OPTIMIZE_PASS(PropagateLayout);
+
+std::string TnnOptimizePropagateLayoutPass::PassName() {
+    return "PropagateLayout";
+}
+
+// tflite reshape (reshape_type 1) transposes the blob to nhwc, reshapes it and transposes it back to nchw.
+// the pass rewrites it into a nchw reshape (reshape_type 0) wherever the static shapes prove both equal.
+
+static bool GetStaticShape(TNN_NS::NetStructure& net_structure, const std::string& blob, TNN_NS::DimsVector& dims) {
+    auto iter = net_structure.blobs_shape_map.find(blob);
+    if (iter == net_structure.blobs_shape_map.end() || iter->second.size() != 4) {
+        return false;
+    }
+    dims = iter->second;
+    for (auto dim : dims) {
+        if (dim <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// the nhwc and the nchw orders of a blob are equal if it has one channel or one pixel
+static bool IsLayoutNeutral(const TNN_NS::DimsVector& dims) {
+    return dims[1] == 1 || dims[2] * dims[3] == 1;
+}
+
+static TNN_NS::ReshapeLayerParam* GetNHWCReshapeParam(const std::shared_ptr<TNN_NS::LayerInfo>& layer) {
+    if (layer->type != TNN_NS::LAYER_RESHAPE || layer->inputs.size() != 1 || layer->outputs.size() != 1) {
+        return nullptr;
+    }
+    auto param = dynamic_cast<TNN_NS::ReshapeLayerParam*>(layer->param.get());
+    if (param == nullptr || param->reshape_type != 1) {
+        return nullptr;
+    }
+    return param;
+}
+
+// two nhwc reshapes in a row are one nhwc reshape to the shape of the second
+static void MergeNHWCReshapes(TNN_NS::NetStructure& net_structure) {
+    auto& layers = net_structure.layers;
+    for (auto iter = layers.begin(); iter != layers.end();) {
+        auto layer = *iter;
+        if (GetNHWCReshapeParam(layer) == nullptr || net_structure.outputs.count(layer->outputs[0]) > 0) {
+            iter++;
+            continue;
+        }
+        TNN_NS::DimsVector input_dims, output_dims;
+        auto consumers = GetConsumerLayers(net_structure, layer->outputs[0]);
+        bool mergeable = !consumers.empty() && GetStaticShape(net_structure, layer->inputs[0], input_dims) &&
+                         GetStaticShape(net_structure, layer->outputs[0], output_dims) &&
+                         input_dims[0] == output_dims[0];
+        for (auto& consumer : consumers) {
+            mergeable = mergeable && GetNHWCReshapeParam(consumer) != nullptr;
+        }
+        if (!mergeable) {
+            iter++;
+            continue;
+        }
+        for (auto& consumer : consumers) {
+            consumer->inputs[0] = layer->inputs[0];
+        }
+        iter = layers.erase(iter);
+    }
+}
+
+// permute the weights of the inner products flattening the blob from the nhwc order to the nchw order
+static bool PermuteInnerProductWeights(TNN_NS::NetResource& net_resource,
+                                       std::vector<std::shared_ptr<TNN_NS::LayerInfo>>& consumers,
+                                       const TNN_NS::DimsVector& dims) {
+    const int channel      = dims[1];
+    const int height       = dims[2];
+    const int width        = dims[3];
+    const int feature_size = channel * height * width;
+    std::vector<TNN_NS::InnerProductLayerResource*> resources;
+    for (auto& consumer : consumers) {
+        auto param = dynamic_cast<TNN_NS::InnerProductLayerParam*>(consumer->param.get());
+        if (consumer->type != TNN_NS::LAYER_INNER_PRODUCT || param == nullptr || param->axis != 1) {
+            return false;
+        }
+        auto iter = net_resource.resource_map.find(consumer->name);
+        if (iter == net_resource.resource_map.end()) {
+            return false;
+        }
+        auto resource = dynamic_cast<TNN_NS::InnerProductLayerResource*>(iter->second.get());
+        if (resource == nullptr || resource->weight_handle.GetDataType() != TNN_NS::DATA_TYPE_FLOAT ||
+            resource->weight_handle.GetDataCount() != param->num_output * feature_size) {
+            return false;
+        }
+        resources.push_back(resource);
+    }
+
+    for (auto resource : resources) {
+        const int num_output = resource->weight_handle.GetDataCount() / feature_size;
+        auto weight_ptr      = resource->weight_handle.force_to<float*>();
+        std::vector<float> tmp(feature_size);
+        for (int i = 0; i < num_output; ++i) {
+            auto data_ptr = weight_ptr + i * feature_size;
+            TNN_NS::DataFormatConverter::ConvertFromNHWCToNCHW<float>(data_ptr, tmp.data(), 1, channel, height,
+                                                                     width);
+            std::copy(tmp.begin(), tmp.end(), data_ptr);
+        }
+    }
+    return true;
+}
+
+TNN_NS::Status TnnOptimizePropagateLayoutPass::exec(tnn::NetStructure& net_structure, tnn::NetResource& net_resource) {
+    MergeNHWCReshapes(net_structure);
+
+    for (auto& layer : net_structure.layers) {
+        auto param = GetNHWCReshapeParam(layer);
+        TNN_NS::DimsVector input_dims, output_dims;
+        if (param == nullptr || !GetStaticShape(net_structure, layer->inputs[0], input_dims) ||
+            !GetStaticShape(net_structure, layer->outputs[0], output_dims)) {
+            continue;
+        }
+
+        bool nchw_equal = false;
+        if (IsLayoutNeutral(input_dims) && IsLayoutNeutral(output_dims)) {
+            nchw_equal = true;
+        } else if (input_dims[0] == output_dims[0] && input_dims[1] == output_dims[1]) {
+            // the reshape only regroups the pixels of each channel
+            nchw_equal = true;
+        } else if (input_dims[0] == output_dims[0] && output_dims[2] * output_dims[3] == 1 &&
+                   net_structure.outputs.count(layer->outputs[0]) == 0) {
+            // flatten before inner products, they take the nchw order if their weights are permuted
+            auto consumers = GetConsumerLayers(net_structure, layer->outputs[0]);
+            nchw_equal     = !consumers.empty() && PermuteInnerProductWeights(net_resource, consumers, input_dims);
+        }
+        if (nchw_equal) {
+            param->reshape_type = 0;
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+REGISTER_OPTIMIZE_PASS(PropagateLayout);
+}  // namespace TNN_CONVERTER
@@ -85,6 +85,16 @@ TNN_NS::Status TFLite2Tnn::Convert2Tnn(TNN_NS::NetStructure& net_structure, TNN_
             }
         }
 
+        // set static shapes, the optimizer passes rewriting nhwc layouts depend on them
+        for (const auto& tensor : tensors) {
+            if (tensor->shape.empty() || tensor->shape.size() > 4) {
+                continue;
+            }
+            std::vector<int32_t> shape(tensor->shape);
+            ConvertShapeFormatTFLite(shape);
+            net_structure.blobs_shape_map[tensor->name] = shape;
+        }
+
         // set output
         auto& outputs = net_structure.outputs;
         for (const auto index : tf_lite_model_->subgraphs[i]->outputs) {
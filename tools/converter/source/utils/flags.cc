@@ -24,4 +24,6 @@ DEFINE_string(od, "", output_dir_message);
 
 DEFINE_string(mt, "", model_type_message);
 
+DEFINE_bool(sm, false, memory_plan_message);
+
 }  // namespace TNN_CONVERTER
\ No newline at end of file
@@ -20,11 +20,14 @@ namespace TNN_CONVERTER {
 
 static const char help_message[] = "print a usage message.";
 
-static const char tf_path_message[] = "specify model path: <the>/<path>/<to>/<test.tflite>.";
+static const char tf_path_message[] = "specify model path: <the>/<path>/<to>/<test.tflite|test.onnx>.";
 
 static const char output_dir_message[] = "specify output path: <the>/<path>/<to>/<directory>.";
 
-static const char model_type_message[] = "specify model type: Caffe, TF, TFLite.";
+static const char model_type_message[] = "specify model type: TFLITE, ONNX.";
+
+static const char memory_plan_message[] =
+    "embed the static blob shapes and the blob memory plan of the model input shapes into the tnn proto.";
 
 DECLARE_bool(h);
 
@@ -34,6 +37,8 @@ DECLARE_string(od);
 
 DECLARE_string(mt);
 
+DECLARE_bool(sm);
+
 }  // namespace TNN_CONVERTER
 
 #endif  // TNNCONVERTER_SRC_FLAGS_H_
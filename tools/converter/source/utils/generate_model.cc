@@ -30,12 +30,22 @@ std::string GetFileName(std::string& file_path) {
 }
 
 TNN_NS::Status GenerateModel(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
-                             std::string& output_dir, std::string& file_name) {
+                             std::string& output_dir, std::string& file_name, bool embed_memory_plan) {
     std::string proto_path = output_dir + file_name + PROTO_SUFFIX;
     std::string model_path = output_dir + file_name + MODEL_SUFFIX;
     printf("TNN Converter generate TNN proto path %s\n", proto_path.c_str());
     printf("TNN Converter generate TNN model path %s\n", model_path.c_str());
+    // the blobs of the net after the optimization
+    net_structure.blobs.clear();
+    for (const auto& iter : net_structure.inputs_shape_map) {
+        net_structure.blobs.insert(iter.first);
+    }
+    for (const auto& layer : net_structure.layers) {
+        net_structure.blobs.insert(layer->inputs.begin(), layer->inputs.end());
+        net_structure.blobs.insert(layer->outputs.begin(), layer->outputs.end());
+    }
     TNN_NS::ModelPacker model_packer(&net_structure, &net_resource);
+    model_packer.SetEmbedMemoryPlan(embed_memory_plan);
     Status status = model_packer.Pack(proto_path, model_path);
     if (status != TNN_OK) {
         LOGE("generate tnn model failed!\n");
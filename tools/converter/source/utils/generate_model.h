@@ -25,8 +25,9 @@ const std::string MODEL_SUFFIX = ".tnnmodel";
 
 std::string GetFileName(std::string& file_path);
 
+// @brief pack the tnn model, embed_memory_plan needs the shapes of all blobs in net_structure.blobs_shape_map
 TNN_NS::Status GenerateModel(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
-                             std::string& output_dir, std::string& file_name);
+                             std::string& output_dir, std::string& file_name, bool embed_memory_plan = false);
 
 }  // namespace TNN_CONVERTER
 
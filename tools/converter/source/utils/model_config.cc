@@ -27,6 +27,8 @@ ModelConfig::ModelConfig(std::string model_type, std::string model_path, std::st
     // TODO
     if (model_type == "TFLITE") {
         model_type_ = MODEL_TYPE_TF_LITE;
+    } else if (model_type == "ONNX") {
+        model_type_ = MODEL_TYPE_ONNX;
     }
     model_path_ = model_path;
     output_dir_ = output_dir;
@@ -0,0 +1,90 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "shape_inference.h"
+
+#include <memory>
+
+#include "tnn/core/blob.h"
+#include "tnn/core/macro.h"
+#include "tnn/layer/base_layer.h"
+
+namespace TNN_CONVERTER {
+
+TNN_NS::Status InferLayerShapes(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
+                                const std::shared_ptr<TNN_NS::LayerInfo>& layer) {
+    auto& blobs_shape_map = net_structure.blobs_shape_map;
+    std::shared_ptr<TNN_NS::BaseLayer> base_layer(TNN_NS::CreateLayer(layer->type));
+    if (base_layer == nullptr) {
+        LOGE("The shape inference do not support layer %s of type %s\n", layer->name.c_str(), layer->type_str.c_str());
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+
+    // the blobs only carry the dims, the layer is not initialized on any device
+    std::vector<std::shared_ptr<TNN_NS::Blob>> blobs;
+    std::vector<TNN_NS::Blob*> input_blobs;
+    std::vector<TNN_NS::Blob*> output_blobs;
+    for (const auto& name : layer->inputs) {
+        auto iter = blobs_shape_map.find(name);
+        if (iter == blobs_shape_map.end()) {
+            LOGE("The shape of blob %s used by layer %s is unknown\n", name.c_str(), layer->name.c_str());
+            return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+        }
+        TNN_NS::BlobDesc desc;
+        desc.name = name;
+        desc.dims = iter->second;
+        blobs.push_back(std::make_shared<TNN_NS::Blob>(desc));
+        input_blobs.push_back(blobs.back().get());
+    }
+    for (const auto& name : layer->outputs) {
+        TNN_NS::BlobDesc desc;
+        desc.name = name;
+        blobs.push_back(std::make_shared<TNN_NS::Blob>(desc));
+        output_blobs.push_back(blobs.back().get());
+    }
+
+    auto resource_iter = net_resource.resource_map.find(layer->name);
+    auto resource      = resource_iter == net_resource.resource_map.end() ? nullptr : resource_iter->second.get();
+    base_layer->InferShapeAhead(input_blobs, output_blobs, layer->param.get(), resource);
+
+    // InferShapeAhead does not report errors, a layer failing to infer leaves invalid dims
+    for (auto output_blob : output_blobs) {
+        const auto& dims = output_blob->GetBlobDesc().dims;
+        bool valid       = !dims.empty();
+        for (const auto dim : dims) {
+            valid = valid && dim > 0;
+        }
+        if (!valid) {
+            LOGE("The shape inference of layer %s failed\n", layer->name.c_str());
+            return TNN_NS::TNNERR_CONVERT_INVALID_MODEL;
+        }
+        blobs_shape_map[output_blob->GetBlobDesc().name] = dims;
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+TNN_NS::Status InferBlobShapes(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource) {
+    for (const auto& iter : net_structure.inputs_shape_map) {
+        net_structure.blobs_shape_map[iter.first] = iter.second;
+    }
+    for (const auto& layer : net_structure.layers) {
+        auto status = InferLayerShapes(net_structure, net_resource, layer);
+        if (status != TNN_NS::TNN_CONVERT_OK) {
+            return status;
+        }
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
+}  // namespace TNN_CONVERTER
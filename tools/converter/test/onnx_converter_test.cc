@@ -0,0 +1,320 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "onnx/onnx_converter.h"
+#include "onnx/onnx_utils.h"
+#include "tnn/interpreter/layer_resource.h"
+
+namespace TNN_CONVERTER {
+
+class OnnxConverterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        model_.set_ir_version(7);
+        model_.add_opset_import()->set_version(11);
+        graph_ = model_.mutable_graph();
+    }
+
+    void AddInput(const std::string& name, const std::vector<int64_t>& dims) {
+        auto input = graph_->add_input();
+        input->set_name(name);
+        auto tensor_type = input->mutable_type()->mutable_tensor_type();
+        tensor_type->set_elem_type(onnx::TensorProto::FLOAT);
+        for (const auto dim : dims) {
+            tensor_type->mutable_shape()->add_dim()->set_dim_value(dim);
+        }
+    }
+
+    void AddOutput(const std::string& name) {
+        graph_->add_output()->set_name(name);
+    }
+
+    onnx::TensorProto* AddInitializer(const std::string& name, onnx::TensorProto tensor) {
+        tensor.set_name(name);
+        auto initializer = graph_->add_initializer();
+        *initializer     = tensor;
+        return initializer;
+    }
+
+    onnx::NodeProto* AddNode(const std::string& op_type, const std::vector<std::string>& inputs,
+                             const std::string& output) {
+        auto node = graph_->add_node();
+        node->set_op_type(op_type);
+        for (const auto& input : inputs) {
+            node->add_input(input);
+        }
+        node->add_output(output);
+        return node;
+    }
+
+    static void SetAttribute(onnx::NodeProto* node, const std::string& name, int64_t value) {
+        auto attribute = node->add_attribute();
+        attribute->set_name(name);
+        attribute->set_type(onnx::AttributeProto::INT);
+        attribute->set_i(value);
+    }
+
+    static void SetAttribute(onnx::NodeProto* node, const std::string& name, float value) {
+        auto attribute = node->add_attribute();
+        attribute->set_name(name);
+        attribute->set_type(onnx::AttributeProto::FLOAT);
+        attribute->set_f(value);
+    }
+
+    static void SetAttribute(onnx::NodeProto* node, const std::string& name, const std::vector<int64_t>& values) {
+        auto attribute = node->add_attribute();
+        attribute->set_name(name);
+        attribute->set_type(onnx::AttributeProto::INTS);
+        for (const auto value : values) {
+            attribute->add_ints(value);
+        }
+    }
+
+    // the converter reads the model from a file
+    TNN_NS::Status Convert() {
+        char path[] = "/tmp/tnn_onnx_XXXXXX";
+        int fd      = mkstemp(path);
+        if (fd < 0) {
+            return TNN_NS::Status(TNN_NS::TNNERR_CONVERT_INVALID_MODEL, "can not create the model file");
+        }
+        close(fd);
+        {
+            std::ofstream model_file(path, std::ios::binary);
+            model_.SerializeToOstream(&model_file);
+        }
+        Onnx2Tnn converter(path);
+        auto status = converter.Convert2Tnn(net_structure_, net_resource_);
+        remove(path);
+        return status;
+    }
+
+    std::shared_ptr<TNN_NS::LayerInfo> GetLayer(int index) {
+        return index < net_structure_.layers.size() ? net_structure_.layers[index] : nullptr;
+    }
+
+    // the copy of a raw buffer shares its data
+    static std::vector<float> GetValues(TNN_NS::RawBuffer buffer) {
+        auto data = buffer.force_to<float*>();
+        return std::vector<float>(data, data + buffer.GetBytesSize() / sizeof(float));
+    }
+
+    onnx::ModelProto model_;
+    onnx::GraphProto* graph_ = nullptr;
+    TNN_NS::NetStructure net_structure_;
+    TNN_NS::NetResource net_resource_;
+};
+
+TEST_F(OnnxConverterTest, ConvAsymmetricPads) {
+    AddInput("x", {1, 2, 5, 5});
+    std::vector<float> weight(3 * 2 * 3 * 3);
+    for (int i = 0; i < weight.size(); ++i) {
+        weight[i] = i * 0.5f;
+    }
+    AddInitializer("w", MakeFloatTensor({3, 2, 3, 3}, weight));
+    AddInitializer("b", MakeFloatTensor({3}, {1.0f, 2.0f, 3.0f}));
+    auto node = AddNode("Conv", {"x", "w", "b"}, "y");
+    SetAttribute(node, "kernel_shape", std::vector<int64_t>{3, 3});
+    // onnx pads [h_begin w_begin h_end w_end]
+    SetAttribute(node, "pads", std::vector<int64_t>{0, 1, 1, 2});
+    AddOutput("y");
+    ASSERT_EQ((int)Convert(), (int)TNN_NS::TNN_CONVERT_OK);
+
+    // the conv keeps the symmetric part of the pads, the pad layer before it the rest
+    ASSERT_EQ(net_structure_.layers.size(), 2);
+    auto pad_layer = GetLayer(0);
+    EXPECT_EQ(pad_layer->type, TNN_NS::LAYER_PAD);
+    EXPECT_EQ(pad_layer->name, "y_pad");
+    EXPECT_EQ(pad_layer->inputs, std::vector<std::string>({"x"}));
+    EXPECT_EQ(pad_layer->outputs, std::vector<std::string>({"y_pad"}));
+    auto pad_param = dynamic_cast<TNN_NS::PadLayerParam*>(pad_layer->param.get());
+    ASSERT_NE(pad_param, nullptr);
+    // [w_begin, w_end, h_begin, h_end, c_begin, c_end]
+    EXPECT_EQ(pad_param->pads, std::vector<int>({0, 1, 0, 1, 0, 0}));
+    EXPECT_EQ(pad_param->type, 0);
+
+    auto conv_layer = GetLayer(1);
+    EXPECT_EQ(conv_layer->type, TNN_NS::LAYER_CONVOLUTION);
+    EXPECT_EQ(conv_layer->inputs, std::vector<std::string>({"y_pad"}));
+    auto conv_param = dynamic_cast<TNN_NS::ConvLayerParam*>(conv_layer->param.get());
+    ASSERT_NE(conv_param, nullptr);
+    EXPECT_EQ(conv_param->pads, std::vector<int>({1, 1, 0, 0}));
+    EXPECT_EQ(conv_param->kernels, std::vector<int>({3, 3}));
+    EXPECT_EQ(conv_param->input_channel, 2);
+    EXPECT_EQ(conv_param->output_channel, 3);
+    EXPECT_EQ(conv_param->bias, 1);
+    auto conv_resource = dynamic_cast<TNN_NS::ConvLayerResource*>(net_resource_.resource_map["y"].get());
+    ASSERT_NE(conv_resource, nullptr);
+    EXPECT_EQ(GetValues(conv_resource->filter_handle), weight);
+    EXPECT_EQ(GetValues(conv_resource->bias_handle), std::vector<float>({1.0f, 2.0f, 3.0f}));
+
+    // the output is that of the onnx conv, 5 + 0 + 1 - 3 + 1 rows and 5 + 1 + 2 - 3 + 1 cols
+    EXPECT_EQ(net_structure_.blobs_shape_map["y_pad"], TNN_NS::DimsVector({1, 2, 6, 6}));
+    EXPECT_EQ(net_structure_.blobs_shape_map["y"], TNN_NS::DimsVector({1, 3, 4, 6}));
+    EXPECT_EQ(net_structure_.outputs.count("y"), 1);
+}
+
+TEST_F(OnnxConverterTest, GemmTransBAlphaBeta) {
+    AddInput("a", {2, 3});
+    // b is [num_output, k] with transB
+    AddInitializer("b", MakeFloatTensor({4, 3}, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}));
+    AddInitializer("c", MakeFloatTensor({4}, {1, 2, 3, 4}));
+    auto node = AddNode("Gemm", {"a", "b", "c"}, "y");
+    SetAttribute(node, "transB", int64_t(1));
+    SetAttribute(node, "alpha", 2.0f);
+    SetAttribute(node, "beta", 0.5f);
+    AddOutput("y");
+    ASSERT_EQ((int)Convert(), (int)TNN_NS::TNN_CONVERT_OK);
+
+    ASSERT_EQ(net_structure_.layers.size(), 1);
+    auto layer = GetLayer(0);
+    EXPECT_EQ(layer->type, TNN_NS::LAYER_INNER_PRODUCT);
+    EXPECT_EQ(layer->inputs, std::vector<std::string>({"a"}));
+    auto param = dynamic_cast<TNN_NS::InnerProductLayerParam*>(layer->param.get());
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(param->num_output, 4);
+    EXPECT_EQ(param->has_bias, 1);
+    EXPECT_EQ(param->axis, 1);
+
+    // alpha and beta are folded into the weights and the bias
+    auto resource = dynamic_cast<TNN_NS::InnerProductLayerResource*>(net_resource_.resource_map["y"].get());
+    ASSERT_NE(resource, nullptr);
+    EXPECT_EQ(GetValues(resource->weight_handle),
+              std::vector<float>({2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24}));
+    EXPECT_EQ(GetValues(resource->bias_handle), std::vector<float>({0.5f, 1.0f, 1.5f, 2.0f}));
+    EXPECT_EQ(net_structure_.blobs_shape_map["y"], TNN_NS::DimsVector({2, 4, 1, 1}));
+}
+
+TEST_F(OnnxConverterTest, GemmTransposesWeights) {
+    AddInput("a", {1, 3});
+    // b is [k, num_output] without transB
+    AddInitializer("b", MakeFloatTensor({3, 2}, {1, 2, 3, 4, 5, 6}));
+    AddNode("Gemm", {"a", "b"}, "y");
+    AddOutput("y");
+    ASSERT_EQ((int)Convert(), (int)TNN_NS::TNN_CONVERT_OK);
+
+    auto param = dynamic_cast<TNN_NS::InnerProductLayerParam*>(GetLayer(0)->param.get());
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(param->num_output, 2);
+    EXPECT_EQ(param->has_bias, 0);
+    auto resource = dynamic_cast<TNN_NS::InnerProductLayerResource*>(net_resource_.resource_map["y"].get());
+    ASSERT_NE(resource, nullptr);
+    EXPECT_EQ(GetValues(resource->weight_handle), std::vector<float>({1, 3, 5, 2, 4, 6}));
+    EXPECT_EQ(net_structure_.blobs_shape_map["y"], TNN_NS::DimsVector({1, 2, 1, 1}));
+}
+
+TEST_F(OnnxConverterTest, ShapeSubgraphFoldedIntoReshape) {
+    // y = Reshape(x, Concat(Unsqueeze(Gather(Shape(x), 0)), [-1]))
+    AddInput("x", {1, 2, 3, 4});
+    AddInitializer("index", MakeIntTensor({}, {0}));
+    AddInitializer("minus_one", MakeIntTensor({1}, {-1}));
+    AddNode("Shape", {"x"}, "shape");
+    AddNode("Gather", {"shape", "index"}, "batch");
+    SetAttribute(AddNode("Unsqueeze", {"batch"}, "batch_1d"), "axes", std::vector<int64_t>{0});
+    SetAttribute(AddNode("Concat", {"batch_1d", "minus_one"}, "new_shape"), "axis", int64_t(0));
+    AddNode("Reshape", {"x", "new_shape"}, "y");
+    AddOutput("y");
+    ASSERT_EQ((int)Convert(), (int)TNN_NS::TNN_CONVERT_OK);
+
+    // the shape computation is folded, only the reshape is left
+    ASSERT_EQ(net_structure_.layers.size(), 1);
+    auto layer = GetLayer(0);
+    EXPECT_EQ(layer->type, TNN_NS::LAYER_RESHAPE);
+    EXPECT_EQ(layer->inputs, std::vector<std::string>({"x"}));
+    auto param = dynamic_cast<TNN_NS::ReshapeLayerParam*>(layer->param.get());
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(param->shape, std::vector<int>({1, -1, 1, 1}));
+    EXPECT_EQ(param->num_axes, 4);
+    EXPECT_EQ(net_structure_.blobs_shape_map["y"], TNN_NS::DimsVector({1, 24, 1, 1}));
+}
+
+TEST_F(OnnxConverterTest, Flatten) {
+    AddInput("x", {2, 3, 4, 5});
+    SetAttribute(AddNode("Flatten", {"x"}, "y1"), "axis", int64_t(1));
+    SetAttribute(AddNode("Flatten", {"x"}, "y2"), "axis", int64_t(2));
+    AddOutput("y1");
+    AddOutput("y2");
+    ASSERT_EQ((int)Convert(), (int)TNN_NS::TNN_CONVERT_OK);
+
+    ASSERT_EQ(net_structure_.layers.size(), 2);
+    // the batch is kept if it is the outer dim, otherwise the outer dims are multiplied
+    auto param = dynamic_cast<TNN_NS::ReshapeLayerParam*>(GetLayer(0)->param.get());
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(GetLayer(0)->type, TNN_NS::LAYER_RESHAPE);
+    EXPECT_EQ(param->shape, std::vector<int>({0, -1, 1, 1}));
+    EXPECT_EQ(net_structure_.blobs_shape_map["y1"], TNN_NS::DimsVector({2, 60, 1, 1}));
+
+    param = dynamic_cast<TNN_NS::ReshapeLayerParam*>(GetLayer(1)->param.get());
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(param->shape, std::vector<int>({6, -1, 1, 1}));
+    EXPECT_EQ(net_structure_.blobs_shape_map["y2"], TNN_NS::DimsVector({6, 20, 1, 1}));
+}
+
+TEST_F(OnnxConverterTest, PoolSymmetricPads) {
+    // the pads are all covered by the windows, the shape inference keeps them
+    AddInput("x", {1, 2, 5, 6});
+    auto node = AddNode("MaxPool", {"x"}, "y");
+    SetAttribute(node, "kernel_shape", std::vector<int64_t>{3, 2});
+    SetAttribute(node, "strides", std::vector<int64_t>{2, 2});
+    SetAttribute(node, "pads", std::vector<int64_t>{1, 0, 1, 0});
+    AddOutput("y");
+    ASSERT_EQ((int)Convert(), (int)TNN_NS::TNN_CONVERT_OK);
+
+    auto param = dynamic_cast<TNN_NS::PoolingLayerParam*>(GetLayer(0)->param.get());
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(param->pool_type, 0);
+    EXPECT_EQ(param->kernels, std::vector<int>({2, 3}));
+    EXPECT_EQ(param->pads, std::vector<int>({0, 0, 1, 1}));
+    EXPECT_EQ(net_structure_.blobs_shape_map["y"], TNN_NS::DimsVector({1, 2, 3, 3}));
+}
+
+TEST_F(OnnxConverterTest, PoolAsymmetricPadsRejected) {
+    AddInput("x", {1, 2, 6, 6});
+    auto node = AddNode("AveragePool", {"x"}, "y");
+    SetAttribute(node, "kernel_shape", std::vector<int64_t>{2, 2});
+    SetAttribute(node, "pads", std::vector<int64_t>{0, 0, 1, 1});
+    AddOutput("y");
+    EXPECT_EQ((int)Convert(), (int)TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER);
+}
+
+TEST_F(OnnxConverterTest, ExternalDataRejected) {
+    AddInput("x", {1, 2, 5, 5});
+    auto weight = AddInitializer("w", onnx::TensorProto());
+    weight->set_data_type(onnx::TensorProto::FLOAT);
+    for (const auto dim : {3, 2, 3, 3}) {
+        weight->add_dims(dim);
+    }
+    weight->set_data_location(onnx::TensorProto::EXTERNAL);
+    auto location = weight->add_external_data();
+    location->set_key("location");
+    location->set_value("weights.bin");
+    SetAttribute(AddNode("Conv", {"x", "w"}, "y"), "kernel_shape", std::vector<int64_t>{3, 3});
+    AddOutput("y");
+    EXPECT_EQ((int)Convert(), (int)TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER);
+
+    // tensors read directly report the missing data too
+    std::vector<float> values;
+    EXPECT_FALSE(GetTensorFloats(*weight, values));
+}
+
+}  // namespace TNN_CONVERTER
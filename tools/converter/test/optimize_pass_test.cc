@@ -0,0 +1,208 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "optimizer/tnn_optimize_pass.h"
+#include "tnn/interpreter/layer_resource.h"
+
+namespace TNN_CONVERTER {
+
+class OptimizePassTest : public ::testing::Test {
+protected:
+    void RunPass(const std::string& pass_name) {
+        auto pass = TnnOptimizePassManager::get()->search(pass_name);
+        ASSERT_NE(pass, nullptr);
+        ASSERT_EQ((int)pass->exec(net_structure_, net_resource_), (int)TNN_NS::TNN_CONVERT_OK);
+    }
+
+    template <typename T>
+    std::shared_ptr<T> AddLayer(TNN_NS::LayerType type, const std::string& type_str, const std::string& name,
+                                const std::string& input, const std::string& output) {
+        auto param = std::make_shared<T>();
+        // pad params hide the type of LayerParam
+        static_cast<TNN_NS::LayerParam*>(param.get())->type = type_str;
+        param->name                                         = name;
+
+        auto layer      = std::make_shared<TNN_NS::LayerInfo>();
+        layer->type     = type;
+        layer->type_str = type_str;
+        layer->name     = name;
+        layer->inputs   = {input};
+        layer->outputs  = {output};
+        layer->param    = param;
+        net_structure_.layers.push_back(layer);
+        net_structure_.blobs.insert(input);
+        net_structure_.blobs.insert(output);
+        return param;
+    }
+
+    // 3x3 conv of 2 to 2 channels with explicit pads
+    std::shared_ptr<TNN_NS::ConvLayerParam> AddConv(const std::string& name, const std::string& input,
+                                                    const std::string& output, int pad) {
+        auto param            = AddLayer<TNN_NS::ConvLayerParam>(TNN_NS::LAYER_CONVOLUTION, "Convolution", name,
+                                                                 input, output);
+        param->input_channel  = 2;
+        param->output_channel = 2;
+        param->kernels        = {3, 3};
+        param->strides        = {1, 1};
+        param->dialations     = {1, 1};
+        param->pads           = {pad, pad, pad, pad};
+        param->bias           = 1;
+
+        auto resource                    = std::make_shared<TNN_NS::ConvLayerResource>();
+        resource->filter_handle          = MakeBuffer(std::vector<float>(2 * 2 * 3 * 3, 1.0f));
+        resource->bias_handle            = MakeBuffer({1.0f, 2.0f});
+        net_resource_.resource_map[name] = resource;
+        return param;
+    }
+
+    // binary layer with a constant second operand
+    void AddConstBinary(TNN_NS::LayerType type, const std::string& type_str, const std::string& name,
+                        const std::string& input, const std::string& output, const std::vector<float>& values) {
+        AddLayer<TNN_NS::MultidirBroadcastLayerParam>(type, type_str, name, input, output);
+        auto resource                    = std::make_shared<TNN_NS::EltwiseLayerResource>();
+        resource->element_handle         = MakeBuffer(values);
+        resource->element_shape          = {1, (int)values.size(), 1, 1};
+        net_resource_.resource_map[name] = resource;
+    }
+
+    static TNN_NS::RawBuffer MakeBuffer(const std::vector<float>& values) {
+        TNN_NS::RawBuffer buffer(values.size() * sizeof(float));
+        memcpy(buffer.force_to<float*>(), values.data(), values.size() * sizeof(float));
+        return buffer;
+    }
+
+    std::vector<float> GetElements(const std::string& name) {
+        auto resource = dynamic_cast<TNN_NS::EltwiseLayerResource*>(net_resource_.resource_map[name].get());
+        auto data     = resource->element_handle.force_to<float*>();
+        return std::vector<float>(data, data + resource->element_handle.GetDataCount());
+    }
+
+    TNN_NS::ConvLayerResource* GetConvResource(const std::string& name) {
+        return dynamic_cast<TNN_NS::ConvLayerResource*>(net_resource_.resource_map[name].get());
+    }
+
+    TNN_NS::NetStructure net_structure_;
+    TNN_NS::NetResource net_resource_;
+};
+
+TEST_F(OptimizePassTest, FuseConvPad) {
+    auto pad_param  = AddLayer<TNN_NS::PadLayerParam>(TNN_NS::LAYER_PAD, "Pad", "pad", "input", "padded");
+    pad_param->pads = {1, 1, 1, 1, 0, 0};
+    auto conv_param        = AddConv("conv", "padded", "output", 1);
+    net_structure_.outputs = {"output"};
+
+    RunPass("FuseConvPad");
+    ASSERT_EQ(net_structure_.layers.size(), 1);
+    EXPECT_EQ(net_structure_.layers[0]->inputs[0], "input");
+    EXPECT_EQ(conv_param->pads, std::vector<int>({2, 2, 2, 2}));
+}
+
+TEST_F(OptimizePassTest, FuseConvPadKeepsAsymmetricPads) {
+    auto pad_param  = AddLayer<TNN_NS::PadLayerParam>(TNN_NS::LAYER_PAD, "Pad", "pad", "input", "padded");
+    pad_param->pads = {0, 1, 0, 1, 0, 0};
+    auto conv_param        = AddConv("conv", "padded", "output", 0);
+    net_structure_.outputs = {"output"};
+
+    RunPass("FuseConvPad");
+    EXPECT_EQ(net_structure_.layers.size(), 2);
+    EXPECT_EQ(conv_param->pads, std::vector<int>({0, 0, 0, 0}));
+}
+
+TEST_F(OptimizePassTest, FoldConstants) {
+    // ((x - a) + b) / c * d becomes (x + (b - a)) * (d / c)
+    AddConstBinary(TNN_NS::LAYER_SUB, "Sub", "sub", "input", "blob0", {1.0f, 2.0f});
+    AddConstBinary(TNN_NS::LAYER_ADD, "Add", "add", "blob0", "blob1", {4.0f, 4.0f});
+    AddConstBinary(TNN_NS::LAYER_DIV, "Div", "div", "blob1", "blob2", {2.0f, 4.0f});
+    AddConstBinary(TNN_NS::LAYER_MUL, "Mul", "mul", "blob2", "output", {3.0f, 3.0f});
+    net_structure_.outputs = {"output"};
+
+    RunPass("FoldConstants");
+    ASSERT_EQ(net_structure_.layers.size(), 2);
+    EXPECT_EQ(net_structure_.layers[0]->type, TNN_NS::LAYER_ADD);
+    EXPECT_EQ(net_structure_.layers[0]->inputs[0], "input");
+    EXPECT_EQ(GetElements(net_structure_.layers[0]->name), std::vector<float>({3.0f, 2.0f}));
+    EXPECT_EQ(net_structure_.layers[1]->type, TNN_NS::LAYER_MUL);
+    EXPECT_EQ(net_structure_.layers[1]->inputs[0], net_structure_.layers[0]->outputs[0]);
+    EXPECT_EQ(net_structure_.layers[1]->outputs[0], "output");
+    EXPECT_EQ(GetElements(net_structure_.layers[1]->name), std::vector<float>({1.5f, 0.75f}));
+    EXPECT_EQ(net_resource_.resource_map.size(), 2);
+}
+
+TEST_F(OptimizePassTest, FuseConvScale) {
+    AddConv("conv", "input", "blob0", 1);
+    AddLayer<TNN_NS::BatchNormLayerParam>(TNN_NS::LAYER_BATCH_NORM, "BatchNormCxx", "bn", "blob0", "output");
+    auto bn_resource                 = std::make_shared<TNN_NS::BatchNormLayerResource>();
+    bn_resource->scale_handle        = MakeBuffer({2.0f, 0.5f});
+    bn_resource->bias_handle         = MakeBuffer({1.0f, -1.0f});
+    net_resource_.resource_map["bn"] = bn_resource;
+    net_structure_.outputs           = {"output"};
+
+    RunPass("FuseConvScale");
+    ASSERT_EQ(net_structure_.layers.size(), 1);
+    EXPECT_EQ(net_structure_.layers[0]->outputs[0], "output");
+    EXPECT_EQ(net_resource_.resource_map.count("bn"), 0);
+
+    auto resource = GetConvResource("conv");
+    auto weight   = resource->filter_handle.force_to<float*>();
+    auto bias     = resource->bias_handle.force_to<float*>();
+    EXPECT_FLOAT_EQ(weight[0], 2.0f);
+    EXPECT_FLOAT_EQ(weight[2 * 3 * 3], 0.5f);
+    EXPECT_FLOAT_EQ(bias[0], 1.0f * 2.0f + 1.0f);
+    EXPECT_FLOAT_EQ(bias[1], 2.0f * 0.5f - 1.0f);
+}
+
+TEST_F(OptimizePassTest, FuseConvActivation) {
+    auto conv_param = AddConv("conv", "input", "blob0", 1);
+    AddLayer<TNN_NS::LayerParam>(TNN_NS::LAYER_RELU, "ReLU", "relu", "blob0", "blob1");
+    AddLayer<TNN_NS::LayerParam>(TNN_NS::LAYER_RELU6, "ReLU6", "relu6", "blob1", "output");
+    net_structure_.outputs = {"output"};
+
+    RunPass("FuseConvActivation");
+    ASSERT_EQ(net_structure_.layers.size(), 1);
+    EXPECT_EQ(net_structure_.layers[0]->outputs[0], "output");
+    EXPECT_EQ(conv_param->activation_type, TNN_NS::ActivationType_ReLU6);
+}
+
+TEST_F(OptimizePassTest, FuseConvActivationSkipsQuantizedConv) {
+    auto conv_param       = AddConv("conv", "input", "blob0", 1);
+    conv_param->quantized = true;
+    AddLayer<TNN_NS::LayerParam>(TNN_NS::LAYER_RELU, "ReLU", "relu", "blob0", "output");
+    net_structure_.outputs = {"output"};
+
+    RunPass("FuseConvActivation");
+    EXPECT_EQ(net_structure_.layers.size(), 2);
+    EXPECT_EQ(conv_param->activation_type, TNN_NS::ActivationType_None);
+}
+
+TEST_F(OptimizePassTest, EliminateUnusedLayers) {
+    AddConv("conv", "input", "blob0", 1);
+    AddLayer<TNN_NS::LayerParam>(TNN_NS::LAYER_RELU, "ReLU", "relu", "blob0", "output");
+    // a branch reaching no output of the net
+    AddConv("unused_conv", "blob0", "blob1", 1);
+    AddLayer<TNN_NS::LayerParam>(TNN_NS::LAYER_SIGMOID, "Sigmoid", "unused_sigmoid", "blob1", "blob2");
+    net_structure_.outputs = {"output"};
+
+    RunPass("EliminateUnusedLayers");
+    ASSERT_EQ(net_structure_.layers.size(), 2);
+    EXPECT_EQ(net_structure_.layers[0]->name, "conv");
+    EXPECT_EQ(net_structure_.layers[1]->name, "relu");
+    EXPECT_EQ(net_resource_.resource_map.count("conv"), 1);
+    EXPECT_EQ(net_resource_.resource_map.count("unused_conv"), 0);
+}
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,165 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fstream>
+#include <string>
+
+#include "model_compiler.h"
+#include "tnn/core/common.h"
+#include "tnn/utils/split_utils.h"
+
+using namespace TNN_NS;
+
+int InitModelConfig(ModelConfig& model_config, std::string proto_file, std::string model_file) {
+    {
+        std::ifstream proto_stream(proto_file);
+        if (!proto_stream.is_open() || !proto_stream.good()) {
+            printf("read proto_file failed!\n");
+            return -1;
+        }
+        auto buffer =
+            std::string((std::istreambuf_iterator<char>(proto_stream)), std::istreambuf_iterator<char>());
+        model_config.params.push_back(buffer);
+    }
+
+    {
+        std::ifstream model_stream(model_file, std::ios::binary);
+        if (!model_stream.is_open() || !model_stream.good()) {
+            printf("read model_file failed!\n");
+            return -1;
+        }
+        auto buffer =
+            std::string((std::istreambuf_iterator<char>(model_stream)), std::istreambuf_iterator<char>());
+        model_config.params.push_back(buffer);
+    }
+    return 0;
+}
+
+// @brief parse input shapes as name[n,c,h,w];name2[n,c,h,w]
+bool ParseInputShapes(std::string message, InputShapesMap& input_shapes) {
+    std::vector<std::string> inputs;
+    SplitUtils::SplitStr(message.c_str(), inputs, ";");
+    for (auto& input : inputs) {
+        auto begin = input.find('[');
+        auto end   = input.rfind(']');
+        if (begin == std::string::npos || end == std::string::npos || end < begin) {
+            return false;
+        }
+        std::vector<std::string> dims;
+        SplitUtils::SplitStr(input.substr(begin + 1, end - begin - 1).c_str(), dims, ",");
+        DimsVector shape;
+        for (auto& dim : dims) {
+            shape.push_back(atoi(dim.c_str()));
+        }
+        input_shapes[input.substr(0, begin)] = shape;
+    }
+    return true;
+}
+
+void PrintConfig() {
+    printf(
+        "usage:\n./tnn2cpp [-h] [-p] [-m] [-i] [-o] [-n]\n"
+        "\t-h, --help     \t show this message\n"
+        "\t-p, --proto    \t(require) tnn proto file path\n"
+        "\t-m, --model    \t(require) tnn model file path\n"
+        "\t-i, --input    \t(optional) fixed input shapes, ie, data[1,3,224,224];mask[1,1,224,224], "
+        "the shapes in proto by default\n"
+        "\t-o, --output   \t(optional) directory of the generated files, current directory by default\n"
+        "\t-n, --name     \t(optional) name of the generated namespace and files, model by default\n");
+}
+
+int main(int argc, char* argv[]) {
+    std::string proto_file_name;
+    std::string model_file_name;
+    std::string output_dir;
+    std::string name = "model";
+    InputShapesMap input_shapes;
+
+    struct option long_options[] = {{"proto", required_argument, 0, 'p'}, {"model", required_argument, 0, 'm'},
+                                    {"input", required_argument, 0, 'i'}, {"output", required_argument, 0, 'o'},
+                                    {"name", required_argument, 0, 'n'},  {"help", no_argument, 0, 'h'},
+                                    {0, 0, 0, 0}};
+
+    const char* optstring = "p:m:i:o:n:h";
+
+    if (argc == 1) {
+        PrintConfig();
+        return 0;
+    }
+
+    while (1) {
+        int c = getopt_long(argc, argv, optstring, long_options, nullptr);
+        if (c == -1)
+            break;
+
+        switch (c) {
+            case 'p':
+                printf("proto: %s\n", optarg);
+                proto_file_name = optarg;
+                break;
+            case 'm':
+                printf("model: %s\n", optarg);
+                model_file_name = optarg;
+                break;
+            case 'i':
+                printf("input shapes: %s\n", optarg);
+                if (!ParseInputShapes(optarg, input_shapes)) {
+                    printf("invalid input shapes: %s\n", optarg);
+                    return -1;
+                }
+                break;
+            case 'o':
+                printf("output dir: %s\n", optarg);
+                output_dir = optarg;
+                break;
+            case 'n':
+                printf("name: %s\n", optarg);
+                name = optarg;
+                break;
+            case 'h':
+            case '?':
+                PrintConfig();
+                return 0;
+            default:
+                PrintConfig();
+                break;
+        }
+    }
+
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+    if (InitModelConfig(model_config, proto_file_name, model_file_name) != 0) {
+        return -1;
+    }
+
+    ModelCompiler compiler;
+    Status status = compiler.Init(model_config, input_shapes);
+    if (status != TNN_OK) {
+        printf("tnn2cpp init failed: %s\n", status.description().c_str());
+        return -1;
+    }
+
+    status = compiler.Compile(output_dir, name);
+    if (status != TNN_OK) {
+        printf("tnn2cpp compile failed: %s\n", status.description().c_str());
+        return -1;
+    }
+    printf("tnn2cpp success!\n");
+
+    return 0;
+}
@@ -0,0 +1,718 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "model_compiler.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+#include "tnn/core/blob.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+// source of tnn_aot_kernels.h, embedded at build time
+extern const char* kAotKernelsSource;
+
+// blobs in the arena are aligned to 64 bytes
+static const long long kArenaAlignment = 16;
+
+// output channels of a block of the packed convolution weights, kConvOcBlock of tnn_aot_kernels.h
+static const int kConvOcBlock = 4;
+
+static std::string Sanitize(const std::string& name) {
+    std::string identifier = name;
+    for (auto& c : identifier) {
+        if (!isalnum(c)) {
+            c = '_';
+        }
+    }
+    if (identifier.empty() || isdigit(identifier[0])) {
+        identifier = "_" + identifier;
+    }
+    return identifier;
+}
+
+static std::string FormatFloat(float value) {
+    if (std::isnan(value)) {
+        return "std::numeric_limits<float>::quiet_NaN()";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "std::numeric_limits<float>::infinity()" : "-std::numeric_limits<float>::infinity()";
+    }
+    // 9 significant digits restore the same float
+    char text[32];
+    snprintf(text, sizeof(text), "%.9g", value);
+    std::string literal = text;
+    if (literal.find_first_of(".e") == std::string::npos) {
+        literal += ".0";
+    }
+    return literal + "f";
+}
+
+static std::string FormatDims(const DimsVector& dims) {
+    std::stringstream ss;
+    ss << "[";
+    for (int i = 0; i < dims.size(); ++i) {
+        ss << (i > 0 ? ", " : "") << dims[i];
+    }
+    ss << "]";
+    return ss.str();
+}
+
+// @brief template arguments of a kernel
+static std::string FormatArguments(const std::vector<long long>& arguments) {
+    std::stringstream ss;
+    for (int i = 0; i < arguments.size(); ++i) {
+        ss << (i > 0 ? ", " : "") << arguments[i];
+    }
+    return ss.str();
+}
+
+// @brief float data of a buffer, half buffers are converted
+static std::vector<float> GetFloatData(RawBuffer& buffer) {
+    RawBuffer float_buffer = buffer;
+    if (buffer.GetDataType() == DATA_TYPE_HALF) {
+        float_buffer = ConvertHalfHandle(buffer);
+    } else if (buffer.GetDataType() != DATA_TYPE_FLOAT) {
+        return std::vector<float>();
+    }
+    float* data = float_buffer.force_to<float*>();
+    int count   = float_buffer.GetBytesSize() / sizeof(float);
+    return data ? std::vector<float>(data, data + count) : std::vector<float>();
+}
+
+static void WriteFloatArray(std::stringstream& ss, const std::string& name, const std::vector<float>& data) {
+    ss << "alignas(64) const float " << name << "[" << data.size() << "] = {";
+    for (size_t i = 0; i < data.size(); ++i) {
+        ss << (i % 8 == 0 ? "\n    " : " ") << FormatFloat(data[i]) << ",";
+    }
+    ss << "\n};\n\n";
+}
+
+static Status UnsupportedError(LayerInfo* layer, const std::string& reason) {
+    LOGE("tnn2cpp: layer %s (%s) is not supported, %s\n", layer->name.c_str(), layer->type_str.c_str(),
+         reason.c_str());
+    return Status(TNNERR_LAYER_ERR, "layer is not supported by tnn2cpp");
+}
+
+static bool IsAliasLayer(LayerInfo* layer) {
+    if (layer->type == LAYER_FLATTEN || layer->type == LAYER_DROPOUT) {
+        return true;
+    }
+    // nchw reshape keeps the order of the data
+    auto reshape_param = dynamic_cast<ReshapeLayerParam*>(layer->param.get());
+    return layer->type == LAYER_RESHAPE && reshape_param && reshape_param->reshape_type == 0;
+}
+
+ModelCompiler::ModelCompiler() {}
+
+ModelCompiler::~ModelCompiler() {
+    instance_.reset();
+    interpreter_.reset();
+}
+
+Status ModelCompiler::Init(ModelConfig& model_config, InputShapesMap inputs_shape) {
+    DefaultModelInterpreter* interpreter =
+        dynamic_cast<DefaultModelInterpreter*>(CreateModelInterpreter(model_config.model_type));
+    if (!interpreter) {
+        return Status(TNNERR_NET_ERR, "interpreter is nil");
+    }
+    interpreter_ = std::shared_ptr<DefaultModelInterpreter>(interpreter);
+
+    Status status = interpreter_->Interpret(model_config.params);
+    if (status != TNN_OK) {
+        LOGE("interpret the model falied!\n");
+        return TNNERR_INVALID_MODEL;
+    }
+
+    // the naive device runs the float layers of the model, its blobs have the shapes to compile
+    NetworkConfig net_config;
+    net_config.device_type = DEVICE_NAIVE;
+    net_config.precision   = PRECISION_HIGH;
+    instance_              = std::make_shared<Instance>(net_config, model_config);
+    status = instance_->Init(std::static_pointer_cast<AbstractModelInterpreter>(interpreter_), inputs_shape);
+    if (status != TNN_OK) {
+        LOGE("create instance falied!\n");
+        return TNNERR_INST_ERR;
+    }
+
+    return InferShapes();
+}
+
+Status ModelCompiler::InferShapes() {
+    BlobMap input_blobs;
+    instance_->GetAllInputBlobs(input_blobs);
+    for (auto item : input_blobs) {
+        auto& desc = item.second->GetBlobDesc();
+        if (desc.data_type != DATA_TYPE_FLOAT) {
+            LOGE("tnn2cpp: input %s is not float\n", item.first.c_str());
+            return Status(TNNERR_INVALID_MODEL, "input of the model is not float");
+        }
+        blobs_[item.first].dims     = desc.dims;
+        blobs_[item.first].is_input = true;
+        input_names_.push_back(item.first);
+        memset(item.second->GetHandle().base, 0, DimsVectorUtils::Count(desc.dims) * sizeof(float));
+    }
+
+    BlobMap output_blobs;
+    instance_->GetAllOutputBlobs(output_blobs);
+    for (auto item : output_blobs) {
+        blobs_[item.first].is_output = true;
+        output_names_.push_back(item.first);
+    }
+
+    // one forward visits the layers in order with the blobs of the fixed shapes
+    BlobStatisticCallback before = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
+        CompiledStep step;
+        step.layer = info;
+        for (auto blob : blobs) {
+            step.inputs.push_back(blob->GetBlobDesc().name);
+        }
+        steps_.push_back(step);
+    };
+    BlobStatisticCallback after = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
+        for (auto blob : blobs) {
+            auto& desc = blob->GetBlobDesc();
+            steps_.back().outputs.push_back(desc.name);
+            blobs_[desc.name].dims = desc.dims;
+        }
+    };
+    return instance_->ForwardWithCallback(before, after);
+}
+
+Status ModelCompiler::FuseActivations() {
+    std::map<std::string, int> consumers;
+    for (auto& step : steps_) {
+        for (auto& input : step.inputs) {
+            consumers[input]++;
+        }
+    }
+
+    std::vector<CompiledStep> steps;
+    std::set<int> fused;
+    for (int i = 0; i < steps_.size(); ++i) {
+        if (fused.count(i) > 0) {
+            continue;
+        }
+        CompiledStep step = steps_[i];
+        auto conv_param   = dynamic_cast<ConvLayerParam*>(step.layer->param.get());
+        if (step.layer->type == LAYER_CONVOLUTION && conv_param &&
+            conv_param->activation_type == ActivationType_None && step.outputs.size() == 1) {
+            const std::string output = step.outputs[0];
+            for (int j = i + 1; j < steps_.size() && consumers[output] == 1 && !blobs_[output].is_output; ++j) {
+                auto& next = steps_[j];
+                if (std::find(next.inputs.begin(), next.inputs.end(), output) == next.inputs.end()) {
+                    continue;
+                }
+                if (next.layer->type == LAYER_RELU || next.layer->type == LAYER_RELU6) {
+                    step.activation = next.layer->type == LAYER_RELU ? ActivationType_ReLU : ActivationType_ReLU6;
+                    step.outputs    = next.outputs;
+                    blobs_.erase(output);
+                    fused.insert(j);
+                }
+                break;
+            }
+        }
+        if (IsAliasLayer(step.layer) && step.inputs.size() == 1 && !blobs_[step.outputs[0]].is_output) {
+            step.alias                       = true;
+            blobs_[step.outputs[0]].alias_of = step.inputs[0];
+        }
+        steps.push_back(step);
+    }
+    steps_ = steps;
+    return TNN_OK;
+}
+
+std::string ModelCompiler::GetStorage(std::string blob) {
+    while (!blobs_[blob].alias_of.empty()) {
+        blob = blobs_[blob].alias_of;
+    }
+    return blob;
+}
+
+Status ModelCompiler::PlanMemory() {
+    for (int i = 0; i < steps_.size(); ++i) {
+        for (auto& name : steps_[i].inputs) {
+            auto& storage    = blobs_[GetStorage(name)];
+            storage.last_use = std::max(storage.last_use, i);
+        }
+        for (auto& name : steps_[i].outputs) {
+            auto& storage = blobs_[GetStorage(name)];
+            if (storage.first_use < 0) {
+                storage.first_use = i;
+            }
+            storage.last_use = std::max(storage.last_use, i);
+        }
+    }
+
+    // greedy by size, each blob takes the lowest offset free during its lifetime
+    std::vector<std::string> arena_blobs;
+    for (auto& item : blobs_) {
+        auto& blob = item.second;
+        if (!blob.is_input && !blob.is_output && blob.alias_of.empty() && blob.first_use >= 0) {
+            arena_blobs.push_back(item.first);
+        }
+    }
+    auto size_of = [&](const std::string& name) {
+        long long count = DimsVectorUtils::Count(blobs_[name].dims);
+        return (count + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment;
+    };
+    std::stable_sort(arena_blobs.begin(), arena_blobs.end(),
+                     [&](const std::string& a, const std::string& b) { return size_of(a) > size_of(b); });
+
+    std::vector<std::string> placed;
+    arena_size_ = 0;
+    for (auto& name : arena_blobs) {
+        auto& blob = blobs_[name];
+        std::vector<std::pair<long long, long long>> used;
+        for (auto& other_name : placed) {
+            auto& other = blobs_[other_name];
+            if (other.first_use <= blob.last_use && blob.first_use <= other.last_use) {
+                used.push_back(std::make_pair(other.offset, other.offset + size_of(other_name)));
+            }
+        }
+        std::sort(used.begin(), used.end());
+
+        long long offset = 0;
+        for (auto& range : used) {
+            if (range.first - offset >= size_of(name)) {
+                break;
+            }
+            offset = std::max(offset, range.second);
+        }
+        blob.offset = offset;
+        arena_size_ = std::max(arena_size_, offset + size_of(name));
+        placed.push_back(name);
+    }
+    return TNN_OK;
+}
+
+std::string ModelCompiler::GetArgument(std::string blob) {
+    // a name starting with a digit is sanitized to _name
+    std::string identifier = Sanitize(blob);
+    identifier             = identifier[0] == '_' ? identifier.substr(1) : identifier;
+    return (blobs_[blob].is_input ? "input_" : "output_") + identifier;
+}
+
+std::string ModelCompiler::GetPointer(std::string blob, long long offset) {
+    std::string storage = GetStorage(blob);
+    if (blobs_[storage].is_input || blobs_[storage].is_output) {
+        return GetArgument(storage) + (offset > 0 ? " + " + std::to_string(offset) : "");
+    }
+    return "g_arena + " + std::to_string(blobs_[storage].offset + offset);
+}
+
+std::string ModelCompiler::GetWeightName(CompiledStep& step, std::string suffix) {
+    std::string base = Sanitize(step.layer->name) + "_" + suffix;
+    std::string name = base;
+    for (int i = 1; weight_names_.count(name) > 0; ++i) {
+        name = base + "_" + std::to_string(i);
+    }
+    weight_names_.insert(name);
+    return name;
+}
+
+Status ModelCompiler::GenerateConvolution(CompiledStep& step, std::stringstream& weights,
+                                          std::stringstream& body) {
+    auto layer    = step.layer;
+    auto param    = dynamic_cast<ConvLayerParam*>(layer->param.get());
+    auto resource = dynamic_cast<ConvLayerResource*>(interpreter_->GetNetResource()->resource_map[layer->name].get());
+    if (!param || !resource) {
+        return UnsupportedError(layer, "param or resource is missing");
+    }
+    auto input_dims  = blobs_[step.inputs[0]].dims;
+    auto output_dims = blobs_[step.outputs[0]].dims;
+    if (input_dims.size() != 4 || param->kernels.size() != 2 || resource->filter_format != OIHW) {
+        return UnsupportedError(layer, "only 2d convolution is supported");
+    }
+    int activation = step.activation != ActivationType_None ? step.activation : param->activation_type;
+    if (activation != ActivationType_None && activation != ActivationType_ReLU &&
+        activation != ActivationType_ReLU6) {
+        return UnsupportedError(layer, "activation type " + std::to_string(activation));
+    }
+
+    const int group = param->group;
+    const int ic = input_dims[1], oc = output_dims[1], kh = param->kernels[1], kw = param->kernels[0];
+    const int icg = ic / group, ocg = oc / group;
+    std::vector<float> filter = GetFloatData(resource->filter_handle);
+    if (filter.size() != (size_t)oc * icg * kh * kw) {
+        return UnsupportedError(layer, "filter of " + std::to_string(filter.size()) + " floats");
+    }
+
+    std::vector<long long> shapes = {input_dims[0], ic, input_dims[2], input_dims[3], oc, output_dims[2],
+                                     output_dims[3], kh, kw, param->strides[1], param->strides[0], param->pads[2],
+                                     param->pads[0], param->dialations[1], param->dialations[0]};
+    std::string weight_name = GetWeightName(step, "weight");
+    std::string kernel;
+    if (group == ic && group == oc) {
+        // depthwise weights are used as they are
+        shapes.erase(shapes.begin() + 4);
+        kernel = "DepthwiseConv2d<" + FormatArguments(shapes) + ", " + std::to_string(activation) + ">";
+        WriteFloatArray(weights, weight_name, filter);
+    } else {
+        // [G][OCB][ICG][KH][KW][kConvOcBlock], the output channels of a tap are contiguous
+        const int ocb = (ocg + kConvOcBlock - 1) / kConvOcBlock;
+        std::vector<float> packed((size_t)group * ocb * icg * kh * kw * kConvOcBlock, 0.0f);
+        for (int o = 0; o < oc; ++o) {
+            const int g = o / ocg, b = (o % ocg) / kConvOcBlock, j = (o % ocg) % kConvOcBlock;
+            for (int i = 0; i < icg * kh * kw; ++i) {
+                packed[(((size_t)g * ocb + b) * icg * kh * kw + i) * kConvOcBlock + j] =
+                    filter[(size_t)o * icg * kh * kw + i];
+            }
+        }
+        shapes.push_back(group);
+        kernel = "Conv2d<" + FormatArguments(shapes) + ", " + std::to_string(activation) + ">";
+        WriteFloatArray(weights, weight_name, packed);
+        filter = packed;
+    }
+    weight_size_ += filter.size() * sizeof(float);
+
+    std::string bias_name = "nullptr";
+    std::vector<float> bias = GetFloatData(resource->bias_handle);
+    if (param->bias && !bias.empty()) {
+        if (bias.size() != oc) {
+            return UnsupportedError(layer, "bias of " + std::to_string(bias.size()) + " floats");
+        }
+        bias_name = GetWeightName(step, "bias");
+        WriteFloatArray(weights, bias_name, bias);
+        weight_size_ += bias.size() * sizeof(float);
+    }
+
+    body << "    " << kernel << "(" << GetPointer(step.inputs[0]) << ", " << weight_name << ", " << bias_name << ", "
+         << GetPointer(step.outputs[0]) << ");\n";
+    return TNN_OK;
+}
+
+Status ModelCompiler::GenerateInnerProduct(CompiledStep& step, std::stringstream& weights,
+                                           std::stringstream& body) {
+    auto layer    = step.layer;
+    auto param    = dynamic_cast<InnerProductLayerParam*>(layer->param.get());
+    auto resource =
+        dynamic_cast<InnerProductLayerResource*>(interpreter_->GetNetResource()->resource_map[layer->name].get());
+    if (!param || !resource || param->transpose != 0 || param->axis != 1) {
+        return UnsupportedError(layer, "only axis 1 without transpose is supported");
+    }
+    auto input_dims = blobs_[step.inputs[0]].dims;
+    const int n = input_dims[0], ic = DimsVectorUtils::Count(input_dims, 1), oc = param->num_output;
+    std::vector<float> weight = GetFloatData(resource->weight_handle);
+    if (weight.size() != (size_t)oc * ic) {
+        return UnsupportedError(layer, "weight of " + std::to_string(weight.size()) + " floats");
+    }
+    std::string weight_name = GetWeightName(step, "weight");
+    WriteFloatArray(weights, weight_name, weight);
+    weight_size_ += weight.size() * sizeof(float);
+
+    std::string bias_name = "nullptr";
+    std::vector<float> bias = GetFloatData(resource->bias_handle);
+    if (param->has_bias && !bias.empty()) {
+        bias_name = GetWeightName(step, "bias");
+        WriteFloatArray(weights, bias_name, bias);
+        weight_size_ += bias.size() * sizeof(float);
+    }
+
+    body << "    InnerProduct<" << FormatArguments({n, ic, oc}) << ">(" << GetPointer(step.inputs[0]) << ", "
+         << weight_name << ", " << bias_name << ", " << GetPointer(step.outputs[0]) << ");\n";
+    return TNN_OK;
+}
+
+Status ModelCompiler::GenerateScale(CompiledStep& step, std::stringstream& weights, std::stringstream& body) {
+    auto layer = step.layer;
+    auto resource =
+        dynamic_cast<BatchNormLayerResource*>(interpreter_->GetNetResource()->resource_map[layer->name].get());
+    auto dims = blobs_[step.inputs[0]].dims;
+    if (!resource || dims.size() < 2) {
+        return UnsupportedError(layer, "resource is missing");
+    }
+    const int channel         = dims[1];
+    std::vector<float> scale = GetFloatData(resource->scale_handle);
+    std::vector<float> bias  = GetFloatData(resource->bias_handle);
+    // a single value is shared by all channels
+    if (scale.size() == 1) {
+        scale.resize(channel, scale[0]);
+    }
+    if (bias.size() == 1) {
+        bias.resize(channel, bias[0]);
+    }
+    if (scale.size() != channel || (!bias.empty() && bias.size() != channel)) {
+        return UnsupportedError(layer, "scale of " + std::to_string(scale.size()) + " floats");
+    }
+
+    std::string scale_name = GetWeightName(step, "scale");
+    WriteFloatArray(weights, scale_name, scale);
+    std::string bias_name = "nullptr";
+    if (!bias.empty()) {
+        bias_name = GetWeightName(step, "bias");
+        WriteFloatArray(weights, bias_name, bias);
+    }
+    weight_size_ += (scale.size() + bias.size()) * sizeof(float);
+
+    body << "    ScaleBias<" << FormatArguments({dims[0], channel, DimsVectorUtils::Count(dims, 2)}) << ">("
+         << GetPointer(step.inputs[0]) << ", " << scale_name << ", " << bias_name << ", "
+         << GetPointer(step.outputs[0]) << ");\n";
+    return TNN_OK;
+}
+
+Status ModelCompiler::GenerateStep(CompiledStep& step, std::stringstream& weights, std::stringstream& body) {
+    auto layer = step.layer;
+    if (layer->param && layer->param->quantized) {
+        return UnsupportedError(layer, "quantized layers are not supported");
+    }
+    if (step.outputs.size() != 1 || step.inputs.empty()) {
+        return UnsupportedError(layer, "only layers of one output are supported");
+    }
+
+    body << "    // " << layer->name << " (" << layer->type_str << ")";
+    if (step.activation != ActivationType_None) {
+        body << " with fused " << (step.activation == ActivationType_ReLU ? "relu" : "relu6");
+    }
+    body << ", " << FormatDims(blobs_[step.outputs[0]].dims) << "\n";
+    if (step.alias) {
+        body << "    // shares the memory of " << step.inputs[0] << "\n";
+        return TNN_OK;
+    }
+
+    const std::string input  = GetPointer(step.inputs[0]);
+    const std::string output = GetPointer(step.outputs[0]);
+    auto input_dims          = blobs_[step.inputs[0]].dims;
+    auto output_dims         = blobs_[step.outputs[0]].dims;
+    const long long count    = DimsVectorUtils::Count(output_dims);
+
+    switch (layer->type) {
+        case LAYER_CONVOLUTION:
+            return GenerateConvolution(step, weights, body);
+        case LAYER_INNER_PRODUCT:
+            return GenerateInnerProduct(step, weights, body);
+        case LAYER_BATCH_NORM:
+        case LAYER_SCALE:
+            return GenerateScale(step, weights, body);
+        case LAYER_POOLING: {
+            auto param = dynamic_cast<PoolingLayerParam*>(layer->param.get());
+            if (!param || input_dims.size() != 4 || (param->pool_type != 0 && param->pool_type != 1)) {
+                return UnsupportedError(layer, "only 2d max and average pooling are supported");
+            }
+            body << "    Pooling<"
+                 << FormatArguments({input_dims[0], input_dims[1], input_dims[2], input_dims[3], output_dims[2],
+                                     output_dims[3], param->kernels[1], param->kernels[0], param->strides[1],
+                                     param->strides[0], param->pads[2], param->pads[0], param->pool_type})
+                 << ">(" << input << ", " << output << ");\n";
+            break;
+        }
+        case LAYER_RELU:
+            body << "    Relu<" << count << ">(" << input << ", " << output << ");\n";
+            break;
+        case LAYER_RELU6:
+            body << "    Relu6<" << count << ">(" << input << ", " << output << ");\n";
+            break;
+        case LAYER_SIGMOID:
+            body << "    Sigmoid<" << count << ">(" << input << ", " << output << ");\n";
+            break;
+        case LAYER_ADD: {
+            if (step.inputs.size() != 2 || blobs_[step.inputs[1]].dims != output_dims || input_dims != output_dims) {
+                return UnsupportedError(layer, "only the add of two blobs of the same shape is supported");
+            }
+            body << "    Add<" << count << ">(" << input << ", " << GetPointer(step.inputs[1]) << ", " << output
+                 << ");\n";
+            break;
+        }
+        case LAYER_CONCAT: {
+            auto param = dynamic_cast<ConcatLayerParam*>(layer->param.get());
+            if (!param) {
+                return UnsupportedError(layer, "param is missing");
+            }
+            const int axis        = (param->axis + (int)output_dims.size()) % (int)output_dims.size();
+            const long long outer = DimsVectorUtils::Count(output_dims, 0, axis);
+            const long long inner = DimsVectorUtils::Count(output_dims, axis + 1);
+            long long offset      = 0;
+            for (auto& name : step.inputs) {
+                const long long size = blobs_[name].dims[axis] * inner;
+                body << "    ConcatInput<" << FormatArguments({outer, size, output_dims[axis] * inner}) << ">("
+                     << GetPointer(name) << ", " << GetPointer(step.outputs[0], offset) << ");\n";
+                offset += size;
+            }
+            break;
+        }
+        case LAYER_SOFTMAX: {
+            auto param = dynamic_cast<SoftmaxLayerParam*>(layer->param.get());
+            if (!param) {
+                return UnsupportedError(layer, "param is missing");
+            }
+            const int axis = (param->axis + (int)output_dims.size()) % (int)output_dims.size();
+            body << "    Softmax<"
+                 << FormatArguments({DimsVectorUtils::Count(output_dims, 0, axis), output_dims[axis],
+                                     DimsVectorUtils::Count(output_dims, axis + 1)})
+                 << ">(" << input << ", " << output << ");\n";
+            break;
+        }
+        case LAYER_SHUFFLE_CHANNEL: {
+            auto param = dynamic_cast<ShuffleLayerParam*>(layer->param.get());
+            if (!param || output_dims.size() < 2) {
+                return UnsupportedError(layer, "param is missing");
+            }
+            body << "    ShuffleChannel<"
+                 << FormatArguments(
+                        {output_dims[0], param->group, output_dims[1], DimsVectorUtils::Count(output_dims, 2)})
+                 << ">(" << input << ", " << output << ");\n";
+            break;
+        }
+        case LAYER_STRIDED_SLICE: {
+            auto param = dynamic_cast<StrideSliceLayerParam*>(layer->param.get());
+            if (!param || input_dims.size() != 4 || param->begins.size() != 4 || param->strides.size() != 4) {
+                return UnsupportedError(layer, "only 4 dims slices are supported");
+            }
+            // begins and strides are in the order [w h c n]
+            auto begins  = param->begins;
+            auto strides = param->strides;
+            std::reverse(begins.begin(), begins.end());
+            std::reverse(strides.begin(), strides.end());
+            body << "    StridedSlice<"
+                 << FormatArguments({input_dims[1], input_dims[2], input_dims[3], output_dims[0], output_dims[1],
+                                     output_dims[2], output_dims[3], begins[0], begins[1], begins[2], begins[3],
+                                     strides[0], strides[1], strides[2], strides[3]})
+                 << ">(" << input << ", " << output << ");\n";
+            break;
+        }
+        default:
+            if (IsAliasLayer(layer)) {
+                // a network output can not share the memory of its input
+                body << "    Copy<" << count << ">(" << input << ", " << output << ");\n";
+                break;
+            }
+            return UnsupportedError(layer, "no kernel in tnn_aot_kernels.h");
+    }
+    return TNN_OK;
+}
+
+Status ModelCompiler::WriteHeader(std::string path, std::string name) {
+    std::ofstream header(path);
+    if (!header.is_open()) {
+        LOGE("tnn2cpp: open %s failed\n", path.c_str());
+        return Status(TNNERR_COMMON_ERROR, "open output file failed");
+    }
+
+    std::string guard = "TNN_AOT_" + name + "_H_";
+    std::transform(guard.begin(), guard.end(), guard.begin(), ::toupper);
+    header << "// Generated by tnn2cpp, do not edit.\n\n";
+    header << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    header << "namespace tnn_aot {\nnamespace " << name << " {\n\n";
+
+    header << "// @brief run the model on nchw float blobs. The blobs inside the model live in\n"
+           << "// a static arena, calls must not overlap.\n";
+    std::vector<std::string> arguments;
+    for (auto& blob : input_names_) {
+        header << "// @param " << GetArgument(blob) << " " << FormatDims(blobs_[blob].dims) << "\n";
+        arguments.push_back("const float *" + GetArgument(blob));
+    }
+    for (auto& blob : output_names_) {
+        header << "// @param " << GetArgument(blob) << " " << FormatDims(blobs_[blob].dims) << "\n";
+        arguments.push_back("float *" + GetArgument(blob));
+    }
+    header << "void Forward(";
+    for (int i = 0; i < arguments.size(); ++i) {
+        header << (i > 0 ? ", " : "") << arguments[i];
+    }
+    header << ");\n\n";
+
+    header << "// bytes of the static arena and of the weights\n";
+    header << "static const long long kArenaBytes  = " << arena_size_ * sizeof(float) << ";\n";
+    header << "static const long long kWeightBytes = " << weight_size_ << ";\n\n";
+
+    header << "}  // namespace " << name << "\n}  // namespace tnn_aot\n\n";
+    header << "#endif  // " << guard << "\n";
+    return TNN_OK;
+}
+
+Status ModelCompiler::WriteSource(std::string path, std::string name) {
+    std::stringstream weights;
+    std::stringstream body;
+    for (auto& step : steps_) {
+        Status status = GenerateStep(step, weights, body);
+        if (status != TNN_OK) {
+            return status;
+        }
+    }
+
+    std::ofstream source(path);
+    if (!source.is_open()) {
+        LOGE("tnn2cpp: open %s failed\n", path.c_str());
+        return Status(TNNERR_COMMON_ERROR, "open output file failed");
+    }
+    source << "// Generated by tnn2cpp, do not edit.\n\n";
+    source << "#include \"" << name << ".h\"\n\n";
+    source << "#include <limits>\n\n";
+    source << "#include \"tnn_aot_kernels.h\"\n\n";
+    source << "namespace tnn_aot {\nnamespace " << name << " {\n\nnamespace {\n\n";
+    source << weights.str();
+    source << "// blobs inside the model, placed by their lifetimes\n";
+    source << "alignas(64) float g_arena[" << std::max(arena_size_, 1LL) << "];\n\n";
+    source << "}  // namespace\n\n";
+
+    source << "void Forward(";
+    bool first = true;
+    for (auto& blob : input_names_) {
+        source << (first ? "" : ", ") << "const float *" << GetArgument(blob);
+        first = false;
+    }
+    for (auto& blob : output_names_) {
+        source << (first ? "" : ", ") << "float *" << GetArgument(blob);
+        first = false;
+    }
+    source << ") {\n";
+    source << body.str();
+    source << "}\n\n";
+    source << "}  // namespace " << name << "\n}  // namespace tnn_aot\n";
+    return TNN_OK;
+}
+
+Status ModelCompiler::Compile(std::string output_dir, std::string name) {
+    name = Sanitize(name);
+    Status status = FuseActivations();
+    if (status != TNN_OK) {
+        return status;
+    }
+    status = PlanMemory();
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    std::string prefix = output_dir.empty() ? "" : output_dir + "/";
+    status             = WriteSource(prefix + name + ".cc", name);
+    if (status != TNN_OK) {
+        return status;
+    }
+    status = WriteHeader(prefix + name + ".h", name);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    std::ofstream kernels(prefix + "tnn_aot_kernels.h");
+    if (!kernels.is_open()) {
+        LOGE("tnn2cpp: open %s failed\n", (prefix + "tnn_aot_kernels.h").c_str());
+        return Status(TNNERR_COMMON_ERROR, "open output file failed");
+    }
+    kernels << kAotKernelsSource;
+
+    printf("layers: %d  arena: %.3f KB  weights: %.3f KB\n", (int)steps_.size(), arena_size_ * sizeof(float) / 1024.0,
+           weight_size_ / 1024.0);
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,111 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TOOLS_TNN2CPP_MODEL_COMPILER_H_
+#define TNN_TOOLS_TNN2CPP_MODEL_COMPILER_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tnn/core/instance.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+
+namespace TNN_NS {
+
+// @brief kernel call of the generated code, a layer of the model
+struct CompiledStep {
+    LayerInfo* layer = nullptr;
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
+    // activation fused from the next layer
+    int activation = ActivationType_None;
+    // the output shares the memory of the input, no code is generated
+    bool alias = false;
+};
+
+// @brief blob of the generated code
+struct CompiledBlob {
+    DimsVector dims;
+    bool is_input  = false;
+    bool is_output = false;
+    // blob whose memory is shared, empty if the blob owns its memory
+    std::string alias_of;
+    // first and last step using the memory
+    int first_use = -1;
+    int last_use  = -1;
+    // offset in the arena in floats, -1 for the input and output blobs
+    long long offset = -1;
+};
+
+// @brief ModelCompiler generates c++ code of a model with fixed input shapes.
+// The shapes of the blobs are inferred by a naive instance, the generated
+// code calls the kernels of tnn_aot_kernels.h with the shapes as template
+// arguments, weights are packed into aligned constants and the blobs are
+// placed in a static arena planned from their lifetimes.
+class ModelCompiler {
+public:
+    ModelCompiler();
+
+    ~ModelCompiler();
+
+    // @brief interpret the model and infer the shapes of all blobs
+    // @param inputs_shape input shapes, the shapes in proto if empty
+    Status Init(ModelConfig& model_config, InputShapesMap inputs_shape = InputShapesMap());
+
+    // @brief write name.h, name.cc and tnn_aot_kernels.h to output_dir
+    // @param name name of the generated namespace and files
+    Status Compile(std::string output_dir, std::string name);
+
+private:
+    Status InferShapes();
+    Status FuseActivations();
+    Status PlanMemory();
+
+    Status GenerateStep(CompiledStep& step, std::stringstream& weights, std::stringstream& body);
+    Status GenerateConvolution(CompiledStep& step, std::stringstream& weights, std::stringstream& body);
+    Status GenerateInnerProduct(CompiledStep& step, std::stringstream& weights, std::stringstream& body);
+    Status GenerateScale(CompiledStep& step, std::stringstream& weights, std::stringstream& body);
+
+    Status WriteHeader(std::string path, std::string name);
+    Status WriteSource(std::string path, std::string name);
+
+    // @brief blob owning the memory of the blob
+    std::string GetStorage(std::string blob);
+    // @brief pointer expression of the blob in the generated code
+    // @param offset offset in floats
+    std::string GetPointer(std::string blob, long long offset = 0);
+    // @brief identifier of the input or output argument of the blob
+    std::string GetArgument(std::string blob);
+    // @brief identifier of a weight constant of the step
+    std::string GetWeightName(CompiledStep& step, std::string suffix);
+
+    std::shared_ptr<DefaultModelInterpreter> interpreter_;
+    std::shared_ptr<Instance> instance_;
+    std::vector<std::string> input_names_;
+    std::vector<std::string> output_names_;
+    std::vector<CompiledStep> steps_;
+    std::map<std::string, CompiledBlob> blobs_;
+    std::set<std::string> weight_names_;
+    long long arena_size_  = 0;
+    long long weight_size_ = 0;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TOOLS_TNN2CPP_MODEL_COMPILER_H_
@@ -0,0 +1,306 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+// Kernels of the code generated by tnn2cpp. Every shape is a template
+// parameter, the compiler sees constant trip counts and folds the padding
+// checks. Blobs are nchw float, this header only depends on the c++ library.
+
+#ifndef TNN_TOOLS_TNN2CPP_TNN_AOT_KERNELS_H_
+#define TNN_TOOLS_TNN2CPP_TNN_AOT_KERNELS_H_
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace tnn_aot {
+
+// same values as TNN_NS::ActivationType
+enum ActivationType { kActNone = 0, kActReLU = 1, kActReLU6 = 2 };
+
+// output channels of a block of the packed convolution weights
+static const int kConvOcBlock = 4;
+
+template <int ACT>
+inline float Activate(float value) {
+    return ACT == kActReLU ? std::max(value, 0.0f)
+                           : (ACT == kActReLU6 ? std::min(std::max(value, 0.0f), 6.0f) : value);
+}
+
+// @brief first output index whose input index out * stride - pad + k is not negative
+inline int ValidBegin(int pad, int k, int stride) {
+    int v = pad - k;
+    return v <= 0 ? 0 : (v + stride - 1) / stride;
+}
+
+// @brief end of the output indices whose input index is less than in
+inline int ValidEnd(int in, int pad, int k, int stride, int out) {
+    int v = in - 1 + pad - k;
+    return v < 0 ? 0 : std::min(out, v / stride + 1);
+}
+
+// @brief accumulate one kernel tap of an input plane into an output plane
+template <int IH, int IW, int OH, int OW, int SH, int SW, int PH, int PW>
+inline void AccumulateTap(const float *input, float weight, int kh, int kw, float *output) {
+    const int oh_begin = ValidBegin(PH, kh, SH);
+    const int oh_end   = ValidEnd(IH, PH, kh, SH, OH);
+    const int ow_begin = ValidBegin(PW, kw, SW);
+    const int ow_end   = ValidEnd(IW, PW, kw, SW, OW);
+    for (int oh = oh_begin; oh < oh_end; ++oh) {
+        const float *in_row = input + (oh * SH - PH + kh) * IW - PW + kw;
+        float *out_row      = output + oh * OW;
+        for (int ow = ow_begin; ow < ow_end; ++ow) {
+            out_row[ow] += weight * in_row[ow * SW];
+        }
+    }
+}
+
+template <int COUNT, int ACT>
+inline void ActivatePlane(float *data) {
+    if (ACT == kActNone) {
+        return;
+    }
+    for (int i = 0; i < COUNT; ++i) {
+        data[i] = Activate<ACT>(data[i]);
+    }
+}
+
+// @brief convolution with packed weights
+// weight is [G][ceil(OCG / kConvOcBlock)][ICG][KH][KW][kConvOcBlock], padded with zeros
+// bias is [OC] or null
+template <int N, int IC, int IH, int IW, int OC, int OH, int OW, int KH, int KW, int SH, int SW, int PH, int PW,
+          int DH, int DW, int G, int ACT>
+inline void Conv2d(const float *input, const float *weight, const float *bias, float *output) {
+    const int ICG   = IC / G;
+    const int OCG   = OC / G;
+    const int OCB   = (OCG + kConvOcBlock - 1) / kConvOcBlock;
+    const int PLANE = OH * OW;
+    for (int n = 0; n < N; ++n) {
+        for (int g = 0; g < G; ++g) {
+            const float *in_g = input + (n * IC + g * ICG) * IH * IW;
+            for (int ob = 0; ob < OCB; ++ob) {
+                const int oc_begin = g * OCG + ob * kConvOcBlock;
+                const int oc_count = std::min(kConvOcBlock, OCG - ob * kConvOcBlock);
+                float *out_b       = output + (n * OC + oc_begin) * PLANE;
+                for (int j = 0; j < oc_count; ++j) {
+                    std::fill(out_b + j * PLANE, out_b + (j + 1) * PLANE, bias ? bias[oc_begin + j] : 0.0f);
+                }
+
+                const float *w_b = weight + (g * OCB + ob) * ICG * KH * KW * kConvOcBlock;
+                for (int ic = 0; ic < ICG; ++ic) {
+                    const float *in_c = in_g + ic * IH * IW;
+                    for (int kh = 0; kh < KH; ++kh) {
+                        for (int kw = 0; kw < KW; ++kw) {
+                            const float *w = w_b + ((ic * KH + kh) * KW + kw) * kConvOcBlock;
+                            for (int j = 0; j < oc_count; ++j) {
+                                AccumulateTap<IH, IW, OH, OW, SH, SW, PH, PW>(in_c, w[j], kh * DH, kw * DW,
+                                                                              out_b + j * PLANE);
+                            }
+                        }
+                    }
+                }
+                for (int j = 0; j < oc_count; ++j) {
+                    ActivatePlane<PLANE, ACT>(out_b + j * PLANE);
+                }
+            }
+        }
+    }
+}
+
+// @brief depthwise convolution, weight is [C][KH][KW], bias is [C] or null
+template <int N, int C, int IH, int IW, int OH, int OW, int KH, int KW, int SH, int SW, int PH, int PW, int DH,
+          int DW, int ACT>
+inline void DepthwiseConv2d(const float *input, const float *weight, const float *bias, float *output) {
+    const int PLANE = OH * OW;
+    for (int n = 0; n < N; ++n) {
+        for (int c = 0; c < C; ++c) {
+            const float *in_c = input + (n * C + c) * IH * IW;
+            float *out_c      = output + (n * C + c) * PLANE;
+            std::fill(out_c, out_c + PLANE, bias ? bias[c] : 0.0f);
+            for (int kh = 0; kh < KH; ++kh) {
+                for (int kw = 0; kw < KW; ++kw) {
+                    AccumulateTap<IH, IW, OH, OW, SH, SW, PH, PW>(in_c, weight[(c * KH + kh) * KW + kw], kh * DH,
+                                                                  kw * DW, out_c);
+                }
+            }
+            ActivatePlane<PLANE, ACT>(out_c);
+        }
+    }
+}
+
+// @brief pooling, TYPE 0 for max and 1 for average over the valid inputs
+template <int N, int C, int IH, int IW, int OH, int OW, int KH, int KW, int SH, int SW, int PH, int PW, int TYPE>
+inline void Pooling(const float *input, float *output) {
+    for (int nc = 0; nc < N * C; ++nc) {
+        const float *in_c = input + nc * IH * IW;
+        float *out_c      = output + nc * OH * OW;
+        if (OH == 1 && OW == 1 && KH >= IH && KW >= IW && PH == 0 && PW == 0) {
+            // global pooling
+            float value = TYPE == 0 ? -FLT_MAX : 0.0f;
+            for (int i = 0; i < IH * IW; ++i) {
+                value = TYPE == 0 ? std::max(value, in_c[i]) : value + in_c[i];
+            }
+            out_c[0] = TYPE == 0 ? value : value / (IH * IW);
+            continue;
+        }
+        for (int oh = 0; oh < OH; ++oh) {
+            const int h_begin = std::max(oh * SH - PH, 0);
+            const int h_end   = std::min(oh * SH - PH + KH, IH);
+            for (int ow = 0; ow < OW; ++ow) {
+                const int w_begin = std::max(ow * SW - PW, 0);
+                const int w_end   = std::min(ow * SW - PW + KW, IW);
+                float value       = TYPE == 0 ? -FLT_MAX : 0.0f;
+                for (int h = h_begin; h < h_end; ++h) {
+                    for (int w = w_begin; w < w_end; ++w) {
+                        value = TYPE == 0 ? std::max(value, in_c[h * IW + w]) : value + in_c[h * IW + w];
+                    }
+                }
+                const int count     = (h_end - h_begin) * (w_end - w_begin);
+                out_c[oh * OW + ow] = TYPE == 0 ? value : (count > 0 ? value / count : 0.0f);
+            }
+        }
+    }
+}
+
+// @brief fully connected layer, weight is [OC][IC], bias is [OC] or null
+template <int N, int IC, int OC>
+inline void InnerProduct(const float *input, const float *weight, const float *bias, float *output) {
+    for (int n = 0; n < N; ++n) {
+        const float *in_n = input + n * IC;
+        for (int oc = 0; oc < OC; ++oc) {
+            const float *w = weight + oc * IC;
+            float acc      = 0.0f;
+            for (int ic = 0; ic < IC; ++ic) {
+                acc += w[ic] * in_n[ic];
+            }
+            output[n * OC + oc] = acc + (bias ? bias[oc] : 0.0f);
+        }
+    }
+}
+
+template <int COUNT>
+inline void Relu(const float *input, float *output) {
+    for (int i = 0; i < COUNT; ++i) {
+        output[i] = std::max(input[i], 0.0f);
+    }
+}
+
+template <int COUNT>
+inline void Relu6(const float *input, float *output) {
+    for (int i = 0; i < COUNT; ++i) {
+        output[i] = std::min(std::max(input[i], 0.0f), 6.0f);
+    }
+}
+
+template <int COUNT>
+inline void Sigmoid(const float *input, float *output) {
+    for (int i = 0; i < COUNT; ++i) {
+        output[i] = 1.0f / (1.0f + std::exp(-input[i]));
+    }
+}
+
+template <int COUNT>
+inline void Add(const float *input0, const float *input1, float *output) {
+    for (int i = 0; i < COUNT; ++i) {
+        output[i] = input0[i] + input1[i];
+    }
+}
+
+template <int COUNT>
+inline void Copy(const float *input, float *output) {
+    if (input != output) {
+        std::memcpy(output, input, COUNT * sizeof(float));
+    }
+}
+
+// @brief per channel scale and bias, bias is [C] or null
+template <int N, int C, int PLANE>
+inline void ScaleBias(const float *input, const float *scale, const float *bias, float *output) {
+    for (int n = 0; n < N; ++n) {
+        for (int c = 0; c < C; ++c) {
+            const float k    = scale[c];
+            const float b    = bias ? bias[c] : 0.0f;
+            const int offset = (n * C + c) * PLANE;
+            for (int i = 0; i < PLANE; ++i) {
+                output[offset + i] = input[offset + i] * k + b;
+            }
+        }
+    }
+}
+
+// @brief copy OUTER blocks of IN_SIZE floats to the output with a stride of
+// OUT_SIZE, one input of a concat
+template <int OUTER, int IN_SIZE, int OUT_SIZE>
+inline void ConcatInput(const float *input, float *output) {
+    for (int i = 0; i < OUTER; ++i) {
+        std::memcpy(output + i * OUT_SIZE, input + i * IN_SIZE, IN_SIZE * sizeof(float));
+    }
+}
+
+template <int OUTER, int C, int INNER>
+inline void Softmax(const float *input, float *output) {
+    for (int o = 0; o < OUTER; ++o) {
+        const float *in_o = input + o * C * INNER;
+        float *out_o      = output + o * C * INNER;
+        for (int i = 0; i < INNER; ++i) {
+            float max_value = -FLT_MAX;
+            for (int c = 0; c < C; ++c) {
+                max_value = std::max(max_value, in_o[c * INNER + i]);
+            }
+            float sum = 0.0f;
+            for (int c = 0; c < C; ++c) {
+                out_o[c * INNER + i] = std::exp(in_o[c * INNER + i] - max_value);
+                sum += out_o[c * INNER + i];
+            }
+            for (int c = 0; c < C; ++c) {
+                out_o[c * INNER + i] /= sum;
+            }
+        }
+    }
+}
+
+// @brief channel c = i * (C / G) + j of the input goes to channel j * G + i
+template <int N, int G, int C, int PLANE>
+inline void ShuffleChannel(const float *input, float *output) {
+    const int CG = C / G;
+    for (int n = 0; n < N; ++n) {
+        for (int i = 0; i < G; ++i) {
+            for (int j = 0; j < CG; ++j) {
+                std::memcpy(output + (n * C + j * G + i) * PLANE, input + (n * C + i * CG + j) * PLANE,
+                            PLANE * sizeof(float));
+            }
+        }
+    }
+}
+
+// @brief strided slice of a 4 dims blob, begins and strides in nchw order
+template <int IC, int IH, int IW, int ON, int OC, int OH, int OW, int BN, int BC, int BH, int BW, int SN, int SC,
+          int SH, int SW>
+inline void StridedSlice(const float *input, float *output) {
+    for (int n = 0; n < ON; ++n) {
+        for (int c = 0; c < OC; ++c) {
+            for (int h = 0; h < OH; ++h) {
+                const float *in_row = input + (((BN + n * SN) * IC + BC + c * SC) * IH + BH + h * SH) * IW + BW;
+                float *out_row      = output + ((n * OC + c) * OH + h) * OW;
+                for (int w = 0; w < OW; ++w) {
+                    out_row[w] = in_row[w * SW];
+                }
+            }
+        }
+    }
+}
+
+}  // namespace tnn_aot
+
+#endif  // TNN_TOOLS_TNN2CPP_TNN_AOT_KERNELS_H_